@@ -0,0 +1,213 @@
+/* Copyright 2013-2019 Matt Tytel
+ *
+ * vital is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * vital is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with vital.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "audio_file_cache.h"
+
+AudioFileCache::AudioFileCache() : Thread("Vital Audio File Cache"), prefetch_format_(kDecoded),
+                                   prefetch_max_samples_(0), next_id_(0), total_bytes_(0) {
+  format_manager_.registerBasicFormats();
+  startThread();
+}
+
+AudioFileCache::~AudioFileCache() {
+  cancelPendingUpdate();
+  signalThreadShouldExit();
+  wake_.signal();
+  stopThread(-1);
+}
+
+void AudioFileCache::load(const File& file, Format format, int max_samples, Listener* listener) {
+  {
+    ScopedLock lock(lock_);
+    requests_.erase(std::remove_if(requests_.begin(), requests_.end(),
+                                   [=](const Request& request) { return request.listener == listener; }),
+                    requests_.end());
+    int64 id = next_id_++;
+    requests_.push_back({ file, format, max_samples, listener, id });
+    latest_requests_[listener] = id;
+  }
+  wake_.signal();
+}
+
+void AudioFileCache::prefetch(std::function<std::vector<File>()> find_files, Format format, int max_samples) {
+  {
+    ScopedLock lock(lock_);
+    prefetch_files_ = std::move(find_files);
+    prefetch_format_ = format;
+    prefetch_max_samples_ = max_samples;
+  }
+  wake_.signal();
+}
+
+void AudioFileCache::removeListener(Listener* listener) {
+  ScopedLock lock(lock_);
+  requests_.erase(std::remove_if(requests_.begin(), requests_.end(),
+                                 [=](const Request& request) { return request.listener == listener; }),
+                  requests_.end());
+  deliveries_.erase(std::remove_if(deliveries_.begin(), deliveries_.end(),
+                                   [=](const Delivery& delivery) { return delivery.listener == listener; }),
+                    deliveries_.end());
+  latest_requests_.erase(listener);
+}
+
+void AudioFileCache::run() {
+  while (!threadShouldExit()) {
+    Request request;
+    bool has_request = false;
+    {
+      ScopedLock lock(lock_);
+      if (!requests_.empty()) {
+        request = requests_.front();
+        requests_.erase(requests_.begin());
+        has_request = true;
+      }
+    }
+
+    if (has_request) {
+      std::shared_ptr<const Entry> entry = findOrDecode(request.file, request.format, request.max_samples);
+
+      ScopedLock lock(lock_);
+      auto latest = latest_requests_.find(request.listener);
+      if (latest != latest_requests_.end() && latest->second == request.id) {
+        deliveries_.push_back({ request.file, request.listener, entry });
+        triggerAsyncUpdate();
+      }
+    }
+    else
+      runPrefetch();
+
+    if (!hasPendingRequest())
+      wake_.wait(-1);
+  }
+}
+
+void AudioFileCache::handleAsyncUpdate() {
+  std::vector<Delivery> deliveries;
+  {
+    ScopedLock lock(lock_);
+    deliveries.swap(deliveries_);
+  }
+
+  for (Delivery& delivery : deliveries) {
+    {
+      ScopedLock lock(lock_);
+      if (latest_requests_.count(delivery.listener) == 0)
+        continue;
+    }
+    delivery.listener->audioFileDecoded(delivery.file, delivery.entry);
+  }
+}
+
+std::shared_ptr<const AudioFileCache::Entry> AudioFileCache::findOrDecode(const File& file, Format format,
+                                                                           int max_samples) {
+  if (!file.existsAsFile())
+    return nullptr;
+
+  Time modified = file.getLastModificationTime();
+  for (auto iter = entries_.begin(); iter != entries_.end(); ++iter) {
+    const Entry* entry = iter->get();
+    if (entry->file == file && entry->format == format && entry->max_samples == max_samples) {
+      std::shared_ptr<const Entry> found = *iter;
+      entries_.erase(iter);
+      if (found->modified != modified) {
+        total_bytes_ -= found->bytes;
+        break;
+      }
+
+      entries_.push_front(found);
+      return found;
+    }
+  }
+
+  std::shared_ptr<const Entry> entry = decode(file, modified, format, max_samples);
+  if (entry)
+    insert(entry);
+  return entry;
+}
+
+std::shared_ptr<const AudioFileCache::Entry> AudioFileCache::decode(const File& file, Time modified,
+                                                                     Format format, int max_samples) {
+  std::unique_ptr<AudioFormatReader> format_reader(format_manager_.createReaderFor(file));
+  if (format_reader == nullptr || format_reader->lengthInSamples <= 0)
+    return nullptr;
+
+  std::shared_ptr<Entry> entry = std::make_shared<Entry>();
+  entry->file = file;
+  entry->modified = modified;
+  entry->format = format;
+  entry->max_samples = max_samples;
+  entry->sample_rate = format_reader->sampleRate;
+
+  int num_samples = (int)std::min<long long>(format_reader->lengthInSamples, max_samples);
+  int num_channels = format_reader->numChannels;
+  entry->buffer.setSize(num_channels, num_samples);
+  format_reader->read(&entry->buffer, 0, num_samples, 0, true, true);
+  format_reader = nullptr;
+
+  if (format == kBandLimited) {
+    const float* right = num_channels > 1 ? entry->buffer.getReadPointer(1) : nullptr;
+    entry->sample_data = vital::Sample::createData(entry->buffer.getReadPointer(0), right,
+                                                   num_samples, entry->sample_rate);
+    entry->buffer.setSize(0, 0);
+    num_channels = right ? 2 : 1;
+    entry->bytes = kBandLimitedBufferMult * sizeof(float) * num_channels * (int64)entry->sample_data->length;
+  }
+  else
+    entry->bytes = sizeof(float) * num_channels * (int64)num_samples;
+
+  return entry;
+}
+
+void AudioFileCache::insert(std::shared_ptr<const Entry> entry) {
+  entries_.push_front(entry);
+  total_bytes_ += entry->bytes;
+
+  while (entries_.size() > 1 && (entries_.size() > kMaxEntries || total_bytes_ > kMaxBytes)) {
+    total_bytes_ -= entries_.back()->bytes;
+    entries_.pop_back();
+  }
+}
+
+bool AudioFileCache::hasPendingRequest() {
+  ScopedLock lock(lock_);
+  return !requests_.empty() || prefetch_files_ != nullptr;
+}
+
+void AudioFileCache::runPrefetch() {
+  std::function<std::vector<File>()> find_files;
+  Format format;
+  int max_samples;
+  {
+    ScopedLock lock(lock_);
+    find_files = std::move(prefetch_files_);
+    prefetch_files_ = nullptr;
+    format = prefetch_format_;
+    max_samples = prefetch_max_samples_;
+  }
+
+  if (find_files == nullptr)
+    return;
+
+  for (const File& file : find_files()) {
+    {
+      ScopedLock lock(lock_);
+      if (!requests_.empty() || threadShouldExit())
+        return;
+    }
+    if (file.existsAsFile())
+      findOrDecode(file, format, max_samples);
+  }
+}
@@ -0,0 +1,105 @@
+/* Copyright 2013-2019 Matt Tytel
+ *
+ * vital is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * vital is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with vital.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "JuceHeader.h"
+#include "sample_source.h"
+
+#include <functional>
+#include <list>
+#include <map>
+
+// Decodes audio files on a background thread and keeps the most recent results, keyed by path and
+// modification time. Results are delivered on the message thread, and only the latest request of each
+// listener is delivered. Prefetched files are decoded once no request is waiting.
+class AudioFileCache : public Thread, public AsyncUpdater {
+  public:
+    static constexpr int kMaxEntries = 8;
+    static constexpr int64 kMaxBytes = 512 * 1024 * 1024;
+    static constexpr int kBandLimitedBufferMult = 8;
+
+    enum Format {
+      kDecoded,
+      kBandLimited
+    };
+
+    struct Entry {
+      File file;
+      Time modified;
+      Format format;
+      int max_samples;
+      int sample_rate;
+      AudioSampleBuffer buffer;
+      std::shared_ptr<vital::Sample::SampleData> sample_data;
+      int64 bytes;
+    };
+
+    class Listener {
+      public:
+        virtual ~Listener() { }
+        // entry is nullptr when the file could not be decoded.
+        virtual void audioFileDecoded(const File& file, std::shared_ptr<const Entry> entry) = 0;
+    };
+
+    AudioFileCache();
+    virtual ~AudioFileCache();
+
+    void load(const File& file, Format format, int max_samples, Listener* listener);
+    void prefetch(std::function<std::vector<File>()> find_files, Format format, int max_samples);
+    void removeListener(Listener* listener);
+
+    void run() override;
+    void handleAsyncUpdate() override;
+
+  private:
+    struct Request {
+      File file;
+      Format format;
+      int max_samples;
+      Listener* listener;
+      int64 id;
+    };
+
+    struct Delivery {
+      File file;
+      Listener* listener;
+      std::shared_ptr<const Entry> entry;
+    };
+
+    std::shared_ptr<const Entry> findOrDecode(const File& file, Format format, int max_samples);
+    std::shared_ptr<const Entry> decode(const File& file, Time modified, Format format, int max_samples);
+    void insert(std::shared_ptr<const Entry> entry);
+    bool hasPendingRequest();
+    void runPrefetch();
+
+    AudioFormatManager format_manager_;
+    WaitableEvent wake_;
+
+    CriticalSection lock_;
+    std::vector<Request> requests_;
+    std::map<Listener*, int64> latest_requests_;
+    std::vector<Delivery> deliveries_;
+    std::function<std::vector<File>()> prefetch_files_;
+    Format prefetch_format_;
+    int prefetch_max_samples_;
+    int64 next_id_;
+
+    std::list<std::shared_ptr<const Entry>> entries_;
+    int64 total_bytes_;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(AudioFileCache)
+};
@@ -0,0 +1,320 @@
+/* Copyright 2013-2019 Matt Tytel
+ *
+ * vital is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * vital is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with vital.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "bank_writer.h"
+
+#include <thread>
+
+namespace {
+  constexpr uint32 kLocalHeaderSignature = 0x04034b50;
+  constexpr uint32 kDirectoryHeaderSignature = 0x02014b50;
+  constexpr uint32 kEndOfDirectorySignature = 0x06054b50;
+  constexpr int kVersion = 20;
+  constexpr int kUtf8NameFlag = 1 << 11;
+  constexpr int kStoreMethod = 0;
+  constexpr int kDeflateMethod = 8;
+  constexpr int64 kMaxArchiveSize = 0xffffffffLL;
+  constexpr int kMaxEntries = 0xffff;
+
+  const char* kStoredExtensions[] = { ".flac", ".ogg", ".mp3" };
+
+  class Crc32Table {
+    public:
+      Crc32Table() {
+        for (uint32 i = 0; i < 256; ++i) {
+          uint32 value = i;
+          for (int bit = 0; bit < 8; ++bit)
+            value = (value & 1) ? (0xedb88320 ^ (value >> 1)) : (value >> 1);
+          table_[i] = value;
+        }
+      }
+
+      uint32 update(uint32 crc, const uint8* data, size_t size) const {
+        crc = ~crc;
+        for (size_t i = 0; i < size; ++i)
+          crc = table_[(crc ^ data[i]) & 0xff] ^ (crc >> 8);
+        return ~crc;
+      }
+
+    private:
+      uint32 table_[256];
+  };
+
+  const Crc32Table& getCrc32Table() {
+    static const Crc32Table table;
+    return table;
+  }
+
+  void writeTimeAndDate(OutputStream& output, Time time) {
+    output.writeShort((short)(time.getSeconds() / 2 + (time.getMinutes() << 5) + (time.getHours() << 11)));
+    output.writeShort((short)(time.getDayOfMonth() + ((time.getMonth() + 1) << 5) + ((time.getYear() - 1980) << 9)));
+  }
+} // namespace
+
+BankWriter::BankWriter(const File& destination, int compression_level, int num_threads) :
+    Thread("Vital Bank Writer"), destination_(destination), total_bytes_(0),
+    prepared_bytes_(0), written_bytes_(0), state_(kIdle) {
+  compression_level_ = jlimit(0, 9, compression_level);
+  if (num_threads <= 0)
+    num_threads = std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+  num_threads_ = num_threads;
+}
+
+BankWriter::~BankWriter() {
+  stopThread(-1);
+}
+
+bool BankWriter::shouldStore(const File& file) {
+  for (const char* extension : kStoredExtensions) {
+    if (file.hasFileExtension(extension))
+      return true;
+  }
+  return false;
+}
+
+void BankWriter::addFile(const File& file, const String& stored_path) {
+  std::unique_ptr<Entry> entry = std::make_unique<Entry>();
+  entry->file = file;
+  entry->stored_path = stored_path;
+  entry->modified = file.getLastModificationTime();
+  entry->store = compression_level_ == 0 || shouldStore(file);
+  entry->uncompressed_size = 0;
+  entry->compressed_size = 0;
+  entry->header_offset = 0;
+  entry->crc = 0;
+  entry->failed = false;
+  total_bytes_ += file.getSize();
+  entries_.push_back(std::move(entry));
+}
+
+void BankWriter::start() {
+  state_.store(kWriting);
+  startThread();
+}
+
+double BankWriter::getProgress() const {
+  if (getState() == kFinished)
+    return 1.0;
+  if (total_bytes_ == 0)
+    return 0.0;
+
+  return 0.5 * (prepared_bytes_.load() + written_bytes_.load()) / total_bytes_;
+}
+
+void BankWriter::prepareEntry(Entry* entry, ThreadPoolJob* job) {
+  std::unique_ptr<FileInputStream> input = entry->file.createInputStream();
+  if (input == nullptr || input->failedToOpen()) {
+    entry->failed = true;
+    return;
+  }
+
+  std::unique_ptr<FileOutputStream> compressed_output;
+  std::unique_ptr<GZIPCompressorOutputStream> compressor;
+  if (!entry->store) {
+    entry->compressed_file = File::createTempFile(".vitalbank");
+    compressed_output = entry->compressed_file.createOutputStream(kBufferSize);
+    if (compressed_output == nullptr || compressed_output->failedToOpen()) {
+      entry->failed = true;
+      return;
+    }
+    compressor = std::make_unique<GZIPCompressorOutputStream>(*compressed_output, compression_level_,
+                                                              GZIPCompressorOutputStream::windowBitsRaw);
+  }
+
+  const Crc32Table& crc_table = getCrc32Table();
+  HeapBlock<uint8> buffer(kBufferSize);
+  uint32 crc = 0;
+  int64 size = 0;
+  while (!input->isExhausted()) {
+    if (job->shouldExit()) {
+      entry->failed = true;
+      return;
+    }
+
+    int bytes_read = input->read(buffer, kBufferSize);
+    if (bytes_read < 0) {
+      entry->failed = true;
+      return;
+    }
+
+    crc = crc_table.update(crc, buffer, bytes_read);
+    size += bytes_read;
+    if (compressor && !compressor->write(buffer, bytes_read)) {
+      entry->failed = true;
+      return;
+    }
+    prepared_bytes_ += bytes_read;
+  }
+
+  entry->crc = crc;
+  entry->uncompressed_size = size;
+  entry->compressed_size = size;
+  if (compressor) {
+    compressor = nullptr;
+    compressed_output->flush();
+    entry->failed = compressed_output->getStatus().failed();
+    compressed_output = nullptr;
+    entry->compressed_size = entry->compressed_file.getSize();
+  }
+}
+
+void BankWriter::writeFlagsAndSizes(const Entry* entry, OutputStream& output) const {
+  output.writeShort(kVersion);
+  output.writeShort(kUtf8NameFlag);
+  output.writeShort(entry->store ? kStoreMethod : kDeflateMethod);
+  writeTimeAndDate(output, entry->modified);
+  output.writeInt((int)entry->crc);
+  output.writeInt((int)(uint32)entry->compressed_size);
+  output.writeInt((int)(uint32)entry->uncompressed_size);
+  output.writeShort((short)(entry->stored_path.toUTF8().sizeInBytes() - 1));
+  output.writeShort(0);
+}
+
+bool BankWriter::writeEntry(Entry* entry, OutputStream& output) {
+  File source = entry->store ? entry->file : entry->compressed_file;
+  std::unique_ptr<FileInputStream> input = source.createInputStream();
+  if (input == nullptr || input->failedToOpen())
+    return false;
+
+  entry->header_offset = output.getPosition();
+  output.writeInt((int)kLocalHeaderSignature);
+  writeFlagsAndSizes(entry, output);
+  output << entry->stored_path;
+
+  int64 buffer_size = kBufferSize;
+  HeapBlock<uint8> buffer(buffer_size);
+  int64 remaining = entry->compressed_size;
+  while (remaining > 0) {
+    if (threadShouldExit())
+      return false;
+
+    int bytes_read = input->read(buffer, (int)std::min(remaining, buffer_size));
+    if (bytes_read <= 0 || !output.write(buffer, bytes_read))
+      return false;
+
+    remaining -= bytes_read;
+  }
+
+  written_bytes_ += entry->uncompressed_size;
+  return true;
+}
+
+bool BankWriter::writeArchive(ThreadPool& pool, OutputStream& output) {
+  // Only a few entries are compressed ahead of the writer so temporary files don't pile up.
+  int num_entries = static_cast<int>(entries_.size());
+  int max_ahead = kEntriesAheadPerThread * num_threads_;
+  int next_job = 0;
+
+  for (int i = 0; i < num_entries; ++i) {
+    for (; next_job < num_entries && next_job <= i + max_ahead; ++next_job)
+      pool.addJob(new EntryJob(this, entries_[next_job].get()), true);
+
+    Entry* entry = entries_[i].get();
+    while (!entry->ready.wait(kWaitMs)) {
+      if (threadShouldExit())
+        return false;
+    }
+
+    if (entry->failed) {
+      error_ = "Couldn't read " + entry->file.getFullPathName();
+      return false;
+    }
+    if (!writeEntry(entry, output)) {
+      if (!threadShouldExit())
+        error_ = "Couldn't write " + entry->stored_path;
+      return false;
+    }
+    if (!entry->store)
+      entry->compressed_file.deleteFile();
+
+    if (output.getPosition() > kMaxArchiveSize) {
+      error_ = "Bank is larger than 4GB";
+      return false;
+    }
+  }
+
+  int64 directory_start = output.getPosition();
+  for (auto& entry : entries_) {
+    output.writeInt((int)kDirectoryHeaderSignature);
+    output.writeShort(kVersion);
+    writeFlagsAndSizes(entry.get(), output);
+    output.writeShort(0);
+    output.writeShort(0);
+    output.writeShort(0);
+    output.writeInt(0);
+    output.writeInt((int)(uint32)entry->header_offset);
+    output << entry->stored_path;
+  }
+  int64 directory_end = output.getPosition();
+
+  output.writeInt((int)kEndOfDirectorySignature);
+  output.writeShort(0);
+  output.writeShort(0);
+  output.writeShort((short)entries_.size());
+  output.writeShort((short)entries_.size());
+  output.writeInt((int)(directory_end - directory_start));
+  output.writeInt((int)(uint32)directory_start);
+  output.writeShort(0);
+  return directory_end <= kMaxArchiveSize;
+}
+
+void BankWriter::run() {
+  if (entries_.empty() || static_cast<int>(entries_.size()) > kMaxEntries) {
+    finish(kFailed, "Bank must have between 1 and " + String(kMaxEntries) + " files");
+    return;
+  }
+
+  TemporaryFile temporary(destination_);
+  std::unique_ptr<FileOutputStream> output = temporary.getFile().createOutputStream(kBufferSize);
+  if (output == nullptr || output->failedToOpen()) {
+    finish(kFailed, "Couldn't write to " + destination_.getFullPathName());
+    return;
+  }
+
+  bool success = false;
+  {
+    ThreadPool pool(num_threads_);
+    success = writeArchive(pool, *output);
+    pool.removeAllJobs(true, kStopJobsTimeoutMs);
+  }
+
+  for (auto& entry : entries_) {
+    if (entry->compressed_file != File())
+      entry->compressed_file.deleteFile();
+  }
+
+  if (success) {
+    output->flush();
+    success = output->getStatus().wasOk();
+    if (!success)
+      error_ = output->getStatus().getErrorMessage();
+  }
+  output = nullptr;
+
+  if (threadShouldExit())
+    finish(kCancelled);
+  else if (!success)
+    finish(kFailed, error_.isEmpty() ? "Couldn't write bank" : error_);
+  else if (!temporary.overwriteTargetFileWithTemporary())
+    finish(kFailed, "Couldn't write to " + destination_.getFullPathName());
+  else
+    finish(kFinished);
+}
+
+void BankWriter::finish(State state, const String& error) {
+  error_ = error;
+  state_.store(state);
+}
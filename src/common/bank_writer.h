@@ -0,0 +1,107 @@
+/* Copyright 2013-2019 Matt Tytel
+ *
+ * vital is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * vital is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with vital.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "JuceHeader.h"
+
+#include <atomic>
+
+// Writes a bank archive on a background thread. Every entry is read once on a pool thread to find its
+// checksum, and compressed entries are deflated into a temporary file on the way. The writer thread then
+// appends the entries to the archive in order, so no entry is ever held in memory whole. Formats that are
+// already compressed are stored as they are.
+class BankWriter : public Thread {
+  public:
+    static constexpr int kDefaultCompressionLevel = 9;
+    static constexpr int kBufferSize = 1 << 16;
+    static constexpr int kWaitMs = 50;
+    static constexpr int kStopJobsTimeoutMs = 5000;
+    static constexpr int kEntriesAheadPerThread = 2;
+
+    enum State {
+      kIdle,
+      kWriting,
+      kFinished,
+      kCancelled,
+      kFailed
+    };
+
+    BankWriter(const File& destination, int compression_level = kDefaultCompressionLevel, int num_threads = 0);
+    virtual ~BankWriter();
+
+    static bool shouldStore(const File& file);
+
+    void addFile(const File& file, const String& stored_path);
+    void start();
+    void cancel() { signalThreadShouldExit(); }
+    void run() override;
+
+    State getState() const { return static_cast<State>(state_.load()); }
+    bool isDone() const { return getState() >= kFinished; }
+    double getProgress() const;
+    const String& getError() const { return error_; }
+    int getNumEntries() const { return static_cast<int>(entries_.size()); }
+
+  private:
+    struct Entry {
+      File file;
+      String stored_path;
+      Time modified;
+      bool store;
+      int64 uncompressed_size;
+      int64 compressed_size;
+      int64 header_offset;
+      uint32 crc;
+      File compressed_file;
+      bool failed;
+      WaitableEvent ready;
+    };
+
+    class EntryJob : public ThreadPoolJob {
+      public:
+        EntryJob(BankWriter* writer, Entry* entry) :
+            ThreadPoolJob("Vital Bank Entry"), writer_(writer), entry_(entry) { }
+
+        JobStatus runJob() override {
+          writer_->prepareEntry(entry_, this);
+          entry_->ready.signal();
+          return jobHasFinished;
+        }
+
+      private:
+        BankWriter* writer_;
+        Entry* entry_;
+    };
+
+    void prepareEntry(Entry* entry, ThreadPoolJob* job);
+    bool writeEntry(Entry* entry, OutputStream& output);
+    bool writeArchive(ThreadPool& pool, OutputStream& output);
+    void writeFlagsAndSizes(const Entry* entry, OutputStream& output) const;
+    void finish(State state, const String& error = "");
+
+    File destination_;
+    int compression_level_;
+    int num_threads_;
+    std::vector<std::unique_ptr<Entry>> entries_;
+    int64 total_bytes_;
+    std::atomic<int64> prepared_bytes_;
+    std::atomic<int64> written_bytes_;
+    std::atomic<int> state_;
+    String error_;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(BankWriter)
+};
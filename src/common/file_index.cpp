@@ -0,0 +1,370 @@
+/* Copyright 2013-2019 Matt Tytel
+ *
+ * vital is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * vital is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with vital.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "file_index.h"
+
+#include "load_save.h"
+
+#include <chrono>
+#include <set>
+
+#if JUCE_LINUX
+#include <sys/inotify.h>
+#include <unistd.h>
+#endif
+
+namespace {
+  constexpr int kIndexVersion = 1;
+
+  double getMilliseconds() {
+    std::chrono::duration<double, std::milli> time = std::chrono::steady_clock::now().time_since_epoch();
+    return time.count();
+  }
+} // namespace
+
+FileIndex::FileIndex() : Thread("Vital File Index"), next_id_(0), dirty_(false), watch_fd_(-1) {
+#if JUCE_LINUX
+  watch_fd_ = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+#endif
+  load();
+}
+
+FileIndex::~FileIndex() {
+  cancelPendingUpdate();
+  signalThreadShouldExit();
+  wake_.signal();
+  stopThread(-1);
+  save();
+
+#if JUCE_LINUX
+  if (watch_fd_ >= 0)
+    close(watch_fd_);
+#endif
+}
+
+void FileIndex::findFiles(Array<File>& files, const String& wildcards, const std::vector<File>& directories) {
+  walk(directories, parseWildcards(wildcards), files, nullptr);
+}
+
+void FileIndex::request(const std::vector<File>& directories, const String& wildcards, Listener* listener) {
+  {
+    ScopedLock lock(request_lock_);
+    requests_.erase(std::remove_if(requests_.begin(), requests_.end(),
+                                   [=](const Request& request) { return request.listener == listener; }),
+                    requests_.end());
+    int64 id = next_id_++;
+    requests_.push_back({ directories, parseWildcards(wildcards), listener, id });
+    latest_requests_[listener] = id;
+  }
+
+  if (!isThreadRunning())
+    startThread();
+  wake_.signal();
+}
+
+void FileIndex::removeListener(Listener* listener) {
+  ScopedLock lock(request_lock_);
+  requests_.erase(std::remove_if(requests_.begin(), requests_.end(),
+                                 [=](const Request& request) { return request.listener == listener; }),
+                  requests_.end());
+  deliveries_.erase(std::remove_if(deliveries_.begin(), deliveries_.end(),
+                                   [=](const Delivery& delivery) { return delivery.listener == listener; }),
+                    deliveries_.end());
+  latest_requests_.erase(listener);
+}
+
+void FileIndex::run() {
+  while (!threadShouldExit()) {
+    Request request;
+    bool has_request = false;
+    {
+      ScopedLock lock(request_lock_);
+      if (!requests_.empty()) {
+        request = requests_.front();
+        requests_.erase(requests_.begin());
+        has_request = true;
+      }
+    }
+
+    if (has_request) {
+      Array<File> results;
+      walk(request.directories, request.wildcards, results, &request);
+      continue;
+    }
+
+    readWatchEvents();
+    save();
+    wake_.wait(kIdleWaitMs);
+  }
+}
+
+void FileIndex::handleAsyncUpdate() {
+  std::vector<Delivery> deliveries;
+  {
+    ScopedLock lock(request_lock_);
+    deliveries.swap(deliveries_);
+  }
+
+  for (Delivery& delivery : deliveries) {
+    {
+      ScopedLock lock(request_lock_);
+      auto latest = latest_requests_.find(delivery.listener);
+      if (latest == latest_requests_.end() || latest->second != delivery.id)
+        continue;
+    }
+    delivery.listener->filesIndexed(delivery.files);
+  }
+}
+
+StringArray FileIndex::parseWildcards(const String& wildcards) {
+  StringArray result;
+  result.addTokens(wildcards, ";,", "\"'");
+  result.trim();
+  result.removeEmptyStrings();
+  return result;
+}
+
+bool FileIndex::matchesWildcards(const String& name, const StringArray& wildcards) {
+  for (const String& wildcard : wildcards) {
+    if (name.matchesWildcard(wildcard, !File::areFileNamesCaseSensitive()))
+      return true;
+  }
+  return false;
+}
+
+bool FileIndex::walk(const std::vector<File>& directories, const StringArray& wildcards, Array<File>& results,
+                     const Request* request) {
+  readWatchEvents();
+
+  std::vector<File> stack(directories.rbegin(), directories.rend());
+  std::set<String> visited;
+  double last_delivery = getMilliseconds();
+
+  while (!stack.empty()) {
+    File directory = stack.back();
+    stack.pop_back();
+    if (!visited.insert(directory.getFullPathName()).second)
+      continue;
+
+    Listing listing;
+    if (!getListing(directory, listing))
+      continue;
+
+    for (const String& name : listing.files) {
+      if (matchesWildcards(name, wildcards))
+        results.add(directory.getChildFile(name));
+    }
+    for (int i = listing.directories.size() - 1; i >= 0; --i)
+      stack.push_back(directory.getChildFile(listing.directories[i]));
+
+    if (request) {
+      if (threadShouldExit() || !isLatest(*request))
+        return false;
+
+      double now = getMilliseconds();
+      if (now - last_delivery >= kBatchMs && !results.isEmpty()) {
+        deliver(*request, results);
+        last_delivery = now;
+      }
+    }
+  }
+
+  if (request)
+    deliver(*request, results);
+  return true;
+}
+
+bool FileIndex::getListing(const File& directory, Listing& listing) {
+  String path = directory.getFullPathName();
+  {
+    ScopedLock lock(index_lock_);
+    auto found = listings_.find(path);
+    if (found != listings_.end() && found->second.trusted) {
+      listing = found->second;
+      return true;
+    }
+  }
+
+  int64 modified = directory.getLastModificationTime().toMilliseconds();
+  bool watched = addWatch(path);
+  {
+    ScopedLock lock(index_lock_);
+    auto found = listings_.find(path);
+    if (found != listings_.end() && found->second.modified == modified) {
+      // A change after the watch was added removes the listing, so it can be trusted from now on.
+      found->second.trusted = watched;
+      listing = found->second;
+      return true;
+    }
+  }
+
+  if (!directory.isDirectory())
+    return false;
+
+  listing.modified = modified;
+  listing.trusted = false;
+  for (const DirectoryEntry& entry : RangedDirectoryIterator(directory, false, "*", File::findFilesAndDirectories)) {
+    if (entry.isDirectory())
+      listing.directories.add(entry.getFile().getFileName());
+    else
+      listing.files.add(entry.getFile().getFileName());
+  }
+
+  ScopedLock lock(index_lock_);
+  listings_[path] = listing;
+  dirty_ = true;
+  return true;
+}
+
+bool FileIndex::isLatest(const Request& request) {
+  ScopedLock lock(request_lock_);
+  auto latest = latest_requests_.find(request.listener);
+  return latest != latest_requests_.end() && latest->second == request.id;
+}
+
+void FileIndex::deliver(const Request& request, Array<File>& files) {
+  ScopedLock lock(request_lock_);
+  auto latest = latest_requests_.find(request.listener);
+  if (latest == latest_requests_.end() || latest->second != request.id)
+    return;
+
+  deliveries_.push_back({ request.listener, request.id, files });
+  files.clear();
+  triggerAsyncUpdate();
+}
+
+bool FileIndex::addWatch(const String& path) {
+#if JUCE_LINUX
+  if (watch_fd_ < 0)
+    return false;
+
+  {
+    ScopedLock lock(index_lock_);
+    if (watches_.count(path))
+      return true;
+    if (watches_.size() >= kMaxWatches)
+      return false;
+  }
+
+  uint32_t mask = IN_CREATE | IN_DELETE | IN_MOVED_FROM | IN_MOVED_TO | IN_DELETE_SELF | IN_MOVE_SELF | IN_ONLYDIR;
+  int watch = inotify_add_watch(watch_fd_, path.toRawUTF8(), mask);
+  if (watch < 0)
+    return false;
+
+  ScopedLock lock(index_lock_);
+  watches_[path] = watch;
+  watch_paths_[watch] = path;
+  return true;
+#else
+  return false;
+#endif
+}
+
+void FileIndex::readWatchEvents() {
+#if JUCE_LINUX
+  if (watch_fd_ < 0)
+    return;
+
+  alignas(inotify_event) char buffer[4096];
+  while (true) {
+    ssize_t length = read(watch_fd_, buffer, sizeof(buffer));
+    if (length <= 0)
+      return;
+
+    ScopedLock lock(index_lock_);
+    for (char* position = buffer; position < buffer + length;) {
+      const inotify_event* event = reinterpret_cast<const inotify_event*>(position);
+      position += sizeof(inotify_event) + event->len;
+
+      if (event->mask & IN_Q_OVERFLOW) {
+        for (auto& listing : listings_)
+          listing.second.trusted = false;
+        continue;
+      }
+
+      auto found = watch_paths_.find(event->wd);
+      if (found == watch_paths_.end())
+        continue;
+
+      listings_.erase(found->second);
+      if (event->mask & IN_IGNORED) {
+        watches_.erase(found->second);
+        watch_paths_.erase(found);
+      }
+    }
+  }
+#endif
+}
+
+void FileIndex::load() {
+  File file = LoadSave::getFileIndexFile();
+  if (!file.existsAsFile())
+    return;
+
+  try {
+    json data = json::parse(file.loadFileAsString().toStdString(), nullptr, false);
+    if (data.is_discarded() || data.count("version") == 0 || data["version"] != kIndexVersion)
+      return;
+
+    for (auto& entry : data["directories"].items()) {
+      Listing listing;
+      listing.modified = entry.value()["modified"];
+      listing.trusted = false;
+      for (const std::string& name : entry.value()["files"])
+        listing.files.add(name);
+      for (const std::string& name : entry.value()["directories"])
+        listing.directories.add(name);
+      listings_[String(entry.key())] = std::move(listing);
+    }
+  }
+  catch (const json::exception& e) {
+    listings_.clear();
+  }
+}
+
+void FileIndex::save() {
+  json directories;
+  {
+    ScopedLock lock(index_lock_);
+    if (!dirty_)
+      return;
+
+    for (const auto& listing : listings_) {
+      json entry;
+      entry["modified"] = listing.second.modified;
+      json files = json::array();
+      for (const String& name : listing.second.files)
+        files.push_back(name.toStdString());
+      json folders = json::array();
+      for (const String& name : listing.second.directories)
+        folders.push_back(name.toStdString());
+      entry["files"] = files;
+      entry["directories"] = folders;
+      directories[listing.first.toStdString()] = entry;
+    }
+    dirty_ = false;
+  }
+
+  File file = LoadSave::getFileIndexFile();
+  if (file == File())
+    return;
+
+  json data;
+  data["version"] = kIndexVersion;
+  data["directories"] = directories;
+  file.getParentDirectory().createDirectory();
+  file.replaceWithText(data.dump());
+}
@@ -0,0 +1,101 @@
+/* Copyright 2013-2019 Matt Tytel
+ *
+ * vital is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * vital is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with vital.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "JuceHeader.h"
+
+#include <map>
+
+// Lists audio and preset folders recursively without walking the disk every time. Each directory's listing
+// is kept with the directory's modification time, which changes whenever an entry is added, removed or
+// renamed, so a directory is only read again once its time changes. Where inotify is available, listings
+// that have been confirmed since their watch was added are trusted without touching the disk at all. The
+// index is saved between sessions. Requests run on a background thread and stream results to the
+// listener on the message thread.
+class FileIndex : public Thread, public AsyncUpdater {
+  public:
+    static constexpr int kBatchMs = 50;
+    static constexpr int kIdleWaitMs = 1000;
+    static constexpr int kMaxWatches = 4096;
+
+    class Listener {
+      public:
+        virtual ~Listener() { }
+        virtual void filesIndexed(const Array<File>& files) = 0;
+    };
+
+    FileIndex();
+    virtual ~FileIndex();
+
+    void findFiles(Array<File>& files, const String& wildcards, const std::vector<File>& directories);
+    void request(const std::vector<File>& directories, const String& wildcards, Listener* listener);
+    void removeListener(Listener* listener);
+
+    void run() override;
+    void handleAsyncUpdate() override;
+
+  private:
+    struct Listing {
+      int64 modified;
+      StringArray files;
+      StringArray directories;
+      bool trusted;
+    };
+
+    struct Request {
+      std::vector<File> directories;
+      StringArray wildcards;
+      Listener* listener;
+      int64 id;
+    };
+
+    struct Delivery {
+      Listener* listener;
+      int64 id;
+      Array<File> files;
+    };
+
+    static StringArray parseWildcards(const String& wildcards);
+    static bool matchesWildcards(const String& name, const StringArray& wildcards);
+
+    bool walk(const std::vector<File>& directories, const StringArray& wildcards, Array<File>& results,
+              const Request* request);
+    bool getListing(const File& directory, Listing& listing);
+    bool isLatest(const Request& request);
+    void deliver(const Request& request, Array<File>& files);
+    bool addWatch(const String& path);
+    void readWatchEvents();
+    void load();
+    void save();
+
+    WaitableEvent wake_;
+
+    CriticalSection request_lock_;
+    std::vector<Request> requests_;
+    std::map<Listener*, int64> latest_requests_;
+    std::vector<Delivery> deliveries_;
+    int64 next_id_;
+
+    CriticalSection index_lock_;
+    std::map<String, Listing> listings_;
+    std::map<int, String> watch_paths_;
+    std::map<String, int> watches_;
+    bool dirty_;
+    int watch_fd_;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(FileIndex)
+};
@@ -170,18 +170,35 @@ namespace vital {
 
   #endif
 
+  inline CriticalSection& getFourierPlanLock() {
+    static CriticalSection plan_lock;
+    return plan_lock;
+  }
+
   template <size_t bits>
   class FFT {
     public:
+      // Each thread gets its own scratch buffers so wavetables can render off the message thread.
       static FourierTransform* transform() {
-        static FFT<bits> instance;
-        return &instance.fourier_transform_;
+        static thread_local FFT<bits> instance;
+        return instance.fourier_transform_.get();
       }
 
+      // Plans this thread's transform up front so the first render doesn't have to.
+      static void prepare() { transform(); }
+
     private:
-      FFT() : fourier_transform_(bits) { }
+      FFT() {
+        ScopedLock lock(getFourierPlanLock());
+        fourier_transform_ = std::make_unique<FourierTransform>(bits);
+      }
+
+      ~FFT() {
+        ScopedLock lock(getFourierPlanLock());
+        fourier_transform_ = nullptr;
+      }
 
-      FourierTransform fourier_transform_;
+      std::unique_ptr<FourierTransform> fourier_transform_;
   };
 
 } // namespace vital
@@ -15,6 +15,9 @@
  */
 
 #include "load_save.h"
+#include "bank_writer.h"
+#include "convolution.h"
+#include "file_index.h"
 #include "modulation_connection_processor.h"
 #include "sound_engine.h"
 #include "midi_manager.h"
@@ -101,6 +104,10 @@ json LoadSave::stateToJson(SynthBase* synth, const CriticalSection& critical_sec
   if (sample)
     settings_data["sample"] = sample->stateToJson();
 
+  vital::Convolution* convolution = synth->getConvolution();
+  if (convolution && !convolution->hasDefaultImpulse())
+    settings_data["convolution_impulse"] = convolution->stateToJson();
+
   json modulations;
   vital::ModulationConnectionBank& modulation_bank = synth->getModulationBank();
   for (int i = 0; i < vital::kMaxModulationConnections; ++i) {
@@ -195,22 +202,30 @@ void LoadSave::loadModulations(SynthBase* synth, const json& modulations) {
   }
 }
 
-void LoadSave::loadSample(SynthBase* synth, const json& json_sample) {
-  vital::Sample* sample = synth->getSample();
-  if (sample)
-    sample->jsonToState(json_sample);
+LoadSave::StagedState::StagedState() = default;
+
+LoadSave::StagedState::~StagedState() = default;
+
+void LoadSave::stageSample(StagedState* staged, json& json_sample) {
+  staged->sample = std::make_unique<vital::Sample>();
+  staged->sample->jsonToState(std::move(json_sample));
 }
 
-void LoadSave::loadWavetables(SynthBase* synth, const json& wavetables) {
-  if (synth->getWavetableCreator(0) == nullptr)
-    return;
+void LoadSave::stageImpulse(StagedState* staged, json& impulse) {
+  staged->impulse = std::make_unique<vital::Convolution::ImpulseResponse>(
+      vital::Convolution::jsonToImpulse(std::move(impulse)));
+}
 
-  int i = 0;
-  for (const json& wavetable : wavetables) {
-    WavetableCreator* wavetable_creator = synth->getWavetableCreator(i);
-    wavetable_creator->jsonToState(wavetable);
+void LoadSave::stageWavetables(StagedState* staged, json& wavetables) {
+  for (json& wavetable : wavetables) {
+    if (staged->wavetable_creators.size() >= vital::kNumOscillators)
+      break;
+
+    staged->wavetables.push_back(std::make_unique<vital::Wavetable>(vital::kNumOscillatorWaveFrames));
+    staged->wavetable_creators.push_back(std::make_unique<WavetableCreator>(staged->wavetables.back().get()));
+    WavetableCreator* wavetable_creator = staged->wavetable_creators.back().get();
+    wavetable_creator->jsonToState(std::move(wavetable));
     wavetable_creator->render();
-    i++;
   }
 }
 
@@ -224,7 +239,7 @@ void LoadSave::loadLfos(SynthBase* synth, const json& lfos) {
   }
 }
 
-void LoadSave::loadSaveState(std::map<std::string, String>& state, json data) {
+void LoadSave::loadSaveState(std::map<std::string, String>& state, const json& data) {
   if (data.count("preset_name")) {
     std::string preset_name = data["preset_name"];
     state["preset_name"] = preset_name;
@@ -267,10 +282,9 @@ void LoadSave::initSaveInfo(std::map<std::string, String>& save_info) {
 }
 
 json LoadSave::updateFromOldVersion(json state) {
-  json settings = state["settings"];
-  json modulations = settings["modulations"];
-  json sample = settings["sample"];
-  json wavetables = settings["wavetables"];
+  json& settings = state["settings"];
+  json modulations = std::move(settings["modulations"]);
+  json& sample = settings["sample"];
 
   std::string version = state["synth_version"];
 
@@ -330,11 +344,9 @@ json LoadSave::updateFromOldVersion(json state) {
     }
 
     if (settings.count("wave_tables"))
-      settings["wavetables"] = settings["wave_tables"];
+      settings["wavetables"] = std::move(settings["wave_tables"]);
   }
 
-  wavetables = settings["wavetables"];
-
   if (compareVersionStrings(version, "0.2.4") < 0) {
     int portamento_type = settings["portamento_type"];
     settings["portamento_force"] = std::max(0, portamento_type - 1);
@@ -429,15 +441,17 @@ json LoadSave::updateFromOldVersion(json state) {
   }
 
   if (compareVersionStrings(version, "0.3.4") < 0) {
+    // The chain had every effect before convolution except the filter.
+    static constexpr int kNumOldEffects = vital::constants::kConvolution - 1;
     float float_order = settings["effect_chain_order"];
     int effect_order[vital::constants::kNumEffects];
-    vital::utils::decodeFloatToOrder(effect_order, float_order, vital::constants::kNumEffects - 1);
-    for (int i = 0; i < vital::constants::kNumEffects - 1; ++i) {
+    vital::utils::decodeFloatToOrder(effect_order, float_order, kNumOldEffects);
+    for (int i = 0; i < kNumOldEffects; ++i) {
       if (effect_order[i] >= vital::constants::kFilterFx)
         effect_order[i] += 1;
     }
-    effect_order[vital::constants::kNumEffects - 1] = vital::constants::kFilterFx;
-    settings["effect_chain_order"] = vital::utils::encodeOrderToFloat(effect_order, vital::constants::kNumEffects);
+    effect_order[kNumOldEffects] = vital::constants::kFilterFx;
+    settings["effect_chain_order"] = vital::utils::encodeOrderToFloat(effect_order, kNumOldEffects + 1);
   }
 
   if (compareVersionStrings(version, "0.3.5") < 0) {
@@ -764,12 +778,13 @@ json LoadSave::updateFromOldVersion(json state) {
     wavetable_creator.initPredefinedWaves();
     wavetable_creator.setName("Sub");
 
+    json& wavetables = settings["wavetables"];
     json new_wavetables;
     for (int i = (int)wavetables.size() - 1; i >= 0; --i)
-      new_wavetables.push_back(wavetables[i]);
+      new_wavetables.push_back(std::move(wavetables[i]));
 
     new_wavetables.push_back(wavetable_creator.stateToJson());
-    settings["wavetables"] = new_wavetables;
+    wavetables = std::move(new_wavetables);
 
     json new_modulations;
     for (json& modulation : modulations) {
@@ -1018,13 +1033,19 @@ json LoadSave::updateFromOldVersion(json state) {
     }
   }
 
-  settings["modulations"] = modulations;
-  settings["sample"] = sample;
-  state["settings"] = settings;
+  if (!settings.count("convolution_on") && settings.count("effect_chain_order")) {
+    float float_order = settings["effect_chain_order"];
+    int effect_order[vital::constants::kNumEffects];
+    vital::utils::decodeFloatToOrder(effect_order, float_order, vital::constants::kConvolution);
+    effect_order[vital::constants::kConvolution] = vital::constants::kConvolution;
+    settings["effect_chain_order"] = vital::utils::encodeOrderToFloat(effect_order, vital::constants::kNumEffects);
+  }
+
+  settings["modulations"] = std::move(modulations);
   return state;
 }
 
-bool LoadSave::jsonToState(SynthBase* synth, std::map<std::string, String>& save_info, json data) {
+bool LoadSave::prepareState(StagedState* staged, json data) {
   std::string version = data["synth_version"];
   
   int compare_feature_versions = compareFeatureVersionStrings(version, ProjectInfo::versionString);
@@ -1032,23 +1053,56 @@ bool LoadSave::jsonToState(SynthBase* synth, std::map<std::string, String>& save
     return false;
   
   int compare_versions = compareVersionStrings(version, ProjectInfo::versionString);
-  if (compare_versions < 0 || data["settings"].count("sub_octave"))
-    data = updateFromOldVersion(data);
+  json& old_settings = data["settings"];
+  if (compare_versions < 0 || old_settings.count("sub_octave") || !old_settings.count("convolution_on"))
+    data = updateFromOldVersion(std::move(data));
   
-  json settings = data["settings"];
-  json modulations = settings["modulations"];
-  json sample = settings["sample"];
-  json wavetables = settings["wavetables"];
-  json lfos = settings["lfos"];
+  // Sub trees are passed by reference and blobs are moved into their loaders to avoid copying them.
+  json& settings = data["settings"];
+  stageSample(staged, settings["sample"]);
+  if (settings.count("convolution_impulse"))
+    stageImpulse(staged, settings["convolution_impulse"]);
+  stageWavetables(staged, settings["wavetables"]);
+  staged->data = std::move(data);
+  return true;
+}
+
+void LoadSave::applyState(SynthBase* synth, std::map<std::string, String>& save_info, StagedState* staged) {
+  json& settings = staged->data["settings"];
+  json& modulations = settings["modulations"];
+  json& lfos = settings["lfos"];
 
   loadControls(synth, settings);
   loadModulations(synth, modulations);
-  loadSample(synth, sample);
-  loadWavetables(synth, wavetables);
+
+  vital::Sample* sample = synth->getSample();
+  if (sample && staged->sample)
+    sample->swapData(staged->sample.get());
+
+  vital::Convolution* convolution = synth->getConvolution();
+  if (convolution) {
+    if (staged->impulse)
+      convolution->setImpulse(std::move(*staged->impulse));
+    else
+      convolution->loadDefaultImpulse();
+  }
+
+  if (synth->getWavetableCreator(0)) {
+    for (int i = 0; i < staged->wavetable_creators.size(); ++i)
+      synth->getWavetableCreator(i)->swapData(staged->wavetable_creators[i].get());
+  }
+
   loadLfos(synth, lfos);
-  loadSaveState(save_info, data);
+  loadSaveState(save_info, staged->data);
   synth->checkOversampling();
-  
+}
+
+bool LoadSave::jsonToState(SynthBase* synth, std::map<std::string, String>& save_info, json data) {
+  StagedState staged;
+  if (!prepareState(&staged, std::move(data)))
+    return false;
+
+  applyState(synth, save_info, &staged);
   return true;
 }
 
@@ -1181,6 +1235,25 @@ File LoadSave::getFavoritesFile() {
 #endif
 }
 
+File LoadSave::getFileIndexFile() {
+#if defined(JUCE_DATA_STRUCTURES_H_INCLUDED)
+  PropertiesFile::Options config_options;
+  config_options.applicationName = "Vial";
+  config_options.osxLibrarySubFolder = "Application Support";
+  config_options.filenameSuffix = "index";
+
+#ifdef LINUX
+  config_options.folderName = "." + String(ProjectInfo::projectName).toLowerCase();
+#else
+  config_options.folderName = String(ProjectInfo::projectName).toLowerCase();
+#endif
+
+  return config_options.getDefaultFile();
+#else
+  return File();
+#endif
+}
+
 File LoadSave::getDefaultSkin() {
 #if defined(JUCE_DATA_STRUCTURES_H_INCLUDED)
   PropertiesFile::Options config_options;
@@ -1325,6 +1398,24 @@ void LoadSave::saveAnimateWidgets(bool animate_widgets) {
   saveJsonToConfig(data);
 }
 
+void LoadSave::saveBankCompressionLevel(int level) {
+  json data = getConfigJson();
+  data["bank_compression_level"] = level;
+  saveJsonToConfig(data);
+}
+
+void LoadSave::savePresetSwitchFade(float seconds) {
+  json data = getConfigJson();
+  data["preset_switch_fade"] = seconds;
+  saveJsonToConfig(data);
+}
+
+void LoadSave::savePresetSwitchStyle(int style) {
+  json data = getConfigJson();
+  data["preset_switch_style"] = style;
+  saveJsonToConfig(data);
+}
+
 void LoadSave::saveDisplayHzFrequency(bool hz_frequency) {
   json data = getConfigJson();
   data["hz_frequency"] = hz_frequency;
@@ -1630,6 +1721,33 @@ int LoadSave::getOversamplingAmount() {
   return data["oversampling_amount"];
 }
 
+int LoadSave::getBankCompressionLevel() {
+  json data = getConfigJson();
+
+  if (!data.count("bank_compression_level"))
+    return BankWriter::kDefaultCompressionLevel;
+
+  return data["bank_compression_level"];
+}
+
+float LoadSave::getPresetSwitchFade() {
+  json data = getConfigJson();
+
+  if (!data.count("preset_switch_fade"))
+    return SynthBase::kDefaultPresetFadeSeconds;
+
+  return data["preset_switch_fade"];
+}
+
+int LoadSave::getPresetSwitchStyle() {
+  json data = getConfigJson();
+
+  if (!data.count("preset_switch_style"))
+    return SynthBase::kFadeVoices;
+
+  return data["preset_switch_style"];
+}
+
 float LoadSave::loadWindowSize() {
   static constexpr float kMinWindowSize = 0.25f;
   
@@ -1841,11 +1959,9 @@ File LoadSave::getUserLfoDirectory() {
 
 void LoadSave::getAllFilesOfTypeInDirectories(Array<File>& files, const String& extensions,
                                               const std::vector<File>& directories) {
+  SharedResourcePointer<FileIndex> file_index;
   files.clear();
-  for (const File& directory : directories) {
-    if (directory.exists() && directory.isDirectory())
-      directory.findChildFiles(files, File::findFiles, true, extensions);
-  }
+  file_index->findFiles(files, extensions, directories);
 }
 
 void LoadSave::getAllPresets(Array<File>& presets) {
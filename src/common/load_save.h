@@ -17,6 +17,7 @@
 #pragma once
 
 #include "JuceHeader.h"
+#include "convolution.h"
 #include "json/json.h"
 
 #include <map>
@@ -26,11 +27,14 @@
 using json = nlohmann::json;
 
 namespace vital {
+  class Sample;
   class StringLayout;
+  class Wavetable;
 }
 
 class MidiManager;
 class SynthBase;
+class WavetableCreator;
 
 class LoadSave {
   public:
@@ -46,6 +50,18 @@ class LoadSave {
         JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(FileSorterAscending)
     };
 
+    // A preset with its sample and wavetables already decoded and rendered, ready to be swapped into a synth.
+    struct StagedState {
+      StagedState();
+      ~StagedState();
+
+      json data;
+      std::unique_ptr<vital::Sample> sample;
+      std::unique_ptr<vital::Convolution::ImpulseResponse> impulse;
+      std::vector<std::unique_ptr<vital::Wavetable>> wavetables;
+      std::vector<std::unique_ptr<WavetableCreator>> wavetable_creators;
+    };
+
     enum PresetStyle {
       kBass,
       kLead,
@@ -75,13 +91,16 @@ class LoadSave {
 
     static void loadControls(SynthBase* synth, const json& data);
     static void loadModulations(SynthBase* synth, const json& modulations);
-    static void loadSample(SynthBase* synth, const json& sample);
-    static void loadWavetables(SynthBase* synth, const json& wavetables);
+    static void stageSample(StagedState* staged, json& sample);
+    static void stageImpulse(StagedState* staged, json& impulse);
+    static void stageWavetables(StagedState* staged, json& wavetables);
     static void loadLfos(SynthBase* synth, const json& lfos);
-    static void loadSaveState(std::map<std::string, String>& save_info, json data);
+    static void loadSaveState(std::map<std::string, String>& save_info, const json& data);
 
     static void initSaveInfo(std::map<std::string, String>& save_info);
     static json updateFromOldVersion(json state);
+    static bool prepareState(StagedState* staged, json state);
+    static void applyState(SynthBase* synth, std::map<std::string, String>& save_info, StagedState* staged);
     static bool jsonToState(SynthBase* synth, std::map<std::string, String>& save_info, json state);
 
     static String getAuthorFromFile(const File& file);
@@ -94,6 +113,7 @@ class LoadSave {
     static void writeErrorLog(String error_log);
     static json getConfigJson();
     static File getFavoritesFile();
+    static File getFileIndexFile();
     static File getDefaultSkin();
     static json getFavoritesJson();
     static void addFavorite(const File& new_favorite);
@@ -120,6 +140,9 @@ class LoadSave {
     static bool displayHzFrequency();
     static bool authenticated();
     static int getOversamplingAmount();
+    static int getBankCompressionLevel();
+    static float getPresetSwitchFade();
+    static int getPresetSwitchStyle();
     static float loadWindowSize();
     static String loadVersion();
     static String loadContentVersion();
@@ -134,6 +157,9 @@ class LoadSave {
     static void saveWorkOffline(bool work_offline);
     static void saveLoadedSkin(const std::string& name);
     static void saveAnimateWidgets(bool animate_widgets);
+    static void saveBankCompressionLevel(int level);
+    static void savePresetSwitchFade(float seconds);
+    static void savePresetSwitchStyle(int style);
     static void saveDisplayHzFrequency(bool display_hz);
     static void saveAuthenticated(bool authenticated);
     static void saveWindowSize(float window_size);
@@ -16,6 +16,8 @@
 
 #include "synth_base.h"
 
+#include "convolution.h"
+#include "fourier_transform.h"
 #include "sample_source.h"
 #include "sound_engine.h"
 #include "load_save.h"
@@ -24,9 +26,15 @@
 #include "startup.h"
 #include "synth_gui_interface.h"
 #include "synth_parameters.h"
+#include "telemetry_tap.h"
 #include "utils.h"
+#include "wave_frame.h"
 
-SynthBase::SynthBase() : expired_(false) {
+#include <chrono>
+
+SynthBase::SynthBase() : expired_(false), preset_switch_state_(kSwitchIdle), preset_switch_style_(kFadeVoices),
+                         preset_fade_seconds_(kDefaultPresetFadeSeconds), preset_switch_gain_(1.0f),
+                         preset_release_samples_(0) {
   expired_ = LoadSave::isExpired();
   self_reference_ = std::make_shared<SynthBase*>();
   *self_reference_ = this;
@@ -43,25 +51,26 @@ SynthBase::SynthBase() : expired_(false) {
       wavetable_creators_[i]->init();
     }
   }
+  vital::FFT<vital::WaveFrame::kWaveformBits>::prepare();
 
   keyboard_state_ = std::make_unique<MidiKeyboardState>();
   midi_manager_ = std::make_unique<MidiManager>(this, keyboard_state_.get(), &save_info_, this);
 
   last_played_note_ = 0.0f;
   last_num_pressed_ = 0;
-  audio_memory_ = std::make_unique<vital::StereoMemory>(vital::kAudioMemorySamples);
-  memset(oscilloscope_memory_, 0, 2 * vital::kOscilloscopeMemoryResolution * sizeof(vital::poly_float));
-  memset(oscilloscope_memory_write_, 0, 2 * vital::kOscilloscopeMemoryResolution * sizeof(vital::poly_float));
-  memory_reset_period_ = vital::kOscilloscopeMemoryResolution;
-  memory_input_offset_ = 0;
-  memory_index_ = 0;
+  telemetry_tap_ = std::make_unique<TelemetryTap>();
 
   controls_ = engine_->getControls();
 
   Startup::doStartupChecks(midi_manager_.get());
+  setPresetSwitchFade(LoadSave::getPresetSwitchFade());
+  setPresetSwitchStyle(static_cast<PresetSwitchStyle>(LoadSave::getPresetSwitchStyle()));
 }
 
-SynthBase::~SynthBase() { }
+SynthBase::~SynthBase() {
+  if (preset_loader_)
+    preset_loader_->stopThread(-1);
+}
 
 void SynthBase::valueChanged(const std::string& name, vital::mono_float value) {
   controls_[name]->set(value);
@@ -291,6 +300,10 @@ vital::Sample* SynthBase::getSample() {
   return engine_->getSample();
 }
 
+vital::Convolution* SynthBase::getConvolution() {
+  return engine_->getConvolution();
+}
+
 LineGenerator* SynthBase::getLfoSource(int index) {
   return engine_->getLfoSource(index);
 }
@@ -312,6 +325,8 @@ void SynthBase::initEngine() {
     engine_->getSample()->init();
   }
 
+  engine_->getConvolution()->loadDefaultImpulse();
+
   for (int i = 0; i < vital::kNumLfos; ++i)
     getLfoSource(i)->initTriangle();
 
@@ -337,11 +352,11 @@ void SynthBase::loadInitPreset() {
   pauseProcessing(false);
 }
 
-bool SynthBase::loadFromJson(const json& data) {
+bool SynthBase::loadFromJson(json data) {
   pauseProcessing(true);
   engine_->allSoundsOff();
   try {
-    bool result = LoadSave::jsonToState(this, save_info_, data);
+    bool result = LoadSave::jsonToState(this, save_info_, std::move(data));
     pauseProcessing(false);
     return result;
   }
@@ -356,8 +371,12 @@ bool SynthBase::loadFromFile(File preset, std::string& error) {
     return false;
   
   try {
-    json parsed_json_state = json::parse(preset.loadFileAsString().toStdString(), nullptr);
-    if (!loadFromJson(parsed_json_state)) {
+    MemoryBlock preset_data;
+    preset.loadFileAsData(preset_data);
+    const char* begin = static_cast<const char*>(preset_data.getData());
+    json parsed_json_state = json::parse(begin, begin + preset_data.getSize());
+    preset_data.reset();
+    if (!loadFromJson(std::move(parsed_json_state))) {
       error = "Preset was created with a newer version.";
       return false;
     }
@@ -380,6 +399,143 @@ bool SynthBase::loadFromFile(File preset, std::string& error) {
   return true;
 }
 
+void SynthBase::loadFromFileInBackground(File preset) {
+  if (preset_loader_ == nullptr)
+    preset_loader_ = std::make_unique<PresetLoader>(this);
+  if (!preset_loader_->isThreadRunning())
+    preset_loader_->startThread();
+
+  preset_loader_->loadPreset(preset, getGuiInterface() != nullptr);
+}
+
+bool SynthBase::isLoadingInBackground() {
+  return preset_loader_ && preset_loader_->isBusy();
+}
+
+void SynthBase::setPresetSwitchFade(float seconds) {
+  preset_fade_seconds_ = vital::utils::clamp(seconds, 0.0f, kMaxPresetFadeSeconds);
+}
+
+void SynthBase::setPresetSwitchStyle(PresetSwitchStyle style) {
+  preset_switch_style_ = vital::utils::iclamp(style, 0, kNumPresetSwitchStyles - 1);
+}
+
+void SynthBase::PresetLoader::loadPreset(const File& preset, bool lock_gui) {
+  ScopedLock lock(request_lock_);
+  pending_preset_ = preset;
+  lock_gui_ = lock_gui;
+  busy_ = true;
+  wake_.signal();
+}
+
+void SynthBase::PresetLoader::run() {
+  vital::FFT<vital::WaveFrame::kWaveformBits>::prepare();
+
+  while (!threadShouldExit()) {
+    if (!wake_.wait(kWaitTimeMs))
+      continue;
+
+    while (!threadShouldExit()) {
+      File preset;
+      bool lock_gui = false;
+      {
+        ScopedLock lock(request_lock_);
+        if (pending_preset_ == File()) {
+          busy_ = false;
+          break;
+        }
+
+        preset = pending_preset_;
+        lock_gui = lock_gui_;
+        pending_preset_ = File();
+      }
+
+      std::string error;
+      switchPreset(preset, lock_gui, error);
+      if (lock_gui && !error.empty() && !threadShouldExit())
+        (new PresetLoadFailedCallback(synth_->self_reference_, error))->post();
+    }
+  }
+}
+
+void SynthBase::PresetLoader::switchPreset(const File& preset, bool lock_gui, std::string& error) {
+  if (!preset.exists()) {
+    error = "Preset file doesn't exist.";
+    return;
+  }
+
+  LoadSave::StagedState staged;
+  try {
+    MemoryBlock preset_data;
+    preset.loadFileAsData(preset_data);
+    const char* begin = static_cast<const char*>(preset_data.getData());
+    json parsed_json_state = json::parse(begin, begin + preset_data.getSize());
+    preset_data.reset();
+    if (!LoadSave::prepareState(&staged, std::move(parsed_json_state))) {
+      error = "Preset was created with a newer version.";
+      return;
+    }
+  }
+  catch (const json::exception& e) {
+    error = "Preset file is corrupted.";
+    return;
+  }
+
+  // If the audio thread never parks it isn't running, so fall back to pausing it.
+  bool parked = parkEngine();
+  if (threadShouldExit())
+    return;
+
+  std::unique_ptr<MessageManagerLock> gui_lock;
+  if (lock_gui) {
+    gui_lock = std::make_unique<MessageManagerLock>(this);
+    if (!gui_lock->lockWasGained()) {
+      error = "Couldn't lock the interface to switch presets.";
+      synth_->preset_switch_state_ = kSwitchFadingIn;
+      return;
+    }
+  }
+
+  if (!parked)
+    synth_->pauseProcessing(true);
+
+  synth_->engine_->allSoundsOff();
+  LoadSave::applyState(synth_, synth_->save_info_, &staged);
+  synth_->active_file_ = preset;
+  synth_->setPresetName(preset.getFileNameWithoutExtension());
+
+  if (!parked)
+    synth_->pauseProcessing(false);
+  synth_->preset_switch_state_ = kSwitchFadingIn;
+
+  if (lock_gui) {
+    SynthGuiInterface* gui_interface = synth_->getGuiInterface();
+    if (gui_interface) {
+      gui_interface->updateFullGui();
+      gui_interface->notifyFresh();
+    }
+  }
+}
+
+bool SynthBase::PresetLoader::parkEngine() {
+  float wait_seconds = synth_->preset_fade_seconds_.load() + kParkTimeoutMs / 1000.0f;
+  synth_->preset_release_samples_ = 0;
+  if (synth_->preset_switch_style_.load() == kReleaseVoices) {
+    wait_seconds += kMaxPresetReleaseSeconds;
+    synth_->preset_switch_state_ = kSwitchReleasing;
+  }
+  else
+    synth_->preset_switch_state_ = kSwitchFadingOut;
+
+  auto timeout = std::chrono::steady_clock::now() + std::chrono::duration<float>(wait_seconds);
+  while (!synth_->isEngineParked()) {
+    if (threadShouldExit() || std::chrono::steady_clock::now() > timeout)
+      return false;
+    Thread::sleep(1);
+  }
+  return true;
+}
+
 void SynthBase::renderAudioToFile(File file, float seconds, float bpm, std::vector<int> notes, bool render_images) {
   static constexpr int kSampleRate = 44100;
   static constexpr int kPreProcessSamples = 44100;
@@ -394,7 +550,11 @@ void SynthBase::renderAudioToFile(File file, float seconds, float bpm, std::vect
 
   ScopedLock lock(getCriticalSection());
 
+  if (render_images)
+    telemetry_tap_->subscribe();
+
   processModulationChanges();
+  engine_->setTelemetryEnabled(telemetry_tap_->isActive());
   engine_->setSampleRate(kSampleRate);
   engine_->setBpm(bpm);
   engine_->updateAllModulationSwitches();
@@ -429,7 +589,7 @@ void SynthBase::renderAudioToFile(File file, float seconds, float bpm, std::vect
   File images_folder = File::getCurrentWorkingDirectory().getChildFile("images");
   if (!images_folder.exists() && render_images)
     images_folder.createDirectory();
-  const vital::poly_float* memory = getOscilloscopeMemory();
+  vital::poly_float memory[vital::kOscilloscopeMemoryResolution + 1];
 #endif
 
   for (int samples = 0; samples < total_samples; samples += kBufferSize) {
@@ -465,6 +625,7 @@ void SynthBase::renderAudioToFile(File file, float seconds, float bpm, std::vect
       Image image(Image::RGB, kImageWidth, kImageHeight, true);
       Graphics g(image);
       g.fillAll(Colour(0xff1d2125));
+      telemetry_tap_->readOscilloscope(memory, vital::kOscilloscopeMemoryResolution + 1);
 
       Path left_path;
       Path right_path;
@@ -498,6 +659,9 @@ void SynthBase::renderAudioToFile(File file, float seconds, float bpm, std::vect
   #endif
   }
 
+  if (render_images)
+    telemetry_tap_->unsubscribe();
+
   writer->flush();
   file_stream->flush();
 
@@ -581,7 +745,15 @@ void SynthBase::processAudio(AudioSampleBuffer* buffer, int channels, int sample
   if (expired_)
     return;
 
+  if (!updatePresetSwitch(samples)) {
+    for (int channel = 0; channel < channels; ++channel)
+      buffer->clear(channel, offset, samples);
+    return;
+  }
+
+  engine_->setTelemetryEnabled(telemetry_tap_->isActive());
   engine_->process(samples);
+  fadePresetSwitch(engine_->output(0)->buffer, samples);
   writeAudio(buffer, channels, samples, offset);
 }
 
@@ -590,10 +762,62 @@ void SynthBase::processAudioWithInput(AudioSampleBuffer* buffer, const vital::po
   if (expired_)
     return;
 
+  if (!updatePresetSwitch(samples)) {
+    for (int channel = 0; channel < channels; ++channel)
+      buffer->clear(channel, offset, samples);
+    return;
+  }
+
+  engine_->setTelemetryEnabled(telemetry_tap_->isActive());
   engine_->processWithInput(input_buffer, samples);
+  fadePresetSwitch(engine_->output(0)->buffer, samples);
   writeAudio(buffer, channels, samples, offset);
 }
 
+bool SynthBase::beginAudioBlock() {
+  int state = preset_switch_state_.load();
+  if (state == kSwitchFadingOut && preset_switch_gain_ <= 0.0f)
+    preset_switch_state_.compare_exchange_strong(state, kSwitchParked);
+
+  return preset_switch_state_.load() != kSwitchParked;
+}
+
+bool SynthBase::updatePresetSwitch(int num_samples) {
+  int state = preset_switch_state_.load();
+  if (state == kSwitchParked)
+    return false;
+
+  if (state == kSwitchReleasing) {
+    if (preset_release_samples_ == 0)
+      engine_->allNotesOff(0);
+
+    preset_release_samples_ += num_samples;
+    int max_release_samples = kMaxPresetReleaseSeconds * engine_->getSampleRate();
+    if (engine_->getNumActiveVoices() == 0 || preset_release_samples_ >= max_release_samples)
+      preset_switch_state_.compare_exchange_strong(state, kSwitchFadingOut);
+  }
+  return true;
+}
+
+void SynthBase::fadePresetSwitch(vital::poly_float* audio, int num_samples) {
+  int state = preset_switch_state_.load();
+  if (state != kSwitchFadingOut && state != kSwitchFadingIn)
+    return;
+
+  float fade_samples = std::max(1.0f, preset_fade_seconds_.load() * engine_->getSampleRate());
+  float delta = 1.0f / fade_samples;
+  if (state == kSwitchFadingOut)
+    delta = -delta;
+
+  for (int i = 0; i < num_samples; ++i) {
+    preset_switch_gain_ = vital::utils::clamp(preset_switch_gain_ + delta, 0.0f, 1.0f);
+    audio[i] *= preset_switch_gain_;
+  }
+
+  if (state == kSwitchFadingIn && preset_switch_gain_ >= 1.0f)
+    preset_switch_state_.compare_exchange_strong(state, kSwitchIdle);
+}
+
 void SynthBase::writeAudio(AudioSampleBuffer* buffer, int channels, int samples, int offset) {
   const vital::mono_float* engine_output = (const vital::mono_float*)engine_->output(0)->buffer;
   for (int channel = 0; channel < channels; ++channel) {
@@ -609,6 +833,9 @@ void SynthBase::writeAudio(AudioSampleBuffer* buffer, int channels, int samples,
 }
 
 void SynthBase::processMidi(MidiBuffer& midi_messages, int start_sample, int end_sample) {
+  if (isEngineParked())
+    return;
+
   bool process_all = end_sample == 0;
   for (const MidiMessageMetadata message : midi_messages) {
     int midi_sample = message.samplePosition;
@@ -622,6 +849,9 @@ void SynthBase::processKeyboardEvents(MidiBuffer& buffer, int num_samples) {
 }
 
 void SynthBase::processModulationChanges() {
+  if (isEngineParked())
+    return;
+
   vital::modulation_change change;
   while (getNextModulationChange(change)) {
     if (change.disconnecting)
@@ -631,51 +861,27 @@ void SynthBase::processModulationChanges() {
   }
 }
 
+const vital::StereoMemory* SynthBase::getAudioMemory() {
+  return telemetry_tap_->getAudioMemory();
+}
+
 void SynthBase::updateMemoryOutput(int samples, const vital::poly_float* audio) {
-  for (int i = 0; i < samples; ++i)
-    audio_memory_->push(audio[i]);
+  if (!telemetry_tap_->isActive())
+    return;
 
   vital::mono_float last_played = engine_->getLastActiveNote();
   last_played = vital::utils::clamp(last_played, kOutputWindowMinNote, kOutputWindowMaxNote);
 
   int num_pressed = engine_->getNumPressedNotes();
-  int output_inc = std::max<int>(1, engine_->getSampleRate() / vital::kOscilloscopeMemorySampleRate);
-  int oscilloscope_samples = 2 * vital::kOscilloscopeMemoryResolution;
-
+  telemetry_tap_->setSampleRate(engine_->getSampleRate());
   if (last_played && (last_played_note_ != last_played || num_pressed > last_num_pressed_)) {
     last_played_note_ = last_played;
-    
     vital::mono_float frequency = vital::utils::midiNoteToFrequency(last_played_note_);
-    vital::mono_float period = engine_->getSampleRate() / frequency;
-    int window_length = output_inc * vital::kOscilloscopeMemoryResolution;
-
-    memory_reset_period_ = period;
-    while (memory_reset_period_ < window_length)
-      memory_reset_period_ += memory_reset_period_;
-
-    memory_reset_period_ = std::min(memory_reset_period_, 2.0f * window_length);
-    memory_index_ = 0;
-    vital::utils::copyBuffer(oscilloscope_memory_, oscilloscope_memory_write_, oscilloscope_samples);
+    telemetry_tap_->syncToPeriod(engine_->getSampleRate() / frequency);
   }
   last_num_pressed_ = num_pressed;
 
-  for (; memory_input_offset_ < samples; memory_input_offset_ += output_inc) {
-    int input_index = vital::utils::iclamp(memory_input_offset_, 0, samples);
-    memory_index_ = vital::utils::iclamp(memory_index_, 0, oscilloscope_samples - 1);
-    VITAL_ASSERT(input_index >= 0);
-    VITAL_ASSERT(input_index < samples);
-    VITAL_ASSERT(memory_index_ >= 0);
-    VITAL_ASSERT(memory_index_ < oscilloscope_samples);
-    oscilloscope_memory_write_[memory_index_++] = audio[input_index];
-
-    if (memory_index_ * output_inc >= memory_reset_period_) {
-      memory_input_offset_ += memory_reset_period_ - memory_index_ * output_inc;
-      memory_index_ = 0;
-      vital::utils::copyBuffer(oscilloscope_memory_, oscilloscope_memory_write_, oscilloscope_samples);
-    }
-  }
-
-  memory_input_offset_ -= samples;
+  telemetry_tap_->write(audio, samples);
 }
 
 void SynthBase::armMidiLearn(const std::string& name) {
@@ -758,6 +964,14 @@ void SynthBase::checkOversampling() {
   return engine_->checkOversampling();
 }
 
+void SynthBase::PresetLoadFailedCallback::messageCallback() {
+  if (auto synth_base = listener.lock()) {
+    SynthGuiInterface* gui_interface = (*synth_base)->getGuiInterface();
+    if (gui_interface)
+      gui_interface->presetLoadFailed(error);
+  }
+}
+
 void SynthBase::ValueChangedCallback::messageCallback() {
   if (auto synth_base = listener.lock()) {
     SynthGuiInterface* gui_interface = (*synth_base)->getGuiInterface();
@@ -768,3 +982,25 @@ void SynthBase::ValueChangedCallback::messageCallback() {
     }
   }
 }
+
+void HeadlessSynth::processBlock(AudioSampleBuffer& buffer, MidiBuffer& midi_messages,
+                                 int num_samples, double seconds) {
+  ScopedLock lock(getCriticalSection());
+  if (!beginAudioBlock()) {
+    buffer.clear(0, num_samples);
+    return;
+  }
+
+  processModulationChanges();
+  double sample_time = 1.0 / getSampleRate();
+  for (int sample_offset = 0; sample_offset < num_samples;) {
+    int samples = std::min<int>(num_samples - sample_offset, vital::kMaxBufferSize);
+
+    engine_->correctToTime(seconds);
+    processMidi(midi_messages, sample_offset, sample_offset + samples);
+    processAudio(&buffer, buffer.getNumChannels(), samples, sample_offset);
+
+    seconds += samples * sample_time;
+    sample_offset += samples;
+  }
+}
@@ -18,6 +18,7 @@
 
 #include "JuceHeader.h"
 #include "concurrentqueue/concurrentqueue.h"
+#include "file_index.h"
 #include "line_generator.h"
 #include "synth_constants.h"
 #include "synth_types.h"
@@ -25,10 +26,12 @@
 #include "tuning.h"
 #include "wavetable_creator.h"
 
+#include <atomic>
 #include <set>
 #include <string>
 
 namespace vital {
+  class Convolution;
   class SoundEngine;
   struct Output;
   class StatusOutput;
@@ -39,11 +42,21 @@ namespace vital {
 }
 
 class SynthGuiInterface;
+class TelemetryTap;
 
 class SynthBase : public MidiManager::Listener {
   public:
     static constexpr float kOutputWindowMinNote = 16.0f;
     static constexpr float kOutputWindowMaxNote = 128.0f;
+    static constexpr float kDefaultPresetFadeSeconds = 0.02f;
+    static constexpr float kMaxPresetFadeSeconds = 1.0f;
+    static constexpr float kMaxPresetReleaseSeconds = 4.0f;
+
+    enum PresetSwitchStyle {
+      kFadeVoices,
+      kReleaseVoices,
+      kNumPresetSwitchStyles
+    };
 
     SynthBase();
     virtual ~SynthBase();
@@ -76,6 +89,7 @@ class SynthBase : public MidiManager::Listener {
     vital::Wavetable* getWavetable(int index);
     WavetableCreator* getWavetableCreator(int index);
     vital::Sample* getSample();
+    vital::Convolution* getConvolution();
     LineGenerator* getLfoSource(int index);
 
     int getSampleRate();
@@ -83,6 +97,12 @@ class SynthBase : public MidiManager::Listener {
     void loadTuningFile(const File& file);
     void loadInitPreset();
     bool loadFromFile(File preset, std::string& error);
+    void loadFromFileInBackground(File preset);
+    bool isLoadingInBackground();
+    void setPresetSwitchFade(float seconds);
+    void setPresetSwitchStyle(PresetSwitchStyle style);
+    float getPresetSwitchFade() { return preset_fade_seconds_.load(); }
+    PresetSwitchStyle getPresetSwitchStyle() { return static_cast<PresetSwitchStyle>(preset_switch_style_.load()); }
     void renderAudioToFile(File file, float seconds, float bpm, std::vector<int> notes, bool render_images);
     void renderAudioForResynthesis(float* data, int samples, int note);
     bool saveToFile(File preset);
@@ -114,12 +134,12 @@ class SynthBase : public MidiManager::Listener {
     vital::control_map& getControls() { return controls_; }
     vital::SoundEngine* getEngine() { return engine_.get(); }
     MidiKeyboardState* getKeyboardState() { return keyboard_state_.get(); }
-    const vital::poly_float* getOscilloscopeMemory() { return oscilloscope_memory_; }
-    const vital::StereoMemory* getAudioMemory() { return audio_memory_.get(); }
+    TelemetryTap* getTelemetryTap() { return telemetry_tap_.get(); }
+    const vital::StereoMemory* getAudioMemory();
     const vital::StereoMemory* getEqualizerMemory();
     vital::ModulationConnectionBank& getModulationBank();
     void notifyOversamplingChanged();
-    void checkOversampling();
+    virtual void checkOversampling();
     virtual const CriticalSection& getCriticalSection() = 0;
     virtual void pauseProcessing(bool pause) = 0;
     Tuning* getTuning() { return &tuning_; }
@@ -135,12 +155,57 @@ class SynthBase : public MidiManager::Listener {
       vital::mono_float value;
     };
 
+    struct PresetLoadFailedCallback : public CallbackMessage {
+      PresetLoadFailedCallback(std::shared_ptr<SynthBase*> listener, std::string error) :
+          listener(listener), error(std::move(error)) { }
+
+      void messageCallback() override;
+
+      std::weak_ptr<SynthBase*> listener;
+      std::string error;
+    };
+
   protected:
+    enum PresetSwitchState {
+      kSwitchIdle,
+      kSwitchReleasing,
+      kSwitchFadingOut,
+      kSwitchParked,
+      kSwitchFadingIn
+    };
+
+    // Prepares presets off the audio thread. Once a preset is staged the audio thread fades out and stops
+    // touching the engine, the staged state is swapped in and the audio thread fades back in.
+    class PresetLoader : public Thread {
+      public:
+        static constexpr int kWaitTimeMs = 100;
+        static constexpr int kParkTimeoutMs = 500;
+
+        PresetLoader(SynthBase* synth) : Thread("Vital Preset Loader"), synth_(synth),
+                                         lock_gui_(false), busy_(false) { }
+
+        void loadPreset(const File& preset, bool lock_gui);
+        bool isBusy() { return busy_.load(); }
+
+        void run() override;
+
+      private:
+        void switchPreset(const File& preset, bool lock_gui, std::string& error);
+        bool parkEngine();
+
+        SynthBase* synth_;
+        CriticalSection request_lock_;
+        File pending_preset_;
+        bool lock_gui_;
+        std::atomic<bool> busy_;
+        WaitableEvent wake_;
+    };
+
     vital::modulation_change createModulationChange(vital::ModulationConnection* connection);
     bool isInvalidConnection(const vital::modulation_change& change);
     virtual SynthGuiInterface* getGuiInterface() = 0;
     json saveToJson();
-    bool loadFromJson(const json& state);
+    bool loadFromJson(json state);
     vital::ModulationConnection* getConnection(const std::string& source, const std::string& destination);
 
     inline bool getNextModulationChange(vital::modulation_change& change) {
@@ -161,6 +226,10 @@ class SynthBase : public MidiManager::Listener {
     void processKeyboardEvents(MidiBuffer& buffer, int num_samples);
     void processModulationChanges();
     void updateMemoryOutput(int samples, const vital::poly_float* audio);
+    bool isEngineParked() { return preset_switch_state_.load() == kSwitchParked; }
+    bool beginAudioBlock();
+    bool updatePresetSwitch(int num_samples);
+    void fadePresetSwitch(vital::poly_float* audio, int num_samples);
 
     std::unique_ptr<vital::SoundEngine> engine_;
     std::unique_ptr<MidiManager> midi_manager_;
@@ -170,14 +239,11 @@ class SynthBase : public MidiManager::Listener {
     std::shared_ptr<SynthBase*> self_reference_;
 
     File active_file_;
-    vital::poly_float oscilloscope_memory_[2 * vital::kOscilloscopeMemoryResolution];
-    vital::poly_float oscilloscope_memory_write_[2 * vital::kOscilloscopeMemoryResolution];
-    std::unique_ptr<vital::StereoMemory> audio_memory_;
+    // Keeps the folder index and its watches alive between browser openings and preset list queries.
+    SharedResourcePointer<FileIndex> file_index_;
+    std::unique_ptr<TelemetryTap> telemetry_tap_;
     vital::mono_float last_played_note_;
     int last_num_pressed_;
-    vital::mono_float memory_reset_period_;
-    vital::mono_float memory_input_offset_;
-    int memory_index_;
     bool expired_;
 
     std::map<std::string, String> save_info_;
@@ -187,6 +253,13 @@ class SynthBase : public MidiManager::Listener {
     moodycamel::ConcurrentQueue<vital::modulation_change> modulation_change_queue_;
     Tuning tuning_;
 
+    std::unique_ptr<PresetLoader> preset_loader_;
+    std::atomic<int> preset_switch_state_;
+    std::atomic<int> preset_switch_style_;
+    std::atomic<float> preset_fade_seconds_;
+    vital::mono_float preset_switch_gain_;
+    int preset_release_samples_;
+
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(SynthBase)
 };
 
@@ -203,6 +276,9 @@ class HeadlessSynth : public SynthBase {
         critical_section_.exit();
     }
 
+    void processBlock(AudioSampleBuffer& buffer, MidiBuffer& midi_messages, int num_samples, double seconds);
+    using SynthBase::loadFromJson;
+
   protected:
     virtual SynthGuiInterface* getGuiInterface() override { return nullptr; }
 
@@ -107,6 +107,7 @@ namespace vital {
       kFlanger,
       kPhaser,
       kReverb,
+      kConvolution,
       kNumEffects
     };
 
@@ -129,6 +130,27 @@ namespace vital {
       kNumRetriggerStyles,
     };
 
+    enum OversamplingQuality {
+      kEcoOversampling,
+      kStandardOversampling,
+      kLinearPhaseOversampling,
+      kNumOversamplingQualities
+    };
+
+    enum ModulatorSubRate {
+      kFullRateModulators,
+      kHalfRateModulators,
+      kQuarterRateModulators,
+      kEighthRateModulators,
+      kNumModulatorSubRates
+    };
+
+    enum SubRateInterpolation {
+      kLinearSubRate,
+      kCubicSubRate,
+      kNumSubRateInterpolations
+    };
+
     constexpr int kNumSyncedFrequencyRatios = 13;
     constexpr vital::mono_float kSyncedFrequencyRatios[kNumSyncedFrequencyRatios] = {
       0.0f,
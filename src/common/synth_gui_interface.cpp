@@ -20,6 +20,7 @@
 #include "sound_engine.h"
 #include "load_save.h"
 #include "synth_base.h"
+#include "telemetry_tap.h"
 
 SynthGuiData::SynthGuiData(SynthBase* synth_base) : synth(synth_base) {
   controls = synth->getControls();
@@ -48,6 +49,7 @@ void SynthGuiInterface::notifyChange() { }
 void SynthGuiInterface::notifyFresh() { }
 void SynthGuiInterface::openSaveDialog() { }
 void SynthGuiInterface::externalPresetLoaded(File preset) { }
+void SynthGuiInterface::presetLoadFailed(const std::string& error) { }
 void SynthGuiInterface::setGuiSize(float scale) { }
 
 #else
@@ -62,10 +64,14 @@ SynthGuiInterface::SynthGuiInterface(SynthBase* synth, bool use_gui) : synth_(sy
       lfo_sources[i] = synth->getLfoSource(i);
     SynthGuiData synth_data(synth_);
     gui_ = std::make_unique<FullInterface>(&synth_data);
+    synth_->getTelemetryTap()->subscribe();
   }
 }
 
-SynthGuiInterface::~SynthGuiInterface() { }
+SynthGuiInterface::~SynthGuiInterface() {
+  if (gui_)
+    synth_->getTelemetryTap()->unsubscribe();
+}
 
 void SynthGuiInterface::updateFullGui() {
   if (gui_ == nullptr)
@@ -191,6 +197,14 @@ void SynthGuiInterface::externalPresetLoaded(File preset) {
   gui_->externalPresetLoaded(preset);
 }
 
+void SynthGuiInterface::presetLoadFailed(const std::string& error) {
+  if (gui_ == nullptr)
+    return;
+
+  std::string message = "There was an error open the preset. " + error;
+  AlertWindow::showNativeDialogBox("Error opening preset", message, false);
+}
+
 void SynthGuiInterface::setGuiSize(float scale) {
   if (gui_ == nullptr)
     return;
@@ -66,6 +66,7 @@ class SynthGuiInterface {
     void notifyFresh();
     void openSaveDialog();
     void externalPresetLoaded(File preset);
+    void presetLoadFailed(const std::string& error);
     void setGuiSize(float scale);
     FullInterface* getGui() { return gui_.get(); }
     std::unique_ptr<FullInterface> gui_;
@@ -17,10 +17,12 @@
 #include "synth_parameters.h"
 
 #include "compressor.h"
+#include "convolution.h"
 #include "distortion.h"
 #include "digital_svf.h"
 #include "synth_constants.h"
 #include "random_lfo.h"
+#include "reverb.h"
 #include "synth_lfo.h"
 #include "synth_oscillator.h"
 #include "synth_strings.h"
@@ -156,8 +158,16 @@ namespace vital {
       ValueDetails::kQuadratic, false, "%", "Reverb Chorus Amount", nullptr },
     { "reverb_chorus_frequency", 0x000000, -8.0, 3.0, -2.0, 0.0, 1.0,
       ValueDetails::kExponential, false, " Hz", "Reverb Chorus Frequency", nullptr },
+    { "reverb_quality", 0x000804, 0.0, Reverb::kNumQualities - 1, Reverb::kStandard, 0.0, 1.0,
+      ValueDetails::kIndexed, false, "", "Reverb Quality", strings::kReverbQualityNames },
     { "reverb_on", 0x000000, 0.0, 1.0, 0.0, 0.0, 1.0,
       ValueDetails::kIndexed, false, "", "Reverb Switch", strings::kOffOnNames },
+    { "convolution_dry_wet", 0x000804, 0.0, 1.0, 0.3, 0.0, 100.0,
+      ValueDetails::kLinear, false, "%", "Convolution Mix", nullptr },
+    { "convolution_gain", 0x000804, Convolution::kMinGain, Convolution::kMaxGain, 0.0, 0.0, 1.0,
+      ValueDetails::kLinear, false, " dB", "Convolution Gain", nullptr },
+    { "convolution_on", 0x000804, 0.0, 1.0, 0.0, 0.0, 1.0,
+      ValueDetails::kIndexed, false, "", "Convolution Switch", strings::kOffOnNames },
     { "sub_on", 0x000000, 0.0, 1.0, 0.0, 0.0, 1.0,
       ValueDetails::kIndexed, false, "", "Sub Switch", strings::kOffOnNames },
     { "sub_direct_out", 0x000000, 0.0, 1.0, 0.0, 0.0, 1.0,
@@ -346,6 +356,17 @@ namespace vital {
       ValueDetails::kIndexed, false, "", "MPE Enabled", strings::kOffOnNames },
     { "view_spectrogram", 0x000803, 0.0, 2.0, 0.0, 0.0, 1.0,
       ValueDetails::kIndexed, false, "", "View Spectrogram", strings::kOffOnNames },
+    { "oversampling_quality", 0x000804, 0.0, constants::kNumOversamplingQualities - 1,
+      constants::kStandardOversampling, 0.0, 1.0,
+      ValueDetails::kIndexed, false, "", "Oversampling Quality", strings::kOversamplingQualityNames },
+    { "unison_culling", 0x000804, 0.0, 1.0, 0.0, 0.0, 1.0,
+      ValueDetails::kIndexed, false, "", "Unison Culling", strings::kOffOnNames },
+    { "modulator_sub_rate", 0x000804, 0.0, constants::kNumModulatorSubRates - 1,
+      constants::kFullRateModulators, 0.0, 1.0,
+      ValueDetails::kIndexed, false, "", "Modulator Sub Rate", strings::kModulatorSubRateNames },
+    { "modulator_sub_rate_interpolation", 0x000804, 0.0, constants::kNumSubRateInterpolations - 1,
+      constants::kLinearSubRate, 0.0, 1.0,
+      ValueDetails::kIndexed, false, "", "Modulator Sub Rate Interpolation", strings::kSubRateInterpolationNames },
   };
 
   const ValueDetails ValueDetailsLookup::env_parameter_list[] = {
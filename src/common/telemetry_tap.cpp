@@ -0,0 +1,67 @@
+/* Copyright 2013-2019 Matt Tytel
+ *
+ * vital is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * vital is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with vital.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "telemetry_tap.h"
+
+TelemetryTap::TelemetryTap() : memory_(vital::kAudioMemorySamples), num_consumers_(0),
+                               sample_rate_(vital::kDefaultSampleRate), samples_written_(0), sync_start_(0),
+                               sync_period_(0.0f) { }
+
+void TelemetryTap::unsubscribe() {
+  VITAL_ASSERT(num_consumers_.load() > 0);
+  num_consumers_--;
+}
+
+int TelemetryTap::getOutputIncrement() const {
+  return std::max(1, sample_rate_.load(std::memory_order_relaxed) / vital::kOscilloscopeMemorySampleRate);
+}
+
+void TelemetryTap::syncToPeriod(vital::mono_float period) {
+  float window_length = getOutputIncrement() * vital::kOscilloscopeMemoryResolution;
+  float sync_period = std::max(period, 1.0f);
+  while (sync_period < window_length)
+    sync_period += sync_period;
+
+  sync_period_.store(std::min(sync_period, 2.0f * window_length), std::memory_order_relaxed);
+  sync_start_.store(samples_written_.load(std::memory_order_relaxed), std::memory_order_release);
+}
+
+void TelemetryTap::write(const vital::poly_float* audio, int num_samples) {
+  for (int i = 0; i < num_samples; ++i)
+    memory_.push(audio[i]);
+
+  samples_written_.store(samples_written_.load(std::memory_order_relaxed) + num_samples,
+                         std::memory_order_release);
+}
+
+void TelemetryTap::readOscilloscope(vital::poly_float* destination, int num_samples) const {
+  int64_t written = samples_written_.load(std::memory_order_acquire);
+  int64_t sync_start = sync_start_.load(std::memory_order_acquire);
+  float sync_period = sync_period_.load(std::memory_order_relaxed);
+  int output_inc = getOutputIncrement();
+
+  int64_t start = written - output_inc * (num_samples - 1) - 1;
+  if (sync_period > 0.0f && start >= sync_start) {
+    int64_t num_periods = (start - sync_start) / sync_period;
+    start = sync_start + static_cast<int64_t>(num_periods * sync_period);
+  }
+
+  // Sample n of the stream sits at ring index n + 1.
+  for (int i = 0; i < num_samples; ++i) {
+    unsigned int index = static_cast<unsigned int>(start + i * output_inc + 1);
+    destination[i] = vital::poly_float(memory_.getAtIndex(0, index), memory_.getAtIndex(1, index));
+  }
+}
@@ -0,0 +1,55 @@
+/* Copyright 2013-2019 Matt Tytel
+ *
+ * vital is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * vital is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with vital.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "JuceHeader.h"
+
+#include "memory.h"
+#include "synth_constants.h"
+
+#include <atomic>
+
+// Hands the synth output from the audio thread to visualizers and meters. The audio thread is the only
+// writer and only writes while a consumer is subscribed. Consumers read the ring directly and do their own
+// decimation, aligned to the period of the last played note.
+class TelemetryTap {
+  public:
+    TelemetryTap();
+
+    void subscribe() { num_consumers_++; }
+    void unsubscribe();
+    bool isActive() const { return num_consumers_.load(std::memory_order_relaxed) > 0; }
+
+    void setSampleRate(int sample_rate) { sample_rate_.store(sample_rate, std::memory_order_relaxed); }
+    void syncToPeriod(vital::mono_float period);
+    void write(const vital::poly_float* audio, int num_samples);
+
+    const vital::StereoMemory* getAudioMemory() const { return &memory_; }
+    void readOscilloscope(vital::poly_float* destination, int num_samples) const;
+
+  private:
+    int getOutputIncrement() const;
+
+    vital::StereoMemory memory_;
+    std::atomic<int> num_consumers_;
+    std::atomic<int> sample_rate_;
+    std::atomic<uint64_t> samples_written_;
+    std::atomic<uint64_t> sync_start_;
+    std::atomic<float> sync_period_;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(TelemetryTap)
+};
@@ -305,15 +305,14 @@ void FileSource::jsonToState(json data) {
 
   writePhaseOverrideBuffer();
 
-  WavetableComponent::jsonToState(data);
-
   int sample_rate = vital::kDefaultSampleRate;
   if (data.count("audio_sample_rate"))
     sample_rate = data["audio_sample_rate"];
 
-  MemoryOutputStream decoded;
-  std::string audio_data = data["audio_file"];
+  const std::string& audio_data = data["audio_file"].get_ref<const std::string&>();
+  MemoryOutputStream decoded(audio_data.size() * 3 / 4 + sizeof(int16_t));
   Base64::convertFromBase64(decoded, audio_data);
+  WavetableComponent::jsonToState(std::move(data));
 
   int size = static_cast<int>(decoded.getDataSize()) / sizeof(int16_t);
   std::unique_ptr<float[]> float_data = std::make_unique<float[]>(size);
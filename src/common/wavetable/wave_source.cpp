@@ -48,8 +48,9 @@ json WaveSource::stateToJson() {
 }
 
 void WaveSource::jsonToState(json data) {
-  WavetableComponent::jsonToState(data);
-  interpolation_mode_ = data["interpolation"];
+  InterpolationMode interpolation_mode = data["interpolation"];
+  WavetableComponent::jsonToState(std::move(data));
+  interpolation_mode_ = interpolation_mode;
   compute_frame_->setInterpolationMode(interpolation_mode_);
 }
 
@@ -198,11 +199,10 @@ json WaveSourceKeyframe::stateToJson() {
 }
 
 void WaveSourceKeyframe::jsonToState(json data) {
-  WavetableKeyframe::jsonToState(data);
-
   MemoryOutputStream decoded(sizeof(float) * vital::WaveFrame::kWaveformSize);
-  std::string wave_data = data["wave_data"];
-  Base64::convertFromBase64(decoded, wave_data);
+  Base64::convertFromBase64(decoded, data["wave_data"].get_ref<const std::string&>());
   memcpy(wave_frame_->time_domain, decoded.getData(), sizeof(float) * vital::WaveFrame::kWaveformSize);
   wave_frame_->toFrequencyDomain();
+
+  WavetableKeyframe::jsonToState(std::move(data));
 }
\ No newline at end of file
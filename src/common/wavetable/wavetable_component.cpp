@@ -44,9 +44,9 @@ void WavetableComponent::remove(WavetableKeyframe* keyframe) {
 
 void WavetableComponent::jsonToState(json data) {
   keyframes_.clear();
-  for (json json_keyframe : data["keyframes"]) {
+  for (json& json_keyframe : data["keyframes"]) {
     WavetableKeyframe* keyframe = insertNewKeyframe(json_keyframe["position"]);
-    keyframe->jsonToState(json_keyframe);
+    keyframe->jsonToState(std::move(json_keyframe));
   }
 
   if (data.count("interpolation_style"))
@@ -161,6 +161,13 @@ void WavetableCreator::clear() {
   full_normalize_ = true;
 }
 
+void WavetableCreator::swapData(WavetableCreator* other) {
+  groups_.swap(other->groups_);
+  std::swap(full_normalize_, other->full_normalize_);
+  std::swap(remove_all_dc_, other->remove_all_dc_);
+  wavetable_->swapData(other->wavetable_);
+}
+
 void WavetableCreator::loadDefaultCreator() {
   wavetable_->setName("Init");
   WavetableGroup* new_group = new WavetableGroup();
@@ -486,7 +493,7 @@ void WavetableCreator::jsonToState(json data) {
   }
 
   clear();
-  data = updateJson(data);
+  data = updateJson(std::move(data));
 
   std::string name = "";
   if (data.count("name"))
@@ -505,10 +512,9 @@ void WavetableCreator::jsonToState(json data) {
   else
     full_normalize_ = false;
 
-  json json_groups = data["groups"];
-  for (const json& json_group : json_groups) {
+  for (json& json_group : data["groups"]) {
     WavetableGroup* new_group = new WavetableGroup();
-    new_group->jsonToState(json_group);
+    new_group->jsonToState(std::move(json_group));
     addGroup(new_group);
   }
 
@@ -122,11 +122,10 @@ json WavetableGroup::stateToJson() {
 void WavetableGroup::jsonToState(json data) {
   components_.clear();
 
-  json json_components = data["components"];
-  for (json json_component : json_components) {
+  for (json& json_component : data["components"]) {
     std::string type = json_component["type"];
     WavetableComponent* component = WavetableComponentFactory::createComponent(type);
-    component->jsonToState(json_component);
+    component->jsonToState(std::move(json_component));
     addComponent(component);
   }
 }
@@ -0,0 +1,192 @@
+/* Copyright 2013-2019 Matt Tytel
+ *
+ * vital is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * vital is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with vital.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "engine_host.h"
+
+#if VITAL_ENGINE_HOST
+
+#include "sound_engine.h"
+#include "synth_base.h"
+#include "utils.h"
+
+#if JUCE_LINUX
+#include <unistd.h>
+#elif JUCE_MAC
+#include <mach/mach.h>
+#endif
+
+#include <chrono>
+
+namespace {
+  constexpr int kWaitTimeMs = 100;
+
+  double getMilliseconds() {
+    std::chrono::duration<double, std::milli> time = std::chrono::steady_clock::now().time_since_epoch();
+    return time.count();
+  }
+} // namespace
+
+EngineHost::Instance::Instance(int block_size) : synth(std::make_unique<HeadlessSynth>()),
+                                                 output(vital::kNumChannels, block_size), num_blocks_processed(0) { }
+
+EngineHost::EngineHost(int num_instances, int num_threads, int block_size, int sample_rate) :
+    block_size_(block_size), sample_rate_(sample_rate), position_(0.0), working_threads_(0) {
+  num_threads = vital::utils::iclamp(num_threads, 1, kMaxThreads);
+
+  for (int i = 0; i < num_instances; ++i) {
+    instances_.push_back(std::make_unique<Instance>(block_size_));
+    instances_[i]->synth->getEngine()->setSampleRate(sample_rate_);
+  }
+
+  queues_ = std::make_unique<WorkQueue[]>(num_threads);
+  for (int i = 1; i < num_threads; ++i) {
+    workers_.push_back(std::make_unique<Worker>(this, i));
+    workers_.back()->startThread(Thread::realtimeAudioPriority);
+  }
+
+  resetStats();
+}
+
+EngineHost::~EngineHost() {
+  for (auto& worker : workers_) {
+    worker->signalThreadShouldExit();
+    worker->wake();
+  }
+  for (auto& worker : workers_)
+    worker->stopThread(-1);
+}
+
+bool EngineHost::loadPreset(const File& preset) {
+  if (!preset.existsAsFile())
+    return false;
+
+  try {
+    json parsed_json_state = json::parse(preset.loadFileAsString().toStdString(), nullptr);
+    for (auto& instance : instances_) {
+      if (!instance->synth->loadFromJson(parsed_json_state))
+        return false;
+    }
+  }
+  catch (const json::exception& e) {
+    return false;
+  }
+  return true;
+}
+
+void EngineHost::Worker::run() {
+  while (!threadShouldExit()) {
+    if (!start_.wait(kWaitTimeMs) || threadShouldExit())
+      continue;
+
+    host_->processInstances(index_);
+    host_->finishWork();
+  }
+}
+
+void EngineHost::processInstances(int worker_index) {
+  int num_queues = static_cast<int>(workers_.size()) + 1;
+  for (int q = 0; q < num_queues; ++q) {
+    WorkQueue& queue = queues_[(worker_index + q) % num_queues];
+
+    for (int i = queue.next.fetch_add(1); i < queue.end; i = queue.next.fetch_add(1)) {
+      Instance* instance = instances_[i].get();
+      instance->synth->processBlock(instance->output, instance->midi, block_size_, position_);
+      instance->midi.clear();
+      instance->num_blocks_processed++;
+    }
+  }
+}
+
+void EngineHost::finishWork() {
+  if (working_threads_.fetch_sub(1) == 1)
+    done_.signal();
+}
+
+bool EngineHost::processBlock() {
+  double start = getMilliseconds();
+
+  int num_instances = getNumInstances();
+  int num_queues = static_cast<int>(workers_.size()) + 1;
+  for (int q = 0; q < num_queues; ++q) {
+    queues_[q].next.store(q * num_instances / num_queues);
+    queues_[q].end = (q + 1) * num_instances / num_queues;
+  }
+
+  working_threads_.store(static_cast<int>(workers_.size()));
+  for (auto& worker : workers_)
+    worker->wake();
+
+  processInstances(0);
+  if (!workers_.empty())
+    done_.wait();
+
+  position_ += block_size_ / (1.0 * sample_rate_);
+
+  double block_ms = getMilliseconds() - start;
+  bool met_deadline = block_ms <= block_size_ * 1000.0 / sample_rate_;
+  num_blocks_++;
+  deadline_misses_ += met_deadline ? 0 : 1;
+  total_block_ms_ += block_ms;
+  peak_block_ms_ = std::max(peak_block_ms_, block_ms);
+  return met_deadline;
+}
+
+EngineHost::Stats EngineHost::getStats() const {
+  Stats stats;
+  stats.num_instances = getNumInstances();
+  stats.num_threads = static_cast<int>(workers_.size()) + 1;
+  stats.num_blocks = num_blocks_;
+  stats.deadline_misses = deadline_misses_;
+  stats.deadline_ms = block_size_ * 1000.0 / sample_rate_;
+  stats.average_block_ms = num_blocks_ ? total_block_ms_ / num_blocks_ : 0.0;
+  stats.peak_block_ms = peak_block_ms_;
+  stats.cpu_load = stats.average_block_ms / stats.deadline_ms;
+  stats.process_resident_bytes = getProcessResidentBytes();
+  return stats;
+}
+
+void EngineHost::resetStats() {
+  num_blocks_ = 0;
+  deadline_misses_ = 0;
+  total_block_ms_ = 0.0;
+  peak_block_ms_ = 0.0;
+}
+
+size_t EngineHost::getProcessResidentBytes() {
+#if JUCE_LINUX
+  long total_pages = 0;
+  long resident_pages = 0;
+  FILE* statm = fopen("/proc/self/statm", "r");
+  if (statm == nullptr)
+    return 0;
+
+  int num_read = fscanf(statm, "%ld %ld", &total_pages, &resident_pages);
+  fclose(statm);
+  if (num_read != 2)
+    return 0;
+  return resident_pages * sysconf(_SC_PAGESIZE);
+#elif JUCE_MAC
+  mach_task_basic_info info;
+  mach_msg_type_number_t count = MACH_TASK_BASIC_INFO_COUNT;
+  if (task_info(mach_task_self(), MACH_TASK_BASIC_INFO, (task_info_t)&info, &count) != KERN_SUCCESS)
+    return 0;
+  return info.resident_size;
+#else
+  return 0;
+#endif
+}
+
+#endif
@@ -0,0 +1,122 @@
+/* Copyright 2013-2019 Matt Tytel
+ *
+ * vital is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * vital is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with vital.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "JuceHeader.h"
+
+#if !defined(__EMSCRIPTEN__)
+#define VITAL_ENGINE_HOST 1
+#else
+#define VITAL_ENGINE_HOST 0
+#endif
+
+#if VITAL_ENGINE_HOST
+
+#include <atomic>
+
+class HeadlessSynth;
+
+// Runs many independent synths in one process. Lookup tables, random tables and predefined wave frames are
+// process wide singletons so every instance shares them, and presets are parsed once for all instances.
+// Each block the instances are split between the worker threads, and workers that run out steal the rest.
+class EngineHost {
+  public:
+    static constexpr int kDefaultBlockSize = 128;
+    static constexpr int kDefaultSampleRate = 44100;
+    static constexpr int kMaxThreads = 64;
+
+    struct Stats {
+      int num_instances;
+      int num_threads;
+      int64 num_blocks;
+      int64 deadline_misses;
+      double deadline_ms;
+      double average_block_ms;
+      double peak_block_ms;
+      double cpu_load;
+      // Resident memory of the whole process, not only of this host's instances.
+      size_t process_resident_bytes;
+    };
+
+    EngineHost(int num_instances, int num_threads, int block_size = kDefaultBlockSize,
+               int sample_rate = kDefaultSampleRate);
+    ~EngineHost();
+
+    bool loadPreset(const File& preset);
+    bool processBlock();
+
+    int getNumInstances() const { return static_cast<int>(instances_.size()); }
+    int getBlockSize() const { return block_size_; }
+    HeadlessSynth* getSynth(int index) { return instances_[index]->synth.get(); }
+    MidiBuffer& getMidi(int index) { return instances_[index]->midi; }
+    const AudioSampleBuffer& getOutput(int index) const { return instances_[index]->output; }
+    int64 getNumBlocksProcessed(int index) const { return instances_[index]->num_blocks_processed; }
+
+    Stats getStats() const;
+    void resetStats();
+
+    static size_t getProcessResidentBytes();
+
+  private:
+    struct Instance {
+      Instance(int block_size);
+
+      std::unique_ptr<HeadlessSynth> synth;
+      AudioSampleBuffer output;
+      MidiBuffer midi;
+      int64 num_blocks_processed;
+    };
+
+    struct alignas(64) WorkQueue {
+      std::atomic<int> next;
+      int end;
+    };
+
+    class Worker : public Thread {
+      public:
+        Worker(EngineHost* host, int index) : Thread("Vital Engine " + String(index)), host_(host), index_(index) { }
+
+        void run() override;
+        void wake() { start_.signal(); }
+
+      private:
+        EngineHost* host_;
+        int index_;
+        WaitableEvent start_;
+    };
+
+    void processInstances(int worker_index);
+    void finishWork();
+
+    int block_size_;
+    int sample_rate_;
+    double position_;
+    std::vector<std::unique_ptr<Instance>> instances_;
+    std::unique_ptr<WorkQueue[]> queues_;
+    std::vector<std::unique_ptr<Worker>> workers_;
+    std::atomic<int> working_threads_;
+    WaitableEvent done_;
+
+    int64 num_blocks_;
+    int64 deadline_misses_;
+    double total_block_ms_;
+    double peak_block_ms_;
+
+    JUCE_DECLARE_NON_COPYABLE(EngineHost)
+};
+
+#endif
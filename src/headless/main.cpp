@@ -18,6 +18,20 @@
 #include "load_save.h"
 #include "tuning.h"
 #include "synth_base.h"
+#include "streaming_server.h"
+#include "engine_host.h"
+#include "convolution.h"
+#include "dsp_kernels.h"
+#include "decimator.h"
+#include "synth_oscillator.h"
+#include "synth_strings.h"
+#include "value.h"
+#include "wavetable.h"
+#include "wavetable_creator.h"
+
+#include <chrono>
+#include <csignal>
+#include <thread>
 
 String getArgumentValue(int argc, const char* argv[], const String& flag, const String& full_flag) {
   for (int i = 0; i < argc - 1; ++i) {
@@ -30,7 +44,7 @@ String getArgumentValue(int argc, const char* argv[], const String& flag, const
 }
 
 bool hasFlag(int argc, const char* argv[], const String& flag, const String& full_flag) {
-  for (int i = 0; i < argc - 1; ++i) {
+  for (int i = 0; i < argc; ++i) {
     std::string arg = argv[i];
     if (arg == flag || arg == full_flag)
       return true;
@@ -114,29 +128,520 @@ void doRenderToFile(HeadlessSynth& headless_synth, int argc, const char* argv[])
   headless_synth.renderAudioToFile(output_file, length, bpm, midi_notes, render_images);
 }
 
-bool loadFromCommandLine(HeadlessSynth& synth, const String& command_line) {
+File getFileFromCommandLine(const String& command_line) {
   String file_path = command_line;
   if (file_path[0] == '"' && file_path[file_path.length() - 1] == '"')
     file_path = command_line.substring(1, command_line.length() - 1);
-  File file = File::getCurrentWorkingDirectory().getChildFile(file_path);
-  if (!file.exists())
-    return false;
-  
-  std::string error;
-  synth.loadFromFile(file, error);
-  return true;
+  return File::getCurrentWorkingDirectory().getChildFile(file_path);
 }
 
-int main(int argc, const char* argv[]) {
-  HeadlessSynth headless_synth;
-  
+File getPresetFile(int argc, const char* argv[]) {
   bool last_arg_was_option = false;
   for (int i = 1; i < argc; ++i) {
     std::string arg = argv[i];
-    if (arg != "" && arg[0] != '-' && !last_arg_was_option && loadFromCommandLine(headless_synth, arg))
-      break;
+    if (arg != "" && arg[0] != '-' && !last_arg_was_option) {
+      File file = getFileFromCommandLine(arg);
+      if (file.exists())
+        return file;
+    }
+
+    last_arg_was_option = arg[0] == '-' && arg != "--headless" && arg != "--serve-test" &&
+                          arg != "--kernel-bench" && arg != "--oversampling-bench" &&
+                          arg != "--convolution-bench" && arg != "--oscillator-bench" &&
+                          arg != "--spectral-cache-bench";
+  }
+
+  return File();
+}
+
+#if VITAL_STREAMING_SERVER
+std::atomic<bool> serving(true);
+
+void stopServing(int signal) {
+  serving = false;
+}
+
+int getIntArgument(int argc, const char* argv[], const String& full_flag, int default_value, int min, int max) {
+  String string_value = getArgumentValue(argc, argv, "", full_flag);
+  if (string_value.isEmpty())
+    return default_value;
+
+  return std::max(min, std::min(max, string_value.getIntValue()));
+}
+
+int doServe(const File& preset, int argc, const char* argv[]) {
+  static constexpr int kMaxInstances = 64;
+  static constexpr int kMaxBlocks = 1024;
+  static constexpr int kMaxEvents = 1 << 16;
+
+  streaming::Config config;
+  config.num_instances = getIntArgument(argc, argv, "--serve-instances", 1, 1, kMaxInstances);
+  config.block_size = getIntArgument(argc, argv, "--block-size", streaming::kDefaultBlockSize,
+                                     1, vital::kMaxBufferSize);
+  config.sample_rate = getIntArgument(argc, argv, "--sample-rate", streaming::kDefaultSampleRate,
+                                      vital::kDefaultSampleRate / 4, vital::kDefaultSampleRate * 8);
+  config.num_blocks = getIntArgument(argc, argv, "--serve-blocks", streaming::kDefaultNumBlocks, 2, kMaxBlocks);
+  config.num_events = getIntArgument(argc, argv, "--serve-events", streaming::kDefaultNumEvents, 16, kMaxEvents);
+  config.first_core = getIntArgument(argc, argv, "--first-core", 0, 0, kMaxInstances - 1);
+
+  std::string socket_path = getArgumentValue(argc, argv, "", "--serve").toStdString();
+  streaming::Server server(socket_path, config, preset);
+  if (!server.start()) {
+    std::cout << "Error: Couldn't start server on " << socket_path << newLine;
+    return 1;
+  }
+
+  signal(SIGINT, stopServing);
+  signal(SIGTERM, stopServing);
+  server.run(serving);
+  server.stop();
+  return 0;
+}
+#endif
+
+#if VITAL_ENGINE_HOST
+int doInstanceBenchmark(const File& preset, int argc, const char* argv[]) {
+  static constexpr int kMaxInstances = 1024;
+  static constexpr int kNote = 48;
+  static constexpr int kNumNotes = 4;
+  static constexpr int kNoteSpacing = 4;
+  static constexpr float kWarmupSeconds = 0.25f;
+  static constexpr float kDefaultSeconds = 2.0f;
+  static constexpr double kBytesPerMegabyte = 1024.0 * 1024.0;
+
+  String string_instances = getArgumentValue(argc, argv, "", "--instances");
+  int max_instances = vital::utils::iclamp(string_instances.getIntValue(), 1, kMaxInstances);
+  int max_threads = std::max(1, (int)std::thread::hardware_concurrency());
+  String string_threads = getArgumentValue(argc, argv, "", "--threads");
+  if (!string_threads.isEmpty())
+    max_threads = vital::utils::iclamp(string_threads.getIntValue(), 1, EngineHost::kMaxThreads);
+
+  float seconds = kDefaultSeconds;
+  String string_length = getArgumentValue(argc, argv, "-l", "--length");
+  if (string_length.getFloatValue() > 0.0f)
+    seconds = string_length.getFloatValue();
+
+  std::vector<int> instance_counts;
+  for (int num_instances = 1; num_instances < max_instances; num_instances *= 2)
+    instance_counts.push_back(num_instances);
+  instance_counts.push_back(max_instances);
+
+  std::cout << "instances threads   block_ms  deadline_ms  peak_ms   load  misses  process_rss_mb"
+               "  rss_growth_mb_per_instance" << std::endl;
+  for (int num_instances : instance_counts) {
+    size_t base_bytes = EngineHost::getProcessResidentBytes();
+    EngineHost host(num_instances, std::min(num_instances, max_threads));
+    host.loadPreset(preset);
+    for (int i = 0; i < num_instances; ++i) {
+      for (int n = 0; n < kNumNotes; ++n)
+        host.getMidi(i).addEvent(MidiMessage::noteOn(1, kNote + n * kNoteSpacing, 0.8f), 0);
+    }
+
+    int sample_rate = EngineHost::kDefaultSampleRate;
+    int warmup_blocks = kWarmupSeconds * sample_rate / host.getBlockSize();
+    for (int b = 0; b < warmup_blocks; ++b)
+      host.processBlock();
+
+    host.resetStats();
+    int num_blocks = seconds * sample_rate / host.getBlockSize();
+    for (int b = 0; b < num_blocks; ++b)
+      host.processBlock();
+
+    EngineHost::Stats stats = host.getStats();
+    size_t process_bytes = stats.process_resident_bytes;
+    double rss = process_bytes / kBytesPerMegabyte;
+    double growth = (process_bytes - std::min(base_bytes, process_bytes)) / kBytesPerMegabyte;
+    std::cout << String(stats.num_instances).paddedLeft(' ', 9) << " "
+              << String(stats.num_threads).paddedLeft(' ', 7) << " "
+              << String(stats.average_block_ms, 4).paddedLeft(' ', 10) << " "
+              << String(stats.deadline_ms, 4).paddedLeft(' ', 12) << " "
+              << String(stats.peak_block_ms, 3).paddedLeft(' ', 8) << " "
+              << String(stats.cpu_load, 3).paddedLeft(' ', 6) << " "
+              << String(stats.deadline_misses).paddedLeft(' ', 7) << " "
+              << String(rss, 1).paddedLeft(' ', 15) << " "
+              << String(growth / num_instances, 2).paddedLeft(' ', 27) << std::endl;
+  }
+
+  return 0;
+}
+#endif
+
+int doKernelBenchmark() {
+  static constexpr int kSize = 4096;
+  static constexpr int kNumTaps = 32;
+  static constexpr int kNumOutputs = (kSize / vital::kernels::kFrameSize - kNumTaps) / 2;
+  static constexpr int kNumPolyphaseOutputs = kSize / 2 - kNumTaps - 1;
+  static constexpr int kFractionBits = 21;
+  static constexpr int kIterations = 2000;
+
+  Random random(1);
+  std::unique_ptr<float[]> source = std::make_unique<float[]>(kSize + 1);
+  std::unique_ptr<uint32_t[]> phases = std::make_unique<uint32_t[]>(kSize);
+  for (int i = 0; i <= kSize; ++i)
+    source[i] = random.nextFloat() * 2.0f - 1.0f;
+  for (int i = 0; i < kSize; ++i)
+    phases[i] = static_cast<uint32_t>(random.nextInt());
+
+  float taps[kNumTaps];
+  for (int i = 0; i < kNumTaps; ++i)
+    taps[i] = random.nextFloat() - 0.5f;
+
+  std::unique_ptr<float[]> dest = std::make_unique<float[]>(kSize);
+  std::unique_ptr<float[]> expected = std::make_unique<float[]>(kSize);
+
+  auto measure = [&](const vital::kernels::Table& table, int kernel) {
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < kIterations; ++i) {
+      if (kernel == 0)
+        table.copy(dest.get(), source.get(), kSize);
+      else if (kernel == 1)
+        table.interpolate(dest.get(), source.get(), phases.get(), kFractionBits, kSize);
+      else if (kernel == 2)
+        table.halfband(dest.get(), source.get(), vital::kernels::kFrameSize, taps, kNumTaps, kNumOutputs);
+      else {
+        table.polyphase(dest.get(), source.get(), source.get() + 2, taps, kNumTaps, 0.5f, kNumTaps / 2,
+                        kNumPolyphaseOutputs);
+      }
+    }
+    std::chrono::duration<double, std::micro> time = std::chrono::steady_clock::now() - start;
+    return time.count() / kIterations;
+  };
+
+  const char* kernel_names[] = { "copy", "interpolate", "halfband", "polyphase" };
+  const vital::kernels::Table& baseline = vital::kernels::getTable(vital::kernels::kBaseline);
+  std::cout << "active: " << vital::kernels::getName(vital::kernels::get().isa) << std::endl;
+  std::cout << "kernel       isa      us_per_call  speedup  max_error" << std::endl;
+  for (int kernel = 0; kernel < 4; ++kernel) {
+    double baseline_time = measure(baseline, kernel);
+    memcpy(expected.get(), dest.get(), kSize * sizeof(float));
+
+    for (int i = 0; i < vital::kernels::kNumIsas; ++i) {
+      vital::kernels::Isa isa = static_cast<vital::kernels::Isa>(i);
+      if (!vital::kernels::isSupported(isa))
+        continue;
+
+      double time = measure(vital::kernels::getTable(isa), kernel);
+      float max_error = 0.0f;
+      for (int s = 0; s < kSize; ++s)
+        max_error = std::max(max_error, std::abs(dest[s] - expected[s]));
+
+      std::cout << String(kernel_names[kernel]).paddedRight(' ', 12) << " "
+                << String(vital::kernels::getName(isa)).paddedRight(' ', 8) << " "
+                << String(time, 3).paddedLeft(' ', 11) << " "
+                << String(baseline_time / time, 2).paddedLeft(' ', 8) << " "
+                << String(max_error, 7).paddedLeft(' ', 10) << std::endl;
+    }
+  }
+
+  static constexpr int kBufferSizes[] = { 4, 8, 16, 32, 64, 128, 256, 512, 1024, 2048 };
+  static constexpr int kBufferFloats = 20000000;
+
+  auto measure_buffer = [&](int size, int kernel, bool dispatch) {
+    int iterations = kBufferFloats / size;
+    const vital::kernels::Table& table = vital::kernels::get();
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < iterations; ++i) {
+      float* buffer = dest.get() + (i % vital::kernels::kFrameSize);
+      if (kernel == 0 && dispatch)
+        table.zero(buffer, size);
+      else if (kernel == 0) {
+        for (int s = 0; s < size; ++s)
+          buffer[s] = 0.0f;
+      }
+      else if (dispatch)
+        table.copy(buffer, source.get(), size);
+      else {
+        for (int s = 0; s < size; ++s)
+          buffer[s] = source[s];
+      }
+    }
+    std::chrono::duration<double, std::nano> time = std::chrono::steady_clock::now() - start;
+    return time.count() / iterations;
+  };
+
+  std::cout << std::endl << "buffer  size  inline_ns  kernel_ns  uses" << std::endl;
+  for (int kernel = 0; kernel < 2; ++kernel) {
+    int min_kernel_size = kernel == 0 ? vital::kernels::kMinZeroKernelSize : vital::kernels::kMinCopyKernelSize;
+    for (int size : kBufferSizes) {
+      double inline_time = measure_buffer(size, kernel, false);
+      double kernel_time = measure_buffer(size, kernel, true);
+      std::cout << String(kernel == 0 ? "zero" : "copy").paddedRight(' ', 6) << " "
+                << String(size).paddedLeft(' ', 5) << " "
+                << String(inline_time, 2).paddedLeft(' ', 10) << " "
+                << String(kernel_time, 2).paddedLeft(' ', 10) << "  "
+                << (size >= min_kernel_size ? "kernel" : "inline") << std::endl;
+    }
+  }
 
-    last_arg_was_option = arg[0] == '-' && arg != "--headless";
+  return 0;
+}
+
+int doOversamplingBenchmark() {
+  static constexpr int kMaxStages = 3;
+  static constexpr int kIterations = 4000;
+  static constexpr int kSettleBlocks = 10;
+  static constexpr double kAliasedFrequency = 15000.0;
+
+  std::cout << "quality        stages  us_per_block  latency  alias_db" << std::endl;
+  for (int q = 0; q < vital::constants::kNumOversamplingQualities; ++q) {
+    vital::constants::OversamplingQuality quality = static_cast<vital::constants::OversamplingQuality>(q);
+    for (int num_stages = 1; num_stages <= kMaxStages; ++num_stages) {
+      int oversample = 1 << num_stages;
+      int input_samples = vital::kMaxBufferSize * oversample;
+      vital::Decimator decimator(kMaxStages);
+      decimator.setQuality(quality);
+      decimator.init();
+
+      vital::Value source;
+      source.setOversampleAmount(oversample);
+      decimator.plug(&source, vital::Decimator::kAudio);
+
+      double frequency = vital::kDefaultSampleRate - kAliasedFrequency;
+      double phase_delta = 2.0 * vital::kPi * frequency / source.getSampleRate();
+      double phase = 0.0;
+      double total = 0.0;
+      double elapsed = 0.0;
+      for (int i = 0; i < kIterations; ++i) {
+        for (int s = 0; s < input_samples; ++s) {
+          source.output()->buffer[s] = std::sin(phase);
+          phase += phase_delta;
+        }
+        phase = std::fmod(phase, 2.0 * vital::kPi);
+
+        auto start = std::chrono::steady_clock::now();
+        decimator.process(vital::kMaxBufferSize);
+        std::chrono::duration<double, std::micro> time = std::chrono::steady_clock::now() - start;
+        elapsed += time.count();
+
+        if (i >= kSettleBlocks) {
+          for (int s = 0; s < vital::kMaxBufferSize; ++s)
+            total += decimator.output()->buffer[s][0] * decimator.output()->buffer[s][0];
+        }
+      }
+
+      double amplitude = std::sqrt(2.0 * total / ((kIterations - kSettleBlocks) * vital::kMaxBufferSize));
+      std::cout << String(strings::kOversamplingQualityNames[q]).paddedRight(' ', 14) << " "
+                << String(num_stages).paddedLeft(' ', 6) << " "
+                << String(elapsed / kIterations, 3).paddedLeft(' ', 13) << " "
+                << String(decimator.getLatency(num_stages)).paddedLeft(' ', 8) << " "
+                << String(20.0 * std::log10(amplitude + 1e-12), 1).paddedLeft(' ', 9) << std::endl;
+    }
+  }
+
+  return 0;
+}
+
+int doConvolutionBenchmark() {
+  static constexpr int kSampleRates[] = { 44100, 96000 };
+  static constexpr float kImpulseSeconds[] = { 0.5f, 2.0f, 8.0f };
+  static constexpr float kAudioSeconds = 10.0f;
+
+  std::cout << "rate    ir_secs  cpu_percent  percent_per_ir_sec" << std::endl;
+  for (int sample_rate : kSampleRates) {
+    for (float impulse_seconds : kImpulseSeconds) {
+      vital::Convolution convolution;
+      vital::Output audio;
+      audio.ensureBufferSize(vital::kMaxBufferSize);
+      vital::Value wet(1.0f);
+      convolution.plug(&audio, vital::Convolution::kAudio);
+      convolution.plug(&wet, vital::Convolution::kWet);
+      convolution.setBackgroundProcessing(false);
+      convolution.setSampleRate(sample_rate);
+
+      // Tail partitions run inline here, so the time covers both the audio thread and the worker.
+      Random random(1);
+      int impulse_length = impulse_seconds * sample_rate;
+      std::vector<vital::mono_float> left(impulse_length);
+      std::vector<vital::mono_float> right(impulse_length);
+      for (int i = 0; i < impulse_length; ++i) {
+        left[i] = random.nextFloat() * 2.0f - 1.0f;
+        right[i] = random.nextFloat() * 2.0f - 1.0f;
+      }
+      convolution.setImpulseResponse(left.data(), right.data(), impulse_length, sample_rate, "Benchmark");
+
+      int num_blocks = kAudioSeconds * sample_rate / vital::kMaxBufferSize;
+      double elapsed = 0.0;
+      for (int b = 0; b < num_blocks; ++b) {
+        for (int i = 0; i < vital::kMaxBufferSize; ++i)
+          audio.buffer[i] = random.nextFloat() * 2.0f - 1.0f;
+
+        auto start = std::chrono::steady_clock::now();
+        convolution.process(vital::kMaxBufferSize);
+        std::chrono::duration<double> time = std::chrono::steady_clock::now() - start;
+        elapsed += time.count();
+      }
+
+      double audio_seconds = num_blocks * vital::kMaxBufferSize / (1.0 * sample_rate);
+      double cpu_percent = 100.0 * elapsed / audio_seconds;
+      std::cout << String(sample_rate).paddedRight(' ', 7) << " "
+                << String(impulse_seconds, 1).paddedLeft(' ', 7) << " "
+                << String(cpu_percent, 2).paddedLeft(' ', 12) << " "
+                << String(cpu_percent / impulse_seconds, 2).paddedLeft(' ', 19) << std::endl;
+    }
+  }
+
+  return 0;
+}
+
+std::vector<std::unique_ptr<vital::Value>> plugOscillatorInputs(vital::SynthOscillator* oscillator,
+                                                                int num_voices, int unison) {
+  std::vector<std::unique_ptr<vital::Value>> inputs;
+  for (int i = 0; i < vital::SynthOscillator::kNumInputs; ++i) {
+    bool audio_rate = i == vital::SynthOscillator::kAmplitude || i == vital::SynthOscillator::kTranspose ||
+                      i == vital::SynthOscillator::kTune || i == vital::SynthOscillator::kPhase;
+    inputs.push_back(std::make_unique<vital::Value>(0.0f, !audio_rate));
+    oscillator->plug(inputs[i].get(), i);
+  }
+
+  vital::poly_float active_voices = num_voices == 2 ? 1.0f : vital::poly_float(1.0f, 1.0f, 0.0f, 0.0f);
+  inputs[vital::SynthOscillator::kActiveVoices]->set(active_voices);
+  inputs[vital::SynthOscillator::kMidiNote]->set(vital::poly_float(48.0f, 48.0f, 55.0f, 55.0f));
+  inputs[vital::SynthOscillator::kMidiTrack]->set(1.0f);
+  inputs[vital::SynthOscillator::kAmplitude]->set(0.7f);
+  inputs[vital::SynthOscillator::kUnisonVoices]->set(unison);
+  inputs[vital::SynthOscillator::kUnisonDetune]->set(2.0f);
+  inputs[vital::SynthOscillator::kDetunePower]->set(1.5f);
+  inputs[vital::SynthOscillator::kDetuneRange]->set(2.0f);
+  inputs[vital::SynthOscillator::kBlend]->set(0.8f);
+  inputs[vital::SynthOscillator::kStereoSpread]->set(0.5f);
+  return inputs;
+}
+
+int doOscillatorBenchmark() {
+  static constexpr int kUnisonCounts[] = { 1, 2, 4, 8, 16 };
+  static constexpr int kIterations = 4000;
+  static constexpr int kFrameChangeBlocks = 100;
+
+  vital::Wavetable wavetable(vital::kNumOscillatorWaveFrames);
+  WavetableCreator creator(&wavetable);
+  creator.initPredefinedWaves();
+  creator.render();
+
+  std::cout << "voices  unison  us_per_block  us_per_unison_voice" << std::endl;
+  for (int num_voices = 1; num_voices <= 2; ++num_voices) {
+    for (int unison : kUnisonCounts) {
+      vital::SynthOscillator oscillator(&wavetable);
+      std::vector<std::unique_ptr<vital::Value>> inputs = plugOscillatorInputs(&oscillator, num_voices, unison);
+      vital::Output reset;
+      vital::Output retrigger;
+      oscillator.plug(&reset, vital::SynthOscillator::kReset);
+      oscillator.plug(&retrigger, vital::SynthOscillator::kRetrigger);
+      reset.trigger(vital::constants::kFullMask, 1.0f, 0);
+
+      double elapsed = 0.0;
+      for (int i = 0; i < kIterations; ++i) {
+        if (i % kFrameChangeBlocks == 0)
+          inputs[vital::SynthOscillator::kWaveFrame]->set((i / kFrameChangeBlocks) % vital::kNumOscillatorWaveFrames);
+
+        auto start = std::chrono::steady_clock::now();
+        oscillator.process(vital::kMaxBufferSize);
+        std::chrono::duration<double, std::micro> time = std::chrono::steady_clock::now() - start;
+        elapsed += time.count();
+        reset.clearTrigger();
+      }
+
+      double us_per_block = elapsed / kIterations;
+      std::cout << String(num_voices).paddedLeft(' ', 6) << " "
+                << String(unison).paddedLeft(' ', 7) << " "
+                << String(us_per_block, 3).paddedLeft(' ', 13) << " "
+                << String(us_per_block / (num_voices * unison), 3).paddedLeft(' ', 20) << std::endl;
+    }
+  }
+
+  return 0;
+}
+
+int doSpectralCacheBenchmark() {
+  static constexpr vital::SynthOscillator::SpectralMorph kMorphs[] = {
+    vital::SynthOscillator::kVocode, vital::SynthOscillator::kSmear,
+    vital::SynthOscillator::kLowPass, vital::SynthOscillator::kPhaseDisperse
+  };
+  static constexpr int kUnison = 8;
+  static constexpr int kIterations = 2000;
+  static constexpr int kFrameChangeBlocks = 100;
+
+  vital::Wavetable wavetable(vital::kNumOscillatorWaveFrames);
+  WavetableCreator creator(&wavetable);
+  creator.initPredefinedWaves();
+  creator.render();
+
+  // A moving morph amount changes the cache key on every buffer refresh, so it shows the worst case hit rate.
+  std::cout << "morph  modulated  cached_us  uncached_us  hit_rate" << std::endl;
+  for (vital::SynthOscillator::SpectralMorph morph : kMorphs) {
+    for (bool modulated : { false, true }) {
+      double us_per_block[2] = { 0.0, 0.0 };
+      float hit_rate = 0.0f;
+      for (int cached = 0; cached < 2; ++cached) {
+        vital::SynthOscillator oscillator(&wavetable);
+        oscillator.setSpectralFrameCaching(cached);
+        std::vector<std::unique_ptr<vital::Value>> inputs = plugOscillatorInputs(&oscillator, 2, kUnison);
+        vital::Output reset;
+        vital::Output retrigger;
+        oscillator.plug(&reset, vital::SynthOscillator::kReset);
+        oscillator.plug(&retrigger, vital::SynthOscillator::kRetrigger);
+        inputs[vital::SynthOscillator::kSpectralMorphType]->set(morph);
+        inputs[vital::SynthOscillator::kSpectralMorphAmount]->set(0.5f);
+        reset.trigger(vital::constants::kFullMask, 1.0f, 0);
+
+        double elapsed = 0.0;
+        for (int i = 0; i < kIterations; ++i) {
+          if (i % kFrameChangeBlocks == 0)
+            inputs[vital::SynthOscillator::kWaveFrame]->set((i / kFrameChangeBlocks) % vital::kNumOscillatorWaveFrames);
+          if (modulated)
+            inputs[vital::SynthOscillator::kSpectralMorphAmount]->set(0.5f + 0.4f * sinf(0.01f * i));
+
+          auto start = std::chrono::steady_clock::now();
+          oscillator.process(vital::kMaxBufferSize);
+          std::chrono::duration<double, std::micro> time = std::chrono::steady_clock::now() - start;
+          elapsed += time.count();
+          reset.clearTrigger();
+        }
+
+        us_per_block[cached] = elapsed / kIterations;
+        if (cached)
+          hit_rate = oscillator.getSpectralFrameCacheHitRate();
+      }
+
+      std::cout << String(morph).paddedLeft(' ', 5) << " "
+                << String(modulated ? "yes" : "no").paddedLeft(' ', 10) << " "
+                << String(us_per_block[1], 3).paddedLeft(' ', 10) << " "
+                << String(us_per_block[0], 3).paddedLeft(' ', 12) << " "
+                << String(hit_rate, 3).paddedLeft(' ', 9) << std::endl;
+    }
+  }
+
+  return 0;
+}
+
+int main(int argc, const char* argv[]) {
+  File preset = getPresetFile(argc, argv);
+
+#if VITAL_STREAMING_SERVER
+  if (hasFlag(argc, argv, "", "--serve-test"))
+    return streaming::runLoopbackTest(preset) ? 0 : 1;
+  if (!getArgumentValue(argc, argv, "", "--serve").isEmpty())
+    return doServe(preset, argc, argv);
+#endif
+#if VITAL_ENGINE_HOST
+  if (!getArgumentValue(argc, argv, "", "--instances").isEmpty())
+    return doInstanceBenchmark(preset, argc, argv);
+#endif
+
+  if (hasFlag(argc, argv, "", "--kernel-bench"))
+    return doKernelBenchmark();
+  if (hasFlag(argc, argv, "", "--oversampling-bench"))
+    return doOversamplingBenchmark();
+  if (hasFlag(argc, argv, "", "--convolution-bench"))
+    return doConvolutionBenchmark();
+  if (hasFlag(argc, argv, "", "--oscillator-bench"))
+    return doOscillatorBenchmark();
+  if (hasFlag(argc, argv, "", "--spectral-cache-bench"))
+    return doSpectralCacheBenchmark();
+
+  HeadlessSynth headless_synth;
+  if (preset.exists()) {
+    std::string error;
+    headless_synth.loadFromFile(preset, error);
   }
   
   doRenderToFile(headless_synth, argc, argv);
@@ -0,0 +1,539 @@
+/* Copyright 2013-2019 Matt Tytel
+ *
+ * vital is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * vital is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with vital.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "streaming_server.h"
+
+#if VITAL_STREAMING_SERVER
+
+#include "sound_engine.h"
+#include "synth_base.h"
+#include "synth_parameters.h"
+
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <thread>
+#include <unistd.h>
+
+namespace streaming {
+  namespace {
+    constexpr int kWaitTimeMs = 100;
+    constexpr int kMaxWakeBytes = 64;
+    constexpr int kMaxCores = 32;
+    static_assert(kMaxCores <= 32, "Affinity masks are 32 bits wide.");
+
+    void setNonBlocking(int socket) {
+      int flags = fcntl(socket, F_GETFL, 0);
+      fcntl(socket, F_SETFL, flags | O_NONBLOCK);
+    }
+
+    void sendWake(int socket) {
+      char wake = 0;
+      ssize_t result = send(socket, &wake, 1, MSG_NOSIGNAL);
+      UNUSED(result);
+    }
+
+    // Returns false if the other side hung up.
+    bool waitForWake(int socket, int timeout_ms) {
+      pollfd poll_info = { socket, POLLIN, 0 };
+      if (poll(&poll_info, 1, timeout_ms) <= 0)
+        return true;
+
+      char wakes[kMaxWakeBytes];
+      ssize_t num_read = recv(socket, wakes, kMaxWakeBytes, MSG_DONTWAIT);
+      return num_read > 0 || (num_read < 0 && (errno == EAGAIN || errno == EWOULDBLOCK));
+    }
+
+    bool fillSocketAddress(const std::string& path, sockaddr_un& address) {
+      if (path.size() >= sizeof(address.sun_path))
+        return false;
+
+      memset(&address, 0, sizeof(address));
+      address.sun_family = AF_UNIX;
+      strncpy(address.sun_path, path.c_str(), sizeof(address.sun_path) - 1);
+      return true;
+    }
+  } // namespace
+
+  size_t SharedStream::getSize(int block_size, int num_blocks, int num_events) {
+    return sizeof(Header) + sizeof(Event) * num_events + sizeof(float) * kNumChannels * block_size * num_blocks;
+  }
+
+  bool SharedStream::create(const std::string& name, const Config& config) {
+    close();
+    size_t size = getSize(config.block_size, config.num_blocks, config.num_events);
+
+    shm_unlink(name.c_str());
+    int descriptor = shm_open(name.c_str(), O_CREAT | O_EXCL | O_RDWR, S_IRUSR | S_IWUSR);
+    if (descriptor < 0)
+      return false;
+
+    bool sized = ftruncate(descriptor, size) == 0;
+    void* data = sized ? mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, descriptor, 0) : MAP_FAILED;
+    ::close(descriptor);
+    if (data == MAP_FAILED) {
+      shm_unlink(name.c_str());
+      return false;
+    }
+
+    name_ = name;
+    data_ = static_cast<uint8_t*>(data);
+    size_ = size;
+    owner_ = true;
+    memset(data_, 0, size_);
+
+    Header* stream_header = new (data_) Header();
+    stream_header->magic = kMagic;
+    stream_header->version = kVersion;
+    stream_header->sample_rate = config.sample_rate;
+    stream_header->block_size = config.block_size;
+    stream_header->num_channels = kNumChannels;
+    stream_header->num_blocks = config.num_blocks;
+    stream_header->num_events = config.num_events;
+    return true;
+  }
+
+  bool SharedStream::open(const std::string& name) {
+    close();
+    int descriptor = shm_open(name.c_str(), O_RDWR, 0);
+    if (descriptor < 0)
+      return false;
+
+    struct stat info;
+    if (fstat(descriptor, &info) != 0 || info.st_size < (off_t)sizeof(Header)) {
+      ::close(descriptor);
+      return false;
+    }
+
+    void* data = mmap(nullptr, info.st_size, PROT_READ | PROT_WRITE, MAP_SHARED, descriptor, 0);
+    ::close(descriptor);
+    if (data == MAP_FAILED)
+      return false;
+
+    name_ = name;
+    data_ = static_cast<uint8_t*>(data);
+    size_ = info.st_size;
+    owner_ = false;
+
+    Header* stream_header = header();
+    size_t expected_size = getSize(stream_header->block_size, stream_header->num_blocks, stream_header->num_events);
+    if (stream_header->magic != kMagic || stream_header->version != kVersion || expected_size > size_) {
+      close();
+      return false;
+    }
+    return true;
+  }
+
+  void SharedStream::close() {
+    if (data_ == nullptr)
+      return;
+
+    munmap(data_, size_);
+    if (owner_)
+      shm_unlink(name_.c_str());
+
+    data_ = nullptr;
+    size_ = 0;
+    owner_ = false;
+  }
+
+  float* SharedStream::block(uint64_t index) {
+    Header* stream_header = header();
+    float* audio = reinterpret_cast<float*>(data_ + sizeof(Header) + sizeof(Event) * stream_header->num_events);
+    uint64_t block_index = index % stream_header->num_blocks;
+    return audio + block_index * stream_header->block_size * stream_header->num_channels;
+  }
+
+  StreamInstance::StreamInstance(int index, const Config& config, const File& preset) :
+      Thread("Vital Stream " + String(index)), index_(index), config_(config), preset_(preset),
+      socket_(-1), audio_buffer_(kNumChannels, config.block_size), position_(0) { }
+
+  StreamInstance::~StreamInstance() {
+    if (isThreadRunning())
+      stopThread(-1);
+    disconnect();
+  }
+
+  bool StreamInstance::setup() {
+    std::string name = "/vital_stream_" + std::to_string(getpid()) + "_" + std::to_string(index_);
+    if (!stream_.create(name, config_))
+      return false;
+
+    synth_ = std::make_unique<HeadlessSynth>();
+    if (preset_.exists()) {
+      std::string error;
+      synth_->loadFromFile(preset_, error);
+    }
+    synth_->getEngine()->setSampleRate(config_.sample_rate);
+
+    vital::control_map& controls = synth_->getControls();
+    int num_parameters = vital::Parameters::getNumParameters();
+    parameters_.resize(num_parameters, nullptr);
+    for (int i = 0; i < num_parameters; ++i) {
+      auto control = controls.find(vital::Parameters::getDetails(i)->name);
+      if (control != controls.end())
+        parameters_[i] = control->second;
+    }
+
+    midi_buffer_.ensureSize(config_.num_events * (sizeof(Event) + kMaxMidiBytes));
+    return true;
+  }
+
+  void StreamInstance::connect(int socket) {
+    Header* header = stream_.header();
+    header->event_read.store(header->event_write.load(std::memory_order_acquire), std::memory_order_release);
+    header->block_read.store(0, std::memory_order_release);
+    header->block_write.store(0, std::memory_order_release);
+    position_ = 0;
+
+    setNonBlocking(socket);
+    socket_.store(socket);
+    notify();
+  }
+
+  void StreamInstance::disconnect() {
+    int socket = socket_.exchange(-1);
+    if (socket >= 0)
+      ::close(socket);
+  }
+
+  void StreamInstance::applyEvents(uint64_t end_time) {
+    Header* header = stream_.header();
+    Event* events = stream_.events();
+    uint64_t event_read = header->event_read.load(std::memory_order_relaxed);
+    uint64_t event_write = header->event_write.load(std::memory_order_acquire);
+
+    for (; event_read < event_write; ++event_read) {
+      const Event& event = events[event_read % header->num_events];
+      if (event.sample_time >= end_time)
+        break;
+
+      int offset = 0;
+      if (event.sample_time > position_)
+        offset = static_cast<int>(event.sample_time - position_);
+
+      if (event.type == kMidiEvent && event.midi_size > 0 && event.midi_size <= kMaxMidiBytes)
+        midi_buffer_.addEvent(event.midi, event.midi_size, offset);
+      else if (event.type == kParameterEvent && event.parameter_index < parameters_.size() &&
+               parameters_[event.parameter_index]) {
+        parameters_[event.parameter_index]->set(event.value);
+      }
+    }
+
+    header->event_read.store(event_read, std::memory_order_release);
+  }
+
+  void StreamInstance::renderBlock() {
+    Header* header = stream_.header();
+    int block_size = config_.block_size;
+
+    midi_buffer_.clear();
+    applyEvents(position_ + block_size);
+    synth_->processBlock(audio_buffer_, midi_buffer_, block_size, position_ / (1.0 * config_.sample_rate));
+
+    uint64_t block_write = header->block_write.load(std::memory_order_relaxed);
+    float* destination = stream_.block(block_write);
+    const float* left = audio_buffer_.getReadPointer(0);
+    const float* right = audio_buffer_.getReadPointer(1);
+    for (int i = 0; i < block_size; ++i) {
+      destination[kNumChannels * i] = left[i];
+      destination[kNumChannels * i + 1] = right[i];
+    }
+
+    header->block_write.store(block_write + 1, std::memory_order_release);
+    position_ += block_size;
+  }
+
+  bool StreamInstance::waitForClient(int timeout_ms) {
+    int socket = socket_.load();
+    if (socket < 0)
+      return false;
+
+    if (waitForWake(socket, timeout_ms))
+      return true;
+
+    disconnect();
+    return false;
+  }
+
+  void StreamInstance::run() {
+    int num_cores = std::min(kMaxCores, std::max(1, static_cast<int>(std::thread::hardware_concurrency())));
+    setCurrentThreadAffinityMask((uint32)1 << ((config_.first_core + index_) % num_cores));
+
+    Header* header = stream_.header();
+    while (!threadShouldExit()) {
+      int socket = socket_.load();
+      if (socket < 0) {
+        wait(kWaitTimeMs);
+        continue;
+      }
+
+      uint64_t block_read = header->block_read.load(std::memory_order_acquire);
+      uint64_t block_write = header->block_write.load(std::memory_order_relaxed);
+      if (block_write - block_read >= header->num_blocks) {
+        waitForClient(kWaitTimeMs);
+        continue;
+      }
+
+      renderBlock();
+      sendWake(socket);
+      if (!waitForClient(0))
+        continue;
+    }
+  }
+
+  Server::Server(const std::string& socket_path, const Config& config, const File& preset) :
+      socket_path_(socket_path), config_(config), listen_socket_(-1) {
+    for (int i = 0; i < config_.num_instances; ++i)
+      instances_.push_back(std::make_unique<StreamInstance>(i, config_, preset));
+  }
+
+  Server::~Server() {
+    stop();
+  }
+
+  bool Server::start() {
+    sockaddr_un address;
+    if (!fillSocketAddress(socket_path_, address))
+      return false;
+
+    for (auto& instance : instances_) {
+      if (!instance->setup())
+        return false;
+    }
+
+    unlink(socket_path_.c_str());
+    listen_socket_ = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (listen_socket_ < 0)
+      return false;
+
+    if (bind(listen_socket_, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0 ||
+        listen(listen_socket_, config_.num_instances) != 0) {
+      stop();
+      return false;
+    }
+
+    for (auto& instance : instances_)
+      instance->startThread(Thread::realtimeAudioPriority);
+    return true;
+  }
+
+  void Server::stop() {
+    for (auto& instance : instances_) {
+      if (instance->isThreadRunning())
+        instance->stopThread(-1);
+    }
+
+    if (listen_socket_ >= 0) {
+      ::close(listen_socket_);
+      unlink(socket_path_.c_str());
+      listen_socket_ = -1;
+    }
+  }
+
+  void Server::acceptClient() {
+    int client_socket = accept(listen_socket_, nullptr, nullptr);
+    if (client_socket < 0)
+      return;
+
+    for (int i = 0; i < instances_.size(); ++i) {
+      StreamInstance* instance = instances_[i].get();
+      if (instance->isConnected())
+        continue;
+
+      Hello hello;
+      memset(&hello, 0, sizeof(hello));
+      hello.magic = kMagic;
+      hello.instance = i;
+      strncpy(hello.shm_name, instance->getShmName().c_str(), kMaxShmNameLength - 1);
+      if (send(client_socket, &hello, sizeof(hello), MSG_NOSIGNAL) == sizeof(hello))
+        instance->connect(client_socket);
+      else
+        ::close(client_socket);
+      return;
+    }
+
+    ::close(client_socket);
+  }
+
+  void Server::run(const std::atomic<bool>& running) {
+    while (running.load() && listen_socket_ >= 0) {
+      pollfd poll_info = { listen_socket_, POLLIN, 0 };
+      if (poll(&poll_info, 1, kWaitTimeMs) > 0)
+        acceptClient();
+    }
+  }
+
+  bool Client::connect(const std::string& socket_path) {
+    disconnect();
+
+    sockaddr_un address;
+    if (!fillSocketAddress(socket_path, address))
+      return false;
+
+    socket_ = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (socket_ < 0)
+      return false;
+
+    Hello hello;
+    if (::connect(socket_, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0 ||
+        recv(socket_, &hello, sizeof(hello), MSG_WAITALL) != sizeof(hello) || hello.magic != kMagic) {
+      disconnect();
+      return false;
+    }
+
+    hello.shm_name[kMaxShmNameLength - 1] = 0;
+    if (!stream_.open(hello.shm_name)) {
+      disconnect();
+      return false;
+    }
+
+    instance_ = hello.instance;
+    setNonBlocking(socket_);
+    return true;
+  }
+
+  void Client::disconnect() {
+    stream_.close();
+    if (socket_ >= 0)
+      ::close(socket_);
+    socket_ = -1;
+  }
+
+  bool Client::sendEvent(const Event& event) {
+    Header* header = stream_.header();
+    uint64_t event_write = header->event_write.load(std::memory_order_relaxed);
+    if (event_write - header->event_read.load(std::memory_order_acquire) >= header->num_events)
+      return false;
+
+    stream_.events()[event_write % header->num_events] = event;
+    header->event_write.store(event_write + 1, std::memory_order_release);
+    return true;
+  }
+
+  bool Client::sendMidi(uint64_t sample_time, const MidiMessage& message) {
+    int size = message.getRawDataSize();
+    if (size <= 0 || size > kMaxMidiBytes)
+      return false;
+
+    Event event;
+    memset(&event, 0, sizeof(event));
+    event.sample_time = sample_time;
+    event.type = kMidiEvent;
+    event.midi_size = size;
+    memcpy(event.midi, message.getRawData(), size);
+    return sendEvent(event);
+  }
+
+  bool Client::sendParameter(uint64_t sample_time, int index, float value) {
+    Event event;
+    memset(&event, 0, sizeof(event));
+    event.sample_time = sample_time;
+    event.type = kParameterEvent;
+    event.parameter_index = index;
+    event.value = value;
+    return sendEvent(event);
+  }
+
+  bool Client::readBlock(float* interleaved_destination, int timeout_ms) {
+    Header* header = stream_.header();
+    uint64_t block_read = header->block_read.load(std::memory_order_relaxed);
+    double end_time = Time::getMillisecondCounterHiRes() + timeout_ms;
+
+    while (header->block_write.load(std::memory_order_acquire) <= block_read) {
+      int remaining = static_cast<int>(end_time - Time::getMillisecondCounterHiRes());
+      if (remaining <= 0 || !waitForWake(socket_, remaining))
+        return false;
+    }
+
+    int num_samples = header->block_size * header->num_channels;
+    memcpy(interleaved_destination, stream_.block(block_read), num_samples * sizeof(float));
+    header->block_read.store(block_read + 1, std::memory_order_release);
+    sendWake(socket_);
+    return true;
+  }
+
+  bool runLoopbackTest(const File& preset) {
+    static constexpr int kNote = 60;
+    static constexpr float kSeconds = 1.0f;
+    static constexpr float kMinPeak = 0.001f;
+    static constexpr int kTimeoutMs = 2000;
+
+    Config config;
+    config.num_instances = 2;
+    std::string socket_path = File::getSpecialLocation(File::tempDirectory)
+                                  .getChildFile("vital_stream_test_" + String(getpid())).getFullPathName().toStdString();
+
+    Server server(socket_path, config, preset);
+    if (!server.start()) {
+      std::cout << "Stream test: couldn't start server." << std::endl;
+      return false;
+    }
+
+    std::atomic<bool> running(true);
+    std::thread accept_thread([&server, &running]() { server.run(running); });
+
+    Client playing_client;
+    Client silent_client;
+    bool connected = playing_client.connect(socket_path) && silent_client.connect(socket_path);
+    bool success = connected && playing_client.getInstance() != silent_client.getInstance();
+
+    if (success) {
+      int block_size = playing_client.getBlockSize();
+      int num_blocks = kSeconds * config.sample_rate / block_size;
+      uint64_t note_off_time = num_blocks * block_size / 2;
+      playing_client.sendMidi(block_size / 2, MidiMessage::noteOn(1, kNote, 0.8f));
+      playing_client.sendMidi(note_off_time, MidiMessage::noteOff(1, kNote));
+
+      std::vector<float> block(block_size * kNumChannels);
+      float playing_peak = 0.0f;
+      float silent_peak = 0.0f;
+      for (int b = 0; b < num_blocks && success; ++b) {
+        success = playing_client.readBlock(block.data(), kTimeoutMs);
+        for (float sample : block)
+          playing_peak = std::max(playing_peak, std::abs(sample));
+
+        success = success && silent_client.readBlock(block.data(), kTimeoutMs);
+        for (float sample : block)
+          silent_peak = std::max(silent_peak, std::abs(sample));
+      }
+
+      if (!success)
+        std::cout << "Stream test: timed out waiting for audio." << std::endl;
+      else if (playing_peak < kMinPeak || silent_peak > 0.0f) {
+        std::cout << "Stream test: unexpected output levels " << playing_peak << ", " << silent_peak << std::endl;
+        success = false;
+      }
+    }
+    else
+      std::cout << "Stream test: couldn't connect clients." << std::endl;
+
+    playing_client.disconnect();
+    silent_client.disconnect();
+    running = false;
+    accept_thread.join();
+    server.stop();
+
+    if (success)
+      std::cout << "Stream test: passed." << std::endl;
+    return success;
+  }
+} // namespace streaming
+
+#endif
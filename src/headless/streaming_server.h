@@ -0,0 +1,203 @@
+/* Copyright 2013-2019 Matt Tytel
+ *
+ * vital is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * vital is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with vital.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "JuceHeader.h"
+
+#if (JUCE_LINUX || JUCE_MAC) && !defined(__EMSCRIPTEN__)
+#define VITAL_STREAMING_SERVER 1
+#else
+#define VITAL_STREAMING_SERVER 0
+#endif
+
+#if VITAL_STREAMING_SERVER
+
+#include <atomic>
+
+class HeadlessSynth;
+
+namespace vital {
+  class Value;
+} // namespace vital
+
+// A client connects to the server socket and receives a Hello naming the shared memory region of the
+// instance it was assigned. Events and audio move through rings in that region. The socket only carries
+// single wake up bytes: the server sends one per rendered block, the client sends one per consumed block.
+namespace streaming {
+  constexpr uint32_t kMagic = 0x56545354;
+  constexpr uint32_t kVersion = 1;
+  constexpr int kMaxShmNameLength = 64;
+  constexpr int kNumChannels = 2;
+  constexpr int kDefaultBlockSize = 128;
+  constexpr int kDefaultSampleRate = 44100;
+  constexpr int kDefaultNumBlocks = 16;
+  constexpr int kDefaultNumEvents = 1024;
+  constexpr int kMaxMidiBytes = 3;
+
+  static_assert(ATOMIC_LLONG_LOCK_FREE == 2, "Stream indices must be lock free to be shared between processes.");
+
+  enum EventType : uint32_t {
+    kMidiEvent,
+    kParameterEvent
+  };
+
+  struct Event {
+    uint64_t sample_time;
+    uint32_t type;
+    uint32_t parameter_index;
+    float value;
+    uint32_t midi_size;
+    uint8_t midi[4];
+  };
+
+  struct Header {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t sample_rate;
+    uint32_t block_size;
+    uint32_t num_channels;
+    uint32_t num_blocks;
+    uint32_t num_events;
+    uint32_t reserved;
+    std::atomic<uint64_t> event_write;
+    std::atomic<uint64_t> event_read;
+    std::atomic<uint64_t> block_write;
+    std::atomic<uint64_t> block_read;
+  };
+
+  struct Hello {
+    uint32_t magic;
+    uint32_t instance;
+    char shm_name[kMaxShmNameLength];
+  };
+
+  struct Config {
+    int num_instances = 1;
+    int block_size = kDefaultBlockSize;
+    int sample_rate = kDefaultSampleRate;
+    int num_blocks = kDefaultNumBlocks;
+    int num_events = kDefaultNumEvents;
+    int first_core = 0;
+  };
+
+  class SharedStream {
+    public:
+      SharedStream() : data_(nullptr), size_(0), owner_(false) { }
+      ~SharedStream() { close(); }
+
+      bool create(const std::string& name, const Config& config);
+      bool open(const std::string& name);
+      void close();
+
+      Header* header() { return reinterpret_cast<Header*>(data_); }
+      Event* events() { return reinterpret_cast<Event*>(data_ + sizeof(Header)); }
+      float* block(uint64_t index);
+      const std::string& name() const { return name_; }
+
+    private:
+      static size_t getSize(int block_size, int num_blocks, int num_events);
+
+      std::string name_;
+      uint8_t* data_;
+      size_t size_;
+      bool owner_;
+
+      JUCE_DECLARE_NON_COPYABLE(SharedStream)
+  };
+
+  class StreamInstance : public Thread {
+    public:
+      StreamInstance(int index, const Config& config, const File& preset);
+      ~StreamInstance();
+
+      bool setup();
+      bool isConnected() const { return socket_.load() >= 0; }
+      void connect(int socket);
+      const std::string& getShmName() const { return stream_.name(); }
+
+      void run() override;
+
+    private:
+      void disconnect();
+      void applyEvents(uint64_t end_time);
+      void renderBlock();
+      bool waitForClient(int timeout_ms);
+
+      int index_;
+      Config config_;
+      File preset_;
+      std::unique_ptr<HeadlessSynth> synth_;
+      SharedStream stream_;
+      std::atomic<int> socket_;
+      AudioSampleBuffer audio_buffer_;
+      MidiBuffer midi_buffer_;
+      std::vector<vital::Value*> parameters_;
+      uint64_t position_;
+
+      JUCE_DECLARE_NON_COPYABLE(StreamInstance)
+  };
+
+  class Server {
+    public:
+      Server(const std::string& socket_path, const Config& config, const File& preset);
+      ~Server();
+
+      bool start();
+      void stop();
+      void run(const std::atomic<bool>& running);
+
+    private:
+      void acceptClient();
+
+      std::string socket_path_;
+      Config config_;
+      int listen_socket_;
+      std::vector<std::unique_ptr<StreamInstance>> instances_;
+
+      JUCE_DECLARE_NON_COPYABLE(Server)
+  };
+
+  class Client {
+    public:
+      Client() : socket_(-1), instance_(0) { }
+      ~Client() { disconnect(); }
+
+      bool connect(const std::string& socket_path);
+      void disconnect();
+
+      bool sendMidi(uint64_t sample_time, const MidiMessage& message);
+      bool sendParameter(uint64_t sample_time, int index, float value);
+      bool readBlock(float* interleaved_destination, int timeout_ms);
+
+      int getBlockSize() { return stream_.header()->block_size; }
+      int getInstance() const { return instance_; }
+
+    private:
+      bool sendEvent(const Event& event);
+
+      SharedStream stream_;
+      int socket_;
+      int instance_;
+
+      JUCE_DECLARE_NON_COPYABLE(Client)
+  };
+
+  // Runs a server with two instances against local clients and checks the audio that comes back.
+  bool runLoopbackTest(const File& preset);
+} // namespace streaming
+
+#endif
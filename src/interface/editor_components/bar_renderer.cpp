@@ -75,7 +75,7 @@ void BarRenderer::init(OpenGlWrapper& open_gl) {
   open_gl.context.extensions.glBindBuffer(GL_ARRAY_BUFFER, bar_buffer_);
 
   GLsizeiptr vert_size = static_cast<GLsizeiptr>(kFloatsPerBar * total_points_ * sizeof(float));
-  open_gl.context.extensions.glBufferData(GL_ARRAY_BUFFER, vert_size, bar_data_.get(), GL_STATIC_DRAW);
+  open_gl.context.extensions.glBufferData(GL_ARRAY_BUFFER, vert_size, bar_data_.get(), GL_DYNAMIC_DRAW);
 
   open_gl.context.extensions.glGenBuffers(1, &bar_corner_buffer_);
   open_gl.context.extensions.glBindBuffer(GL_ARRAY_BUFFER, bar_corner_buffer_);
@@ -94,7 +94,7 @@ void BarRenderer::init(OpenGlWrapper& open_gl) {
   else
     shader_ = open_gl.shaders->getShaderProgram(Shaders::kBarHorizontalVertex, Shaders::kBarFragment);
 
-  shader_->use();
+  open_gl.useProgram(shader_);
   color_uniform_ = getUniform(open_gl, *shader_, "color");
   dimensions_uniform_ = getUniform(open_gl, *shader_, "dimensions");
   offset_uniform_ = getUniform(open_gl, *shader_, "offset");
@@ -124,11 +124,11 @@ void BarRenderer::drawBars(OpenGlWrapper& open_gl) {
     open_gl.context.extensions.glBindBuffer(GL_ARRAY_BUFFER, bar_buffer_);
 
     GLsizeiptr vert_size = static_cast<GLsizeiptr>(kFloatsPerBar * total_points_ * sizeof(float));
-    open_gl.context.extensions.glBufferData(GL_ARRAY_BUFFER, vert_size, bar_data_.get(), GL_STATIC_DRAW);
+    open_gl.streamBuffer(GL_ARRAY_BUFFER, vert_size, bar_data_.get());
     open_gl.context.extensions.glBindBuffer(GL_ARRAY_BUFFER, 0);
   }
 
-  shader_->use();
+  open_gl.useProgram(shader_);
 
   color_uniform_->set(color_.getFloatRed(), color_.getFloatGreen(),
                       color_.getFloatBlue(), color_.getFloatAlpha());
@@ -149,7 +149,7 @@ void BarRenderer::drawBars(OpenGlWrapper& open_gl) {
                                                   GL_FALSE, kCornerFloatsPerVertex * sizeof(float), nullptr);
   open_gl.context.extensions.glEnableVertexAttribArray(corner_->attributeID);
 
-  glDrawElements(GL_TRIANGLES, kTriangleIndicesPerBar * total_points_, GL_UNSIGNED_INT, nullptr);
+  open_gl.drawElements(GL_TRIANGLES, kTriangleIndicesPerBar * total_points_);
 
   open_gl.context.extensions.glDisableVertexAttribArray(position_->attributeID);
   open_gl.context.extensions.glBindBuffer(GL_ARRAY_BUFFER, 0);
@@ -125,7 +125,7 @@ void EqualizerResponse::init(OpenGlWrapper& open_gl) {
 
   const GLchar* varyings[] = { "response_out" };
   shader_ = open_gl.shaders->getShaderProgram(Shaders::kEqFilterResponseVertex, Shaders::kColorFragment, varyings);
-  shader_->use();
+  open_gl.useProgram(shader_);
 
   position_attribute_ = getAttribute(open_gl, *shader_, "position");
   midi_cutoff_uniform_ = getUniform(open_gl, *shader_, "midi_cutoff");
@@ -156,7 +156,7 @@ void EqualizerResponse::drawResponse(OpenGlWrapper& open_gl, int index) {
   float fill_fade = findValue(Skin::kWidgetFillFade);
   setFillColors(color_fill_to.withMultipliedAlpha(1.0f - fill_fade), color_fill_to);
 
-  shader_->use();
+  open_gl.useProgram(shader_);
   open_gl.context.extensions.glBindVertexArray(vertex_array_object_);
   open_gl.context.extensions.glBindBuffer(GL_ARRAY_BUFFER, line_buffer_);
   open_gl.context.extensions.glVertexAttribPointer(position_attribute_->attributeID, 1, GL_FLOAT, GL_FALSE,
@@ -182,7 +182,7 @@ void EqualizerResponse::drawResponse(OpenGlWrapper& open_gl, int index) {
                             high_filter_.getHighAmount()[index]);
 
   open_gl.context.extensions.glBeginTransformFeedback(GL_POINTS);
-  glDrawArrays(GL_POINTS, 0, kResolution);
+  open_gl.drawArrays(GL_POINTS, kResolution);
   open_gl.context.extensions.glEndTransformFeedback();
 
   void* buffer = open_gl.context.extensions.glMapBufferRange(GL_TRANSFORM_FEEDBACK_BUFFER, 0,
@@ -200,7 +200,7 @@ void FilterResponse::init(OpenGlWrapper& open_gl) {
     OpenGLShaderProgram* shader = open_gl.shaders->getShaderProgram(vertex_shader, Shaders::kColorFragment, varyings);
     shaders_[i].shader = shader;
 
-    shader->use();
+    open_gl.useProgram(shader);
     shaders_[i].position = getAttribute(open_gl, *shader, "position");
 
     shaders_[i].mix = getUniform(open_gl, *shader, "mix");
@@ -413,10 +413,10 @@ bool FilterResponse::isStereoState() {
   return (~equal).anyMask();
 }
 
-void FilterResponse::loadShader(FilterShader shader, vital::constants::FilterModel model, int index) {
+void FilterResponse::loadShader(OpenGlWrapper& open_gl, FilterShader shader, vital::constants::FilterModel model, int index) {
   if (model == vital::constants::kAnalog) {
     analog_filter_.setupFilter(filter_state_);
-    shaders_[shader].shader->use();
+    open_gl.useProgram(shaders_[shader].shader);
     float resonance = vital::utils::clamp(analog_filter_.getResonance()[index], 0.0f, 2.0f);
     shaders_[shader].midi_cutoff->set(filter_state_.midi_cutoff[index]);
     shaders_[shader].resonance->set(resonance);
@@ -431,7 +431,7 @@ void FilterResponse::loadShader(FilterShader shader, vital::constants::FilterMod
   }
   else if (model == vital::constants::kComb) {
     comb_filter_.setupFilter(filter_state_);
-    shaders_[shader].shader->use();
+    open_gl.useProgram(shaders_[shader].shader);
     float resonance = vital::utils::clamp(comb_filter_.getResonance()[index], -0.99f, 0.99f);
     shaders_[shader].midi_cutoff->set(filter_state_.midi_cutoff[index]);
     shaders_[shader].resonance->set(resonance);
@@ -444,7 +444,7 @@ void FilterResponse::loadShader(FilterShader shader, vital::constants::FilterMod
   }
   else if (model == vital::constants::kDigital) {
     digital_filter_.setupFilter(filter_state_);
-    shaders_[shader].shader->use();
+    open_gl.useProgram(shaders_[shader].shader);
     float resonance = vital::utils::clamp(digital_filter_.getResonance()[index], 0.0f, 2.0f);
     shaders_[shader].midi_cutoff->set(digital_filter_.getMidiCutoff()[index]);
     shaders_[shader].resonance->set(resonance);
@@ -459,7 +459,7 @@ void FilterResponse::loadShader(FilterShader shader, vital::constants::FilterMod
   }
   else if (model == vital::constants::kDiode) {
     diode_filter_.setupFilter(filter_state_);
-    shaders_[shader].shader->use();
+    open_gl.useProgram(shaders_[shader].shader);
     shaders_[shader].midi_cutoff->set(filter_state_.midi_cutoff[index]);
     shaders_[shader].resonance->set(diode_filter_.getResonance()[index]);
     shaders_[shader].drive->set(diode_filter_.getDrive()[index]);
@@ -468,7 +468,7 @@ void FilterResponse::loadShader(FilterShader shader, vital::constants::FilterMod
   }
   else if (model == vital::constants::kDirty) {
     dirty_filter_.setupFilter(filter_state_);
-    shaders_[shader].shader->use();
+    open_gl.useProgram(shaders_[shader].shader);
     float resonance = vital::utils::clamp(dirty_filter_.getResonance()[index], 0.0f, 2.0f);
     shaders_[shader].midi_cutoff->set(filter_state_.midi_cutoff[index]);
     shaders_[shader].resonance->set(resonance);
@@ -482,7 +482,7 @@ void FilterResponse::loadShader(FilterShader shader, vital::constants::FilterMod
     shaders_[shader].stages[4]->set(dirty_filter_.getHighAmount24(filter_state_.style)[index]);
   }
   else if (model == vital::constants::kFormant) {
-    shaders_[shader].shader->use();
+    open_gl.useProgram(shaders_[shader].shader);
 
     vital::DigitalSvf* formant0 = formant_filter_.getFormant(0);
     vital::DigitalSvf* formant1 = formant_filter_.getFormant(1);
@@ -517,7 +517,7 @@ void FilterResponse::loadShader(FilterShader shader, vital::constants::FilterMod
   }
   else if (model == vital::constants::kLadder) {
     ladder_filter_.setupFilter(filter_state_);
-    shaders_[shader].shader->use();
+    open_gl.useProgram(shaders_[shader].shader);
     shaders_[shader].midi_cutoff->set(filter_state_.midi_cutoff[index]);
     shaders_[shader].resonance->set(ladder_filter_.getResonance()[index]);
     shaders_[shader].drive->set(ladder_filter_.getDrive()[index]);
@@ -527,7 +527,7 @@ void FilterResponse::loadShader(FilterShader shader, vital::constants::FilterMod
   }
   else if (model == vital::constants::kPhase) {
     phaser_filter_.setupFilter(filter_state_);
-    shaders_[shader].shader->use();
+    open_gl.useProgram(shaders_[shader].shader);
     shaders_[shader].midi_cutoff->set(filter_state_.midi_cutoff[index]);
     shaders_[shader].resonance->set(phaser_filter_.getResonance()[index]);
     shaders_[shader].db24->set(filter_state_.style != vital::SynthFilter::k12Db ? 1.0f : 0.0f);
@@ -582,7 +582,7 @@ void FilterResponse::drawFilterResponse(OpenGlWrapper& open_gl) {
   if (active_) {
     if (new_response) {
       bind(shader, open_gl.context);
-      loadShader(shader, model, 1);
+      loadShader(open_gl, shader, model, 1);
       renderLineResponse(open_gl);
     }
 
@@ -601,7 +601,7 @@ void FilterResponse::drawFilterResponse(OpenGlWrapper& open_gl) {
 
   if (new_response) {
     bind(shader, open_gl.context);
-    loadShader(shader, model, 0);
+    loadShader(open_gl, shader, model, 0);
     renderLineResponse(open_gl);
   }
 
@@ -638,7 +638,7 @@ void FilterResponse::renderLineResponse(OpenGlWrapper& open_gl) {
   }
 
   glBeginTransformFeedback(GL_POINTS);
-  glDrawArrays(GL_POINTS, 0, kResolution);
+  open_gl.drawArrays(GL_POINTS, kResolution);
   glEndTransformFeedback();
 
   std::vector<float> response_data(kResolution * 4);
@@ -114,7 +114,7 @@ class FilterResponse : public OpenGlLineRenderer {
 
     bool setupFilterState(vital::constants::FilterModel model);
     bool isStereoState();
-    void loadShader(FilterShader shader, vital::constants::FilterModel model, int index);
+    void loadShader(OpenGlWrapper& open_gl, FilterShader shader, vital::constants::FilterModel model, int index);
     void bind(FilterShader shader, OpenGLContext& open_gl_context);
     void unbind(FilterShader shader, OpenGLContext& open_gl_context);
     void renderLineResponse(OpenGlWrapper& open_gl);
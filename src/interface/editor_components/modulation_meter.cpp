@@ -147,7 +147,8 @@ void ModulationMeter::setAmountQuadVertices(OpenGlQuad& quad) {
   }
 }
 
-void ModulationMeter::updateDrawing(bool use_poly) {
+bool ModulationMeter::updateDrawing(bool use_poly) {
+  vital::poly_float last_mod_percent = mod_percent_;
   if (mono_total_) {
     current_value_ = mono_total_->trigger_value;
     if (poly_total_ && use_poly)
@@ -180,6 +181,7 @@ void ModulationMeter::updateDrawing(bool use_poly) {
   quads_->setShaderValue(index_, max_percent[0], 1);
   quads_->setShaderValue(index_, min_percent[1], 2);
   quads_->setShaderValue(index_, max_percent[1], 3);
+  return vital::poly_float::notEqual(last_mod_percent, mod_percent_).anyMask();
 }
 
 void ModulationMeter::setModulationAmountQuad(OpenGlQuad& quad, float amount, bool bipolar) {
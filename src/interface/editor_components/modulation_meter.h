@@ -35,7 +35,7 @@ class ModulationMeter : public Component {
     void resized() override;
     void setActive(bool active);
 
-    void updateDrawing(bool use_poly);
+    bool updateDrawing(bool use_poly);
     void setModulationAmountQuad(OpenGlQuad& quad, float amount, bool bipolar);
     void setAmountQuadVertices(OpenGlQuad& quad);
 
@@ -20,6 +20,22 @@
 #include "common.h"
 #include "shaders.h"
 
+namespace {
+  template <class PixelType>
+  void flipArea(HeapBlock<PixelARGB>& data, const Image::BitmapData& source, Rectangle<int> area) {
+    int width = area.getWidth();
+    int height = area.getHeight();
+    data.malloc(width * height);
+
+    for (int y = 0; y < height; ++y) {
+      const PixelType* src = (const PixelType*)source.getPixelPointer(area.getX(), area.getY() + y);
+      PixelARGB* dest = data + width * (height - 1 - y);
+      for (int x = 0; x < width; ++x)
+        dest[x].set(src[x]);
+    }
+  }
+} // namespace
+
 OpenGlBackground::OpenGlBackground() : image_shader_(nullptr), vertices_() {
   new_background_ = false;
   vertex_buffer_ = 0;
@@ -56,7 +72,7 @@ void OpenGlBackground::init(OpenGlWrapper& open_gl) {
   open_gl.context.extensions.glBufferData(GL_ELEMENT_ARRAY_BUFFER, tri_size, triangles, GL_STATIC_DRAW);
 
   image_shader_ = open_gl.shaders->getShaderProgram(Shaders::kImageVertex, Shaders::kImageFragment);
-  image_shader_->use();
+  open_gl.useProgram(image_shader_);
   position_ = OpenGlComponent::getAttribute(open_gl, *image_shader_, "position");
   texture_coordinates_ = OpenGlComponent::getAttribute(open_gl, *image_shader_, "tex_coord_in");
   texture_uniform_ = OpenGlComponent::getUniform(open_gl, *image_shader_, "image");
@@ -107,6 +123,7 @@ void OpenGlBackground::render(OpenGlWrapper& open_gl) {
   mutex_.lock();
   if ((new_background_ || background_.getWidth() == 0) && background_image_.getWidth() > 0) {
     new_background_ = false;
+    dirty_area_ = Rectangle<int>();
     background_.loadImage(background_image_);
 
     float width_ratio = (1.0f * background_.getWidth()) / background_image_.getWidth();
@@ -121,11 +138,13 @@ void OpenGlBackground::render(OpenGlWrapper& open_gl) {
     GLsizeiptr vert_size = static_cast<GLsizeiptr>(static_cast<size_t>(16 * sizeof(float)));
     open_gl.context.extensions.glBufferData(GL_ARRAY_BUFFER, vert_size, vertices_, GL_STATIC_DRAW);
   }
+  else if (!dirty_area_.isEmpty())
+    loadDirtyArea();
 
   glDisable(GL_BLEND);
   glDisable(GL_SCISSOR_TEST);
 
-  image_shader_->use();
+  open_gl.useProgram(image_shader_);
   bind(open_gl.context);
   open_gl.context.extensions.glActiveTexture(GL_TEXTURE0);
 
@@ -133,7 +152,7 @@ void OpenGlBackground::render(OpenGlWrapper& open_gl) {
     texture_uniform_->set(0);
 
   enableAttributes(open_gl.context);
-  glDrawElements(GL_TRIANGLES, 6, GL_UNSIGNED_INT, nullptr);
+  open_gl.drawElements(GL_TRIANGLES, 6);
   disableAttributes(open_gl.context);
   background_.unbind();
 
@@ -143,7 +162,38 @@ void OpenGlBackground::render(OpenGlWrapper& open_gl) {
   mutex_.unlock();
 }
 
+void OpenGlBackground::loadDirtyArea() {
+  Rectangle<int> area = dirty_area_.getIntersection(background_image_.getBounds());
+  dirty_area_ = Rectangle<int>();
+  if (area.isEmpty())
+    return;
+
+  HeapBlock<PixelARGB> data;
+  Image::BitmapData source(background_image_, Image::BitmapData::readOnly);
+  if (source.pixelFormat == Image::RGB)
+    flipArea<PixelRGB>(data, source, area);
+  else if (source.pixelFormat == Image::ARGB)
+    flipArea<PixelARGB>(data, source, area);
+  else
+    return;
+
+  background_.bind();
+  glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+  glTexSubImage2D(GL_TEXTURE_2D, 0, area.getX(), background_.getHeight() - area.getBottom(),
+                  area.getWidth(), area.getHeight(), GL_RGBA, GL_UNSIGNED_BYTE, data);
+  background_.unbind();
+}
+
 void OpenGlBackground::updateBackgroundImage(Image background) {
   background_image_ = background;
   new_background_ = true;
 }
+
+void OpenGlBackground::updateBackgroundImage(Image background, Rectangle<int> area) {
+  if (background != background_image_) {
+    updateBackgroundImage(background);
+    return;
+  }
+
+  dirty_area_ = dirty_area_.isEmpty() ? area : dirty_area_.getUnion(area);
+}
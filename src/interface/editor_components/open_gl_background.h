@@ -27,6 +27,7 @@ class OpenGlBackground {
     virtual ~OpenGlBackground();
 
     void updateBackgroundImage(Image background);
+    void updateBackgroundImage(Image background, Rectangle<int> area);
     virtual void init(OpenGlWrapper& open_gl);
     virtual void render(OpenGlWrapper& open_gl);
     virtual void destroy(OpenGlWrapper& open_gl);
@@ -42,6 +43,8 @@ class OpenGlBackground {
     void disableAttributes(OpenGLContext& open_gl_context);
 
   private:
+    void loadDirtyArea();
+
     OpenGLShaderProgram* image_shader_;
     std::unique_ptr<OpenGLShaderProgram::Uniform> texture_uniform_;
     std::unique_ptr<OpenGLShaderProgram::Attribute> position_;
@@ -53,6 +56,7 @@ class OpenGlBackground {
     OpenGLTexture background_;
     bool new_background_;
     Image background_image_;
+    Rectangle<int> dirty_area_;
 
     GLuint vertex_buffer_;
     GLuint triangle_buffer_;
@@ -52,7 +52,7 @@ void OpenGlImage::init(OpenGlWrapper& open_gl) {
 
   GLsizeiptr vert_size = static_cast<GLsizeiptr>(static_cast<size_t>(kNumPositions * sizeof(float)));
   open_gl.context.extensions.glBufferData(GL_ARRAY_BUFFER, vert_size,
-                                         position_vertices_.get(), GL_STATIC_DRAW);
+                                         position_vertices_.get(), GL_DYNAMIC_DRAW);
 
   open_gl.context.extensions.glGenBuffers(1, &triangle_buffer_);
   open_gl.context.extensions.glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, triangle_buffer_);
@@ -63,7 +63,7 @@ void OpenGlImage::init(OpenGlWrapper& open_gl) {
 
   image_shader_ = open_gl.shaders->getShaderProgram(Shaders::kImageVertex, Shaders::kTintedImageFragment);
 
-  image_shader_->use();
+  open_gl.useProgram(image_shader_);
   image_color_ = OpenGlComponent::getUniform(open_gl, *image_shader_, "color");
   image_position_ = OpenGlComponent::getAttribute(open_gl, *image_shader_, "position");
   texture_coordinates_ = OpenGlComponent::getAttribute(open_gl, *image_shader_, "tex_coord_in");
@@ -103,7 +103,7 @@ void OpenGlImage::drawImage(OpenGlWrapper& open_gl) {
 
   mutex_.lock();
   if (dirty_)
-    open_gl.context.extensions.glBufferData(GL_ARRAY_BUFFER, vert_size, position_vertices_.get(), GL_STATIC_DRAW);
+    open_gl.streamBuffer(GL_ARRAY_BUFFER, vert_size, position_vertices_.get());
   dirty_ = false;
 
   open_gl.context.extensions.glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, triangle_buffer_);
@@ -111,7 +111,7 @@ void OpenGlImage::drawImage(OpenGlWrapper& open_gl) {
   open_gl.context.extensions.glActiveTexture(GL_TEXTURE0);
   mutex_.unlock();
 
-  image_shader_->use();
+  open_gl.useProgram(image_shader_);
 
   image_color_->set(color_.getFloatRed(), color_.getFloatGreen(), color_.getFloatBlue(), color_.getFloatAlpha());
   open_gl.context.extensions.glVertexAttribPointer(image_position_->attributeID, 2, GL_FLOAT,
@@ -122,7 +122,7 @@ void OpenGlImage::drawImage(OpenGlWrapper& open_gl) {
                                                    (GLvoid*)(2 * sizeof(float)));
   open_gl.context.extensions.glEnableVertexAttribArray(texture_coordinates_->attributeID);
 
-  glDrawElements(GL_TRIANGLES, 6, GL_UNSIGNED_INT, nullptr);
+  open_gl.drawElements(GL_TRIANGLES, 6);
 
   open_gl.context.extensions.glDisableVertexAttribArray(image_position_->attributeID);
   open_gl.context.extensions.glDisableVertexAttribArray(texture_coordinates_->attributeID);
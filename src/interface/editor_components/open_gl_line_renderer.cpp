@@ -100,13 +100,13 @@ void OpenGlLineRenderer::init(OpenGlWrapper& open_gl) {
   open_gl.context.extensions.glBindBuffer(GL_ARRAY_BUFFER, line_buffer_);
 
   GLsizeiptr line_vert_size = static_cast<GLsizeiptr>(num_line_floats_ * sizeof(float));
-  open_gl.context.extensions.glBufferData(GL_ARRAY_BUFFER, line_vert_size, line_data_.get(), GL_STATIC_DRAW);
+  open_gl.context.extensions.glBufferData(GL_ARRAY_BUFFER, line_vert_size, line_data_.get(), GL_DYNAMIC_DRAW);
 
   open_gl.context.extensions.glGenBuffers(1, &fill_buffer_);
   open_gl.context.extensions.glBindBuffer(GL_ARRAY_BUFFER, fill_buffer_);
 
   GLsizeiptr fill_vert_size = static_cast<GLsizeiptr>(num_fill_floats_ * sizeof(float));
-  open_gl.context.extensions.glBufferData(GL_ARRAY_BUFFER, fill_vert_size, fill_data_.get(), GL_STATIC_DRAW);
+  open_gl.context.extensions.glBufferData(GL_ARRAY_BUFFER, fill_vert_size, fill_data_.get(), GL_DYNAMIC_DRAW);
 
   open_gl.context.extensions.glGenBuffers(1, &indices_buffer_);
   open_gl.context.extensions.glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, indices_buffer_);
@@ -115,7 +115,7 @@ void OpenGlLineRenderer::init(OpenGlWrapper& open_gl) {
   open_gl.context.extensions.glBufferData(GL_ELEMENT_ARRAY_BUFFER, line_size, indices_data_.get(), GL_STATIC_DRAW);
 
   shader_ = open_gl.shaders->getShaderProgram(Shaders::kLineVertex, Shaders::kLineFragment);
-  shader_->use();
+  open_gl.useProgram(shader_);
   color_uniform_ = getUniform(open_gl, *shader_, "color");
   scale_uniform_ = getUniform(open_gl, *shader_, "scale");
   boost_uniform_ = getUniform(open_gl, *shader_, "boost");
@@ -123,7 +123,7 @@ void OpenGlLineRenderer::init(OpenGlWrapper& open_gl) {
   position_ = getAttribute(open_gl, *shader_, "position");
 
   fill_shader_ = open_gl.shaders->getShaderProgram(Shaders::kFillVertex, Shaders::kFillFragment);
-  fill_shader_->use();
+  open_gl.useProgram(fill_shader_);
   fill_color_from_uniform_ = getUniform(open_gl, *fill_shader_, "color_from");
   fill_color_to_uniform_ = getUniform(open_gl, *fill_shader_, "color_to");
   fill_center_uniform_ = getUniform(open_gl, *fill_shader_, "center_position");
@@ -420,12 +420,12 @@ void OpenGlLineRenderer::drawLines(OpenGlWrapper& open_gl, bool left) {
     open_gl.context.extensions.glBindBuffer(GL_ARRAY_BUFFER, line_buffer_);
 
     GLsizeiptr line_vert_size = static_cast<GLsizeiptr>(num_line_floats_ * sizeof(float));
-    open_gl.context.extensions.glBufferData(GL_ARRAY_BUFFER, line_vert_size, line_data_.get(), GL_STATIC_DRAW);
+    open_gl.streamBuffer(GL_ARRAY_BUFFER, line_vert_size, line_data_.get());
 
     open_gl.context.extensions.glBindBuffer(GL_ARRAY_BUFFER, fill_buffer_);
 
     GLsizeiptr fill_vert_size = static_cast<GLsizeiptr>(num_fill_floats_ * sizeof(float));
-    open_gl.context.extensions.glBufferData(GL_ARRAY_BUFFER, fill_vert_size, fill_data_.get(), GL_STATIC_DRAW);
+    open_gl.streamBuffer(GL_ARRAY_BUFFER, fill_vert_size, fill_data_.get());
 
     open_gl.context.extensions.glBindBuffer(GL_ARRAY_BUFFER, 0);
   }
@@ -441,7 +441,7 @@ void OpenGlLineRenderer::drawLines(OpenGlWrapper& open_gl, bool left) {
 
   if (fill_) {
     open_gl.context.extensions.glBindBuffer(GL_ARRAY_BUFFER, fill_buffer_);
-    fill_shader_->use();
+    open_gl.useProgram(fill_shader_);
     fill_color_from_uniform_->set(fill_color_from_.getFloatRed(), fill_color_from_.getFloatGreen(),
                                   fill_color_from_.getFloatBlue(), fill_color_from_.getFloatAlpha());
     fill_color_to_uniform_->set(fill_color_to_.getFloatRed(), fill_color_to_.getFloatGreen(),
@@ -453,11 +453,11 @@ void OpenGlLineRenderer::drawLines(OpenGlWrapper& open_gl, bool left) {
     open_gl.context.extensions.glVertexAttribPointer(fill_position_->attributeID, kFillFloatsPerVertex, GL_FLOAT,
                                                      GL_FALSE, kFillFloatsPerVertex * sizeof(float), nullptr);
     open_gl.context.extensions.glEnableVertexAttribArray(fill_position_->attributeID);
-    glDrawElements(GL_TRIANGLE_STRIP, num_fill_vertices_, GL_UNSIGNED_INT, nullptr);
+    open_gl.drawElements(GL_TRIANGLE_STRIP, num_fill_vertices_);
   }
 
   open_gl.context.extensions.glBindBuffer(GL_ARRAY_BUFFER, line_buffer_);
-  shader_->use();
+  open_gl.useProgram(shader_);
   open_gl.context.extensions.glVertexAttribPointer(position_->attributeID, kLineFloatsPerVertex, GL_FLOAT,
                                                   GL_FALSE, kLineFloatsPerVertex * sizeof(float), nullptr);
   open_gl.context.extensions.glEnableVertexAttribArray(position_->attributeID);
@@ -467,7 +467,7 @@ void OpenGlLineRenderer::drawLines(OpenGlWrapper& open_gl, bool left) {
   boost_uniform_->set(boost_);
   line_width_uniform_->set(line_width_);
 
-  glDrawElements(GL_TRIANGLE_STRIP, num_line_vertices_, GL_UNSIGNED_INT, nullptr);
+  open_gl.drawElements(GL_TRIANGLE_STRIP, num_line_vertices_);
 
   open_gl.context.extensions.glDisableVertexAttribArray(position_->attributeID);
   open_gl.context.extensions.glBindBuffer(GL_ARRAY_BUFFER, 0);
@@ -59,7 +59,7 @@ void OpenGlMultiImage::init(OpenGlWrapper& open_gl) {
   open_gl.context.extensions.glBindBuffer(GL_ARRAY_BUFFER, vertex_buffer_);
 
   GLsizeiptr vert_size = static_cast<GLsizeiptr>(max_quads_ * kNumFloatsPerQuad * sizeof(float));
-  open_gl.context.extensions.glBufferData(GL_ARRAY_BUFFER, vert_size, data_.get(), GL_STATIC_DRAW);
+  open_gl.context.extensions.glBufferData(GL_ARRAY_BUFFER, vert_size, data_.get(), GL_DYNAMIC_DRAW);
 
   open_gl.context.extensions.glGenBuffers(1, &indices_buffer_);
   open_gl.context.extensions.glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, indices_buffer_);
@@ -68,7 +68,7 @@ void OpenGlMultiImage::init(OpenGlWrapper& open_gl) {
   open_gl.context.extensions.glBufferData(GL_ELEMENT_ARRAY_BUFFER, tri_size, indices_.get(), GL_STATIC_DRAW);
 
   image_shader_ = open_gl.shaders->getShaderProgram(Shaders::kImageVertex, Shaders::kTintedImageFragment);
-  image_shader_->use();
+  open_gl.useProgram(image_shader_);
   color_uniform_ = getUniform(open_gl, *image_shader_, "color");
   position_ = getAttribute(open_gl, *image_shader_, "position");
   texture_coordinates_ = getAttribute(open_gl, *image_shader_, "tex_coord_in");
@@ -119,11 +119,11 @@ void OpenGlMultiImage::render(OpenGlWrapper& open_gl, bool animate) {
     open_gl.context.extensions.glBindBuffer(GL_ARRAY_BUFFER, vertex_buffer_);
 
     GLsizeiptr vert_size = static_cast<GLsizeiptr>(kNumFloatsPerQuad * max_quads_ * sizeof(float));
-    open_gl.context.extensions.glBufferData(GL_ARRAY_BUFFER, vert_size, data_.get(), GL_STATIC_DRAW);
+    open_gl.streamBuffer(GL_ARRAY_BUFFER, vert_size, data_.get());
     open_gl.context.extensions.glBindBuffer(GL_ARRAY_BUFFER, 0);
   }
 
-  image_shader_->use();
+  open_gl.useProgram(image_shader_);
   color_uniform_->set(color_.getFloatRed(), color_.getFloatGreen(),
                       color_.getFloatBlue(), color_.getFloatAlpha());
 
@@ -138,7 +138,7 @@ void OpenGlMultiImage::render(OpenGlWrapper& open_gl, bool animate) {
                                                    (GLvoid*)(2 * sizeof(float)));
   open_gl.context.extensions.glEnableVertexAttribArray(texture_coordinates_->attributeID);
 
-  glDrawElements(GL_TRIANGLES, num_quads_ * kNumIndicesPerQuad, GL_UNSIGNED_INT, nullptr);
+  open_gl.drawElements(GL_TRIANGLES, num_quads_ * kNumIndicesPerQuad);
 
   open_gl.context.extensions.glDisableVertexAttribArray(position_->attributeID);
   open_gl.context.extensions.glDisableVertexAttribArray(texture_coordinates_->attributeID);
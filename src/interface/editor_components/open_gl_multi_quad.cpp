@@ -55,7 +55,7 @@ void OpenGlMultiQuad::init(OpenGlWrapper& open_gl) {
   open_gl.context.extensions.glBindBuffer(GL_ARRAY_BUFFER, vertex_buffer_);
 
   GLsizeiptr vert_size = static_cast<GLsizeiptr>(max_quads_ * kNumFloatsPerQuad * sizeof(float));
-  open_gl.context.extensions.glBufferData(GL_ARRAY_BUFFER, vert_size, data_.get(), GL_STATIC_DRAW);
+  open_gl.context.extensions.glBufferData(GL_ARRAY_BUFFER, vert_size, data_.get(), GL_DYNAMIC_DRAW);
 
   open_gl.context.extensions.glGenBuffers(1, &indices_buffer_);
   open_gl.context.extensions.glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, indices_buffer_);
@@ -64,7 +64,7 @@ void OpenGlMultiQuad::init(OpenGlWrapper& open_gl) {
   open_gl.context.extensions.glBufferData(GL_ELEMENT_ARRAY_BUFFER, bar_size, indices_.get(), GL_STATIC_DRAW);
 
   shader_ = open_gl.shaders->getShaderProgram(Shaders::kPassthroughVertex, fragment_shader_);
-  shader_->use();
+  open_gl.useProgram(shader_);
   color_uniform_ = getUniform(open_gl, *shader_, "color");
   alt_color_uniform_ = getUniform(open_gl, *shader_, "alt_color");
   mod_color_uniform_ = getUniform(open_gl, *shader_, "mod_color");
@@ -136,16 +136,18 @@ void OpenGlMultiQuad::render(OpenGlWrapper& open_gl, bool animate) {
     open_gl.context.extensions.glBindBuffer(GL_ARRAY_BUFFER, vertex_buffer_);
 
     GLsizeiptr vert_size = static_cast<GLsizeiptr>(kNumFloatsPerQuad * max_quads_ * sizeof(float));
-    open_gl.context.extensions.glBufferData(GL_ARRAY_BUFFER, vert_size, data_.get(), GL_STATIC_DRAW);
+    open_gl.streamBuffer(GL_ARRAY_BUFFER, vert_size, data_.get());
     open_gl.context.extensions.glBindBuffer(GL_ARRAY_BUFFER, 0);
   }
 
-  shader_->use();
+  open_gl.useProgram(shader_);
 
   if (alpha_mult_ > current_alpha_mult_)
     current_alpha_mult_ = std::min(alpha_mult_, current_alpha_mult_ + kAlphaInc);
   else
     current_alpha_mult_ = std::max(alpha_mult_, current_alpha_mult_ - kAlphaInc);
+  if (current_alpha_mult_ != alpha_mult_)
+    open_gl.requestNextFrame();
 
   float alpha_color_mult = 1.0f;
   if (alpha_mult_uniform_)
@@ -194,6 +196,8 @@ void OpenGlMultiQuad::render(OpenGlWrapper& open_gl, bool animate) {
 
   if (thickness_uniform_) {
     current_thickness_ = current_thickness_ + kThicknessDecay * (thickness_ - current_thickness_);
+    if (std::abs(thickness_ - current_thickness_) > kThicknessSettled)
+      open_gl.requestNextFrame();
     thickness_uniform_->set(current_thickness_);
   }
   if (rounding_uniform_)
@@ -226,7 +230,7 @@ void OpenGlMultiQuad::render(OpenGlWrapper& open_gl, bool animate) {
     open_gl.context.extensions.glEnableVertexAttribArray(shader_values_->attributeID);
   }
 
-  glDrawElements(GL_TRIANGLES, num_quads_ * kNumIndicesPerQuad, GL_UNSIGNED_INT, nullptr);
+  open_gl.drawElements(GL_TRIANGLES, num_quads_ * kNumIndicesPerQuad);
 
   open_gl.context.extensions.glDisableVertexAttribArray(position_->attributeID);
   if (dimensions_)
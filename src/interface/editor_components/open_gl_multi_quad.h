@@ -29,6 +29,7 @@ class OpenGlMultiQuad : public OpenGlComponent {
     static constexpr int kNumIndicesPerQuad = 6;
     static constexpr float kThicknessDecay = 0.4f;
     static constexpr float kAlphaInc = 0.2f;
+    static constexpr float kThicknessSettled = 0.01f;
 
     OpenGlMultiQuad(int max_quads, Shaders::FragmentShader shader = Shaders::kColorFragment);
     virtual ~OpenGlMultiQuad();
@@ -20,10 +20,11 @@
 #include "synth_constants.h"
 #include "skin.h"
 #include "shaders.h"
+#include "telemetry_tap.h"
 #include "utils.h"
 
-Oscilloscope::Oscilloscope() : OpenGlLineRenderer(kResolution) {
-  memory_ = nullptr;
+Oscilloscope::Oscilloscope() : OpenGlLineRenderer(kResolution), memory_() {
+  tap_ = nullptr;
   setFill(true);
   addRoundedCorners();
 }
@@ -33,7 +34,7 @@ Oscilloscope::~Oscilloscope() { }
 void Oscilloscope::drawWaveform(OpenGlWrapper& open_gl, int index) {
   float y_adjust = getHeight() / 2.0f;
   float width = getWidth();
-  if (memory_) {
+  if (tap_) {
     for (int i = 0; i < kResolution; ++i) {
       float t = i / (kResolution - 1.0f);
       float memory_spot = (1.0f * i * vital::kOscilloscopeMemoryResolution) / kResolution;
@@ -60,6 +61,16 @@ void Oscilloscope::render(OpenGlWrapper& open_gl, bool animate) {
     fill_fade = parent_->findValue(Skin::kWidgetFillFade);
   setFillColors(fill_color.withMultipliedAlpha(1.0f - fill_fade), fill_color);
 
+  if (tap_) {
+    tap_->readOscilloscope(memory_, vital::kOscilloscopeMemoryResolution + 1);
+
+    vital::poly_float peak = 0.0f;
+    for (int i = 0; i <= vital::kOscilloscopeMemoryResolution; ++i)
+      peak = vital::utils::max(peak, vital::poly_float::abs(memory_[i]));
+    if (vital::utils::maxFloat(peak) > kSilence)
+      open_gl.requestNextFrame();
+  }
+
   drawWaveform(open_gl, 0);
   drawWaveform(open_gl, 1);
   renderCorners(open_gl, animate);
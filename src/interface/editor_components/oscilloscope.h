@@ -20,20 +20,25 @@
 #include "memory.h"
 #include "fourier_transform.h"
 #include "open_gl_line_renderer.h"
+#include "synth_constants.h"
+
+class TelemetryTap;
 
 class Oscilloscope : public OpenGlLineRenderer {
   public:
     static constexpr int kResolution = 512;
+    static constexpr float kSilence = 0.0001f;
 
     Oscilloscope();
     virtual ~Oscilloscope();
 
     void drawWaveform(OpenGlWrapper& open_gl, int index);
     void render(OpenGlWrapper& open_gl, bool animate) override;
-    void setOscilloscopeMemory(const vital::poly_float* memory) { memory_ = memory; }
+    void setTelemetryTap(const TelemetryTap* tap) { tap_ = tap; }
 
   private:
-    const vital::poly_float* memory_;
+    const TelemetryTap* tap_;
+    vital::poly_float memory_[vital::kOscilloscopeMemoryResolution + 1];
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(Oscilloscope)
 };
@@ -68,7 +68,7 @@ class OverlayBackgroundRenderer : public OpenGlComponent {
       open_gl.context.extensions.glBufferData(GL_ELEMENT_ARRAY_BUFFER, bar_size, indices_, GL_STATIC_DRAW);
 
       shader_ = open_gl.shaders->getShaderProgram(Shaders::kPassthroughVertex, Shaders::kColorFragment);
-      shader_->use();
+      open_gl.useProgram(shader_);
       color_uniform_ = getUniform(open_gl, *shader_, "color");
       position_ = getAttribute(open_gl, *shader_, "position");
     }
@@ -109,7 +109,7 @@ class OverlayBackgroundRenderer : public OpenGlComponent {
       else
         glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
 
-      shader_->use();
+      open_gl.useProgram(shader_);
       color_uniform_->set(color_.getFloatRed(), color_.getFloatGreen(),
                           color_.getFloatBlue(), color_.getFloatAlpha());
 
@@ -120,7 +120,7 @@ class OverlayBackgroundRenderer : public OpenGlComponent {
                                                        GL_FALSE, kNumFloatsPerVertex * sizeof(float), nullptr);
       open_gl.context.extensions.glEnableVertexAttribArray(position_->attributeID);
 
-      glDrawElements(GL_TRIANGLES, kIndices, GL_UNSIGNED_INT, nullptr);
+      open_gl.drawElements(GL_TRIANGLES, kIndices);
 
       open_gl.context.extensions.glDisableVertexAttribArray(position_->attributeID);
       open_gl.context.extensions.glBindBuffer(GL_ARRAY_BUFFER, 0);
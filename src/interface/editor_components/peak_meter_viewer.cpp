@@ -69,7 +69,7 @@ void PeakMeterViewer::init(OpenGlWrapper& open_gl) {
 
   GLsizeiptr vert_size = static_cast<GLsizeiptr>(static_cast<size_t>(kNumPositions * sizeof(float)));
   open_gl.context.extensions.glBufferData(GL_ARRAY_BUFFER, vert_size,
-                                         position_vertices_, GL_STATIC_DRAW);
+                                         position_vertices_, GL_DYNAMIC_DRAW);
 
   open_gl.context.extensions.glGenBuffers(1, &triangle_buffer_);
   open_gl.context.extensions.glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, triangle_buffer_);
@@ -79,7 +79,7 @@ void PeakMeterViewer::init(OpenGlWrapper& open_gl) {
                                          position_triangles_, GL_STATIC_DRAW);
 
   shader_ = open_gl.shaders->getShaderProgram(Shaders::kGainMeterVertex, Shaders::kGainMeterFragment);
-  shader_->use();
+  open_gl.useProgram(shader_);
   position_ = getAttribute(open_gl, *shader_, "position");
   color_from_ = getUniform(open_gl, *shader_, "color_from");
   color_to_ = getUniform(open_gl, *shader_, "color_to");
@@ -130,7 +130,7 @@ void PeakMeterViewer::render(OpenGlWrapper& open_gl, bool animate) {
   glBlendFunc(GL_ONE, GL_ONE_MINUS_SRC_ALPHA);
   
   setViewPort(open_gl);
-  shader_->use();
+  open_gl.useProgram(shader_);
 
   Colour color_from, color_to;
   if (clamped_ > 0.0f) {
@@ -154,6 +154,13 @@ void PeakMeterViewer::render(OpenGlWrapper& open_gl, bool animate) {
 
   clamped_ = vital::utils::max(clamped_ - kClampDecay, 0.0f);
 
+  int channel = left_ ? 0 : 1;
+  float min_magnitude = vital::utils::dbToMagnitude(kMinDb);
+  if (clamped_ > 0.0f || peak_output_->value()[channel] > min_magnitude ||
+      (peak_memory_output_ && peak_memory_output_->value()[channel] > min_magnitude)) {
+    open_gl.requestNextFrame();
+  }
+
   float rounding = std::min(getHeight() / 3.0f, findValue(Skin::kWidgetRoundedCorner) * 0.5f);
   renderCorners(open_gl, animate, findColour(Skin::kBackground, true), rounding);
 }
@@ -161,8 +168,7 @@ void PeakMeterViewer::render(OpenGlWrapper& open_gl, bool animate) {
 void PeakMeterViewer::draw(OpenGlWrapper& open_gl) {
   open_gl.context.extensions.glBindBuffer(GL_ARRAY_BUFFER, vertex_buffer_);
   GLsizeiptr vert_size = static_cast<GLsizeiptr>(static_cast<size_t>(kNumPositions * sizeof(float)));
-  open_gl.context.extensions.glBufferData(GL_ARRAY_BUFFER, vert_size,
-                                          position_vertices_, GL_STATIC_DRAW);
+  open_gl.streamBuffer(GL_ARRAY_BUFFER, vert_size, position_vertices_);
 
   open_gl.context.extensions.glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, triangle_buffer_);
 
@@ -170,7 +176,7 @@ void PeakMeterViewer::draw(OpenGlWrapper& open_gl) {
                                                    GL_FALSE, 2 * sizeof(float), nullptr);
   open_gl.context.extensions.glEnableVertexAttribArray(position_->attributeID);
 
-  glDrawElements(GL_TRIANGLES, 6, GL_UNSIGNED_INT, nullptr);
+  open_gl.drawElements(GL_TRIANGLES, 6);
 
   open_gl.context.extensions.glBindBuffer(GL_ARRAY_BUFFER, 0);
   open_gl.context.extensions.glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
@@ -23,6 +23,7 @@
 #include "load_save.h"
 #include "full_interface.h"
 #include "save_section.h"
+#include "synth_base.h"
 #include "synth_gui_interface.h"
 #include "tuning.h"
 
@@ -58,6 +59,10 @@ namespace {
       preset_selector->signOut();
     else if (result == SynthPresetSelector::kLogIn)
       preset_selector->signIn();
+    else if (result == SynthPresetSelector::kFadePresetSwitch)
+      preset_selector->setPresetSwitchStyle(SynthBase::kFadeVoices);
+    else if (result == SynthPresetSelector::kReleasePresetSwitch)
+      preset_selector->setPresetSwitchStyle(SynthBase::kReleaseVoices);
   }
 
   String redactEmail(const String& email) {
@@ -135,14 +140,7 @@ void SynthPresetSelector::buttonClicked(Button* clicked_button) {
 void SynthPresetSelector::newPresetSelected(File preset) {
   browser_->clearExternalPreset();
   SynthGuiInterface* parent = findParentComponentOfClass<SynthGuiInterface>();
-  std::string error;
-  bool result = parent->getSynth()->loadFromFile(preset, error);
-  if (result)
-    resetText();
-  else {
-    error = "There was an error open the preset. " + error;
-    AlertWindow::showNativeDialogBox("Error opening preset", error, false);
-  }
+  parent->getSynth()->loadFromFileInBackground(preset);
 }
 
 void SynthPresetSelector::deleteRequested(File preset) {
@@ -209,6 +207,14 @@ void SynthPresetSelector::showPopupMenu(Component* anchor) {
     options.addItem(kClearTuning, "Clear Tuning: " + getTuningName());
   }
 
+  SynthGuiInterface* parent = findParentComponentOfClass<SynthGuiInterface>();
+  if (parent) {
+    int style = parent->getSynth()->getPresetSwitchStyle();
+    options.addItem(-1, "");
+    options.addItem(kFadePresetSwitch, "Switch Presets: Fade Out", style == SynthBase::kFadeVoices);
+    options.addItem(kReleasePresetSwitch, "Switch Presets: Release Notes", style == SynthBase::kReleaseVoices);
+  }
+
   if (LoadSave::getDefaultSkin().exists()) {
     options.addItem(-1, "");
     options.addItem(kClearSkin, "Load Default Skin");
@@ -244,8 +250,7 @@ void SynthPresetSelector::setModified(bool modified) {
 
 void SynthPresetSelector::loadFromFile(File& preset) {
   SynthGuiInterface* parent = findParentComponentOfClass<SynthGuiInterface>();
-  std::string error;
-  parent->getSynth()->loadFromFile(preset, error);
+  parent->getSynth()->loadFromFileInBackground(preset);
 }
 
 void SynthPresetSelector::setPresetBrowserVisibile(bool visible) {
@@ -268,6 +273,15 @@ void SynthPresetSelector::initPreset() {
   resetText();
 }
 
+void SynthPresetSelector::setPresetSwitchStyle(int style) {
+  SynthGuiInterface* parent = findParentComponentOfClass<SynthGuiInterface>();
+  if (parent == nullptr)
+    return;
+
+  parent->getSynth()->setPresetSwitchStyle(static_cast<SynthBase::PresetSwitchStyle>(style));
+  LoadSave::savePresetSwitchStyle(parent->getSynth()->getPresetSwitchStyle());
+}
+
 void SynthPresetSelector::savePreset() {
   if (save_section_) {
     save_section_->setIsPreset(true);
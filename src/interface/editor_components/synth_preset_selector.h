@@ -52,6 +52,8 @@ class SynthPresetSelector : public SynthSection,
       kClearSkin,
       kLogOut,
       kLogIn,
+      kFadePresetSwitch,
+      kReleasePresetSwitch,
       kNumMenuItems
     };
 
@@ -110,6 +112,7 @@ class SynthPresetSelector : public SynthSection,
     void clearSkin();
     void repaintWithSkin();
     void browsePresets();
+    void setPresetSwitchStyle(int style);
 
     void addListener(Listener* listener) { listeners_.push_back(listener); }
 
@@ -790,17 +790,20 @@ void Wavetable3d::warpPhase(int index) {
   float delta = 1.0f / size_;
   float* buffer = (float*)(process_wave_data_ + 1);
   float* time_domain = process_frame_.time_domain;
-  for (int i = 0; i < size_ - vital::poly_float::kSize + 1; i += vital::poly_float::kSize) {
-    vital::poly_float t = (spread + i) * delta;
+  int num_phases = size_ / vital::poly_float::kSize;
+  for (int p = 0; p < num_phases; ++p) {
+    vital::poly_float t = (spread + p * vital::poly_float::kSize) * delta;
     vital::poly_int original_phase = vital::utils::toInt(t * UINT_MAX - INT_MAX) + INT_MAX;
     vital::poly_int adjusted_phase = vital::SynthOscillator::adjustPhase(distortion_type, original_phase,
                                                                          distortion, distortion_phase_);
     
-    vital::poly_float window = vital::SynthOscillator::getPhaseWindow(distortion_type, original_phase, adjusted_phase);
-    adjusted_phase += distortion_phase_;
-    
-    vital::poly_float value = window * vital::SynthOscillator::interpolate(buffer, adjusted_phase);
+    process_windows_[p] = vital::SynthOscillator::getPhaseWindow(distortion_type, original_phase, adjusted_phase);
+    process_phases_[p] = adjusted_phase + distortion_phase_;
+  }
+
+  vital::SynthOscillator::interpolate(time_domain, buffer, process_phases_, num_phases);
+  for (int p = 0; p < num_phases; ++p) {
     for (int v = 0; v < vital::poly_float::kSize; ++v)
-      time_domain[i + v] = value[v];
+      time_domain[p * vital::poly_float::kSize + v] *= process_windows_[p][v];
   }
 }
@@ -203,6 +203,8 @@ class Wavetable3d : public OpenGlComponent, public AudioFileDropSource {
     vital::WaveFrame process_frame_;
     vital::FourierTransform transform_;
     vital::poly_float process_wave_data_[vital::SynthOscillator::kSpectralBufferSize];
+    vital::poly_int process_phases_[kResolution / vital::poly_float::kSize];
+    vital::poly_float process_windows_[kResolution / vital::poly_float::kSize];
     const vital::Wavetable::WavetableData* current_wavetable_data_;
     int wavetable_index_;
 
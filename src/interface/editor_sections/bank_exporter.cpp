@@ -15,6 +15,7 @@
  */
 
 #include "bank_exporter.h"
+#include "bank_writer.h"
 
 #include "skin.h"
 #include "fonts.h"
@@ -473,7 +474,10 @@ BankExporter::BankExporter() : SynthSection("bank_exporter") {
   setSkinOverride(Skin::kPresetBrowser);
 }
 
-BankExporter::~BankExporter() = default;
+BankExporter::~BankExporter() {
+  if (bank_writer_)
+    bank_writer_->cancel();
+}
 
 void BankExporter::paintBackground(Graphics& g) {
   paintChildrenBackgrounds(g);
@@ -574,7 +578,11 @@ void BankExporter::setButtonColors() {
 }
 
 void BankExporter::exportBank() {
-  ZipFile::Builder bank_zip;
+  if (bank_writer_) {
+    bank_writer_->cancel();
+    return;
+  }
+
   String bank_name = bank_name_box_->getText().trim();
   if (bank_name.isEmpty())
     return;
@@ -587,44 +595,74 @@ void BankExporter::exportBank() {
   if (presets.empty() && wavetables.empty() && lfos.empty() && samples.empty())
     return;
 
+  File file = File::getCurrentWorkingDirectory().getChildFile(bank_name + "." + vital::kBankExtension);
+  FileChooser export_box("Export Bank", file, String("*.") + vital::kBankExtension);
+  if (!export_box.browseForFileToSave(true))
+    return;
+
+  File destination = export_box.getResult().withFileExtension(vital::kBankExtension);
+  if (!destination.hasWriteAccess())
+    return;
+
+  bank_writer_ = std::make_unique<BankWriter>(destination, LoadSave::getBankCompressionLevel());
+
   String preset_path = bank_name + "/" + LoadSave::kPresetFolderName + "/";
   for (const std::string& path : presets) {
     File preset(path);
     if (preset.exists())
-      bank_zip.addFile(preset, 9, preset_path + getRelativePath(preset, LoadSave::kPresetFolderName));
+      bank_writer_->addFile(preset, preset_path + getRelativePath(preset, LoadSave::kPresetFolderName));
   }
 
   String wavetable_path = bank_name + "/" + LoadSave::kWavetableFolderName + "/";
   for (const std::string& path : wavetables) {
     File wavetable(path);
     if (wavetable.exists())
-      bank_zip.addFile(wavetable, 9, wavetable_path + getRelativePath(wavetable, LoadSave::kWavetableFolderName));
+      bank_writer_->addFile(wavetable, wavetable_path + getRelativePath(wavetable, LoadSave::kWavetableFolderName));
   }
 
   String lfo_path = bank_name + "/" + LoadSave::kLfoFolderName + "/";
   for (const std::string& path : lfos) {
     File lfo(path);
     if (lfo.exists())
-      bank_zip.addFile(lfo, 9, lfo_path + getRelativePath(lfo, LoadSave::kLfoFolderName));
+      bank_writer_->addFile(lfo, lfo_path + getRelativePath(lfo, LoadSave::kLfoFolderName));
   }
 
   String sample_path = bank_name + "/" + LoadSave::kSampleFolderName + "/";
   for (const std::string& path : samples) {
     File sample(path);
     if (sample.exists())
-      bank_zip.addFile(sample, 9, sample_path + getRelativePath(sample, LoadSave::kSampleFolderName));
+      bank_writer_->addFile(sample, sample_path + getRelativePath(sample, LoadSave::kSampleFolderName));
   }
 
-  File file = File::getCurrentWorkingDirectory().getChildFile(bank_name + "." + vital::kBankExtension);
-  FileChooser export_box("Export Bank", file, String("*.") + vital::kBankExtension);
-  if (export_box.browseForFileToSave(true)) {
-    File destination = export_box.getResult().withFileExtension(vital::kBankExtension);
-    if (destination.hasWriteAccess()) {
-      FileOutputStream output_stream(destination);
-      if (output_stream.openedOk())
-        bank_zip.writeToStream(output_stream, nullptr);
-    }
+  bank_writer_->start();
+  export_bank_button_->setText("Cancel Export");
+  startTimer(kProgressUpdateMs);
+}
+
+void BankExporter::timerCallback() {
+  if (bank_writer_ == nullptr) {
+    stopTimer();
+    return;
+  }
+
+  if (bank_writer_->isDone()) {
+    finishExport();
+    return;
+  }
+
+  int percent = bank_writer_->getProgress() * 100.0;
+  export_bank_button_->setText("Cancel Export " + String(percent) + "%");
+}
+
+void BankExporter::finishExport() {
+  stopTimer();
+  if (bank_writer_->getState() == BankWriter::kFailed) {
+    NativeMessageBox::showMessageBoxAsync(AlertWindow::WarningIcon, "Error Exporting Bank",
+                                          bank_writer_->getError());
   }
+
+  bank_writer_ = nullptr;
+  export_bank_button_->setText("Export Bank");
 }
 
 void BankExporter::loadFiles() {
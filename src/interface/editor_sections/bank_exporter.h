@@ -144,8 +144,8 @@ class ContentList : public SynthSection, ScrollBar::Listener {
     void moveQuadToRow(OpenGlMultiQuad* quad, int index, int row, float y_offset);
     void sort();
 
-    void selectHighlighted(int clicked_index); 
-    void highlightClick(const MouseEvent& e, int clicked_index);
+    void selectHighlighted(int clicked_index); 
+    void highlightClick(const MouseEvent& e, int clicked_index);
     void selectRange(int clicked_index);
 
     std::vector<Listener*> listeners_;
@@ -168,7 +168,9 @@ class ContentList : public SynthSection, ScrollBar::Listener {
     OpenGlQuad hover_;
 };
 
-class BankExporter : public SynthSection, public TextEditor::Listener, public KeyListener {
+class BankWriter;
+
+class BankExporter : public SynthSection, public TextEditor::Listener, public KeyListener, public Timer {
   public:
     class Listener {
       public:
@@ -177,6 +179,8 @@ class BankExporter : public SynthSection, public TextEditor::Listener, public Ke
         virtual void hideBankExporter() = 0;
     };
 
+    static constexpr int kProgressUpdateMs = 100;
+
     BankExporter();
     ~BankExporter();
 
@@ -189,12 +193,14 @@ class BankExporter : public SynthSection, public TextEditor::Listener, public Ke
 
     void buttonClicked(Button* clicked_button) override;
     void textEditorTextChanged(TextEditor& editor) override;
+    void timerCallback() override;
 
     void addListener(Listener* listener) { listeners_.push_back(listener); }
 
   private:
     void setButtonColors();
     void exportBank();
+    void finishExport();
     void loadFiles();
 
     std::unique_ptr<ContentList> preset_list_;
@@ -204,6 +210,7 @@ class BankExporter : public SynthSection, public TextEditor::Listener, public Ke
 
     std::unique_ptr<OpenGlTextEditor> bank_name_box_;
     std::unique_ptr<OpenGlToggleButton> export_bank_button_;
+    std::unique_ptr<BankWriter> bank_writer_;
 
     std::vector<Listener*> listeners_;
 
@@ -0,0 +1,156 @@
+/* Copyright 2013-2019 Matt Tytel
+ *
+ * vital is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * vital is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with vital.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "convolution_section.h"
+
+#include "convolution.h"
+#include "fonts.h"
+#include "load_save.h"
+#include "skin.h"
+#include "synth_button.h"
+#include "synth_gui_interface.h"
+#include "synth_slider.h"
+
+ConvolutionSection::ConvolutionSection(String name) : SynthSection(name), convolution_(nullptr) {
+  preset_selector_ = std::make_unique<PresetSelector>();
+  addSubSection(preset_selector_.get());
+  preset_selector_->addListener(this);
+  setPresetSelector(preset_selector_.get());
+
+  dry_wet_ = std::make_unique<SynthSlider>("convolution_dry_wet");
+  addSlider(dry_wet_.get());
+  dry_wet_->setSliderStyle(Slider::RotaryHorizontalVerticalDrag);
+
+  gain_ = std::make_unique<SynthSlider>("convolution_gain");
+  addSlider(gain_.get());
+  gain_->setSliderStyle(Slider::RotaryHorizontalVerticalDrag);
+
+  on_ = std::make_unique<SynthButton>("convolution_on");
+  addButton(on_.get());
+  setActivator(on_.get());
+  setSkinOverride(Skin::kConvolution);
+}
+
+ConvolutionSection::~ConvolutionSection() {
+  audio_file_cache_->removeListener(this);
+}
+
+void ConvolutionSection::parentHierarchyChanged() {
+  SynthGuiInterface* parent = findParentComponentOfClass<SynthGuiInterface>();
+
+  if (convolution_ == nullptr && parent) {
+    convolution_ = parent->getSynth()->getConvolution();
+    updateImpulseName();
+  }
+}
+
+void ConvolutionSection::paintBackground(Graphics& g) {
+  SynthSection::paintBackground(g);
+
+  g.setColour(findColour(Skin::kBodyText, true));
+  g.setFont(Fonts::instance()->proportional_regular().withPointHeight(size_ratio_ * 10.0f));
+
+  drawLabelForComponent(g, TRANS("GAIN"), gain_.get());
+  drawLabelForComponent(g, TRANS("MIX"), dry_wet_.get());
+}
+
+void ConvolutionSection::resized() {
+  SynthSection::resized();
+
+  preset_selector_->setColour(Skin::kIconButtonOff, findColour(Skin::kUiButton, true));
+  preset_selector_->setColour(Skin::kIconButtonOffHover, findColour(Skin::kUiButtonHover, true));
+  preset_selector_->setColour(Skin::kIconButtonOffPressed, findColour(Skin::kUiButtonPressed, true));
+
+  int title_width = getTitleWidth();
+  int widget_margin = findValue(Skin::kWidgetMargin);
+  int section_height = getKnobSectionHeight();
+  int selector_x = title_width + widget_margin;
+  int selector_height = title_width - 2 * widget_margin;
+  int selector_y = (section_height - selector_height) / 2;
+  preset_selector_->setBounds(selector_x, selector_y, getWidth() - selector_x - widget_margin, selector_height);
+
+  int knob_y2 = section_height - widget_margin;
+  placeKnobsInArea(Rectangle<int>(title_width, knob_y2, getWidth() - title_width, section_height),
+                   { gain_.get(), dry_wet_.get() });
+}
+
+void ConvolutionSection::reset() {
+  SynthSection::reset();
+  updateImpulseName();
+}
+
+void ConvolutionSection::setAllValues(vital::control_map& controls) {
+  SynthSection::setAllValues(controls);
+  updateImpulseName();
+}
+
+void ConvolutionSection::loadFile(const File& file) {
+  preset_selector_->setText(file.getFileNameWithoutExtension());
+  if (convolution_)
+    convolution_->setLastBrowsedFile(file.getFullPathName().toStdString());
+  audio_file_cache_->load(file, AudioFileCache::kDecoded, vital::Convolution::kMaxImpulseSamples, this);
+}
+
+File ConvolutionSection::getCurrentFile() {
+  if (convolution_ == nullptr)
+    return File();
+  return File(convolution_->getLastBrowsedFile());
+}
+
+void ConvolutionSection::audioFileDecoded(const File& file, std::shared_ptr<const AudioFileCache::Entry> entry) {
+  if (entry && convolution_ && entry->buffer.getNumChannels() > 0) {
+    const AudioSampleBuffer& buffer = entry->buffer;
+    const float* right = buffer.getNumChannels() > 1 ? buffer.getReadPointer(1) : nullptr;
+    convolution_->setImpulseResponse(buffer.getReadPointer(0), right, buffer.getNumSamples(), entry->sample_rate,
+                                     file.getFileNameWithoutExtension().toStdString());
+  }
+
+  updateImpulseName();
+}
+
+void ConvolutionSection::prevClicked() {
+  File impulse_file = LoadSave::getShiftedFile(LoadSave::kSampleFolderName, vital::kSampleExtensionsList,
+                                               LoadSave::kAdditionalSampleFoldersName, getCurrentFile(), -1);
+  if (impulse_file.exists())
+    loadFile(impulse_file);
+
+  updatePopupBrowser(this);
+}
+
+void ConvolutionSection::nextClicked() {
+  File impulse_file = LoadSave::getShiftedFile(LoadSave::kSampleFolderName, vital::kSampleExtensionsList,
+                                               LoadSave::kAdditionalSampleFoldersName, getCurrentFile(), 1);
+  if (impulse_file.exists())
+    loadFile(impulse_file);
+
+  updatePopupBrowser(this);
+}
+
+void ConvolutionSection::textMouseDown(const MouseEvent& e) {
+  static constexpr int kBrowserWidth = 450;
+  static constexpr int kBrowserHeight = 300;
+
+  Rectangle<int> bounds(preset_selector_->getRight(), preset_selector_->getY(),
+                        kBrowserWidth * size_ratio_, kBrowserHeight * size_ratio_);
+  bounds = getLocalArea(this, bounds);
+  showPopupBrowser(this, bounds, LoadSave::getSampleDirectories(), vital::kSampleExtensionsList,
+                   LoadSave::kSampleFolderName, LoadSave::kAdditionalSampleFoldersName);
+}
+
+void ConvolutionSection::updateImpulseName() {
+  if (convolution_)
+    preset_selector_->setText(convolution_->getImpulseName());
+}
@@ -0,0 +1,65 @@
+/* Copyright 2013-2019 Matt Tytel
+ *
+ * vital is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * vital is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with vital.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "JuceHeader.h"
+
+#include "synth_section.h"
+#include "audio_file_cache.h"
+#include "preset_selector.h"
+
+class SynthButton;
+class SynthSlider;
+
+namespace vital {
+  class Convolution;
+}
+
+class ConvolutionSection : public SynthSection, public PresetSelector::Listener, AudioFileCache::Listener {
+  public:
+    ConvolutionSection(String name);
+    ~ConvolutionSection();
+
+    void parentHierarchyChanged() override;
+
+    void paintBackground(Graphics& g) override;
+    void paintBackgroundShadow(Graphics& g) override { if (isActive()) paintTabShadow(g); }
+    void resized() override;
+    void reset() override;
+    void setAllValues(vital::control_map& controls) override;
+
+    void loadFile(const File& file) override;
+    File getCurrentFile() override;
+    void audioFileDecoded(const File& file, std::shared_ptr<const AudioFileCache::Entry> entry) override;
+
+    void prevClicked() override;
+    void nextClicked() override;
+    void textMouseDown(const MouseEvent& e) override;
+
+  private:
+    void updateImpulseName();
+
+    std::unique_ptr<SynthButton> on_;
+    std::unique_ptr<PresetSelector> preset_selector_;
+    std::unique_ptr<SynthSlider> dry_wet_;
+    std::unique_ptr<SynthSlider> gain_;
+
+    SharedResourcePointer<AudioFileCache> audio_file_cache_;
+    vital::Convolution* convolution_;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(ConvolutionSection)
+};
@@ -165,7 +165,7 @@ void DistortionFilterResponse::init(OpenGlWrapper& open_gl) {
                                                                   Shaders::kColorFragment, varyings);
   response_shader_.shader = shader;
 
-  shader->use();
+  open_gl.useProgram(shader);
   response_shader_.position = getAttribute(open_gl, *shader, "position");
 
   response_shader_.mix = getUniform(open_gl, *shader, "mix");
@@ -220,9 +220,9 @@ void DistortionFilterResponse::setupFilterState() {
   filter_state_.pass_blend = getOutputTotal(blend_output_, blend_slider_->getValue());
 }
 
-void DistortionFilterResponse::loadShader(int index) {
+void DistortionFilterResponse::loadShader(OpenGlWrapper& open_gl, int index) {
   filter_.setupFilter(filter_state_);
-  response_shader_.shader->use(); 
+  open_gl.useProgram(response_shader_.shader);
   float min_cutoff = cutoff_slider_->getMinimum() + 0.001;
   float cutoff = std::max(min_cutoff, filter_state_.midi_cutoff[index]);
   response_shader_.midi_cutoff->set(cutoff);
@@ -262,7 +262,7 @@ void DistortionFilterResponse::unbind(OpenGLContext& open_gl_context) {
 
 void DistortionFilterResponse::renderLineResponse(OpenGlWrapper& open_gl) {
   open_gl.context.extensions.glBeginTransformFeedback(GL_POINTS);
-  glDrawArrays(GL_POINTS, 0, kResolution);
+  open_gl.drawArrays(GL_POINTS, kResolution);
   open_gl.context.extensions.glEndTransformFeedback();
 
   void* buffer = open_gl.context.extensions.glMapBufferRange(GL_TRANSFORM_FEEDBACK_BUFFER, 0,
@@ -294,7 +294,7 @@ void DistortionFilterResponse::drawFilterResponse(OpenGlWrapper& open_gl, bool a
   setFillCenter(findValue(Skin::kWidgetFillCenter));
   if (active_) {
     bind(open_gl.context);
-    loadShader(1);
+    loadShader(open_gl, 1);
     renderLineResponse(open_gl);
 
     setFillColors(color_fill_from, color_fill_to);
@@ -312,7 +312,7 @@ void DistortionFilterResponse::drawFilterResponse(OpenGlWrapper& open_gl, bool a
   color_fill_from = color_fill_to.withMultipliedAlpha(1.0f - fill_fade);
 
   bind(open_gl.context);
-  loadShader(0);
+  loadShader(open_gl, 0);
   renderLineResponse(open_gl);
 
   setFillColors(color_fill_from, color_fill_to);
@@ -18,6 +18,7 @@
 
 #include "chorus_section.h"
 #include "compressor_section.h"
+#include "convolution_section.h"
 #include "delay_section.h"
 #include "distortion_section.h"
 #include "equalizer_section.h"
@@ -69,6 +70,9 @@ EffectsInterface::EffectsInterface(const vital::output_map& mono_modulations) :
   reverb_section_ = std::make_unique<ReverbSection>("REVERB", mono_modulations);
   container_->addSubSection(reverb_section_.get());
 
+  convolution_section_ = std::make_unique<ConvolutionSection>("CONVOLUTION");
+  container_->addSubSection(convolution_section_.get());
+
   filter_section_ = std::make_unique<FilterSection>("fx", mono_modulations);
   container_->addSubSection(filter_section_.get());
 
@@ -87,6 +91,7 @@ EffectsInterface::EffectsInterface(const vital::output_map& mono_modulations) :
   effects_list_[6] = flanger_section_.get();
   effects_list_[7] = phaser_section_.get();
   effects_list_[8] = reverb_section_.get();
+  effects_list_[9] = convolution_section_.get();
 
   scroll_bar_ = std::make_unique<OpenGlScrollBar>();
   scroll_bar_->setShrinkLeft(true);
@@ -107,6 +112,7 @@ EffectsInterface::~EffectsInterface() {
   flanger_section_ = nullptr;
   phaser_section_ = nullptr;
   reverb_section_ = nullptr;
+  convolution_section_ = nullptr;
   effect_order_ = nullptr;
 }
 
@@ -27,6 +27,7 @@
 class EffectsContainer;
 class ChorusSection;
 class CompressorSection;
+class ConvolutionSection;
 class DelaySection;
 class DistortionSection;
 class DragDropEffectOrder;
@@ -110,6 +111,7 @@ class EffectsInterface : public SynthSection, public DragDropEffectOrder::Listen
     std::unique_ptr<FlangerSection> flanger_section_;
     std::unique_ptr<PhaserSection> phaser_section_;
     std::unique_ptr<ReverbSection> reverb_section_;
+    std::unique_ptr<ConvolutionSection> convolution_section_;
     std::unique_ptr<FilterSection> filter_section_;
     std::unique_ptr<DragDropEffectOrder> effect_order_;
     std::unique_ptr<OpenGlScrollBar> scroll_bar_;
@@ -81,7 +81,7 @@ void FlangerResponse::init(OpenGlWrapper& open_gl) {
                                                                   Shaders::kColorFragment, varyings);
   response_shader_.shader = shader;
 
-  shader->use();
+  open_gl.useProgram(shader);
   response_shader_.position = getAttribute(open_gl, *shader, "position");
 
   response_shader_.mix = getUniform(open_gl, *shader, "mix");
@@ -135,9 +135,9 @@ void FlangerResponse::setupFilterState() {
   filter_state_.pass_blend = 1.0f;
 }
 
-void FlangerResponse::loadShader(int index) {
+void FlangerResponse::loadShader(OpenGlWrapper& open_gl, int index) {
   comb_filter_.setupFilter(filter_state_);
-  response_shader_.shader->use();
+  open_gl.useProgram(response_shader_.shader);
   float resonance = vital::utils::clamp(comb_filter_.getResonance()[index], -0.99f, 0.99f);
   response_shader_.midi_cutoff->set(filter_state_.midi_cutoff[index]);
   response_shader_.resonance->set(resonance);
@@ -173,7 +173,7 @@ void FlangerResponse::renderLineResponse(OpenGlWrapper& open_gl, int index) {
   static constexpr float kMaxMidi = 128.0f;
 
   open_gl.context.extensions.glBeginTransformFeedback(GL_POINTS);
-  glDrawArrays(GL_POINTS, 0, kResolution);
+  open_gl.drawArrays(GL_POINTS, kResolution);
   open_gl.context.extensions.glEndTransformFeedback();
 
   void* buffer = open_gl.context.extensions.glMapBufferRange(GL_TRANSFORM_FEEDBACK_BUFFER, 0,
@@ -207,7 +207,7 @@ void FlangerResponse::drawFilterResponse(OpenGlWrapper& open_gl, bool animate) {
 
   if (active_) {
     bind(open_gl.context);
-    loadShader(1);
+    loadShader(open_gl, 1);
     renderLineResponse(open_gl, 1);
 
     setFillColors(color_fill_from, color_fill_to);
@@ -225,7 +225,7 @@ void FlangerResponse::drawFilterResponse(OpenGlWrapper& open_gl, bool animate) {
   color_fill_from = color_fill_to.withMultipliedAlpha(1.0f - fill_fade);
 
   bind(open_gl.context);
-  loadShader(0);
+  loadShader(open_gl, 0);
   renderLineResponse(open_gl, 0);
 
   setFillColors(color_fill_from, color_fill_to);
@@ -77,7 +77,7 @@ class FlangerResponse : public OpenGlLineRenderer {
     vital::poly_float getOutputTotal(vital::Output* output, vital::poly_float default_value);
 
     void setupFilterState();
-    void loadShader(int index);
+    void loadShader(OpenGlWrapper& open_gl, int index);
     void bind(OpenGLContext& open_gl_context);
     void unbind(OpenGLContext& open_gl_context);
     void renderLineResponse(OpenGlWrapper& open_gl, int index);
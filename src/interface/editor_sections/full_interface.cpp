@@ -43,13 +43,19 @@
 #include "text_look_and_feel.h"
 #include "update_check_section.h"
 #include "voice_section.h"
+
+#include <chrono>
 #include <emscripten.h>
 FullInterface::FullInterface(SynthGuiData* synth_data) : SynthSection("full_interface"), width_(0), resized_width_(0),
                                                          last_render_scale_(0.0f), display_scale_(1.0f),
                                                          pixel_multiple_(1), setting_all_values_(false),
                                                          unsupported_(false), animate_(true),
                                                          enable_redo_background_(true), needs_download_(false),
-                                                         open_gl_(open_gl_context_) {
+                                                         open_gl_(open_gl_context_), redraw_requested_(true),
+                                                         animating_(false) {
+  peak_meter_readout_ = synth_data->synth->getStatusOutput("peak_meter");
+  num_voices_readout_ = synth_data->synth->getStatusOutput("num_voices");
+
   full_screen_section_ = nullptr;
   Skin default_skin;
   setSkinValues(default_skin, true);
@@ -239,7 +245,8 @@ FullInterface::FullInterface(SynthGuiData* synth_data) : SynthSection("full_inte
   open_gl_context_.attachTo(*this);
 }
 
-FullInterface::FullInterface() : SynthSection("EMPTY"), open_gl_(open_gl_context_) {
+FullInterface::FullInterface() : SynthSection("EMPTY"), open_gl_(open_gl_context_), redraw_requested_(true),
+                                 animating_(false), peak_meter_readout_(nullptr), num_voices_readout_(nullptr) {
   Skin default_skin;
   setSkinValues(default_skin, true);
 
@@ -282,13 +289,26 @@ void FullInterface::paintBackground(Graphics& g) {
   }
 
   paintKnobShadows(g);
-  paintChildrenBackgrounds(g);
+
+  for (auto& sub_section : sub_sections_) {
+    if (!sub_section->isVisible())
+      continue;
+
+    auto tile = background_tiles_.find(sub_section);
+    if (tile != background_tiles_.end() && tile->second.image.isValid() && !tile->second.dirty)
+      g.drawImageAt(tile->second.image, tile->second.bounds.getX(), tile->second.bounds.getY());
+    else
+      paintChildBackground(g, sub_section);
+  }
+
+  paintOpenGlChildrenBackgrounds(g);
 }
 
 void FullInterface::copySkinValues(const Skin& skin) {
   ScopedLock open_gl_lock(open_gl_critical_section_);
   skin.copyValuesToLookAndFeel(DefaultLookAndFeel::instance());
   setSkinValues(skin, true);
+  invalidateBackgroundTiles();
 }
 
 void FullInterface::reloadSkin(const Skin& skin) {
@@ -318,50 +338,85 @@ void FullInterface::loggedIn() {
 #endif
 }
 
+template<class T>
+void FullInterface::repaintTileArea(SynthSection* section, T* child) {
+  BackgroundTile& tile = background_tiles_[section];
+  if (!tile.image.isValid())
+    return;
+
+  Graphics g(tile.image);
+  Rectangle<int> bounds = section->getLocalArea(child, child->getLocalBounds());
+  g.reduceClipRegion(bounds);
+  g.setOrigin(bounds.getTopLeft());
+  child->paintBackground(g);
+  composeBackground(getLocalArea(child, child->getLocalBounds()));
+}
+
 void FullInterface::repaintChildBackground(SynthSection* child) {
-  if (!background_image_.isValid() || setting_all_values_)
-    return; 
+  if (!background_image_.isValid())
+    return;
 
-  if (child->getParentComponent() == synthesis_interface_.get()) {
-    repaintSynthesisSection();
+  SynthSection* section = getTileSection(child);
+  if (section == nullptr)
     return;
-  }
 
-  if (effects_interface_ != nullptr && effects_interface_->isParentOf(child))
-    child = effects_interface_.get();
+  BackgroundTile& tile = background_tiles_[section];
+  if (setting_all_values_) {
+    tile.dirty = true;
+    return;
+  }
 
-  background_.lock();
-  Graphics g(background_image_);
-  paintChildBackground(g, child);
-  background_.updateBackgroundImage(background_image_);
-  background_.unlock();
+  if (!tile.visible)
+    return;
+  if (tile.dirty || section == child || section == effects_interface_.get()) {
+    tile.dirty = true;
+    redoBackground();
+  }
+  else if (child->getParentComponent() == synthesis_interface_.get())
+    repaintSynthesisSection();
+  else
+    repaintTileArea(section, child);
 }
 
 void FullInterface::repaintSynthesisSection() {
   if (synthesis_interface_ == nullptr || !synthesis_interface_->isVisible() || !background_image_.isValid())
     return;
 
-  background_.lock();
-  Graphics g(background_image_);
-  int padding = findValue(Skin::kPadding);
-  g.setColour(findColour(Skin::kBackground, true));
-  g.fillRect(synthesis_interface_->getBounds().expanded(padding));
-  paintChildShadow(g, synthesis_interface_.get());
-  paintChildBackground(g, synthesis_interface_.get());
+  BackgroundTile& tile = background_tiles_[synthesis_interface_.get()];
+  if (tile.dirty || !tile.visible) {
+    tile.dirty = true;
+    redoBackground();
+    return;
+  }
 
-  background_.updateBackgroundImage(background_image_);
-  background_.unlock();
+  renderBackgroundTile(synthesis_interface_.get(), tile);
+  int padding = findValue(Skin::kPadding);
+  composeBackground(synthesis_interface_->getBounds().expanded(padding));
 }
 
 void FullInterface::repaintOpenGlBackground(OpenGlComponent* component) {
   if (!background_image_.isValid())
     return;
 
-  background_.lock();
-  Graphics g(background_image_);
-  paintOpenGlBackground(g, component);
-  background_.updateBackgroundImage(background_image_);
-  background_.unlock();
+  SynthSection* section = getTileSection(component);
+  if (section == nullptr) {
+    background_.lock();
+    Graphics g(background_image_);
+    paintOpenGlBackground(g, component);
+    background_.updateBackgroundImage(background_image_, getLocalArea(component, component->getLocalBounds()));
+    background_.unlock();
+    requestRedraw();
+    return;
+  }
+
+  BackgroundTile& tile = background_tiles_[section];
+  if (!tile.visible)
+    return;
+
+  if (tile.dirty)
+    redoBackground();
+  else
+    repaintTileArea(section, component);
 }
 
 void FullInterface::redoBackground() {
@@ -372,12 +427,105 @@ void FullInterface::redoBackground() {
 
   ScopedLock open_gl_lock(open_gl_critical_section_);
 
+  bool new_image = background_image_.getWidth() != width || background_image_.getHeight() != height;
+  if (new_image)
+    invalidateBackgroundTiles();
+
+  Rectangle<int> dirty_area;
+  bool layout_changed = updateBackgroundTiles(dirty_area);
+  if (!new_image && !layout_changed) {
+    composeBackground(dirty_area);
+    return;
+  }
+
   background_.lock();
-  background_image_ = Image(Image::RGB, width, height, true);
+  if (new_image)
+    background_image_ = Image(Image::RGB, width, height, true);
   Graphics g(background_image_);
   paintBackground(g);
   background_.updateBackgroundImage(background_image_);
   background_.unlock();
+  requestRedraw();
+}
+
+void FullInterface::invalidateBackgroundTiles() {
+  for (auto& tile : background_tiles_)
+    tile.second.dirty = true;
+}
+
+SynthSection* FullInterface::getTileSection(Component* child) {
+  while (child != nullptr && child->getParentComponent() != this)
+    child = child->getParentComponent();
+
+  auto tile = background_tiles_.find(dynamic_cast<SynthSection*>(child));
+  if (tile == background_tiles_.end())
+    return nullptr;
+  return tile->first;
+}
+
+void FullInterface::renderBackgroundTile(SynthSection* section, BackgroundTile& tile) {
+  tile.bounds = getLocalArea(section, section->getLocalBounds());
+  tile.visible = true;
+  tile.dirty = false;
+  if (tile.bounds.isEmpty()) {
+    tile.image = Image();
+    return;
+  }
+
+  if (tile.image.getWidth() != tile.bounds.getWidth() || tile.image.getHeight() != tile.bounds.getHeight())
+    tile.image = Image(Image::ARGB, tile.bounds.getWidth(), tile.bounds.getHeight(), true);
+  else
+    tile.image.clear(tile.image.getBounds());
+
+  Graphics g(tile.image);
+  section->paintBackground(g);
+}
+
+bool FullInterface::updateBackgroundTiles(Rectangle<int>& dirty_area) {
+  bool layout_changed = false;
+  for (auto tile = background_tiles_.begin(); tile != background_tiles_.end();) {
+    if (std::find(sub_sections_.begin(), sub_sections_.end(), tile->first) == sub_sections_.end()) {
+      layout_changed = layout_changed || tile->second.visible;
+      tile = background_tiles_.erase(tile);
+    }
+    else
+      ++tile;
+  }
+
+  for (auto& sub_section : sub_sections_) {
+    BackgroundTile& tile = background_tiles_[sub_section];
+    bool visible = sub_section->isVisible();
+    Rectangle<int> bounds = getLocalArea(sub_section, sub_section->getLocalBounds());
+
+    if (visible != tile.visible || (visible && bounds != tile.bounds)) {
+      layout_changed = true;
+      tile.dirty = true;
+    }
+
+    tile.visible = visible;
+    if (!visible || !tile.dirty)
+      continue;
+
+    renderBackgroundTile(sub_section, tile);
+    int margin = getComponentShadowWidth() + findValue(Skin::kBodyRounding);
+    dirty_area = dirty_area.isEmpty() ? bounds.expanded(margin) : dirty_area.getUnion(bounds.expanded(margin));
+  }
+
+  return layout_changed;
+}
+
+void FullInterface::composeBackground(Rectangle<int> area) {
+  area = area.getIntersection(background_image_.getBounds());
+  if (area.isEmpty())
+    return;
+
+  background_.lock();
+  Graphics g(background_image_);
+  g.reduceClipRegion(area);
+  paintBackground(g);
+  background_.updateBackgroundImage(background_image_, area);
+  background_.unlock();
+  requestRedraw();
 }
 
 void FullInterface::checkShouldReposition(bool resize) {
@@ -514,17 +662,18 @@ void FullInterface::resized() {
     full_screen_section_->setBounds(-total_width * relative.getX(), 0, total_width, getHeight());
   }
 
+  invalidateBackgroundTiles();
   if (getWidth() && getHeight())
     redoBackground();
 
   std::cerr << "exit FullInterface resize call." << std::endl;
 }
 
-void FullInterface::setOscilloscopeMemory(const vital::poly_float* memory) {
+void FullInterface::setTelemetryTap(const TelemetryTap* tap) {
   if (header_)
-    header_->setOscilloscopeMemory(memory);
+    header_->setTelemetryTap(tap);
   if (master_controls_interface_)
-    master_controls_interface_->setOscilloscopeMemory(memory);
+    master_controls_interface_->setTelemetryTap(tap);
 }
 
 void FullInterface::setAudioMemory(const vital::StereoMemory* memory) {
@@ -556,6 +705,7 @@ void FullInterface::animate(bool animate) {
 
   animate_ = animate;
   SynthSection::animate(false);
+  requestRedraw();
 }
 
 void FullInterface::reset() {
@@ -572,7 +722,9 @@ void FullInterface::reset() {
 
   setWavetableNames();
   setting_all_values_ = false;
-  repaintSynthesisSection();
+  if (synthesis_interface_)
+    background_tiles_[synthesis_interface_.get()].dirty = true;
+  redoBackground();
 }
 
 void FullInterface::setAllValues(vital::control_map& controls) {
@@ -629,10 +781,31 @@ void FullInterface::renderOpenGL() {
   }
 
   ScopedLock lock(open_gl_critical_section_);
+  std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+  open_gl_.startFrame();
   open_gl_.display_scale = display_scale_;
   background_.render(open_gl_);
   modulation_manager_->renderMeters(open_gl_, animate_);
   renderOpenGlComponents(open_gl_, animate_);
+
+  std::chrono::duration<double, std::milli> frame_time = std::chrono::steady_clock::now() - start;
+  open_gl_.stats.frame_ms = frame_time.count();
+  last_frame_stats_ = open_gl_.stats;
+  animating_ = open_gl_.animating;
+}
+
+bool FullInterface::needsRedraw() {
+  if (redraw_requested_.exchange(false))
+    return true;
+  if (!animate_)
+    return false;
+
+  ScopedLock lock(open_gl_critical_section_);
+  if (animating_)
+    return true;
+  if (num_voices_readout_ && num_voices_readout_->value()[0] > 0.0f)
+    return true;
+  return peak_meter_readout_ && vital::utils::maxFloat(peak_meter_readout_->value()) > kSilence;
 }
 
 void FullInterface::openGLContextClosing() {
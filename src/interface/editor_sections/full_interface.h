@@ -31,6 +31,8 @@
 #include "update_check_section.h"
 #include "wavetable_creator.h"
 
+#include <atomic>
+
 class AboutSection;
 class BankExporter;
 class BendSection;
@@ -48,6 +50,7 @@ class SaveSection;
 class SynthesisInterface;
 struct SynthGuiData;
 class SynthSlider;
+class TelemetryTap;
 class WavetableEditSection;
 class VoiceSection;
 
@@ -57,13 +60,14 @@ class FullInterface : public SynthSection, public AuthenticationSection::Listene
                       public OpenGLRenderer, DragAndDropContainer {
   public:
     static constexpr double kMinOpenGlVersion = 1.4;
+    static constexpr float kSilence = 0.0001f;
 
     FullInterface(SynthGuiData* synth_gui_data);
 
     FullInterface();
     virtual ~FullInterface();
 
-    void setOscilloscopeMemory(const vital::poly_float* memory);
+    void setTelemetryTap(const TelemetryTap* tap);
     void setAudioMemory(const vital::StereoMemory* memory);
 
     void createModulationSliders(const vital::output_map& mono_modulations,
@@ -77,6 +81,7 @@ class FullInterface : public SynthSection, public AuthenticationSection::Listene
     void repaintSynthesisSection();
     void repaintOpenGlBackground(OpenGlComponent* component);
     void redoBackground();
+    void invalidateBackgroundTiles();
     void checkShouldReposition(bool resize = true);
     void parentHierarchyChanged() override {
       SynthSection::parentHierarchyChanged();
@@ -160,8 +165,28 @@ class FullInterface : public SynthSection, public AuthenticationSection::Listene
     void toggleFilter2Zoom();
 
     juce::OpenGLContext& getGLContext() { return open_gl_context_; }
+    OpenGlFrameStats getFrameStats() {
+      ScopedLock lock(open_gl_critical_section_);
+      return last_frame_stats_;
+    }
+    void requestRedraw() { redraw_requested_ = true; }
+    bool needsRedraw();
 
   private:
+    struct BackgroundTile {
+      Image image;
+      Rectangle<int> bounds;
+      bool visible = false;
+      bool dirty = true;
+    };
+
+    SynthSection* getTileSection(Component* child);
+    template<class T>
+    void repaintTileArea(SynthSection* section, T* child);
+    void renderBackgroundTile(SynthSection* section, BackgroundTile& tile);
+    bool updateBackgroundTiles(Rectangle<int>& dirty_area);
+    void composeBackground(Rectangle<int> area);
+
     bool wavetableEditorsInitialized() {
       for (int i = 0; i < vital::kNumOscillators; ++i) {
         if (wavetable_edits_[i] == nullptr)
@@ -221,6 +246,12 @@ class FullInterface : public SynthSection, public AuthenticationSection::Listene
     OpenGlWrapper open_gl_;
     Image background_image_;
     OpenGlBackground background_;
+    OpenGlFrameStats last_frame_stats_;
+    std::atomic<bool> redraw_requested_;
+    bool animating_;
+    const vital::StatusOutput* peak_meter_readout_;
+    const vital::StatusOutput* num_voices_readout_;
+    std::map<SynthSection*, BackgroundTile> background_tiles_;
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(FullInterface)
 };
@@ -343,8 +343,8 @@ void HeaderSection::setTemporaryTab(String name) {
   repaintBackground();
 }
 
-void HeaderSection::setOscilloscopeMemory(const vital::poly_float* memory) {
-  oscilloscope_->setOscilloscopeMemory(memory);
+void HeaderSection::setTelemetryTap(const TelemetryTap* tap) {
+  oscilloscope_->setTelemetryTap(tap);
 }
 
 void HeaderSection::setAudioMemory(const vital::StereoMemory* memory) {
@@ -25,6 +25,7 @@
 class BankExporter;
 class LogoButton;
 class TabSelector;
+class TelemetryTap;
 class Oscilloscope;
 class Spectrogram;
 class PresetBrowser;
@@ -91,7 +92,7 @@ class HeaderSection : public SynthSection, public SaveSection::Listener,
         listener->showAboutSection();
     }
 
-    void setOscilloscopeMemory(const vital::poly_float* memory);
+    void setTelemetryTap(const TelemetryTap* tap);
     void setAudioMemory(const vital::StereoMemory* memory);
 
     void notifyChange();
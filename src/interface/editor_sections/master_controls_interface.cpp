@@ -561,8 +561,8 @@ class OutputDisplays : public SynthSection {
       spectrogram_->setBounds(x, spectrogram_y, width, spectrogram_height);
     }
 
-    void setOscilloscopeMemory(const vital::poly_float* memory) {
-      oscilloscope_->setOscilloscopeMemory(memory);
+    void setTelemetryTap(const TelemetryTap* tap) {
+      oscilloscope_->setTelemetryTap(tap);
     }
 
     void setAudioMemory(const vital::StereoMemory* memory) {
@@ -638,8 +638,8 @@ void MasterControlsInterface::passOscillatorSection(int index, const OscillatorS
   oscillator_advanceds_[index]->passOscillatorSection(oscillator);
 }
 
-void MasterControlsInterface::setOscilloscopeMemory(const vital::poly_float* memory) {
-  output_displays_->setOscilloscopeMemory(memory);
+void MasterControlsInterface::setTelemetryTap(const TelemetryTap* tap) {
+  output_displays_->setTelemetryTap(tap);
 }
 
 void MasterControlsInterface::setAudioMemory(const vital::StereoMemory* memory) {
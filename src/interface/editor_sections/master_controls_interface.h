@@ -28,6 +28,7 @@ class OversampleSettings;
 class VoiceSettings;
 class OutputDisplays;
 class OscillatorSection;
+class TelemetryTap;
 
 class TuningSelector : public TextSelector {
   public:
@@ -73,7 +74,7 @@ class MasterControlsInterface  : public SynthSection {
 
     void setOscillatorBounds(int index, Rectangle<int> bounds) { oscillator_advanceds_[index]->setBounds(bounds); }
     void passOscillatorSection(int index, const OscillatorSection* oscillator);
-    void setOscilloscopeMemory(const vital::poly_float* memory);
+    void setTelemetryTap(const TelemetryTap* tap);
     void setAudioMemory(const vital::StereoMemory* memory);
 
   private:
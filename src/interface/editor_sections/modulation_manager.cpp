@@ -1108,8 +1108,8 @@ void ModulationManager::renderMeters(OpenGlWrapper& open_gl, bool animate) {
     SynthSlider* slider = slider_model_lookup_[meter.first];
     bool show = meter.second->isModulated() && showingInParents(slider) && slider->isActive();
     meter.second->setActive(show);
-    if (show)
-      meter.second->updateDrawing(num_voices);
+    if (show && meter.second->updateDrawing(num_voices))
+      open_gl.requestNextFrame();
   }
 
   OpenGlComponent::setViewPort(this, open_gl);
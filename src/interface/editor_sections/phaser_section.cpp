@@ -88,7 +88,7 @@ void PhaserResponse::init(OpenGlWrapper& open_gl) {
                                                                   Shaders::kColorFragment, varyings);
   response_shader_.shader = shader;
 
-  shader->use();
+  open_gl.useProgram(shader);
   response_shader_.position = getAttribute(open_gl, *shader, "position");
 
   response_shader_.mix = getUniform(open_gl, *shader, "mix");
@@ -142,9 +142,9 @@ void PhaserResponse::setupFilterState() {
   filter_state_.pass_blend = getOutputTotal(blend_output_, blend_slider_->getValue());
 }
 
-void PhaserResponse::loadShader(int index) {
+void PhaserResponse::loadShader(OpenGlWrapper& open_gl, int index) {
   phaser_filter_.setupFilter(filter_state_);
-  response_shader_.shader->use();
+  open_gl.useProgram(response_shader_.shader);
   response_shader_.midi_cutoff->set(filter_state_.midi_cutoff[index]);
   response_shader_.resonance->set(phaser_filter_.getResonance()[index]);
   response_shader_.db24->set(filter_state_.style != vital::SynthFilter::k12Db ? 1.0f : 0.0f);
@@ -176,7 +176,7 @@ void PhaserResponse::unbind(OpenGLContext& open_gl_context) {
 
 void PhaserResponse::renderLineResponse(OpenGlWrapper& open_gl) {
   open_gl.context.extensions.glBeginTransformFeedback(GL_POINTS);
-  glDrawArrays(GL_POINTS, 0, kResolution);
+  open_gl.drawArrays(GL_POINTS, kResolution);
   open_gl.context.extensions.glEndTransformFeedback();
 
   void* buffer = open_gl.context.extensions.glMapBufferRange(GL_TRANSFORM_FEEDBACK_BUFFER, 0,
@@ -209,7 +209,7 @@ void PhaserResponse::drawFilterResponse(OpenGlWrapper& open_gl, bool animate) {
 
   if (active_) {
     bind(open_gl.context);
-    loadShader(1);
+    loadShader(open_gl, 1);
     renderLineResponse(open_gl);
 
     setFillColors(color_fill_from, color_fill_to);
@@ -227,7 +227,7 @@ void PhaserResponse::drawFilterResponse(OpenGlWrapper& open_gl, bool animate) {
   color_fill_from = color_fill_to.withMultipliedAlpha(1.0f - fill_fade);
 
   bind(open_gl.context);
-  loadShader(0);
+  loadShader(open_gl, 0);
   renderLineResponse(open_gl);
 
   setFillColors(color_fill_from, color_fill_to);
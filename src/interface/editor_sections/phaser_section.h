@@ -80,7 +80,7 @@ class PhaserResponse : public OpenGlLineRenderer {
     vital::poly_float getOutputTotal(const vital::Output* output, vital::poly_float default_value);
 
     void setupFilterState();
-    void loadShader(int index);
+    void loadShader(OpenGlWrapper& open_gl, int index);
     void bind(OpenGLContext& open_gl_context);
     void unbind(OpenGLContext& open_gl_context);
     void renderLineResponse(OpenGlWrapper& open_gl);
@@ -1074,7 +1074,8 @@ PopupBrowser::PopupBrowser() : SynthSection("Popup Browser"),
                                border_(Shaders::kRoundedRectangleBorderFragment),
                                horizontal_divider_(Shaders::kColorFragment),
                                vertical_divider_(Shaders::kColorFragment),
-                               owner_(nullptr) {
+                               owner_(nullptr), favorites_only_(false), first_batch_(false),
+                               reset_scroll_(false) {
   addKeyListener(this);
   setInterceptsMouseClicks(false, true);
 
@@ -1131,7 +1132,9 @@ PopupBrowser::PopupBrowser() : SynthSection("Popup Browser"),
   setSkinOverride(Skin::kPopupBrowser);
 }
 
-PopupBrowser::~PopupBrowser() = default;
+PopupBrowser::~PopupBrowser() {
+  file_index_->removeListener(this);
+}
 
 void PopupBrowser::resized() {
   static constexpr float kBrowseWidthRatio = 0.5f;
@@ -1212,12 +1215,8 @@ void PopupBrowser::visibilityChanged() {
 }
 
 void PopupBrowser::newSelection(File selection) {
-  if (selection.exists() && selection.isDirectory()) {
-    Array<File> files;
-    selection.findChildFiles(files, File::findFiles, true, extensions_);
-    selection_list_->setSelections(files);
-    selection_list_->resetScrollPosition();
-  }
+  if (selection.exists() && selection.isDirectory())
+    requestFiles({ selection }, false, true);
   else {
     if (owner_) {
       owner_->loadFile(selection);
@@ -1227,34 +1226,44 @@ void PopupBrowser::newSelection(File selection) {
 }
 
 void PopupBrowser::allSelected() {
-  Array<File> files;
   Array<File> folders = folder_list_->getSelections();
   folders.addArray(folder_list_->getAdditionalFolders());
-  for (const File& folder : folders) {
-    if (folder.exists() && folder.isDirectory())
-      folder.findChildFiles(files, File::findFiles, true, extensions_);
-  }
-
-  selection_list_->setSelections(files);
-  selection_list_->resetScrollPosition();
+  requestFiles(std::vector<File>(folders.begin(), folders.end()), false, true);
 }
 
 void PopupBrowser::favoritesSelected() {
-  Array<File> files;
   Array<File> folders = folder_list_->getSelections();
   folders.addArray(folder_list_->getAdditionalFolders());
-  for (const File& folder : folders) {
-    if (folder.exists() && folder.isDirectory())
-      folder.findChildFiles(files, File::findFiles, true, extensions_);
-  }
-  Array<File> favorites;
-  std::set<std::string> favorite_lookup = LoadSave::getFavorites();
+  requestFiles(std::vector<File>(folders.begin(), folders.end()), true, true);
+}
+
+void PopupBrowser::requestFiles(const std::vector<File>& directories, bool favorites_only, bool reset_scroll) {
+  favorites_only_ = favorites_only;
+  if (favorites_only_)
+    favorites_filter_ = LoadSave::getFavorites();
+  first_batch_ = true;
+  reset_scroll_ = reset_scroll;
+  file_index_->request(directories, extensions_, this);
+}
+
+void PopupBrowser::filesIndexed(const Array<File>& files) {
+  if (files.isEmpty() && !first_batch_)
+    return;
+
+  if (first_batch_)
+    indexed_files_.clearQuick();
+
   for (const File& file : files) {
-    if (favorite_lookup.count(file.getFullPathName().toStdString()))
-      favorites.add(file);
+    if (!favorites_only_ || favorites_filter_.count(file.getFullPathName().toStdString()))
+      indexed_files_.add(file);
   }
-  selection_list_->setSelections(favorites);
-  selection_list_->resetScrollPosition();
+
+  selection_list_->setSelections(indexed_files_);
+  if (owner_)
+    selection_list_->setSelected(owner_->getCurrentFile());
+  if (first_batch_ && reset_scroll_)
+    selection_list_->resetScrollPosition();
+  first_batch_ = false;
 }
 
 void PopupBrowser::doubleClickedSelected(File selection) {
@@ -1329,13 +1338,10 @@ void PopupBrowser::loadPresets(std::vector<File> directories, const String& exte
       directories.emplace_back(File(path));
   }
 
-  Array<File> presets;
   selection_list_->setSelected(File());
   folder_list_->filter("");
-  if (!folder_list_->selected().exists()) {
-    LoadSave::getAllFilesOfTypeInDirectories(presets, extensions_, directories);
-    selection_list_->setSelections(presets);
-  }
+  if (!folder_list_->selected().exists())
+    requestFiles(directories, false, false);
   selection_list_->filter("");
   if (owner_)
     selection_list_->setSelected(owner_->getCurrentFile());
@@ -18,6 +18,7 @@
 
 #include "JuceHeader.h"
 #include "delete_section.h"
+#include "file_index.h"
 #include "load_save.h"
 #include "open_gl_image.h"
 #include "open_gl_image_component.h"
@@ -368,7 +369,8 @@ class PopupBrowser : public SynthSection,
                      public SelectionList::Listener,
                      public TextEditor::Listener,
                      public KeyListener,
-                     public PopupClosingArea::Listener {
+                     public PopupClosingArea::Listener,
+                     public FileIndex::Listener {
   public:
     PopupBrowser();
     ~PopupBrowser();
@@ -388,6 +390,7 @@ class PopupBrowser : public SynthSection,
     void favoritesSelected() override;
     void doubleClickedSelected(File selection) override;
     void closingAreaClicked(PopupClosingArea* closing_area, const MouseEvent& e) override;
+    void filesIndexed(const Array<File>& files) override;
                        
     bool keyPressed(const KeyPress &key, Component *origin) override;
     bool keyStateChanged(bool is_key_down, Component *origin) override;
@@ -407,6 +410,8 @@ class PopupBrowser : public SynthSection,
     void setBrowserBounds(Rectangle<int> bounds) { browser_bounds_ = bounds; resized(); }
 
   private:
+    void requestFiles(const std::vector<File>& directories, bool favorites_only, bool reset_scroll);
+
     OpenGlQuad body_;
     OpenGlQuad border_;
     OpenGlQuad horizontal_divider_;
@@ -427,5 +432,12 @@ class PopupBrowser : public SynthSection,
     String author_;
     std::set<std::string> more_author_presets_;
 
+    SharedResourcePointer<FileIndex> file_index_;
+    Array<File> indexed_files_;
+    std::set<std::string> favorites_filter_;
+    bool favorites_only_;
+    bool first_batch_;
+    bool reset_scroll_;
+
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(PopupBrowser)
 };
@@ -130,7 +130,9 @@ SampleSection::SampleSection(String name) : SynthSection(std::move(name)), sampl
   setSkinOverride(Skin::kSample);
 }
 
-SampleSection::~SampleSection() = default;
+SampleSection::~SampleSection() {
+  audio_file_cache_->removeListener(this);
+}
 
 void SampleSection::parentHierarchyChanged() {
   SynthGuiInterface* parent = findParentComponentOfClass<SynthGuiInterface>();
@@ -257,22 +259,23 @@ void SampleSection::reset() {
 }
 
 void SampleSection::loadFile(const File& file) {
-  static constexpr int kMaxFileSamples = 17640000;
   preset_selector_->setText(file.getFileNameWithoutExtension());
   sample_->setLastBrowsedFile(file.getFullPathName().toStdString());
+  audio_file_cache_->load(file, AudioFileCache::kBandLimited, kMaxFileSamples, this);
 
-  std::unique_ptr<AudioFormatReader> format_reader(sample_viewer_->formatManager().createReaderFor(file));
-
-  if (format_reader) {
-    int num_samples = (int)std::min<long long>(format_reader->lengthInSamples, kMaxFileSamples);
-    sample_buffer_.setSize(format_reader->numChannels, num_samples);
-    format_reader->read(&sample_buffer_, 0, num_samples, 0, true, true);
-    if (sample_buffer_.getNumChannels() > 1) {
-      sample_->loadSample(sample_buffer_.getReadPointer(0), sample_buffer_.getReadPointer(1),
-                          num_samples, format_reader->sampleRate);
+  audio_file_cache_->prefetch([file]() {
+    std::vector<File> neighbors;
+    for (int shift : { 1, -1 }) {
+      neighbors.push_back(LoadSave::getShiftedFile(LoadSave::kSampleFolderName, vital::kSampleExtensionsList,
+                                                   LoadSave::kAdditionalSampleFoldersName, file, shift));
     }
-    else
-      sample_->loadSample(sample_buffer_.getReadPointer(0), num_samples, format_reader->sampleRate);
+    return neighbors;
+  }, AudioFileCache::kBandLimited, kMaxFileSamples);
+}
+
+void SampleSection::audioFileDecoded(const File& file, std::shared_ptr<const AudioFileCache::Entry> entry) {
+  if (entry && sample_) {
+    sample_->setData(entry->sample_data);
     sample_->setName(file.getFileNameWithoutExtension().toStdString());
   }
 
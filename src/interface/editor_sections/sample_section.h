@@ -19,6 +19,7 @@
 #include "JuceHeader.h"
 
 #include "synth_section.h"
+#include "audio_file_cache.h"
 #include "preset_selector.h"
 #include "sample_viewer.h"
 #include "transpose_quantize.h"
@@ -27,8 +28,10 @@ class SynthSlider;
 class OpenGlShapeButton;
 
 class SampleSection : public SynthSection, public SampleViewer::Listener, public PresetSelector::Listener,
-                      TransposeQuantizeButton::Listener {
+                      TransposeQuantizeButton::Listener, AudioFileCache::Listener {
   public:
+    static constexpr int kMaxFileSamples = 17640000;
+
     class Listener {
       public:
         virtual ~Listener() { }
@@ -54,6 +57,7 @@ class SampleSection : public SynthSection, public SampleViewer::Listener, public
     void loadFile(const File& file) override;
     void sampleLoaded(const File& file) override { loadFile(file); }
     File getCurrentFile() override { return File(sample_->getLastBrowsedFile()); }
+    void audioFileDecoded(const File& file, std::shared_ptr<const AudioFileCache::Entry> entry) override;
 
     void prevClicked() override;
     void nextClicked() override;
@@ -85,7 +89,7 @@ class SampleSection : public SynthSection, public SampleViewer::Listener, public
     std::unique_ptr<OpenGlShapeButton> keytrack_;
     std::unique_ptr<OpenGlShapeButton> random_phase_;
 
-    AudioSampleBuffer sample_buffer_;
+    SharedResourcePointer<AudioFileCache> audio_file_cache_;
     vital::Sample* sample_;
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(SampleSection)
@@ -92,6 +92,31 @@ class Paths {
       return fromSvgData((const void*)BinaryData::reverb_svg, BinaryData::reverb_svgSize);
     }
 
+    static Path convolution() {
+      static constexpr int kNumTaps = 7;
+      static constexpr float kBaseline = 0.8f;
+      static constexpr float kDecay = 0.72f;
+      static const PathStrokeType tap_stroke(0.07f, PathStrokeType::JointStyle::curved,
+                                             PathStrokeType::EndCapStyle::rounded);
+
+      Path taps;
+      float height = 0.6f;
+      for (int i = 0; i < kNumTaps; ++i) {
+        float x = 0.15f + i * 0.7f / (kNumTaps - 1);
+        taps.startNewSubPath(x, kBaseline);
+        taps.lineTo(x, kBaseline - height);
+        height *= kDecay;
+      }
+      taps.startNewSubPath(0.1f, kBaseline);
+      taps.lineTo(0.9f, kBaseline);
+
+      Path path;
+      tap_stroke.createStrokedPath(path, taps);
+      path.addLineSegment(Line<float>(0.0f, 0.0f, 0.0f, 0.0f), 0.2f);
+      path.addLineSegment(Line<float>(1.0f, 1.0f, 1.0f, 1.0f), 0.2f);
+      return path;
+    }
+
     static Path prev() {
       static const PathStrokeType arrow_stroke(0.1f, PathStrokeType::JointStyle::curved,
                                                PathStrokeType::EndCapStyle::rounded);
@@ -107,10 +107,57 @@ class Shaders {
     std::map<int, std::unique_ptr<OpenGLShaderProgram>> shader_programs_;
 };
 
+struct OpenGlFrameStats {
+  OpenGlFrameStats() : draw_calls(0), program_changes(0), buffer_uploads(0), frame_ms(0.0) { }
+
+  int getNumGlCalls() const { return draw_calls + program_changes + buffer_uploads; }
+
+  int draw_calls;
+  int program_changes;
+  int buffer_uploads;
+  double frame_ms;
+};
+
 struct OpenGlWrapper {
-  OpenGlWrapper(OpenGLContext& c) : context(c), shaders(nullptr), display_scale(1.0f) { }
+  OpenGlWrapper(OpenGLContext& c) : context(c), shaders(nullptr), display_scale(1.0f), current_program(0),
+                                    animating(false) { }
+
+  void startFrame() {
+    current_program = 0;
+    animating = false;
+    stats = OpenGlFrameStats();
+  }
+
+  void requestNextFrame() { animating = true; }
+
+  void useProgram(OpenGLShaderProgram* program) {
+    if (program->getProgramID() == current_program)
+      return;
+
+    program->use();
+    current_program = program->getProgramID();
+    stats.program_changes++;
+  }
+
+  void streamBuffer(GLenum target, GLsizeiptr size, const GLvoid* data) {
+    context.extensions.glBufferSubData(target, 0, size, data);
+    stats.buffer_uploads++;
+  }
+
+  void drawElements(GLenum mode, GLsizei count) {
+    glDrawElements(mode, count, GL_UNSIGNED_INT, nullptr);
+    stats.draw_calls++;
+  }
+
+  void drawArrays(GLenum mode, GLsizei count) {
+    glDrawArrays(mode, 0, count);
+    stats.draw_calls++;
+  }
 
   OpenGLContext& context;
   Shaders* shaders;
   float display_scale;
+  GLuint current_program;
+  bool animating;
+  OpenGlFrameStats stats;
 };
\ No newline at end of file
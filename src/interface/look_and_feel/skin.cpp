@@ -47,6 +47,7 @@ namespace {
     "Flanger",
     "Phaser",
     "Reverb",
+    "Convolution",
     "Modulation Drag Drop",
     "Modulation Matrix",
     "Preset Browser",
@@ -53,6 +53,7 @@ class Skin {
       kFlanger,
       kPhaser,
       kReverb,
+      kConvolution,
       kModulationDragDrop,
       kModulationMatrix,
       kPresetBrowser,
@@ -38,6 +38,32 @@ namespace strings {
     "8x"
   };
 
+  const std::string kOversamplingQualityNames[] = {
+    "Eco",
+    "Standard",
+    "Linear Phase"
+  };
+
+  const std::string kModulatorSubRateNames[] = {
+    "Full Rate",
+    "1/2 Rate",
+    "1/4 Rate",
+    "1/8 Rate"
+  };
+
+  const std::string kSubRateInterpolationNames[] = {
+    "Linear",
+    "Cubic"
+  };
+
+  const std::string kReverbQualityNames[] = {
+    "Eco",
+    "Light",
+    "Standard",
+    "Dense",
+    "Ultra"
+  };
+
   const std::string kDelayStyleNames[] = {
     "Mono",
     "Stereo",
@@ -168,7 +194,8 @@ namespace strings {
     "filter_fx",
     "flanger",
     "phaser",
-    "reverb"
+    "reverb",
+    "convolution"
   };
 
   const std::string kSyncedFrequencyNames[] = {
@@ -280,6 +307,7 @@ namespace strings {
     "FLANGER",
     "PHASER",
     "REVERB",
+    "CONVOLUTION",
   };
 
   const std::string kDestinationMenuNames[vital::constants::kNumSourceDestinations + vital::constants::kNumEffects] = {
@@ -297,6 +325,7 @@ namespace strings {
     "Flanger",
     "Phaser",
     "Reverb",
+    "Convolution",
   };
 
   const std::string kPhaseDistortionNames[] = {
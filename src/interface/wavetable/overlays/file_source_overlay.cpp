@@ -167,16 +167,12 @@ void AudioFileViewer::setWindowValues() {
   }
 }
 
-void AudioFileViewer::audioFileLoaded(const File& file) {
-  static constexpr int kMaxFileSamples = 176400;
-  std::unique_ptr<AudioFormatReader> format_reader(format_manager_.createReaderFor(file));
-
-  if (format_reader) {
-    int num_samples = (int)std::min<long long>(format_reader->lengthInSamples, kMaxFileSamples);
-    sample_buffer_.setSize(format_reader->numChannels, num_samples);
-    format_reader->read(&sample_buffer_, 0, num_samples, 0, true, true);
-  }
+void AudioFileViewer::setSampleBuffer(const AudioSampleBuffer& buffer, int sample_rate) {
+  sample_buffer_.makeCopyOf(buffer);
+  sample_rate_ = sample_rate;
+}
 
+void AudioFileViewer::audioFileLoaded(const File& file) {
   dragging_quad_.setActive(false);
 }
 
@@ -297,7 +293,9 @@ FileSourceOverlay::FileSourceOverlay() : WavetableComponentOverlay("FILE SOURCE"
   controls_background_.addTitle("");
 }
 
-FileSourceOverlay::~FileSourceOverlay() { }
+FileSourceOverlay::~FileSourceOverlay() {
+  audio_file_cache_->removeListener(this);
+}
 
 void FileSourceOverlay::frameSelected(WavetableKeyframe* keyframe) {
   if (keyframe == nullptr)
@@ -424,10 +422,17 @@ void FileSourceOverlay::sliderDragEnded(Slider* moved_slider) {
 }
 
 void FileSourceOverlay::loadFile(const File& file) {
-  if (!file.exists() || file_source_ == nullptr)
+  if (file_source_ == nullptr)
+    return;
+
+  audio_file_cache_->load(file, AudioFileCache::kDecoded, AudioFileViewer::kMaxFileSamples, this);
+}
+
+void FileSourceOverlay::audioFileDecoded(const File& file, std::shared_ptr<const AudioFileCache::Entry> entry) {
+  if (entry == nullptr || file_source_ == nullptr)
     return;
 
-  audio_thumbnail_->audioFileLoaded(file);
+  audio_thumbnail_->setSampleBuffer(entry->buffer, entry->sample_rate);
   AudioSampleBuffer* sample_buffer = audio_thumbnail_->getSampleBuffer();
   int sample_rate = audio_thumbnail_->getSampleRate();
   file_source_->loadBuffer(sample_buffer->getReadPointer(0, 0), sample_buffer->getNumSamples(), sample_rate);
@@ -550,6 +555,9 @@ void FileSourceOverlay::loadStartingPositionText() {
 }
 
 void FileSourceOverlay::setFileSource(FileSource* file_source) {
+  if (file_source != file_source_)
+    audio_file_cache_->removeListener(this);
+
   current_frame_ = nullptr;
   file_source_ = file_source;
   audio_thumbnail_->setFileSource(file_source);
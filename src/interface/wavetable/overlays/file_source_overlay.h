@@ -18,6 +18,7 @@
 
 #include "JuceHeader.h"
 
+#include "audio_file_cache.h"
 #include "audio_file_drop_source.h"
 #include "wavetable_component_overlay.h"
 #include "file_source.h"
@@ -38,6 +39,7 @@ class AudioFileViewer : public SynthSection, public AudioFileDropSource {
     };
 
     static constexpr float kResolution = 256;
+    static constexpr int kMaxFileSamples = 176400;
 
     AudioFileViewer();
     virtual ~AudioFileViewer() { }
@@ -60,6 +62,7 @@ class AudioFileViewer : public SynthSection, public AudioFileDropSource {
     void mouseDrag(const MouseEvent& e) override;
     void mouseUp(const MouseEvent& e) override;
 
+    void setSampleBuffer(const AudioSampleBuffer& buffer, int sample_rate);
     AudioSampleBuffer* getSampleBuffer() { return &sample_buffer_; }
     int getSampleRate() const { return sample_rate_; }
 
@@ -86,7 +89,7 @@ class AudioFileViewer : public SynthSection, public AudioFileDropSource {
 };
 
 class FileSourceOverlay : public WavetableComponentOverlay, TextEditor::Listener,
-                          AudioFileDropSource::Listener, AudioFileViewer::DragListener {
+                          AudioFileDropSource::Listener, AudioFileViewer::DragListener, AudioFileCache::Listener {
   public:
     FileSourceOverlay();
     virtual ~FileSourceOverlay();
@@ -102,6 +105,7 @@ class FileSourceOverlay : public WavetableComponentOverlay, TextEditor::Listener
     void buttonClicked(Button* clicked_button) override;
 
     void audioFileLoaded(const File& file) override;
+    void audioFileDecoded(const File& file, std::shared_ptr<const AudioFileCache::Entry> entry) override;
 
     void textEditorReturnKeyPressed(TextEditor& text_editor) override;
     void textEditorFocusLost(TextEditor& text_editor) override;
@@ -130,6 +134,7 @@ class FileSourceOverlay : public WavetableComponentOverlay, TextEditor::Listener
     std::unique_ptr<TextSelector> phase_style_;
     std::unique_ptr<OpenGlToggleButton> normalize_gain_;
     std::unique_ptr<AudioFileViewer> audio_thumbnail_;
+    SharedResourcePointer<AudioFileCache> audio_file_cache_;
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(FileSourceOverlay)
 };
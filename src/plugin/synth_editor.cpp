@@ -29,7 +29,7 @@ SynthEditor::SynthEditor(SynthPlugin& synth) :
 
   Authentication::create();
   gui_->reset();
-  gui_->setOscilloscopeMemory(synth.getOscilloscopeMemory());
+  gui_->setTelemetryTap(synth.getTelemetryTap());
   gui_->setAudioMemory(synth.getAudioMemory());
   gui_->animate(LoadSave::shouldAnimateWidgets());
 
@@ -74,6 +74,11 @@ void SynthPlugin::pauseProcessing(bool pause) {
   suspendProcessing(pause);
 }
 
+void SynthPlugin::checkOversampling() {
+  SynthBase::checkOversampling();
+  setLatencySamples(engine_->getLatencySamples());
+}
+
 const String SynthPlugin::getName() const {
   return JucePlugin_Name;
 }
@@ -130,6 +135,7 @@ void SynthPlugin::prepareToPlay(double sample_rate, int buffer_size) {
   engine_->setSampleRate(sample_rate);
   engine_->updateAllModulationSwitches();
   midi_manager_->setSampleRate(sample_rate);
+  checkOversampling();
 }
 
 void SynthPlugin::releaseResources() {
@@ -143,6 +149,11 @@ void SynthPlugin::processBlock(AudioSampleBuffer& buffer, MidiBuffer& midi_messa
     return;
   }
 
+  if (!beginAudioBlock()) {
+    buffer.clear();
+    return;
+  }
+
   int total_samples = buffer.getNumSamples();
   int num_channels = getTotalNumOutputChannels();
   AudioPlayHead* play_head = getPlayHead();
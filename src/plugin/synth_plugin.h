@@ -36,6 +36,7 @@ class SynthPlugin : public SynthBase, public AudioProcessor, public ValueBridge:
     void setValueNotifyHost(const std::string& name, vital::mono_float value) override;
     const CriticalSection& getCriticalSection() override;
     void pauseProcessing(bool pause) override;
+    void checkOversampling() override;
 
     void prepareToPlay(double sample_rate, int buffer_size) override;
     void releaseResources() override;
@@ -608,7 +608,18 @@ extern "C" {
     EMSCRIPTEN_KEEPALIVE
     void vialRedraw()
     {
-        global_editor->gui_->getGLContext().triggerRepaint();
+        if (global_editor->gui_->needsRedraw())
+            global_editor->gui_->getGLContext().triggerRepaint();
+    }
+
+    EMSCRIPTEN_KEEPALIVE
+    double vialGetFrameMs() {
+        return global_editor->gui_->getFrameStats().frame_ms;
+    }
+
+    EMSCRIPTEN_KEEPALIVE
+    int vialGetGlCalls() {
+        return global_editor->gui_->getFrameStats().getNumGlCalls();
     }
 
     EMSCRIPTEN_KEEPALIVE
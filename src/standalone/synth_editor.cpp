@@ -60,7 +60,7 @@ SynthEditor::SynthEditor(bool use_gui) : SynthGuiInterface(this, use_gui) {
     setLookAndFeel(DefaultLookAndFeel::instance());
     addAndMakeVisible(gui_.get());
     gui_->reset();
-    gui_->setOscilloscopeMemory(getOscilloscopeMemory());
+    gui_->setTelemetryTap(getTelemetryTap());
     gui_->setAudioMemory(getAudioMemory());
 
     Rectangle<int> total_bounds = Desktop::getInstance().getDisplays().getTotalBounds(true);
@@ -98,9 +98,14 @@ void SynthEditor::getNextAudioBlock(const AudioSourceChannelInfo& buffer) {
   int num_samples = buffer.buffer->getNumSamples();
   int synth_samples = std::min(num_samples, vital::kMaxBufferSize);
 
-  processModulationChanges();
   MidiBuffer midi_messages;
   midi_manager_->removeNextBlockOfMessages(midi_messages, num_samples);
+  if (!beginAudioBlock()) {
+    buffer.clearActiveBufferRegion();
+    return;
+  }
+
+  processModulationChanges();
   processKeyboardEvents(midi_messages, num_samples);
 
   double sample_time = 1.0 / getSampleRate();
@@ -0,0 +1,671 @@
+/* Copyright 2013-2019 Matt Tytel
+ *
+ * vital is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * vital is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with vital.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "convolution.h"
+
+#include "fourier_transform.h"
+#include "futils.h"
+#include "synth_constants.h"
+#include "utils.h"
+
+namespace vital {
+
+  namespace {
+    constexpr int kHeadSpectrumSize = 2 * 2 * Convolution::kHeadContainers;
+    constexpr int kTailSpectrumSize = 2 * 2 * Convolution::kTailContainers;
+    constexpr int kStopThreadTimeoutMs = 1000;
+
+    // Spectra are stored as separate real and imaginary containers, bin i in lane i % 4 of container i / 4.
+    force_inline void splitSpectrum(const float* data, poly_float* spectrum, int containers) {
+      poly_float* imaginary = spectrum + containers;
+      int last = containers - 1;
+      for (int i = 0; i < last; ++i) {
+        const float* bins = data + 8 * i;
+        spectrum[i] = poly_float(bins[0], bins[2], bins[4], bins[6]);
+        imaginary[i] = poly_float(bins[1], bins[3], bins[5], bins[7]);
+      }
+
+      spectrum[last] = poly_float(data[8 * last], 0.0f, 0.0f, 0.0f);
+      imaginary[last] = poly_float(data[8 * last + 1], 0.0f, 0.0f, 0.0f);
+    }
+
+    force_inline void mergeSpectrum(float* data, const poly_float* spectrum, int containers, int size) {
+      const poly_float* imaginary = spectrum + containers;
+      int last = containers - 1;
+      for (int i = 0; i < last; ++i) {
+        float* bins = data + 8 * i;
+        for (int v = 0; v < poly_float::kSize; ++v) {
+          bins[2 * v] = spectrum[i][v];
+          bins[2 * v + 1] = imaginary[i][v];
+        }
+      }
+
+      data[size] = spectrum[last][0];
+      data[size + 1] = imaginary[last][0];
+      std::fill(data + size + 2, data + 2 * size, 0.0f);
+    }
+
+    force_inline void multiplyAdd(poly_float* dest, const poly_float* a, const poly_float* b, int containers) {
+      poly_float* dest_imaginary = dest + containers;
+      const poly_float* a_imaginary = a + containers;
+      const poly_float* b_imaginary = b + containers;
+      for (int i = 0; i < containers; ++i) {
+        dest[i] = poly_float::mulSub(poly_float::mulAdd(dest[i], a[i], b[i]), a_imaginary[i], b_imaginary[i]);
+        dest_imaginary[i] = poly_float::mulAdd(poly_float::mulAdd(dest_imaginary[i], a[i], b_imaginary[i]),
+                                               a_imaginary[i], b[i]);
+      }
+    }
+
+    force_inline float cubicSample(const std::vector<mono_float>& samples, double position) {
+      int length = static_cast<int>(samples.size());
+      int index = static_cast<int>(position);
+      float t = position - index;
+      float from = index > 0 ? samples[index - 1] : 0.0f;
+      float start = index < length ? samples[index] : 0.0f;
+      float end = index + 1 < length ? samples[index + 1] : 0.0f;
+      float to = index + 2 < length ? samples[index + 2] : 0.0f;
+
+      float slope_start = 0.5f * (end - from);
+      float slope_end = 0.5f * (to - start);
+      float delta = end - start;
+      return start + t * (slope_start + t * (3.0f * delta - 2.0f * slope_start - slope_end +
+                                             t * (slope_start + slope_end - 2.0f * delta)));
+    }
+
+    void transformPartitions(poly_float* spectra, const std::vector<mono_float>* channels, int offset,
+                             int num_partitions, int partition_size, int length, mono_float scale,
+                             FourierTransform* transform, int containers) {
+      std::unique_ptr<float[]> buffer = std::make_unique<float[]>(4 * partition_size);
+      for (int p = 0; p < num_partitions; ++p) {
+        int start = offset + p * partition_size;
+        int end = std::min(length, start + partition_size);
+        for (int channel = 0; channel < 2; ++channel) {
+          std::fill(buffer.get(), buffer.get() + 4 * partition_size, 0.0f);
+          for (int i = start; i < end; ++i)
+            buffer[i - start] = scale * channels[channel][i];
+
+          transform->transformRealForward(buffer.get());
+          splitSpectrum(buffer.get(), spectra + (2 * p + channel) * 2 * containers, containers);
+        }
+      }
+    }
+  } // namespace
+
+  Convolution::Kernel* Convolution::createKernel(const ImpulseResponse& impulse, int sample_rate,
+                                                 FourierTransform* head_transform,
+                                                 FourierTransform* tail_transform) {
+    Kernel* kernel = new Kernel();
+    kernel->sample_rate = sample_rate;
+    int source_length = static_cast<int>(impulse.left.size());
+    if (source_length == 0 || sample_rate <= 0 || impulse.sample_rate <= 0)
+      return kernel;
+
+    double ratio = impulse.sample_rate / (1.0 * sample_rate);
+    int length = utils::imin(kMaxImpulseSamples, std::ceil(source_length / ratio));
+    const std::vector<mono_float>& source_right = impulse.right.empty() ? impulse.left : impulse.right;
+
+    std::vector<mono_float> channels[2];
+    channels[0].resize(length);
+    channels[1].resize(length);
+    float left_energy = 0.0f;
+    float right_energy = 0.0f;
+    for (int i = 0; i < length; ++i) {
+      channels[0][i] = cubicSample(impulse.left, i * ratio);
+      channels[1][i] = cubicSample(source_right, i * ratio);
+      left_energy += channels[0][i] * channels[0][i];
+      right_energy += channels[1][i] * channels[1][i];
+    }
+
+    float energy = std::max(left_energy, right_energy);
+    if (energy <= 0.0f)
+      return kernel;
+
+    mono_float scale = 1.0f / sqrtf(energy);
+    kernel->length = length;
+    for (int i = 0; i < kHeadBlockSize && i < length; ++i) {
+      mono_float left = scale * channels[0][i];
+      mono_float right = scale * channels[1][i];
+      kernel->direct[i] = poly_float(left, right, left, right);
+    }
+
+    int head_length = utils::imin(length, kHeadLength) - kHeadBlockSize;
+    kernel->num_head_partitions = std::max(0, (head_length + kHeadBlockSize - 1) / kHeadBlockSize);
+    kernel->head_spectra = std::make_unique<poly_float[]>(kernel->num_head_partitions * kHeadSpectrumSize);
+    transformPartitions(kernel->head_spectra.get(), channels, kHeadBlockSize, kernel->num_head_partitions,
+                        kHeadBlockSize, length, scale, head_transform, kHeadContainers);
+
+    int tail_length = length - kHeadLength;
+    kernel->num_tail_partitions = std::max(0, (tail_length + kTailBlockSize - 1) / kTailBlockSize);
+    kernel->tail_spectra = std::make_unique<poly_float[]>(kernel->num_tail_partitions * kTailSpectrumSize);
+    transformPartitions(kernel->tail_spectra.get(), channels, kHeadLength, kernel->num_tail_partitions,
+                        kTailBlockSize, length, scale, tail_transform, kTailContainers);
+    return kernel;
+  }
+
+  Convolution::ImpulseResponse Convolution::createDefaultImpulse() {
+    ImpulseResponse impulse;
+    impulse.name = "Default";
+    impulse.sample_rate = kDefaultSampleRate;
+
+    int length = kDefaultImpulseTime * kDefaultSampleRate;
+    impulse.left.resize(length);
+    impulse.right.resize(length);
+
+    Random random(kDefaultImpulseSeed);
+    mono_float decay = powf(0.001f, 1.0f / (kDefaultImpulseT60 * kDefaultSampleRate));
+    mono_float amplitude = 1.0f;
+    for (int i = 0; i < length; ++i) {
+      impulse.left[i] = amplitude * (2.0f * random.nextFloat() - 1.0f);
+      impulse.right[i] = amplitude * (2.0f * random.nextFloat() - 1.0f);
+      amplitude *= decay;
+    }
+    return impulse;
+  }
+
+  void Convolution::TailThread::run() {
+    while (!threadShouldExit()) {
+      convolution_->updateKernel();
+      convolution_->freeRetiredKernel();
+
+      int64 submission = convolution_->tail_processed_.load();
+      if (submission < convolution_->tail_submitted_.load(std::memory_order_acquire)) {
+        convolution_->processTailBlock(submission);
+        convolution_->tail_processed_.store(submission + 1);
+      }
+      else {
+        int sample_rate = std::max(1, convolution_->target_sample_rate_.load());
+        wait(std::max(1, kTailBlockSize * 1000 / (kPollsPerTailBlock * sample_rate)));
+      }
+    }
+  }
+
+  Convolution::Convolution() : Processor(kNumInputs, 1), default_impulse_(false), impulse_version_(0),
+                               target_sample_rate_(0), built_version_(-1), built_sample_rate_(0),
+                               active_kernel_(nullptr), pending_kernel_(nullptr), retired_kernel_(nullptr),
+                               retire_after_(0), wet_(0.0f), dry_(0.0f), gain_(1.0f),
+                               head_position_(0), head_history_index_(0),
+                               tail_position_(0), tail_block_(0), tail_valid_block_(2), tail_ready_(false),
+                               tail_underruns_(0), tail_generation_(0), tail_output_(nullptr),
+                               tail_submitted_(0), tail_processed_(0),
+                               tail_history_generation_(0), tail_history_size_(1), tail_history_index_(0) {
+    head_transform_ = std::make_unique<FourierTransform>(kHeadBlockBits + 1);
+    tail_transform_ = std::make_unique<FourierTransform>(kTailBlockBits + 1);
+    build_head_transform_ = std::make_unique<FourierTransform>(kHeadBlockBits + 1);
+    build_tail_transform_ = std::make_unique<FourierTransform>(kTailBlockBits + 1);
+
+    head_history_ = std::make_unique<poly_float[]>(kMaxHeadPartitions * kHeadSpectrumSize);
+    head_buffer_ = std::make_unique<float[]>(2 * 4 * kHeadBlockSize);
+
+    for (int i = 0; i < kNumTailSlots; ++i) {
+      tail_inputs_[i] = std::make_unique<mono_float[]>(2 * kTailBlockSize);
+      tail_kernels_[i] = nullptr;
+      tail_generations_[i] = 0;
+      tail_outputs_[i] = std::make_unique<poly_float[]>(kTailBlockSize);
+      tail_output_blocks_[i] = -1;
+    }
+    tail_output_ = tail_outputs_[0].get();
+
+    tail_history_ = std::make_unique<poly_float[]>(tail_history_size_ * kTailSpectrumSize);
+    tail_previous_input_ = std::make_unique<mono_float[]>(2 * kTailBlockSize);
+    tail_current_input_ = std::make_unique<mono_float[]>(2 * kTailBlockSize);
+    tail_sum_ = std::make_unique<poly_float[]>(2 * kTailContainers);
+    tail_buffer_ = std::make_unique<float[]>(2 * 4 * kTailBlockSize);
+
+    target_sample_rate_ = getSampleRate();
+    default_impulse_ = true;
+    storeImpulse(createDefaultImpulse());
+    setBackgroundProcessing(true);
+  }
+
+  Convolution::~Convolution() {
+    if (tail_thread_)
+      tail_thread_->stopThread(kStopThreadTimeoutMs);
+
+    delete active_kernel_;
+    delete pending_kernel_.exchange(nullptr);
+    delete retired_kernel_.exchange(nullptr);
+  }
+
+  void Convolution::process(int num_samples) {
+    VITAL_ASSERT(inputMatchesBufferSize(kAudio));
+    processWithInput(input(kAudio)->source->buffer, num_samples);
+  }
+
+  void Convolution::processWithInput(const poly_float* audio_in, int num_samples) {
+    poly_float* audio_out = output()->buffer;
+    mono_float tick_increment = 1.0f / num_samples;
+
+    poly_float current_wet = wet_;
+    poly_float current_dry = dry_;
+    poly_float wet_in = utils::clamp(input(kWet)->at(0), 0.0f, 1.0f);
+    wet_ = futils::equalPowerFade(wet_in);
+    dry_ = futils::equalPowerFadeInverse(wet_in);
+    poly_float delta_wet = (wet_ - current_wet) * tick_increment;
+    poly_float delta_dry = (dry_ - current_dry) * tick_increment;
+
+    poly_float current_gain = gain_;
+    gain_ = futils::dbToMagnitude(utils::clamp(input(kGain)->at(0), kMinGain, kMaxGain));
+    poly_float delta_gain = (gain_ - current_gain) * tick_increment;
+
+    for (int i = 0; i < num_samples;) {
+      if (tail_position_ == 0)
+        startTailBlock();
+
+      Kernel* kernel = active_kernel_;
+      const poly_float* direct = kernel ? kernel->direct : nullptr;
+      int direct_taps = kernel ? utils::imin(kernel->length, kHeadBlockSize) : 0;
+      mono_float* tail_left = tail_inputs_[tail_block_ % kNumTailSlots].get();
+      mono_float* tail_right = tail_left + kTailBlockSize;
+
+      int chunk_end = std::min(num_samples, i + kHeadBlockSize - head_position_);
+      for (; i < chunk_end; ++i) {
+        poly_float input = audio_in[i] & constants::kFirstMask;
+        input += utils::swapVoices(input);
+
+        head_input_[kHeadBlockSize + head_position_] = input;
+        tail_left[tail_position_] = input[0];
+        tail_right[tail_position_] = input[1];
+
+        poly_float wet = head_output_[head_position_];
+        if (tail_ready_)
+          wet += tail_output_[tail_position_];
+
+        const poly_float* history = head_input_ + kHeadBlockSize + head_position_;
+        for (int t = 0; t < direct_taps; ++t)
+          wet = poly_float::mulAdd(wet, direct[t], history[-t]);
+
+        audio_out[i] = current_wet * current_gain * wet + current_dry * input;
+        VITAL_ASSERT(utils::isContained(audio_out[i]));
+
+        current_wet += delta_wet;
+        current_dry += delta_dry;
+        current_gain += delta_gain;
+        head_position_++;
+        tail_position_++;
+      }
+
+      if (head_position_ == kHeadBlockSize) {
+        processHeadBlock();
+        head_position_ = 0;
+      }
+      if (tail_position_ == kTailBlockSize) {
+        submitTailBlock();
+        tail_position_ = 0;
+      }
+    }
+  }
+
+  void Convolution::setSampleRate(int sample_rate) {
+    Processor::setSampleRate(sample_rate);
+    target_sample_rate_ = getSampleRate();
+    requestKernel();
+  }
+
+  void Convolution::setOversampleAmount(int oversample) {
+    Processor::setOversampleAmount(oversample);
+    target_sample_rate_ = getSampleRate();
+    requestKernel();
+  }
+
+  void Convolution::hardReset() {
+    for (int i = 0; i < 2 * kHeadBlockSize; ++i)
+      head_input_[i] = 0.0f;
+    for (int i = 0; i < kHeadBlockSize; ++i)
+      head_output_[i] = 0.0f;
+    std::fill(head_history_.get(), head_history_.get() + kMaxHeadPartitions * kHeadSpectrumSize, 0.0f);
+
+    head_position_ = 0;
+    tail_position_ = 0;
+    tail_ready_ = false;
+    tail_generation_++;
+    tail_valid_block_ = tail_block_ + 2;
+    wet_ = 0.0f;
+    dry_ = 0.0f;
+  }
+
+  int Convolution::getTailSamples() {
+    if (active_kernel_ == nullptr)
+      return 0;
+    return active_kernel_->length;
+  }
+
+  Convolution::ImpulseResponse Convolution::createImpulse(const mono_float* left, const mono_float* right,
+                                                          int length, int sample_rate, const std::string& name) {
+    ImpulseResponse impulse;
+    impulse.name = name;
+    impulse.sample_rate = sample_rate;
+    length = utils::iclamp(length, 0, kMaxImpulseSamples);
+    impulse.left.assign(left, left + length);
+    if (right)
+      impulse.right.assign(right, right + length);
+
+    // Kernels are normalized to unit energy, so peak normalizing here only keeps saved samples in range.
+    mono_float peak = 0.0f;
+    for (int i = 0; i < length; ++i) {
+      peak = std::max(peak, fabsf(impulse.left[i]));
+      if (right)
+        peak = std::max(peak, fabsf(impulse.right[i]));
+    }
+    if (peak > 0.0f) {
+      for (mono_float& sample : impulse.left)
+        sample /= peak;
+      for (mono_float& sample : impulse.right)
+        sample /= peak;
+    }
+
+    return impulse;
+  }
+
+
+  void Convolution::setImpulse(ImpulseResponse impulse) {
+    default_impulse_ = false;
+    storeImpulse(std::move(impulse));
+  }
+
+  void Convolution::setImpulseResponse(const mono_float* left, const mono_float* right, int length,
+                                       int sample_rate, const std::string& name) {
+    setImpulse(createImpulse(left, right, length, sample_rate, name));
+  }
+
+  void Convolution::loadDefaultImpulse() {
+    if (default_impulse_.exchange(true))
+      return;
+
+    storeImpulse(createDefaultImpulse());
+  }
+
+  bool Convolution::hasDefaultImpulse() {
+    return default_impulse_;
+  }
+
+  std::string Convolution::getImpulseName() {
+    ScopedLock lock(impulse_lock_);
+    return impulse_.name;
+  }
+
+  json Convolution::stateToJson() {
+    ScopedLock lock(impulse_lock_);
+    int length = static_cast<int>(impulse_.left.size());
+
+    json data;
+    data["name"] = impulse_.name;
+    data["length"] = length;
+    data["sample_rate"] = impulse_.sample_rate;
+    std::unique_ptr<int16_t[]> pcm_data = std::make_unique<int16_t[]>(length);
+    utils::floatToPcmData(pcm_data.get(), impulse_.left.data(), length);
+    String encoded = Base64::toBase64(pcm_data.get(), sizeof(int16_t) * length);
+    data["samples"] = encoded.toStdString();
+    if (!impulse_.right.empty()) {
+      utils::floatToPcmData(pcm_data.get(), impulse_.right.data(), length);
+      String encoded_stereo = Base64::toBase64(pcm_data.get(), sizeof(int16_t) * length);
+      data["samples_stereo"] = encoded_stereo.toStdString();
+    }
+    return data;
+  }
+
+  Convolution::ImpulseResponse Convolution::jsonToImpulse(json data) {
+    std::string name = "";
+    if (data.count("name"))
+      name = data["name"].get<std::string>();
+
+    int length = data["length"];
+    int sample_rate = data["sample_rate"];
+
+    MemoryOutputStream decoded(length * sizeof(int16_t));
+    Base64::convertFromBase64(decoded, data["samples"].get_ref<const std::string&>());
+    std::unique_ptr<mono_float[]> buffer = std::make_unique<mono_float[]>(length);
+    utils::pcmToFloatData(buffer.get(), (const int16_t*)decoded.getData(), length);
+
+    if (data.count("samples_stereo")) {
+      MemoryOutputStream decoded_stereo(length * sizeof(int16_t));
+      Base64::convertFromBase64(decoded_stereo, data["samples_stereo"].get_ref<const std::string&>());
+
+      std::unique_ptr<mono_float[]> buffer_stereo = std::make_unique<mono_float[]>(length);
+      utils::pcmToFloatData(buffer_stereo.get(), (const int16_t*)decoded_stereo.getData(), length);
+      return createImpulse(buffer.get(), buffer_stereo.get(), length, sample_rate, name);
+    }
+    return createImpulse(buffer.get(), nullptr, length, sample_rate, name);
+  }
+
+  void Convolution::jsonToState(json data) {
+    setImpulse(jsonToImpulse(std::move(data)));
+  }
+
+  void Convolution::setBackgroundProcessing(bool background) {
+    if (background == isBackgroundProcessing())
+      return;
+
+    if (background) {
+      tail_thread_ = std::make_unique<TailThread>(this);
+      tail_thread_->startThread();
+      return;
+    }
+
+    tail_thread_->stopThread(kStopThreadTimeoutMs);
+    tail_thread_ = nullptr;
+
+    for (int64 i = tail_processed_.load(); i < tail_submitted_.load(); ++i)
+      processTailBlock(i);
+    tail_processed_ = tail_submitted_.load();
+    delete retired_kernel_.exchange(nullptr);
+    updateKernel();
+  }
+
+  void Convolution::storeImpulse(ImpulseResponse impulse) {
+    {
+      ScopedLock lock(impulse_lock_);
+      impulse_ = std::move(impulse);
+    }
+    impulse_version_++;
+    requestKernel();
+  }
+
+  void Convolution::requestKernel() {
+    if (tail_thread_ == nullptr)
+      updateKernel();
+  }
+
+  void Convolution::updateKernel() {
+    int version = impulse_version_.load();
+    int sample_rate = target_sample_rate_.load();
+    if (version == built_version_ && sample_rate == built_sample_rate_)
+      return;
+
+    ImpulseResponse impulse;
+    {
+      ScopedLock lock(impulse_lock_);
+      impulse = impulse_;
+    }
+
+    Kernel* kernel = createKernel(impulse, sample_rate, build_head_transform_.get(), build_tail_transform_.get());
+    built_version_ = version;
+    built_sample_rate_ = sample_rate;
+    delete pending_kernel_.exchange(kernel);
+  }
+
+  void Convolution::freeRetiredKernel() {
+    Kernel* retired = retired_kernel_.load();
+    if (retired && tail_processed_.load() >= retire_after_.load()) {
+      retired_kernel_ = nullptr;
+      delete retired;
+    }
+  }
+
+  void Convolution::startTailBlock() {
+    if (retired_kernel_.load() == nullptr) {
+      Kernel* pending = pending_kernel_.exchange(nullptr);
+      if (pending) {
+        if (isBackgroundProcessing()) {
+          retire_after_ = tail_submitted_.load();
+          retired_kernel_ = active_kernel_;
+        }
+        else
+          delete active_kernel_;
+        active_kernel_ = pending;
+      }
+    }
+
+    int slot = tail_block_ % kNumTailSlots;
+    bool valid = tail_block_ >= tail_valid_block_;
+    tail_ready_ = valid && tail_output_blocks_[slot].load(std::memory_order_acquire) == tail_block_;
+    if (valid && !tail_ready_)
+      tail_underruns_++;
+    tail_output_ = tail_outputs_[slot].get();
+  }
+
+  void Convolution::submitTailBlock() {
+    int slot = tail_block_ % kNumTailSlots;
+    tail_kernels_[slot] = active_kernel_;
+    tail_generations_[slot] = tail_generation_;
+
+    int64 submission = tail_block_;
+    tail_block_++;
+    tail_submitted_.store(tail_block_, std::memory_order_release);
+    // Orders the publish before the next block overwrites an input slot the worker may still be copying.
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+
+    if (tail_thread_ == nullptr) {
+      processTailBlock(submission);
+      tail_processed_ = submission + 1;
+    }
+  }
+
+  void Convolution::processHeadBlock() {
+    head_history_index_ = (head_history_index_ + 1) % kMaxHeadPartitions;
+    poly_float* spectrum = head_history_.get() + head_history_index_ * kHeadSpectrumSize;
+
+    for (int channel = 0; channel < 2; ++channel) {
+      float* buffer = head_buffer_.get() + channel * 4 * kHeadBlockSize;
+      for (int i = 0; i < 2 * kHeadBlockSize; ++i)
+        buffer[i] = head_input_[i][channel];
+      head_transform_->transformRealForward(buffer);
+      splitSpectrum(buffer, spectrum + channel * 2 * kHeadContainers, kHeadContainers);
+    }
+
+    for (int i = 0; i < kHeadBlockSize; ++i)
+      head_input_[i] = head_input_[kHeadBlockSize + i];
+
+    Kernel* kernel = active_kernel_;
+    int num_partitions = kernel ? kernel->num_head_partitions : 0;
+    if (num_partitions == 0) {
+      for (int i = 0; i < kHeadBlockSize; ++i)
+        head_output_[i] = 0.0f;
+      return;
+    }
+
+    poly_float sum[2 * kHeadContainers];
+    for (int channel = 0; channel < 2; ++channel) {
+      for (int i = 0; i < 2 * kHeadContainers; ++i)
+        sum[i] = 0.0f;
+
+      for (int p = 0; p < num_partitions; ++p) {
+        int index = (head_history_index_ - p + kMaxHeadPartitions) % kMaxHeadPartitions;
+        const poly_float* input = head_history_.get() + index * kHeadSpectrumSize + channel * 2 * kHeadContainers;
+        const poly_float* response = kernel->head_spectra.get() + (2 * p + channel) * 2 * kHeadContainers;
+        multiplyAdd(sum, input, response, kHeadContainers);
+      }
+
+      float* buffer = head_buffer_.get() + channel * 4 * kHeadBlockSize;
+      mergeSpectrum(buffer, sum, kHeadContainers, 2 * kHeadBlockSize);
+      head_transform_->transformRealInverse(buffer);
+    }
+
+    const float* left = head_buffer_.get() + kHeadBlockSize;
+    const float* right = head_buffer_.get() + 4 * kHeadBlockSize + kHeadBlockSize;
+    for (int i = 0; i < kHeadBlockSize; ++i)
+      head_output_[i] = poly_float(left[i], right[i], left[i], right[i]);
+  }
+
+  void Convolution::processTailBlock(int64 submission) {
+    int slot = submission % kNumTailSlots;
+    Kernel* kernel = tail_kernels_[slot];
+    int generation = tail_generations_[slot];
+    mono_float* input = tail_inputs_[slot].get();
+    std::copy(input, input + 2 * kTailBlockSize, tail_current_input_.get());
+
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if (tail_submitted_.load(std::memory_order_relaxed) >= submission + kNumTailSlots) {
+      skipTailBlock();
+      return;
+    }
+
+    int num_partitions = kernel ? kernel->num_tail_partitions : 0;
+    if (generation != tail_history_generation_ || num_partitions > tail_history_size_) {
+      if (num_partitions > tail_history_size_) {
+        tail_history_size_ = num_partitions;
+        tail_history_ = std::make_unique<poly_float[]>(tail_history_size_ * kTailSpectrumSize);
+      }
+      else
+        std::fill(tail_history_.get(), tail_history_.get() + tail_history_size_ * kTailSpectrumSize, 0.0f);
+
+      std::fill(tail_previous_input_.get(), tail_previous_input_.get() + 2 * kTailBlockSize, 0.0f);
+      tail_history_generation_ = generation;
+      tail_history_index_ = 0;
+    }
+
+    tail_history_index_ = (tail_history_index_ + 1) % tail_history_size_;
+    poly_float* spectrum = tail_history_.get() + tail_history_index_ * kTailSpectrumSize;
+    for (int channel = 0; channel < 2; ++channel) {
+      float* buffer = tail_buffer_.get() + channel * 4 * kTailBlockSize;
+      const mono_float* previous = tail_previous_input_.get() + channel * kTailBlockSize;
+      const mono_float* current = tail_current_input_.get() + channel * kTailBlockSize;
+      std::copy(previous, previous + kTailBlockSize, buffer);
+      std::copy(current, current + kTailBlockSize, buffer + kTailBlockSize);
+      tail_transform_->transformRealForward(buffer);
+      splitSpectrum(buffer, spectrum + channel * 2 * kTailContainers, kTailContainers);
+    }
+    tail_previous_input_.swap(tail_current_input_);
+
+    int output_slot = (submission + 2) % kNumTailSlots;
+    poly_float* output = tail_outputs_[output_slot].get();
+    if (num_partitions == 0) {
+      for (int i = 0; i < kTailBlockSize; ++i)
+        output[i] = 0.0f;
+    }
+    else {
+      poly_float* sum = tail_sum_.get();
+      for (int channel = 0; channel < 2; ++channel) {
+        for (int i = 0; i < 2 * kTailContainers; ++i)
+          sum[i] = 0.0f;
+
+        for (int p = 0; p < num_partitions; ++p) {
+          int index = (tail_history_index_ - p + tail_history_size_) % tail_history_size_;
+          const poly_float* spectrum_in = tail_history_.get() + index * kTailSpectrumSize;
+          const poly_float* response = kernel->tail_spectra.get() + (2 * p + channel) * 2 * kTailContainers;
+          multiplyAdd(sum, spectrum_in + channel * 2 * kTailContainers, response, kTailContainers);
+        }
+
+        float* buffer = tail_buffer_.get() + channel * 4 * kTailBlockSize;
+        mergeSpectrum(buffer, sum, kTailContainers, 2 * kTailBlockSize);
+        tail_transform_->transformRealInverse(buffer);
+      }
+
+      const float* left = tail_buffer_.get() + kTailBlockSize;
+      const float* right = tail_buffer_.get() + 4 * kTailBlockSize + kTailBlockSize;
+      for (int i = 0; i < kTailBlockSize; ++i)
+        output[i] = poly_float(left[i], right[i], left[i], right[i]);
+    }
+
+    tail_output_blocks_[output_slot].store(submission + 2, std::memory_order_release);
+  }
+
+  void Convolution::skipTailBlock() {
+    tail_history_index_ = (tail_history_index_ + 1) % tail_history_size_;
+    poly_float* spectrum = tail_history_.get() + tail_history_index_ * kTailSpectrumSize;
+    std::fill(spectrum, spectrum + kTailSpectrumSize, 0.0f);
+    std::fill(tail_previous_input_.get(), tail_previous_input_.get() + 2 * kTailBlockSize, 0.0f);
+  }
+} // namespace vital
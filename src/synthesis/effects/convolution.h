@@ -0,0 +1,200 @@
+/* Copyright 2013-2019 Matt Tytel
+ *
+ * vital is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * vital is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with vital.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#pragma once
+
+#include "processor.h"
+#include "json/json.h"
+
+#include <atomic>
+
+using json = nlohmann::json;
+
+namespace vital {
+
+  class FourierTransform;
+
+  // Convolves with a stereo impulse response without added latency. The first block of taps is applied
+  // directly, the rest of the head uses uniformly partitioned overlap-save on the audio thread and the tail
+  // uses larger partitions computed on a background thread that has one tail block of time to finish.
+  class Convolution : public Processor {
+    public:
+      static constexpr int kHeadBlockBits = 6;
+      static constexpr int kHeadBlockSize = 1 << kHeadBlockBits;
+      static constexpr int kHeadContainers = (kHeadBlockSize + poly_float::kSize) / poly_float::kSize;
+      static constexpr int kTailBlockBits = 10;
+      static constexpr int kTailBlockSize = 1 << kTailBlockBits;
+      static constexpr int kTailContainers = (kTailBlockSize + poly_float::kSize) / poly_float::kSize;
+      static constexpr int kHeadLength = 2 * kTailBlockSize;
+      static constexpr int kMaxHeadPartitions = kHeadLength / kHeadBlockSize - 1;
+      static constexpr int kNumTailSlots = 3;
+      static constexpr int kMaxImpulseSamples = 1 << 21;
+      static constexpr float kMinGain = -24.0f;
+      static constexpr float kMaxGain = 12.0f;
+      static constexpr float kDefaultImpulseTime = 1.2f;
+      static constexpr float kDefaultImpulseT60 = 1.0f;
+      static constexpr int kDefaultImpulseSeed = 0x7;
+
+      enum {
+        kAudio,
+        kWet,
+        kGain,
+        kNumInputs
+      };
+
+      struct ImpulseResponse {
+        std::string name;
+        int sample_rate = kDefaultSampleRate;
+        std::vector<mono_float> left;
+        std::vector<mono_float> right;
+      };
+
+      // An impulse response split into partitions and transformed for one sample rate.
+      struct Kernel {
+        int sample_rate = 0;
+        int length = 0;
+        int num_head_partitions = 0;
+        int num_tail_partitions = 0;
+        poly_float direct[kHeadBlockSize];
+        std::unique_ptr<poly_float[]> head_spectra;
+        std::unique_ptr<poly_float[]> tail_spectra;
+
+        JUCE_LEAK_DETECTOR(Kernel)
+      };
+
+      static Kernel* createKernel(const ImpulseResponse& impulse, int sample_rate,
+                                  FourierTransform* head_transform, FourierTransform* tail_transform);
+      static ImpulseResponse createDefaultImpulse();
+      static ImpulseResponse createImpulse(const mono_float* left, const mono_float* right, int length,
+                                           int sample_rate, const std::string& name);
+      static ImpulseResponse jsonToImpulse(json data);
+
+      Convolution();
+      virtual ~Convolution();
+
+      virtual Processor* clone() const override { VITAL_ASSERT(false); return nullptr; }
+
+      void process(int num_samples) override;
+      void processWithInput(const poly_float* audio_in, int num_samples) override;
+      void setSampleRate(int sample_rate) override;
+      void setOversampleAmount(int oversample) override;
+      void hardReset() override;
+      int getTailSamples();
+
+      // Impulse responses can be set from any thread but not from the audio thread. Preset loaders decode with
+      // jsonToImpulse ahead of time and only swap the result in with setImpulse.
+      void setImpulse(ImpulseResponse impulse);
+      void setImpulseResponse(const mono_float* left, const mono_float* right, int length, int sample_rate,
+                              const std::string& name);
+      void loadDefaultImpulse();
+      bool hasDefaultImpulse();
+      std::string getImpulseName();
+      void setLastBrowsedFile(const std::string& path) { last_browsed_file_ = path; }
+      std::string getLastBrowsedFile() const { return last_browsed_file_; }
+      json stateToJson();
+      void jsonToState(json data);
+
+      // Without background processing, kernels are built on the calling thread and the tail is computed
+      // inline. Used for offline rendering and tests.
+      void setBackgroundProcessing(bool background);
+      bool isBackgroundProcessing() const { return tail_thread_ != nullptr; }
+      bool hasKernel() const { return active_kernel_ != nullptr; }
+      int getTailUnderruns() const { return tail_underruns_; }
+
+    private:
+      // Polls for submitted tail blocks several times per block so the audio thread never has to wake it
+      // through a lock.
+      class TailThread : public Thread {
+        public:
+          static constexpr int kPollsPerTailBlock = 4;
+
+          TailThread(Convolution* convolution) : Thread("Vital Convolution"), convolution_(convolution) { }
+          void run() override;
+
+        private:
+          Convolution* convolution_;
+      };
+
+      void storeImpulse(ImpulseResponse impulse);
+      void requestKernel();
+      void updateKernel();
+      void freeRetiredKernel();
+      void startTailBlock();
+      void submitTailBlock();
+      void processHeadBlock();
+      void processTailBlock(int64 submission);
+      void skipTailBlock();
+
+      std::unique_ptr<TailThread> tail_thread_;
+      std::unique_ptr<FourierTransform> head_transform_;
+      std::unique_ptr<FourierTransform> tail_transform_;
+      std::unique_ptr<FourierTransform> build_head_transform_;
+      std::unique_ptr<FourierTransform> build_tail_transform_;
+
+      CriticalSection impulse_lock_;
+      ImpulseResponse impulse_;
+      std::atomic<bool> default_impulse_;
+      std::string last_browsed_file_;
+      std::atomic<int> impulse_version_;
+      std::atomic<int> target_sample_rate_;
+      int built_version_;
+      int built_sample_rate_;
+
+      Kernel* active_kernel_;
+      std::atomic<Kernel*> pending_kernel_;
+      std::atomic<Kernel*> retired_kernel_;
+      std::atomic<int64> retire_after_;
+
+      poly_float wet_;
+      poly_float dry_;
+      poly_float gain_;
+
+      int head_position_;
+      poly_float head_input_[2 * kHeadBlockSize];
+      poly_float head_output_[kHeadBlockSize];
+      std::unique_ptr<poly_float[]> head_history_;
+      int head_history_index_;
+      std::unique_ptr<float[]> head_buffer_;
+
+      int tail_position_;
+      int64 tail_block_;
+      int64 tail_valid_block_;
+      bool tail_ready_;
+      int tail_underruns_;
+      int tail_generation_;
+      const poly_float* tail_output_;
+      std::unique_ptr<mono_float[]> tail_inputs_[kNumTailSlots];
+      Kernel* tail_kernels_[kNumTailSlots];
+      int tail_generations_[kNumTailSlots];
+      std::unique_ptr<poly_float[]> tail_outputs_[kNumTailSlots];
+      std::atomic<int64> tail_output_blocks_[kNumTailSlots];
+      std::atomic<int64> tail_submitted_;
+      std::atomic<int64> tail_processed_;
+
+      // Owned by whichever thread computes the tail.
+      int tail_history_generation_;
+      int tail_history_size_;
+      int tail_history_index_;
+      std::unique_ptr<poly_float[]> tail_history_;
+      std::unique_ptr<mono_float[]> tail_previous_input_;
+      std::unique_ptr<mono_float[]> tail_current_input_;
+      std::unique_ptr<poly_float[]> tail_sum_;
+      std::unique_ptr<float[]> tail_buffer_;
+
+      JUCE_LEAK_DETECTOR(Convolution)
+  };
+} // namespace vital
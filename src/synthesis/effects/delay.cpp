@@ -47,6 +47,20 @@ namespace vital {
     memory_ = std::make_unique<MemoryType>(max_samples);
     period_ = utils::min(period_, max_samples - 1);
   }
+
+  template<class MemoryType>
+  int Delay<MemoryType>::getTailSamples() const {
+    mono_float feedback = std::abs(feedback_[0]);
+    if (feedback >= 1.0f)
+      return kMaxTailSamples;
+
+    // Ping pong styles take two periods to complete one feedback loop.
+    mono_float repeats = 1.0f;
+    if (feedback > 0.0f)
+      repeats += std::log(kTailSilenceAmplitude) / std::log(feedback);
+    mono_float samples = 2.0f * repeats * utils::maxFloat(period_);
+    return utils::min(samples, kMaxTailSamples);
+  }
   
   template<class MemoryType>
   void Delay<MemoryType>::process(int num_samples) {
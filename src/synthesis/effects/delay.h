@@ -80,6 +80,7 @@ namespace vital {
 
       void hardReset() override;
       void setMaxSamples(int max_samples);
+      int getTailSamples() const;
 
       virtual void process(int num_samples) override;
       virtual void processWithInput(const poly_float* audio_in, int num_samples) override;
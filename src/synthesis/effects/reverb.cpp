@@ -29,29 +29,59 @@ namespace vital {
   static constexpr float kSampleDelayMultiplier = 0.05f;
   static constexpr float kSampleIncrementMultiplier = 0.05f;
 
-  const poly_int Reverb::kAllpassDelays[kNetworkContainers] = {
+  const poly_int Reverb::kAllpassDelays[kMaxNetworkContainers] = {
     { 1001, 799, 933, 876 },
     { 895, 807, 907, 853 },
     { 957, 1019, 711, 567 },
-    { 833, 779, 663, 997 }
+    { 833, 779, 663, 997 },
+    { 767, 617, 744, 734 },
+    { 989, 674, 870, 926 },
+    { 590, 949, 584, 879 },
+    { 802, 622, 633, 651 },
+    { 888, 936, 562, 892 },
+    { 699, 598, 782, 912 },
+    { 828, 658, 985, 703 },
+    { 694, 593, 822, 944 },
+    { 963, 867, 728, 839 },
+    { 968, 811, 714, 1011 },
+    { 790, 722, 689, 627 },
+    { 786, 762, 603, 954 }
   };
 
-  const poly_float Reverb::kFeedbackDelays[kNetworkContainers] = {
+  const poly_float Reverb::kFeedbackDelays[kMaxNetworkContainers] = {
     { 6753.2f, 9278.4f, 7704.5f, 11328.5f },
     { 9701.12f, 5512.5f, 8480.45f, 5638.65f },
     { 3120.73f, 3429.5f, 3626.37f, 7713.52f },
-    { 4521.54f, 6518.97f, 5265.56f, 5630.25f }
+    { 4521.54f, 6518.97f, 5265.56f, 5630.25f },
+    { 6263.77f, 9489.32f, 3898.85f, 4152.11f },
+    { 3219.3f, 3799.07f, 6038.21f, 11196.28f },
+    { 7625.14f, 5065.89f, 4733.41f, 9240.02f },
+    { 6906.34f, 3585.04f, 3395.11f, 3505.07f },
+    { 10760.78f, 6979.3f, 10910.46f, 5115.12f },
+    { 5759.35f, 10189.48f, 3959.67f, 4334.86f },
+    { 4276.84f, 3304.42f, 7431.76f, 8947.15f },
+    { 5461.5f, 3256.01f, 7826.36f, 8068.37f },
+    { 7238.79f, 9108.56f, 7026.93f, 6666.39f },
+    { 4196.0f, 5599.35f, 8688.02f, 7529.21f },
+    { 4856.54f, 8980.99f, 9214.79f, 3159.25f },
+    { 8242.04f, 7176.54f, 11271.69f, 4924.9f }
   };
 
+  int Reverb::getNetworkSize(int quality) {
+    static constexpr int kNetworkSizes[kNumQualities] = { 8, 16, 16, 32, 64 };
+    return kNetworkSizes[quality];
+  }
+
   Reverb::Reverb() : Processor(kNumInputs, 1), chorus_phase_(0.0f), chorus_amount_(0.0f), feedback_(0.0f),
                      damping_(0.0f), dry_(0.0f), wet_(0.0f), write_index_(0),
-                     max_allpass_size_(0), max_feedback_size_(0),
+                     quality_(kStandard), network_size_(getNetworkSize(kStandard)), downsample_(1),
+                     num_dirty_lines_(0), max_allpass_size_(0), max_feedback_size_(0),
                      feedback_mask_(0), allpass_mask_(0), poly_allpass_mask_(0) {
     setupBuffersForSampleRate(kDefaultSampleRate);
 
     memory_ = std::make_unique<StereoMemory>(kMaxSampleRate);
 
-    for (int i = 0; i < kNetworkContainers; ++i)
+    for (int i = 0; i < kMaxNetworkContainers; ++i)
       decays_[i] = 0.0f;
 
     low_pre_coefficient_ = 0.1f;
@@ -61,6 +91,7 @@ namespace vital {
     low_amplitude_ = 0.0f;
     high_amplitude_ = 0.0f;
     sample_delay_ = kMinDelay;
+    last_network_output_ = 0.0f;
   }
 
   void Reverb::setupBuffersForSampleRate(int sample_rate) {
@@ -69,9 +100,10 @@ namespace vital {
     if (max_feedback_size_ == max_feedback_size)
       return;
 
+    // Every line is allocated up front so quality can change on the audio thread.
     max_feedback_size_ = max_feedback_size;
     feedback_mask_ = max_feedback_size_ - 1;
-    for (int i = 0; i < kNetworkSize; ++i) {
+    for (int i = 0; i < kMaxNetworkSize; ++i) {
       feedback_memories_[i] = std::make_unique<mono_float[]>(max_feedback_size_ + kExtraLookupSample);
       feedback_lookups_[i] = feedback_memories_[i].get() + 1;
     }
@@ -79,10 +111,59 @@ namespace vital {
     max_allpass_size_ = buffer_scale * (1 << kBaseAllpassBits);
     poly_allpass_mask_ = max_allpass_size_ - 1;
     allpass_mask_ = max_allpass_size_ * poly_float::kSize - 1;
-    for (int i = 0; i < kNetworkContainers; ++i)
+    for (int i = 0; i < kMaxNetworkContainers; ++i)
       allpass_lookups_[i] = std::make_unique<poly_float[]>(max_allpass_size_);
 
     write_index_ &= feedback_mask_;
+    num_dirty_lines_ = 0;
+  }
+
+  void Reverb::setQuality(int quality) {
+    int downsample = runsAtBaseRate(quality) ? getOversampleAmount() : 1;
+    if (quality == quality_ && downsample == downsample_)
+      return;
+
+    // Lines already in the network keep their tail. Lines joining it only need clearing if they were used before.
+    int network_size = getNetworkSize(quality);
+    clearLines(network_size_, std::min(network_size, num_dirty_lines_));
+
+    if (downsample != downsample_) {
+      mono_float delay_ratio = downsample_ / (1.0f * downsample);
+      sample_delay_ = utils::clamp(sample_delay_ * delay_ratio, kMinDelay, kMaxSampleRate);
+      sample_delay_increment_ *= delay_ratio;
+    }
+
+    quality_ = quality;
+    downsample_ = downsample;
+    network_size_ = network_size;
+  }
+
+  void Reverb::clearLines(int start, int end) {
+    for (int c = start / poly_float::kSize; c < end / poly_float::kSize; ++c) {
+      low_shelf_filters_[c].reset(constants::kFullMask);
+      high_shelf_filters_[c].reset(constants::kFullMask);
+      decays_[c] = 0.0f;
+      std::fill(allpass_lookups_[c].get(), allpass_lookups_[c].get() + max_allpass_size_, 0.0f);
+    }
+
+    int feedback_memory_size = max_feedback_size_ + kExtraLookupSample;
+    for (int i = start; i < end; ++i)
+      std::fill(feedback_memories_[i].get(), feedback_memories_[i].get() + feedback_memory_size, 0.0f);
+  }
+
+  void Reverb::clearNetwork() {
+    low_pre_filter_.reset(constants::kFullMask);
+    high_pre_filter_.reset(constants::kFullMask);
+    last_network_output_ = 0.0f;
+
+    for (int c = 0; c < kMaxNetworkContainers; ++c) {
+      low_shelf_filters_[c].reset(constants::kFullMask);
+      high_shelf_filters_[c].reset(constants::kFullMask);
+      decays_[c] = 0.0f;
+    }
+
+    clearLines(0, num_dirty_lines_);
+    num_dirty_lines_ = 0;
   }
 
   void Reverb::process(int num_samples) {
@@ -91,14 +172,72 @@ namespace vital {
   }
 
   void Reverb::processWithInput(const poly_float* audio_in, int num_samples) {
-    for (int i = 0; i < kNetworkSize; ++i)
-      wrapFeedbackBuffer(feedback_memories_[i].get());
+    int quality = utils::iclamp(input(kQuality)->at(0)[0], 0, kNumQualities - 1);
+    setQuality(quality);
 
     poly_float* audio_out = output()->buffer;
     mono_float tick_increment = 1.0f / num_samples;
 
     poly_float current_dry = dry_;
     poly_float current_wet = wet_;
+    poly_float wet_in = utils::clamp(input(kWet)->at(0), 0.0f, 1.0f);
+    wet_ = futils::equalPowerFade(wet_in);
+    dry_ = futils::equalPowerFadeInverse(wet_in);
+    poly_float delta_wet = (wet_ - current_wet) * tick_increment;
+    poly_float delta_dry = (dry_ - current_dry) * tick_increment;
+
+    if (downsample_ == 1) {
+      processNetwork(audio_in, num_samples);
+
+      for (int i = 0; i < num_samples; ++i) {
+        poly_float input = audio_in[i] & constants::kFirstMask;
+        input += utils::swapVoices(input);
+        audio_out[i] = current_wet * network_output_[i] + current_dry * input;
+        current_dry += delta_dry;
+        current_wet += delta_wet;
+      }
+      return;
+    }
+
+    // The network runs at the base rate on averaged input and is linearly interpolated back up.
+    VITAL_ASSERT(num_samples % downsample_ == 0);
+    int network_samples = num_samples / downsample_;
+    mono_float downsample_scale = 1.0f / downsample_;
+    for (int i = 0; i < network_samples; ++i) {
+      poly_float total = 0.0f;
+      for (int s = 0; s < downsample_; ++s)
+        total += audio_in[i * downsample_ + s];
+      downsampled_input_[i] = total * downsample_scale;
+    }
+
+    processNetwork(downsampled_input_, network_samples);
+
+    poly_float from = last_network_output_;
+    for (int i = 0; i < network_samples; ++i) {
+      poly_float to = network_output_[i];
+      poly_float delta = (to - from) * downsample_scale;
+      for (int s = 0; s < downsample_; ++s) {
+        int index = i * downsample_ + s;
+        from += delta;
+        poly_float input = audio_in[index] & constants::kFirstMask;
+        input += utils::swapVoices(input);
+        audio_out[index] = current_wet * from + current_dry * input;
+        current_dry += delta_dry;
+        current_wet += delta_wet;
+      }
+      from = to;
+    }
+    last_network_output_ = from;
+  }
+
+  void Reverb::processNetwork(const poly_float* audio_in, int num_samples) {
+    int num_containers = network_size_ / poly_float::kSize;
+    num_dirty_lines_ = std::max(num_dirty_lines_, network_size_);
+    for (int i = 0; i < network_size_; ++i)
+      wrapFeedbackBuffer(feedback_memories_[i].get());
+
+    mono_float tick_increment = 1.0f / num_samples;
+
     poly_float current_low_pre_coefficient = low_pre_coefficient_;
     poly_float current_high_pre_coefficient = high_pre_coefficient_;
     poly_float current_low_coefficient = low_coefficient_;
@@ -106,13 +245,7 @@ namespace vital {
     poly_float current_high_coefficient = high_coefficient_;
     poly_float current_high_amplitude = high_amplitude_;
 
-    poly_float wet_in = utils::clamp(input(kWet)->at(0), 0.0f, 1.0f);
-    wet_ = futils::equalPowerFade(wet_in);
-    dry_ = futils::equalPowerFadeInverse(wet_in);
-    poly_float delta_wet = (wet_ - current_wet) * tick_increment;
-    poly_float delta_dry = (dry_ - current_dry) * tick_increment;
-
-    int sample_rate = getSampleRate();
+    int sample_rate = getNetworkSampleRate();
     int buffer_scale = getBufferScale(sample_rate);
     float sample_rate_ratio = getSampleRateRatio(sample_rate);
     poly_float low_pre_cutoff_midi = utils::clamp(input(kPreLowCutoff)->at(0), 0.0f, 130.0f);
@@ -122,8 +255,6 @@ namespace vital {
     poly_float high_pre_cutoff_midi = utils::clamp(input(kPreHighCutoff)->at(0), 0.0f, 130.0f);
     poly_float high_pre_cutoff_frequency = utils::midiNoteToFrequency(high_pre_cutoff_midi);
     high_pre_coefficient_ = OnePoleFilter<>::computeCoefficient(high_pre_cutoff_frequency, sample_rate);
-    poly_float delta_low_pre_coefficient = (low_pre_coefficient_ - current_low_pre_coefficient) * tick_increment;
-    poly_float delta_high_pre_coefficient = (high_pre_coefficient_ - current_high_pre_coefficient) * tick_increment;
 
     poly_float low_cutoff_midi = utils::clamp(input(kLowCutoff)->at(0), 0.0f, 130.0f);
     poly_float low_cutoff_frequency = utils::midiNoteToFrequency(low_cutoff_midi);
@@ -132,224 +263,163 @@ namespace vital {
     poly_float high_cutoff_midi = utils::clamp(input(kHighCutoff)->at(0), 0.0f, 130.0f);
     poly_float high_cutoff_frequency = utils::midiNoteToFrequency(high_cutoff_midi);
     high_coefficient_ = OnePoleFilter<>::computeCoefficient(high_cutoff_frequency, sample_rate);
-    poly_float delta_low_coefficient = (low_coefficient_ - current_low_coefficient) * tick_increment;
     poly_float delta_high_coefficient = (high_coefficient_ - current_high_coefficient) * tick_increment;
 
     poly_float low_gain = utils::clamp(input(kLowGain)->at(0), -24.0f, 0.0f);
     low_amplitude_ = poly_float(1.0f) - utils::dbToMagnitude(low_gain);
     poly_float high_gain = utils::clamp(input(kHighGain)->at(0), -24.0f, 0.0f);
     high_amplitude_ = utils::dbToMagnitude(high_gain);
-    poly_float delta_low_amplitude = (low_amplitude_ - current_low_amplitude) * tick_increment;
     poly_float delta_high_amplitude = (high_amplitude_ - current_high_amplitude) * tick_increment;
 
-    const mono_float* allpass_lookup1 = (mono_float*)allpass_lookups_[0].get();
-    const mono_float* allpass_lookup2 = (mono_float*)allpass_lookups_[1].get();
-    const mono_float* allpass_lookup3 = (mono_float*)allpass_lookups_[2].get();
-    const mono_float* allpass_lookup4 = (mono_float*)allpass_lookups_[3].get();
-
-    mono_float* feedback_lookups1[] = { feedback_lookups_[0], feedback_lookups_[1],
-                                        feedback_lookups_[2], feedback_lookups_[3] };
-    mono_float* feedback_lookups2[] = { feedback_lookups_[4], feedback_lookups_[5],
-                                        feedback_lookups_[6], feedback_lookups_[7] };
-    mono_float* feedback_lookups3[] = { feedback_lookups_[8], feedback_lookups_[9],
-                                        feedback_lookups_[10], feedback_lookups_[11] };
-    mono_float* feedback_lookups4[] = { feedback_lookups_[12], feedback_lookups_[13],
-                                        feedback_lookups_[14], feedback_lookups_[15] };
-
     poly_float size = utils::clamp(input(kSize)->at(0), 0.0f, 1.0f);
     poly_float size_mult = futils::pow(2.0f, size * kSizePowerRange + kMinSizePower);
 
     poly_float decay_samples = utils::clamp(input(kDecayTime)->at(0), kMinDecayTime, kMaxDecayTime) * kBaseSampleRate;
     poly_float decay_period = size_mult / decay_samples;
-    poly_float current_decay1 = decays_[0];
-    poly_float current_decay2 = decays_[1];
-    poly_float current_decay3 = decays_[2];
-    poly_float current_decay4 = decays_[3];
-    decays_[0] = utils::pow(kT60Amplitude, kFeedbackDelays[0] * decay_period);
-    decays_[1] = utils::pow(kT60Amplitude, kFeedbackDelays[1] * decay_period);
-    decays_[2] = utils::pow(kT60Amplitude, kFeedbackDelays[2] * decay_period);
-    decays_[3] = utils::pow(kT60Amplitude, kFeedbackDelays[3] * decay_period);
-    poly_float delta_decay1 = (decays_[0] - current_decay1) * tick_increment;
-    poly_float delta_decay2 = (decays_[1] - current_decay2) * tick_increment;
-    poly_float delta_decay3 = (decays_[2] - current_decay3) * tick_increment;
-    poly_float delta_decay4 = (decays_[3] - current_decay4) * tick_increment;
+    poly_float current_decays[kMaxNetworkContainers];
+    poly_float delta_decays[kMaxNetworkContainers];
+    for (int c = 0; c < num_containers; ++c) {
+      current_decays[c] = decays_[c];
+      decays_[c] = utils::pow(kT60Amplitude, kFeedbackDelays[c] * decay_period);
+      delta_decays[c] = (decays_[c] - current_decays[c]) * tick_increment;
+    }
 
     poly_int delay_offset(0, -1, -2, -3);
     if (buffer_scale)
       delay_offset += poly_float::kSize;
 
-    poly_int allpass_offset1 = utils::swapStereo(kAllpassDelays[0] * buffer_scale * poly_float::kSize + delay_offset);
-    poly_int allpass_offset2 = utils::swapStereo(kAllpassDelays[1] * buffer_scale * poly_float::kSize + delay_offset);
-    poly_int allpass_offset3 = utils::swapStereo(kAllpassDelays[2] * buffer_scale * poly_float::kSize + delay_offset);
-    poly_int allpass_offset4 = utils::swapStereo(kAllpassDelays[3] * buffer_scale * poly_float::kSize + delay_offset);
+    poly_int allpass_offsets[kMaxNetworkContainers];
+    for (int c = 0; c < num_containers; ++c)
+      allpass_offsets[c] = utils::swapStereo(kAllpassDelays[c] * buffer_scale * poly_float::kSize + delay_offset);
 
     mono_float chorus_frequency = utils::clamp(input(kChorusFrequency)->at(0)[0], 0.0f, kMaxChorusFrequency);
     mono_float chorus_phase_increment = chorus_frequency / sample_rate;
 
-    mono_float network_offset = 2.0f * kPi / kNetworkSize;
-    poly_float phase_offset = poly_float(0.0f, 1.0f, 2.0f, 3.0f) * network_offset;
-    poly_float container_phase = phase_offset + chorus_phase_ * 2.0f * kPi;
-    chorus_phase_ += num_samples * chorus_phase_increment;
-    chorus_phase_ -= std::floor(chorus_phase_);
-
+    // Each group of four containers gets its own chorus phasor, spread around the network.
+    int num_chorus_groups = (num_containers + poly_float::kSize - 1) / poly_float::kSize;
+    mono_float network_offset = 2.0f * kPi / network_size_;
     poly_float chorus_increment_real = utils::cos(chorus_phase_increment * (2.0f * kPi));
     poly_float chorus_increment_imaginary = utils::sin(chorus_phase_increment * (2.0f * kPi));
-    poly_float current_chorus_real = utils::cos(container_phase);
-    poly_float current_chorus_imaginary = utils::sin(container_phase);
+    poly_float current_chorus_real[kMaxNetworkContainers / poly_float::kSize];
+    poly_float current_chorus_imaginary[kMaxNetworkContainers / poly_float::kSize];
+    for (int g = 0; g < num_chorus_groups; ++g) {
+      poly_float phase_offset = (poly_float(0.0f, 1.0f, 2.0f, 3.0f) + g * poly_float::kSize) * network_offset;
+      poly_float container_phase = phase_offset + chorus_phase_ * 2.0f * kPi;
+      current_chorus_real[g] = utils::cos(container_phase);
+      current_chorus_imaginary[g] = utils::sin(container_phase);
+    }
+    chorus_phase_ += num_samples * chorus_phase_increment;
+    chorus_phase_ -= std::floor(chorus_phase_);
 
-    poly_float delay1 = size_mult * kFeedbackDelays[0] * sample_rate_ratio;
-    poly_float delay2 = size_mult * kFeedbackDelays[1] * sample_rate_ratio;
-    poly_float delay3 = size_mult * kFeedbackDelays[2] * sample_rate_ratio;
-    poly_float delay4 = size_mult * kFeedbackDelays[3] * sample_rate_ratio;
+    poly_float delays[kMaxNetworkContainers];
+    poly_int integer_delays[kMaxNetworkContainers];
+    for (int c = 0; c < num_containers; ++c) {
+      delays[c] = size_mult * kFeedbackDelays[c] * sample_rate_ratio;
+      integer_delays[c] = utils::roundToInt(delays[c]);
+    }
 
     poly_float current_chorus_amount = chorus_amount_;
     chorus_amount_ = utils::clamp(input(kChorusAmount)->at(0)[0], 0.0f, 1.0f) * kMaxChorusDrift * sample_rate_ratio;
-    chorus_amount_ = utils::min(chorus_amount_, delay1 - 8 * poly_float::kSize);
-    chorus_amount_ = utils::min(chorus_amount_, delay2 - 8 * poly_float::kSize);
-    chorus_amount_ = utils::min(chorus_amount_, delay3 - 8 * poly_float::kSize);
-    chorus_amount_ = utils::min(chorus_amount_, delay4 - 8 * poly_float::kSize);
+    for (int c = 0; c < num_containers; ++c)
+      chorus_amount_ = utils::min(chorus_amount_, delays[c] - 8 * poly_float::kSize);
     poly_float delta_chorus_amount = (chorus_amount_ - current_chorus_amount) * tick_increment;
     current_chorus_amount = current_chorus_amount * size_mult;
+    bool legacy_network = quality_ == kStandard;
+    bool fractional_reads = legacy_network || chorus_amount_[0] > 0.0f || current_chorus_amount[0] > 0.0f;
 
     poly_float current_sample_delay = sample_delay_;
     poly_float current_delay_increment = sample_delay_increment_;
     poly_float end_target = current_sample_delay + current_delay_increment * num_samples;
-    poly_float target_delay = utils::clamp(input(kDelay)->at(0) * getSampleRate(), kMinDelay, kMaxSampleRate);
+    poly_float target_delay = utils::clamp(input(kDelay)->at(0) * sample_rate, kMinDelay, kMaxSampleRate);
     target_delay = utils::interpolate(sample_delay_, target_delay, kSampleDelayMultiplier);
     poly_float makeup_delay = target_delay - end_target;
     poly_float delta_delay_increment = makeup_delay / (0.5f * num_samples * num_samples) * kSampleIncrementMultiplier;
 
+    mono_float network_scale = 1.0f / std::sqrt(1.0f * network_size_);
+    mono_float mix_scale = legacy_network ? 1.0f : network_scale;
+    poly_float feedback_reads[kMaxNetworkContainers];
+    poly_float writes[kMaxNetworkContainers];
+    poly_float stores[kMaxNetworkContainers];
     for (int i = 0; i < num_samples; ++i) {
-      current_chorus_amount += delta_chorus_amount;
-      current_chorus_real = current_chorus_real * chorus_increment_real -
-                            current_chorus_imaginary * chorus_increment_imaginary;
-      current_chorus_imaginary = current_chorus_imaginary * chorus_increment_real +
-                                 current_chorus_real * chorus_increment_imaginary;
-      poly_float feedback_offset1 = delay1 + current_chorus_real * current_chorus_amount;
-      poly_float feedback_offset2 = delay2 - current_chorus_real * current_chorus_amount;
-      poly_float feedback_offset3 = delay3 + current_chorus_imaginary * current_chorus_amount;
-      poly_float feedback_offset4 = delay4 - current_chorus_imaginary * current_chorus_amount;
-      poly_float feedback_read1 = readFeedback(feedback_lookups1, feedback_offset1);
-      poly_float feedback_read2 = readFeedback(feedback_lookups2, feedback_offset2);
-      poly_float feedback_read3 = readFeedback(feedback_lookups3, feedback_offset3);
-      poly_float feedback_read4 = readFeedback(feedback_lookups4, feedback_offset4);
+      if (fractional_reads) {
+        current_chorus_amount += delta_chorus_amount;
+        for (int g = 0; g < num_chorus_groups; ++g) {
+          poly_float real = current_chorus_real[g] * chorus_increment_real -
+                            current_chorus_imaginary[g] * chorus_increment_imaginary;
+          current_chorus_imaginary[g] = current_chorus_imaginary[g] * chorus_increment_real +
+                                        real * chorus_increment_imaginary;
+          current_chorus_real[g] = real;
+        }
+
+        for (int c = 0; c < num_containers; ++c) {
+          int group = c / poly_float::kSize;
+          poly_float modulation = (c & 2) ? current_chorus_imaginary[group] : current_chorus_real[group];
+          modulation *= current_chorus_amount;
+          poly_float offset = (c & 1) ? delays[c] - modulation : delays[c] + modulation;
+          feedback_reads[c] = readFeedback(feedback_lookups_ + c * poly_float::kSize, offset);
+        }
+      }
+      else {
+        for (int c = 0; c < num_containers; ++c)
+          feedback_reads[c] = readIntegerFeedback(feedback_lookups_ + c * poly_float::kSize, integer_delays[c]);
+      }
 
       poly_float input = audio_in[i] & constants::kFirstMask;
       input += utils::swapVoices(input);
       poly_float filtered_input = high_pre_filter_.tickBasic(input, current_high_pre_coefficient);
       filtered_input = low_pre_filter_.tickBasic(input, current_low_pre_coefficient) - filtered_input;
-      poly_float scaled_input = filtered_input * 0.25f;
-
-      poly_float allpass_read1 = readAllpass(allpass_lookup1, allpass_offset1);
-      poly_float allpass_read2 = readAllpass(allpass_lookup2, allpass_offset2);
-      poly_float allpass_read3 = readAllpass(allpass_lookup3, allpass_offset3);
-      poly_float allpass_read4 = readAllpass(allpass_lookup4, allpass_offset4);
-      
-      poly_float allpass_delay_input1 = feedback_read1 - allpass_read1 * kAllpassFeedback;
-      poly_float allpass_delay_input2 = feedback_read2 - allpass_read2 * kAllpassFeedback;
-      poly_float allpass_delay_input3 = feedback_read3 - allpass_read3 * kAllpassFeedback;
-      poly_float allpass_delay_input4 = feedback_read4 - allpass_read4 * kAllpassFeedback;
+      poly_float scaled_input = filtered_input * network_scale;
 
       int allpass_write_index = write_index_ & poly_allpass_mask_;
-      allpass_lookups_[0][allpass_write_index] = scaled_input + allpass_delay_input1;
-      allpass_lookups_[1][allpass_write_index] = scaled_input + allpass_delay_input2;
-      allpass_lookups_[2][allpass_write_index] = scaled_input + allpass_delay_input3;
-      allpass_lookups_[3][allpass_write_index] = scaled_input + allpass_delay_input4;
-
-      poly_float allpass_output1 = allpass_read1 + allpass_delay_input1 * kAllpassFeedback;
-      poly_float allpass_output2 = allpass_read2 + allpass_delay_input2 * kAllpassFeedback;
-      poly_float allpass_output3 = allpass_read3 + allpass_delay_input3 * kAllpassFeedback;
-      poly_float allpass_output4 = allpass_read4 + allpass_delay_input4 * kAllpassFeedback;
-
-      poly_float total_rows = allpass_output1 + allpass_output2 + allpass_output3 + allpass_output4;
-      poly_float other_feedback = poly_float::mulAdd(total_rows.sum() * 0.25f, total_rows, -0.5f);
-
-      poly_float write1 = other_feedback + allpass_output1;
-      poly_float write2 = other_feedback + allpass_output2;
-      poly_float write3 = other_feedback + allpass_output3;
-      poly_float write4 = other_feedback + allpass_output4;
-
-      poly_float::transpose(allpass_output1.value, allpass_output2.value,
-                            allpass_output3.value, allpass_output4.value);
-      poly_float adjacent_feedback = (allpass_output1 + allpass_output2 + allpass_output3 + allpass_output4) * -0.5f;
-
-      write1 += adjacent_feedback[0];
-      write2 += adjacent_feedback[1];
-      write3 += adjacent_feedback[2];
-      write4 += adjacent_feedback[3];
-      poly_float high_filtered1 = high_shelf_filters_[0].tickBasic(write1, current_high_coefficient);
-      poly_float high_filtered2 = high_shelf_filters_[1].tickBasic(write2, current_high_coefficient);
-      poly_float high_filtered3 = high_shelf_filters_[2].tickBasic(write3, current_high_coefficient);
-      poly_float high_filtered4 = high_shelf_filters_[3].tickBasic(write4, current_high_coefficient);
-      write1 = high_filtered1 + current_high_amplitude * (write1 - high_filtered1);
-      write2 = high_filtered2 + current_high_amplitude * (write2 - high_filtered2);
-      write3 = high_filtered3 + current_high_amplitude * (write3 - high_filtered3);
-      write4 = high_filtered4 + current_high_amplitude * (write4 - high_filtered4);
-
-      poly_float low_filtered1 = low_shelf_filters_[0].tickBasic(write1, current_low_coefficient);
-      poly_float low_filtered2 = low_shelf_filters_[1].tickBasic(write2, current_low_coefficient);
-      poly_float low_filtered3 = low_shelf_filters_[2].tickBasic(write3, current_low_coefficient);
-      poly_float low_filtered4 = low_shelf_filters_[3].tickBasic(write4, current_low_coefficient);
-      write1 -= low_filtered1 * current_low_amplitude;
-      write2 -= low_filtered2 * current_low_amplitude;
-      write3 -= low_filtered3 * current_low_amplitude;
-      write4 -= low_filtered4 * current_low_amplitude;
-
-      current_decay1 += delta_decay1;
-      current_decay2 += delta_decay2;
-      current_decay3 += delta_decay3;
-      current_decay4 += delta_decay4;
-      poly_float store1 = current_decay1 * write1;
-      poly_float store2 = current_decay2 * write2;
-      poly_float store3 = current_decay3 * write3;
-      poly_float store4 = current_decay4 * write4;
-      feedback_lookups1[0][write_index_] = store1[0];
-      feedback_lookups1[1][write_index_] = store1[1];
-      feedback_lookups1[2][write_index_] = store1[2];
-      feedback_lookups1[3][write_index_] = store1[3];
-      feedback_lookups2[0][write_index_] = store2[0];
-      feedback_lookups2[1][write_index_] = store2[1];
-      feedback_lookups2[2][write_index_] = store2[2];
-      feedback_lookups2[3][write_index_] = store2[3];
-      feedback_lookups3[0][write_index_] = store3[0];
-      feedback_lookups3[1][write_index_] = store3[1];
-      feedback_lookups3[2][write_index_] = store3[2];
-      feedback_lookups3[3][write_index_] = store3[3];
-      feedback_lookups4[0][write_index_] = store4[0];
-      feedback_lookups4[1][write_index_] = store4[1];
-      feedback_lookups4[2][write_index_] = store4[2];
-      feedback_lookups4[3][write_index_] = store4[3];
+      for (int c = 0; c < num_containers; ++c) {
+        const mono_float* allpass_lookup = (mono_float*)allpass_lookups_[c].get();
+        poly_float allpass_read = readAllpass(allpass_lookup, allpass_offsets[c]);
+        poly_float allpass_delay_input = feedback_reads[c] - allpass_read * kAllpassFeedback;
+        allpass_lookups_[c][allpass_write_index] = scaled_input + allpass_delay_input;
+        writes[c] = (allpass_read + allpass_delay_input * kAllpassFeedback) * mix_scale;
+      }
+
+      if (legacy_network)
+        mixLegacyNetwork(writes);
+      else
+        utils::hadamardTransform(writes, num_containers);
+
+      poly_float total = 0.0f;
+      for (int c = 0; c < num_containers; ++c) {
+        poly_float write = writes[c];
+        poly_float high_filtered = high_shelf_filters_[c].tickBasic(write, current_high_coefficient);
+        write = high_filtered + current_high_amplitude * (write - high_filtered);
+        poly_float low_filtered = low_shelf_filters_[c].tickBasic(write, current_low_coefficient);
+        write -= low_filtered * current_low_amplitude;
+        total += write;
+
+        current_decays[c] += delta_decays[c];
+        poly_float store = current_decays[c] * write;
+        mono_float* const* lookups = feedback_lookups_ + c * poly_float::kSize;
+        lookups[0][write_index_] = store[0];
+        lookups[1][write_index_] = store[1];
+        lookups[2][write_index_] = store[2];
+        lookups[3][write_index_] = store[3];
+        stores[c] = store * mix_scale;
+      }
 
       write_index_ = (write_index_ + 1) & feedback_mask_;
 
-      poly_float total_allpass = store1 + store2 + store3 + store4;
-      poly_float other_feedback_allpass = poly_float::mulAdd(total_allpass.sum() * 0.25f, total_allpass, -0.5f);
-
-      poly_float feed_forward1 = other_feedback_allpass + store1;
-      poly_float feed_forward2 = other_feedback_allpass + store2;
-      poly_float feed_forward3 = other_feedback_allpass + store3;
-      poly_float feed_forward4 = other_feedback_allpass + store4;
-
-      poly_float::transpose(store1.value, store2.value, store3.value, store4.value);
-      poly_float adjacent_feedback_allpass = (store1 + store2 + store3 + store4) * -0.5f;
-
-      feed_forward1 += adjacent_feedback_allpass[0];
-      feed_forward2 += adjacent_feedback_allpass[1];
-      feed_forward3 += adjacent_feedback_allpass[2];
-      feed_forward4 += adjacent_feedback_allpass[3];
-
-      poly_float total = write1 + write2 + write3 + write4;
-      total += (feed_forward1 * current_decay1 + feed_forward2 * current_decay2 +
-                feed_forward3 * current_decay3 + feed_forward4 * current_decay4) * 0.125f;
+      if (legacy_network)
+        mixLegacyNetwork(stores);
+      else
+        utils::hadamardTransform(stores, num_containers);
+      poly_float feed_forward = 0.0f;
+      for (int c = 0; c < num_containers; ++c)
+        feed_forward += stores[c] * current_decays[c];
+      total += feed_forward * 0.125f;
 
       memory_->push(total + utils::swapVoices(total));
-      audio_out[i] = current_wet * memory_->get(current_sample_delay) + current_dry * input;
+      network_output_[i] = memory_->get(current_sample_delay);
 
       current_delay_increment += delta_delay_increment;
       current_sample_delay += current_delay_increment;
       current_sample_delay = utils::clamp(current_sample_delay, kMinDelay, kMaxSampleRate);
-      current_dry += delta_dry;
-      current_wet += delta_wet;
       current_high_coefficient += delta_high_coefficient;
       current_high_amplitude += delta_high_amplitude;
     }
@@ -365,30 +435,22 @@ namespace vital {
 
   void Reverb::setOversampleAmount(int oversample_amount) {
     Processor::setOversampleAmount(oversample_amount);
+    if (runsAtBaseRate(quality_))
+      downsample_ = oversample_amount;
     setupBuffersForSampleRate(getSampleRate());
   }
 
   void Reverb::hardReset() {
     wet_ = 0.0f;
     dry_ = 0.0f;
-    low_pre_filter_.reset(constants::kFullMask);
-    high_pre_filter_.reset(constants::kFullMask);
     chorus_amount_ = utils::clamp(input(kChorusAmount)->at(0)[0], 0.0f, 1.0f) * kMaxChorusDrift;
+    clearNetwork();
+  }
 
-    for (int i = 0; i < kNetworkContainers; ++i) {
-      low_shelf_filters_[i].reset(constants::kFullMask);
-      high_shelf_filters_[i].reset(constants::kFullMask);
-      decays_[i] = 0.0f;
-    }
-
-    for (int n = 0; n < kNetworkContainers; ++n) {
-      for (int i = 0; i < max_allpass_size_; ++i)
-        allpass_lookups_[n][i] = 0.0f;
-    }
-
-    for (int n = 0; n < kNetworkSize; ++n) {
-      for (int i = 0; i < max_feedback_size_ + kExtraLookupSample; ++i)
-        feedback_memories_[n][i] = 0.0f;
-    }
+  int Reverb::getTailSamples() {
+    mono_float decay_time = utils::clamp(input(kDecayTime)->at(0)[0], kMinDecayTime, kMaxDecayTime);
+    mono_float num_decays = std::log(kTailSilenceAmplitude) / std::log(kT60Amplitude);
+    mono_float pre_delay = utils::max(input(kDelay)->at(0)[0], 0.0f);
+    return (num_decays * decay_time + pre_delay) * getSampleRate();
   }
 } // namespace vital
@@ -31,17 +31,32 @@ namespace vital {
 
       static constexpr int kBaseSampleRate = 44100;
       static constexpr int kDefaultSampleRate = 88200;
-      static constexpr int kNetworkSize = 16;
+      static constexpr int kMaxNetworkSize = 64;
       static constexpr int kBaseFeedbackBits = 14;
       static constexpr int kExtraLookupSample = 4;
       static constexpr int kBaseAllpassBits = 10;
-      static constexpr int kNetworkContainers = kNetworkSize / poly_float::kSize;
+      static constexpr int kMaxNetworkContainers = kMaxNetworkSize / poly_float::kSize;
       static constexpr int kMinSizePower = -3;
       static constexpr int kMaxSizePower = 1;
       static constexpr float kSizePowerRange = kMaxSizePower - kMinSizePower;
+      static constexpr int kMaxNetworkSamples = kMaxBufferSize * kMaxOversample;
+
+      static const poly_int kAllpassDelays[kMaxNetworkContainers];
+      static const poly_float kFeedbackDelays[kMaxNetworkContainers];
+
+      // Trades density for CPU. The lighter settings run the network at the base sample rate instead of the
+      // oversampled engine rate.
+      enum Quality {
+        kEco,
+        kLight,
+        kStandard,
+        kDense,
+        kUltra,
+        kNumQualities
+      };
 
-      static const poly_int kAllpassDelays[kNetworkContainers];
-      static const poly_float kFeedbackDelays[kNetworkContainers];
+      static int getNetworkSize(int quality);
+      static bool runsAtBaseRate(int quality) { return quality < kStandard; }
 
       enum {
         kAudio,
@@ -58,6 +73,7 @@ namespace vital {
         kSize,
         kDelay,
         kWet,
+        kQuality,
         kNumInputs
       };
 
@@ -78,6 +94,9 @@ namespace vital {
       void setOversampleAmount(int oversample_amount) override;
       void setupBuffersForSampleRate(int sample_rate);
       void hardReset() override;
+      int getTailSamples();
+      force_inline int getNetworkSize() const { return network_size_; }
+      force_inline int getNetworkSampleRate() { return getSampleRate() / downsample_; }
 
       force_inline poly_float readFeedback(const mono_float* const* lookups, poly_float offset) {
         poly_float write_offset = poly_float(write_index_) - offset;
@@ -90,6 +109,12 @@ namespace vital {
         return interpolation_matrix.multiplyAndSumRows(value_matrix);
       }
 
+      force_inline poly_float readIntegerFeedback(const mono_float* const* lookups, poly_int offset) {
+        poly_int indices = (poly_int(write_index_) - offset) & feedback_mask_;
+        return poly_float(lookups[0][indices[0]], lookups[1][indices[1]],
+                          lookups[2][indices[2]], lookups[3][indices[3]]);
+      }
+
       force_inline poly_float readAllpass(const mono_float* lookup, poly_int offset) {
         poly_int indices = (poly_int(write_index_ * poly_float::kSize) - offset) & allpass_mask_;
         return poly_float(lookup[indices[0]], lookup[indices[1]], lookup[indices[2]], lookup[indices[3]]);
@@ -105,15 +130,39 @@ namespace vital {
       virtual Processor* clone() const override { VITAL_ASSERT(false); return nullptr; }
 
     private:
+      // The network that shipped before quality settings existed. Standard keeps it so presets sound the same.
+      static force_inline void mixLegacyNetwork(poly_float* values) {
+        poly_float total_rows = values[0] + values[1] + values[2] + values[3];
+        poly_float other_feedback = poly_float::mulAdd(total_rows.sum() * 0.25f, total_rows, -0.5f);
+
+        poly_float rows[] = { values[0], values[1], values[2], values[3] };
+        poly_float::transpose(rows[0].value, rows[1].value, rows[2].value, rows[3].value);
+        poly_float adjacent_feedback = (rows[0] + rows[1] + rows[2] + rows[3]) * -0.5f;
+
+        for (int i = 0; i < poly_float::kSize; ++i) {
+          values[i] = other_feedback + values[i];
+          values[i] += adjacent_feedback[i];
+        }
+      }
+
+      void setQuality(int quality);
+      void clearLines(int start, int end);
+      void clearNetwork();
+      void processNetwork(const poly_float* audio_in, int num_samples);
+
       std::unique_ptr<StereoMemory> memory_;
 
-      std::unique_ptr<poly_float[]> allpass_lookups_[kNetworkContainers];
-      std::unique_ptr<mono_float[]> feedback_memories_[kNetworkSize];
-      mono_float* feedback_lookups_[kNetworkSize];
-      poly_float decays_[kNetworkContainers];
+      std::unique_ptr<poly_float[]> allpass_lookups_[kMaxNetworkContainers];
+      std::unique_ptr<mono_float[]> feedback_memories_[kMaxNetworkSize];
+      mono_float* feedback_lookups_[kMaxNetworkSize];
+      poly_float decays_[kMaxNetworkContainers];
+
+      OnePoleFilter<> low_shelf_filters_[kMaxNetworkContainers];
+      OnePoleFilter<> high_shelf_filters_[kMaxNetworkContainers];
 
-      OnePoleFilter<> low_shelf_filters_[kNetworkContainers];
-      OnePoleFilter<> high_shelf_filters_[kNetworkContainers];
+      poly_float downsampled_input_[kMaxNetworkSamples];
+      poly_float network_output_[kMaxNetworkSamples];
+      poly_float last_network_output_;
 
       OnePoleFilter<> low_pre_filter_;
       OnePoleFilter<> high_pre_filter_;
@@ -135,6 +184,10 @@ namespace vital {
       poly_float wet_;
       int write_index_;
 
+      int quality_;
+      int network_size_;
+      int downsample_;
+      int num_dirty_lines_;
       int max_allpass_size_;
       int max_feedback_size_;
       int feedback_mask_;
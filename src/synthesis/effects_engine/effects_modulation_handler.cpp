@@ -249,8 +249,7 @@ namespace vital {
     note_retriggered_.clearTrigger();
 
     if (getNumActiveVoices() == 0) {
-      for (auto& status_source : data_->status_outputs)
-        status_source.second->clear();
+      clearStatusOutputs();
     }
     else {
       poly_mask voice_mask = getCurrentVoiceMask();
@@ -262,8 +261,7 @@ namespace vital {
           buffer[0] = masked_value + utils::swapVoices(masked_value);
         }
       }
-      for (auto& status_source : data_->status_outputs)
-        status_source.second->update(voice_mask);
+      updateStatusOutputs(voice_mask);
     }
   }
 
@@ -236,8 +236,7 @@ namespace vital {
     upsampler_->processWithInput(audio_in, num_samples);
     ProcessorRouter::process(num_samples);
 
-    for (auto& status_source : data_->status_outputs)
-      status_source.second->update();
+    updateStatusOutputs();
   }
 
   void SoundEngine::correctToTime(double seconds) {
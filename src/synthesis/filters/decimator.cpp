@@ -16,33 +16,66 @@
 
 #include "decimator.h"
 
+#include "fir_halfband_decimator.h"
 #include "iir_halfband_decimator.h"
 
 namespace vital {
-  Decimator::Decimator(int max_stages) : ProcessorRouter(kNumInputs, 1), max_stages_(max_stages) {
+  Decimator::Decimator(int max_stages) : ProcessorRouter(kNumInputs, 1), max_stages_(max_stages),
+                                         quality_(constants::kStandardOversampling) {
     num_stages_ = -1;
     for (int i = 0; i < max_stages_; ++i) {
       IirHalfbandDecimator* stage = new IirHalfbandDecimator();
       stage->setOversampleAmount(1 << (max_stages_ - i - 1));
       addProcessor(stage);
-      stages_.push_back(stage);
+      iir_stages_.push_back(stage);
+    }
+
+    for (int i = 0; i < max_stages_; ++i) {
+      FirHalfbandDecimator* stage = new FirHalfbandDecimator();
+      stage->setOversampleAmount(1 << (max_stages_ - i - 1));
+      addProcessor(stage);
+      fir_stages_.push_back(stage);
     }
   }
 
   Decimator::~Decimator() { }
 
   void Decimator::init() {
-    stages_[0]->useInput(input(kAudio));
-    stages_[0]->useOutput(output());
+    iir_stages_[0]->useInput(input(kAudio));
+    iir_stages_[0]->useOutput(output());
+    fir_stages_[0]->useInput(input(kAudio));
+    fir_stages_[0]->useOutput(output());
     for (int i = 1; i < max_stages_; ++i) {
-      stages_[i]->plug(stages_[i - 1], IirHalfbandDecimator::kAudio);
-      stages_[i]->useOutput(output());
+      iir_stages_[i]->plug(iir_stages_[i - 1], IirHalfbandDecimator::kAudio);
+      iir_stages_[i]->useOutput(output());
+      fir_stages_[i]->plug(fir_stages_[i - 1], FirHalfbandDecimator::kAudio);
+      fir_stages_[i]->useOutput(output());
     }
   }
 
   void Decimator::reset(poly_mask reset_mask) {
-    for (int i = 0; i < max_stages_; ++i)
-      stages_[i]->reset(reset_mask);
+    for (int i = 0; i < max_stages_; ++i) {
+      iir_stages_[i]->reset(reset_mask);
+      fir_stages_[i]->reset(reset_mask);
+    }
+  }
+
+  void Decimator::setQuality(constants::OversamplingQuality quality) {
+    if (quality == quality_)
+      return;
+
+    quality_ = quality;
+    num_stages_ = -1;
+  }
+
+  int Decimator::getLatency(int num_stages) const {
+    if (quality_ != constants::kLinearPhaseOversampling || num_stages <= 0)
+      return 0;
+
+    int latency = FirHalfbandDecimator::getLatency(true);
+    for (int i = 1; i < num_stages; ++i)
+      latency += FirHalfbandDecimator::getLatency(false) >> i;
+    return latency;
   }
 
   void Decimator::process(int num_samples) {
@@ -65,20 +98,28 @@ namespace vital {
     }
 
     if (num_stages != num_stages_) {
-      for (int i = 0; i < num_stages; ++i)
-        stages_[i]->reset(constants::kFullMask);
+      for (int i = 0; i < num_stages; ++i) {
+        iir_stages_[i]->reset(constants::kFullMask);
+        fir_stages_[i]->reset(constants::kFullMask);
+      }
 
       num_stages_ = num_stages;
 
+      bool linear_phase = quality_ == constants::kLinearPhaseOversampling;
       for (int i = 0; i < max_stages_; ++i) {
-        IirHalfbandDecimator* stage = stages_[i];
+        IirHalfbandDecimator* iir_stage = iir_stages_[i];
+        FirHalfbandDecimator* fir_stage = fir_stages_[i];
         bool should_enable = i < num_stages;
-        stage->enable(should_enable);
-        stage->setSharpCutoff(i == num_stages - 1);
+        bool last_stage = i == num_stages - 1;
+        iir_stage->enable(should_enable && !linear_phase);
+        iir_stage->setSharpCutoff(last_stage && quality_ == constants::kStandardOversampling);
+        fir_stage->enable(should_enable && linear_phase);
+        fir_stage->setSharpCutoff(last_stage);
 
         if (should_enable) {
           int oversample_amount = 1 << (num_stages - i - 1);
-          stage->setOversampleAmount(oversample_amount);
+          iir_stage->setOversampleAmount(oversample_amount);
+          fir_stage->setOversampleAmount(oversample_amount);
         }
       }
     }
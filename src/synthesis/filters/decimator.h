@@ -21,6 +21,7 @@
 
 namespace vital {
 
+  class FirHalfbandDecimator;
   class IirHalfbandDecimator;
 
   class Decimator : public ProcessorRouter {
@@ -41,11 +42,19 @@ namespace vital {
       virtual void process(int num_samples) override;
       virtual void setOversampleAmount(int) override { }
 
+      void setQuality(constants::OversamplingQuality quality);
+      force_inline constants::OversamplingQuality getQuality() const { return quality_; }
+
+      // Delay in output samples added by num_stages stages. The IIR stages are minimum phase and report none.
+      int getLatency(int num_stages) const;
+
     private:
       int num_stages_;
       int max_stages_;
+      constants::OversamplingQuality quality_;
 
-      std::vector<IirHalfbandDecimator*> stages_;
+      std::vector<IirHalfbandDecimator*> iir_stages_;
+      std::vector<FirHalfbandDecimator*> fir_stages_;
 
       JUCE_LEAK_DETECTOR(Decimator)
   };
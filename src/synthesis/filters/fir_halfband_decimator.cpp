@@ -14,107 +14,110 @@
  * along with vital.  If not, see <http://www.gnu.org/licenses/>.
  */
 
+
 #include "fir_halfband_decimator.h"
 #include "poly_utils.h"
 
+#include <cmath>
+#include <cstring>
+
 namespace vital {
-  FirHalfbandDecimator::FirHalfbandDecimator() : Processor(kNumInputs, 1) {
-    static const mono_float coefficients[kNumTaps] = {
-      0.000088228877315364f,
-      0.000487010018128278f,
-      0.000852264975437944f,
-      -0.001283563593466774f,
-      -0.010130591831925894f,
-      -0.025688727779244691f,
-      -0.036346596505004387f,
-      -0.024088355516718698f,
-      0.012246773417129486f,
-      0.040021434054637831f,
-      0.017771298164062477f,
-      -0.046866403416502632f,
-      -0.075597513455990611f,
-      0.013331126342402619f,
-      0.202889888191404910f,
-      0.362615173769444080f,
-      0.362615173769444080f,
-      0.202889888191404910f,
-      0.013331126342402619f,
-      -0.075597513455990611f,
-      -0.046866403416502632f,
-      0.017771298164062477f,
-      0.040021434054637831f,
-      0.012246773417129486f,
-      -0.024088355516718698f,
-      -0.036346596505004387f,
-      -0.025688727779244691f,
-      -0.010130591831925894f,
-      -0.001283563593466774f,
-      0.000852264975437944f,
-      0.000487010018128278f,
-      0.000088228877315364f,
+
+  namespace {
+    constexpr double kKaiserBeta = 8.0;
+
+    double besselI0(double value) {
+      double sum = 1.0;
+      double term = 1.0;
+      for (int k = 1; term > 1e-12 * sum; ++k) {
+        double factor = value / (2.0 * k);
+        term *= factor * factor;
+        sum += term;
+      }
+      return sum;
+    }
+
+    // Side taps of a Kaiser windowed halfband with 2 * num_taps - 1 taps, scaled to sum to one half like
+    // the center tap so the passband is flat.
+    void createSideTaps(mono_float* taps, int num_taps) {
+      double center = num_taps - 1.0;
+      double window_scale = 1.0 / besselI0(kKaiserBeta);
+      double values[FirHalfbandDecimator::kNumTaps127];
+      double total = 0.0;
+      for (int t = 0; t < num_taps; ++t) {
+        double offset = 2.0 * t - center;
+        double sinc = std::sin(0.5 * kPi * offset) / (kPi * offset);
+        double ratio = offset / center;
+        double window = besselI0(kKaiserBeta * std::sqrt(1.0 - ratio * ratio)) * window_scale;
+        values[t] = sinc * window;
+        total += values[t];
+      }
+
+      for (int t = 0; t < num_taps; ++t)
+        taps[t] = values[t] * 0.5 / total;
+    }
+
+    struct HalfbandTaps {
+      HalfbandTaps() {
+        createSideTaps(taps35, FirHalfbandDecimator::kNumTaps35);
+        createSideTaps(taps127, FirHalfbandDecimator::kNumTaps127);
+      }
+
+      mono_float taps35[FirHalfbandDecimator::kNumTaps35];
+      mono_float taps127[FirHalfbandDecimator::kNumTaps127];
     };
 
-    for (int i = 0; i < kNumTaps / 2; ++i)
-      taps_[i] = poly_float(coefficients[2 * i], coefficients[2 * i + 1]);
+    const HalfbandTaps& getHalfbandTaps() {
+      static const HalfbandTaps taps;
+      return taps;
+    }
+  } // namespace
+
+  FirHalfbandDecimator::FirHalfbandDecimator() : Processor(kNumInputs, 1), sharp_cutoff_(false) {
+    getHalfbandTaps();
     reset(constants::kFullMask);
   }
 
-  void FirHalfbandDecimator::saveMemory(int num_samples) {
-    int input_buffer_size = 2 * num_samples;
-    poly_float* audio = input(kAudio)->source->buffer;
+  void FirHalfbandDecimator::process(int num_samples) {
+    static constexpr int kStride = poly_float::kSize;
 
-    int start_audio_index = input_buffer_size - kNumTaps + 2;
-    for (int i = 0; i < kNumTaps / 2 - 1; ++i) {
-      int audio_index = start_audio_index + 2 * i;
-      memory_[i] = utils::consolidateAudio(audio[audio_index], audio[audio_index + 1]);
+    const HalfbandTaps& halfband_taps = getHalfbandTaps();
+    int num_taps = kNumTaps35;
+    const mono_float* taps = halfband_taps.taps35;
+    if (sharp_cutoff_) {
+      num_taps = kNumTaps127;
+      taps = halfband_taps.taps127;
     }
-  }
 
-  void FirHalfbandDecimator::process(int num_samples) {
-    const poly_float* audio = input(kAudio)->source->buffer;
     int output_buffer_size = num_samples;
-    VITAL_ASSERT(output_buffer_size > kNumTaps / 2);
+    VITAL_ASSERT(output_buffer_size <= kMaxOutputSamples);
     VITAL_ASSERT(input(kAudio)->source->buffer_size >= 2 * output_buffer_size);
 
-    poly_float* audio_out = output()->buffer;
-    for (int memory_start = 0; memory_start < kNumTaps / 2 - 1; ++memory_start) {
-      poly_float sum = 0.0f;
-
-      int tap_index = 0;
-      int num_memory = kNumTaps / 2 - memory_start - 1;
-      for (; tap_index < num_memory; ++tap_index)
-        sum = utils::mulAdd(sum, memory_[tap_index + memory_start], taps_[tap_index]);
-
-      int audio_index = 0;
-      for (; tap_index < kNumTaps / 2; ++tap_index) {
-        poly_float consolidated = utils::consolidateAudio(audio[audio_index], audio[audio_index + 1]);
-        sum = utils::mulAdd(sum, consolidated, taps_[tap_index]);
-        audio_index += 2;
-      }
-
-      audio_out[memory_start] = utils::sumSplitAudio(sum);
+    // Input is copied out first so the output can share the input buffer.
+    int memory_size = 2 * (num_taps - 1);
+    const mono_float* audio = reinterpret_cast<const mono_float*>(input(kAudio)->source->buffer);
+    for (int i = 0; i < output_buffer_size; ++i) {
+      const mono_float* frame = audio + 2 * i * kStride;
+      center_memory_[memory_size + 2 * i] = frame[0];
+      center_memory_[memory_size + 2 * i + 1] = frame[1];
+      side_memory_[memory_size + 2 * i] = frame[kStride];
+      side_memory_[memory_size + 2 * i + 1] = frame[kStride + 1];
     }
 
-    int out_index = kNumTaps / 2 - 1;
-    int audio_start = 0;
-    for (; out_index < output_buffer_size; ++out_index) {
-      poly_float sum = 0.0f;
-      int audio_index = audio_start;
-      for (int tap_index = 0; tap_index < kNumTaps / 2; ++tap_index) {
-        poly_float consolidated = utils::consolidateAudio(audio[audio_index], audio[audio_index + 1]);
-        sum = utils::mulAdd(sum, consolidated, taps_[tap_index]);
-        audio_index += 2;
-      }
-      audio_start += 2;
+    kernels::get().polyphase(result_, side_memory_, center_memory_, taps, num_taps,
+                             0.5f, num_taps / 2, output_buffer_size);
 
-      audio_out[out_index] = utils::sumSplitAudio(sum);
-    }
+    poly_float* audio_out = output()->buffer;
+    for (int i = 0; i < output_buffer_size; ++i)
+      audio_out[i] = poly_float(result_[2 * i], result_[2 * i + 1]);
 
-    saveMemory(num_samples);
+    int consumed = 2 * output_buffer_size;
+    memmove(center_memory_, center_memory_ + consumed, memory_size * sizeof(mono_float));
+    memmove(side_memory_, side_memory_ + consumed, memory_size * sizeof(mono_float));
   }
 
   void FirHalfbandDecimator::reset(poly_mask reset_mask) {
-    for (int i = 0; i < kNumTaps / 2 - 1; ++i)
-      memory_[i] = 0.0f;
+    memset(center_memory_, 0, sizeof(center_memory_));
+    memset(side_memory_, 0, sizeof(side_memory_));
   }
 } // namespace vital
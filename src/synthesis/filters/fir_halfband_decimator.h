@@ -14,6 +14,7 @@
  * along with vital.  If not, see <http://www.gnu.org/licenses/>.
  */
 
+
 #pragma once
 
 #include "processor.h"
@@ -21,30 +22,39 @@
 
 namespace vital {
 
+  // Linear phase halfband decimator. Every other tap of a halfband filter is zero, so the odd input samples go
+  // through the nonzero side taps and the even input samples only through the center tap.
   class FirHalfbandDecimator : public Processor {
     public:
-      static constexpr int kNumTaps = 32;
+      static constexpr int kNumTaps35 = 18;
+      static constexpr int kNumTaps127 = 64;
+      static constexpr int kMaxOutputSamples = kMaxBufferSize * kMaxOversample / 2;
+      static constexpr int kBufferSize = 2 * (kNumTaps127 - 1 + kMaxOutputSamples);
 
       enum {
         kAudio,
         kNumInputs
       };
 
+      static force_inline int getLatency(bool sharp_cutoff) {
+        return (sharp_cutoff ? kNumTaps127 : kNumTaps35) / 2 - 1;
+      }
+
       FirHalfbandDecimator();
       virtual ~FirHalfbandDecimator() { }
 
       virtual Processor* clone() const override { return new FirHalfbandDecimator(*this); }
 
-      void saveMemory(int num_samples);
       virtual void process(int num_samples) override;
-
-    private:
       void reset(poly_mask reset_mask) override;
+      force_inline void setSharpCutoff(bool sharp_cutoff) { sharp_cutoff_ = sharp_cutoff; }
 
-      poly_float memory_[kNumTaps / 2 - 1];
-      poly_float taps_[kNumTaps / 2];
+    private:
+      bool sharp_cutoff_;
+      mono_float center_memory_[kBufferSize];
+      mono_float side_memory_[kBufferSize];
+      mono_float result_[2 * kMaxOutputSamples];
 
       JUCE_LEAK_DETECTOR(FirHalfbandDecimator)
   };
 } // namespace vital
-
@@ -65,6 +65,8 @@ namespace vital {
 
   constexpr int kPpq = 960; // Pulses per quarter note.
   constexpr mono_float kVoiceKillTime = 0.05f;
+  constexpr mono_float kTailSilenceAmplitude = 0.000001f;
+  constexpr int kMaxTailSamples = 1 << 30;
   constexpr int kNumMidiChannels = 16;
   constexpr int kFirstMidiChannel = 0;
   constexpr int kLastMidiChannel = kNumMidiChannels - 1;
@@ -0,0 +1,515 @@
+/* Copyright 2013-2019 Matt Tytel
+ *
+ * vital is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * vital is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with vital.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "dsp_kernels.h"
+
+#include <cstdlib>
+#include <cstring>
+
+#if VITAL_SSE2 && !defined(__EMSCRIPTEN__)
+  #define VITAL_KERNEL_DISPATCH 1
+#else
+  #define VITAL_KERNEL_DISPATCH 0
+#endif
+
+#if defined(_MSC_VER) && !defined(__clang__)
+  #include <intrin.h>
+  #define VITAL_KERNEL_TARGET(isa)
+#else
+  #define VITAL_KERNEL_TARGET(isa) __attribute__((target(isa)))
+#endif
+
+namespace vital {
+  namespace kernels {
+    namespace {
+      void zeroScalar(mono_float* dest, int size) {
+        memset(dest, 0, size * sizeof(mono_float));
+      }
+
+      void copyScalar(mono_float* dest, const mono_float* source, int size) {
+        for (int i = 0; i < size; ++i)
+          dest[i] = source[i];
+      }
+
+      void interpolateScalar(mono_float* dest, const mono_float* buffer, const uint32_t* phases,
+                             int fraction_bits, int size) {
+        uint32_t fraction_mask = (1u << fraction_bits) - 1;
+        mono_float fraction_scale = 1.0f / (1u << fraction_bits);
+        for (int i = 0; i < size; ++i) {
+          uint32_t index = phases[i] >> fraction_bits;
+          mono_float t = (phases[i] & fraction_mask) * fraction_scale;
+          dest[i] = buffer[index] + t * (buffer[index + 1] - buffer[index]);
+        }
+      }
+
+      void halfbandScalar(mono_float* dest, const mono_float* source, int stride,
+                          const mono_float* taps, int num_taps, int num_outputs) {
+        for (int i = 0; i < num_outputs; ++i) {
+          const mono_float* start = source + 2 * i * stride;
+          mono_float left = 0.0f;
+          mono_float right = 0.0f;
+          for (int t = 0; t < num_taps; ++t) {
+            left += taps[t] * start[t * stride];
+            right += taps[t] * start[t * stride + 1];
+          }
+
+          mono_float* frame = dest + i * stride;
+          for (int c = 0; c < stride; c += 2) {
+            frame[c] = left;
+            frame[c + 1] = right;
+          }
+        }
+      }
+
+      void polyphaseScalar(mono_float* dest, const mono_float* source, const mono_float* center_source,
+                           const mono_float* taps, int num_taps, mono_float center, int center_offset,
+                           int num_outputs) {
+        for (int i = 0; i < num_outputs; ++i) {
+          const mono_float* start = source + 2 * i;
+          const mono_float* center_start = center_source + 2 * (i + center_offset);
+          mono_float left = center * center_start[0];
+          mono_float right = center * center_start[1];
+          for (int t = 0; t < num_taps; ++t) {
+            left += taps[t] * start[2 * t];
+            right += taps[t] * start[2 * t + 1];
+          }
+
+          dest[2 * i] = left;
+          dest[2 * i + 1] = right;
+        }
+      }
+
+    #if VITAL_SSE2
+      void copySse2(mono_float* dest, const mono_float* source, int size) {
+        int i = 0;
+        for (; i + 4 <= size; i += 4)
+          _mm_storeu_ps(dest + i, _mm_loadu_ps(source + i));
+        copyScalar(dest + i, source + i, size - i);
+      }
+
+      void halfbandSse2(mono_float* dest, const mono_float* source, int stride,
+                        const mono_float* taps, int num_taps, int num_outputs) {
+        if (stride != kFrameSize) {
+          halfbandScalar(dest, source, stride, taps, num_taps, num_outputs);
+          return;
+        }
+
+        for (int i = 0; i < num_outputs; ++i) {
+          const mono_float* start = source + 2 * i * kFrameSize;
+          __m128 sum = _mm_setzero_ps();
+          for (int t = 0; t < num_taps; ++t)
+            sum = _mm_add_ps(sum, _mm_mul_ps(_mm_loadu_ps(start + t * kFrameSize), _mm_set1_ps(taps[t])));
+          _mm_storeu_ps(dest + i * kFrameSize, _mm_movelh_ps(sum, sum));
+        }
+      }
+
+      void polyphaseSse2(mono_float* dest, const mono_float* source, const mono_float* center_source,
+                         const mono_float* taps, int num_taps, mono_float center, int center_offset,
+                         int num_outputs) {
+        const __m128 center_value = _mm_set1_ps(center);
+
+        int i = 0;
+        for (; i + 4 <= num_outputs; i += 4) {
+          const mono_float* start = source + 2 * i;
+          const mono_float* center_start = center_source + 2 * (i + center_offset);
+          __m128 sum1 = _mm_mul_ps(_mm_loadu_ps(center_start), center_value);
+          __m128 sum2 = _mm_mul_ps(_mm_loadu_ps(center_start + 4), center_value);
+          for (int t = 0; t < num_taps; ++t) {
+            __m128 tap = _mm_set1_ps(taps[t]);
+            sum1 = _mm_add_ps(sum1, _mm_mul_ps(_mm_loadu_ps(start + 2 * t), tap));
+            sum2 = _mm_add_ps(sum2, _mm_mul_ps(_mm_loadu_ps(start + 2 * t + 4), tap));
+          }
+          _mm_storeu_ps(dest + 2 * i, sum1);
+          _mm_storeu_ps(dest + 2 * i + 4, sum2);
+        }
+
+        polyphaseScalar(dest + 2 * i, source + 2 * i, center_source + 2 * i, taps, num_taps,
+                        center, center_offset, num_outputs - i);
+      }
+    #elif VITAL_NEON
+      void copyNeon(mono_float* dest, const mono_float* source, int size) {
+        int i = 0;
+        for (; i + 4 <= size; i += 4)
+          vst1q_f32(dest + i, vld1q_f32(source + i));
+        copyScalar(dest + i, source + i, size - i);
+      }
+
+      void halfbandNeon(mono_float* dest, const mono_float* source, int stride,
+                        const mono_float* taps, int num_taps, int num_outputs) {
+        if (stride != kFrameSize) {
+          halfbandScalar(dest, source, stride, taps, num_taps, num_outputs);
+          return;
+        }
+
+        for (int i = 0; i < num_outputs; ++i) {
+          const mono_float* start = source + 2 * i * kFrameSize;
+          float32x4_t sum = vdupq_n_f32(0.0f);
+          for (int t = 0; t < num_taps; ++t)
+            sum = vmlaq_n_f32(sum, vld1q_f32(start + t * kFrameSize), taps[t]);
+          float32x2_t stereo = vget_low_f32(sum);
+          vst1q_f32(dest + i * kFrameSize, vcombine_f32(stereo, stereo));
+        }
+      }
+
+      void polyphaseNeon(mono_float* dest, const mono_float* source, const mono_float* center_source,
+                         const mono_float* taps, int num_taps, mono_float center, int center_offset,
+                         int num_outputs) {
+        int i = 0;
+        for (; i + 4 <= num_outputs; i += 4) {
+          const mono_float* start = source + 2 * i;
+          const mono_float* center_start = center_source + 2 * (i + center_offset);
+          float32x4_t sum1 = vmulq_n_f32(vld1q_f32(center_start), center);
+          float32x4_t sum2 = vmulq_n_f32(vld1q_f32(center_start + 4), center);
+          for (int t = 0; t < num_taps; ++t) {
+            sum1 = vmlaq_n_f32(sum1, vld1q_f32(start + 2 * t), taps[t]);
+            sum2 = vmlaq_n_f32(sum2, vld1q_f32(start + 2 * t + 4), taps[t]);
+          }
+          vst1q_f32(dest + 2 * i, sum1);
+          vst1q_f32(dest + 2 * i + 4, sum2);
+        }
+
+        polyphaseScalar(dest + 2 * i, source + 2 * i, center_source + 2 * i, taps, num_taps,
+                        center, center_offset, num_outputs - i);
+      }
+    #endif
+
+    #if VITAL_KERNEL_DISPATCH
+      VITAL_KERNEL_TARGET("sse4.1")
+      void interpolateSse41(mono_float* dest, const mono_float* buffer, const uint32_t* phases,
+                            int fraction_bits, int size) {
+        const __m128i fraction_mask = _mm_set1_epi32((1 << fraction_bits) - 1);
+        const __m128 fraction_scale = _mm_set1_ps(1.0f / (1u << fraction_bits));
+        const __m128i shift = _mm_cvtsi32_si128(fraction_bits);
+
+        int i = 0;
+        for (; i + 4 <= size; i += 4) {
+          __m128i phase = _mm_loadu_si128((const __m128i*)(phases + i));
+          __m128i index = _mm_srl_epi32(phase, shift);
+          __m128 t = _mm_mul_ps(_mm_cvtepi32_ps(_mm_and_si128(phase, fraction_mask)), fraction_scale);
+
+          const mono_float* from0 = buffer + _mm_extract_epi32(index, 0);
+          const mono_float* from1 = buffer + _mm_extract_epi32(index, 1);
+          const mono_float* from2 = buffer + _mm_extract_epi32(index, 2);
+          const mono_float* from3 = buffer + _mm_extract_epi32(index, 3);
+          __m128 from = _mm_setr_ps(from0[0], from1[0], from2[0], from3[0]);
+          __m128 to = _mm_setr_ps(from0[1], from1[1], from2[1], from3[1]);
+          _mm_storeu_ps(dest + i, _mm_add_ps(from, _mm_mul_ps(t, _mm_sub_ps(to, from))));
+        }
+        interpolateScalar(dest + i, buffer, phases + i, fraction_bits, size - i);
+      }
+
+      VITAL_KERNEL_TARGET("avx2,fma")
+      void zeroAvx2(mono_float* dest, int size) {
+        int i = 0;
+        for (; i + 8 <= size; i += 8)
+          _mm256_storeu_ps(dest + i, _mm256_setzero_ps());
+        for (; i < size; ++i)
+          dest[i] = 0.0f;
+      }
+
+      VITAL_KERNEL_TARGET("avx2,fma")
+      void copyAvx2(mono_float* dest, const mono_float* source, int size) {
+        int i = 0;
+        for (; i + 8 <= size; i += 8)
+          _mm256_storeu_ps(dest + i, _mm256_loadu_ps(source + i));
+        for (; i < size; ++i)
+          dest[i] = source[i];
+      }
+
+      VITAL_KERNEL_TARGET("avx2,fma")
+      void interpolateAvx2(mono_float* dest, const mono_float* buffer, const uint32_t* phases,
+                           int fraction_bits, int size) {
+        const __m256i fraction_mask = _mm256_set1_epi32((1 << fraction_bits) - 1);
+        const __m256 fraction_scale = _mm256_set1_ps(1.0f / (1u << fraction_bits));
+        const __m128i shift = _mm_cvtsi32_si128(fraction_bits);
+
+        int i = 0;
+        for (; i + 8 <= size; i += 8) {
+          __m256i phase = _mm256_loadu_si256((const __m256i*)(phases + i));
+          __m256i index = _mm256_srl_epi32(phase, shift);
+          __m256 t = _mm256_mul_ps(_mm256_cvtepi32_ps(_mm256_and_si256(phase, fraction_mask)), fraction_scale);
+          __m256 from = _mm256_i32gather_ps(buffer, index, sizeof(mono_float));
+          __m256 to = _mm256_i32gather_ps(buffer + 1, index, sizeof(mono_float));
+          _mm256_storeu_ps(dest + i, _mm256_fmadd_ps(t, _mm256_sub_ps(to, from), from));
+        }
+        interpolateScalar(dest + i, buffer, phases + i, fraction_bits, size - i);
+      }
+
+      VITAL_KERNEL_TARGET("avx2,fma")
+      void halfbandAvx2(mono_float* dest, const mono_float* source, int stride,
+                        const mono_float* taps, int num_taps, int num_outputs) {
+        if (stride != kFrameSize || num_taps > kMaxHalfbandTaps) {
+          halfbandScalar(dest, source, stride, taps, num_taps, num_outputs);
+          return;
+        }
+
+        // Each register holds two neighbouring frames, so pairs of taps are applied together.
+        __m256 tap_pairs[kMaxHalfbandTaps / 2];
+        int num_pairs = num_taps / 2;
+        for (int t = 0; t < num_pairs; ++t) {
+          __m256 low = _mm256_castps128_ps256(_mm_set1_ps(taps[2 * t]));
+          tap_pairs[t] = _mm256_insertf128_ps(low, _mm_set1_ps(taps[2 * t + 1]), 1);
+        }
+
+        for (int i = 0; i < num_outputs; ++i) {
+          const mono_float* start = source + 2 * i * kFrameSize;
+          __m256 sum = _mm256_setzero_ps();
+          for (int t = 0; t < num_pairs; ++t)
+            sum = _mm256_fmadd_ps(_mm256_loadu_ps(start + 2 * t * kFrameSize), tap_pairs[t], sum);
+
+          __m128 total = _mm_add_ps(_mm256_castps256_ps128(sum), _mm256_extractf128_ps(sum, 1));
+          if (num_taps % 2) {
+            int last = num_taps - 1;
+            total = _mm_fmadd_ps(_mm_loadu_ps(start + last * kFrameSize), _mm_set1_ps(taps[last]), total);
+          }
+          _mm_storeu_ps(dest + i * kFrameSize, _mm_movelh_ps(total, total));
+        }
+      }
+
+      VITAL_KERNEL_TARGET("avx2,fma")
+      void polyphaseAvx2(mono_float* dest, const mono_float* source, const mono_float* center_source,
+                         const mono_float* taps, int num_taps, mono_float center, int center_offset,
+                         int num_outputs) {
+        const __m256 center_value = _mm256_set1_ps(center);
+
+        int i = 0;
+        for (; i + 8 <= num_outputs; i += 8) {
+          const mono_float* start = source + 2 * i;
+          const mono_float* center_start = center_source + 2 * (i + center_offset);
+          __m256 sum1 = _mm256_mul_ps(_mm256_loadu_ps(center_start), center_value);
+          __m256 sum2 = _mm256_mul_ps(_mm256_loadu_ps(center_start + 8), center_value);
+          for (int t = 0; t < num_taps; ++t) {
+            __m256 tap = _mm256_broadcast_ss(taps + t);
+            sum1 = _mm256_fmadd_ps(_mm256_loadu_ps(start + 2 * t), tap, sum1);
+            sum2 = _mm256_fmadd_ps(_mm256_loadu_ps(start + 2 * t + 8), tap, sum2);
+          }
+          _mm256_storeu_ps(dest + 2 * i, sum1);
+          _mm256_storeu_ps(dest + 2 * i + 8, sum2);
+        }
+
+        polyphaseScalar(dest + 2 * i, source + 2 * i, center_source + 2 * i, taps, num_taps,
+                        center, center_offset, num_outputs - i);
+      }
+
+      VITAL_KERNEL_TARGET("avx512f")
+      void zeroAvx512(mono_float* dest, int size) {
+        int i = 0;
+        for (; i + 16 <= size; i += 16)
+          _mm512_storeu_ps(dest + i, _mm512_setzero_ps());
+        for (; i < size; ++i)
+          dest[i] = 0.0f;
+      }
+
+      VITAL_KERNEL_TARGET("avx512f")
+      void copyAvx512(mono_float* dest, const mono_float* source, int size) {
+        int i = 0;
+        for (; i + 16 <= size; i += 16)
+          _mm512_storeu_ps(dest + i, _mm512_loadu_ps(source + i));
+        for (; i < size; ++i)
+          dest[i] = source[i];
+      }
+
+      VITAL_KERNEL_TARGET("avx512f")
+      void interpolateAvx512(mono_float* dest, const mono_float* buffer, const uint32_t* phases,
+                             int fraction_bits, int size) {
+        const __m512i fraction_mask = _mm512_set1_epi32((1 << fraction_bits) - 1);
+        const __m512 fraction_scale = _mm512_set1_ps(1.0f / (1u << fraction_bits));
+        const __m128i shift = _mm_cvtsi32_si128(fraction_bits);
+
+        int i = 0;
+        for (; i + 16 <= size; i += 16) {
+          __m512i phase = _mm512_loadu_si512(phases + i);
+          __m512i index = _mm512_srl_epi32(phase, shift);
+          __m512 t = _mm512_mul_ps(_mm512_cvtepi32_ps(_mm512_and_si512(phase, fraction_mask)), fraction_scale);
+          __m512 from = _mm512_i32gather_ps(index, buffer, sizeof(mono_float));
+          __m512 to = _mm512_i32gather_ps(index, buffer + 1, sizeof(mono_float));
+          _mm512_storeu_ps(dest + i, _mm512_fmadd_ps(t, _mm512_sub_ps(to, from), from));
+        }
+        interpolateScalar(dest + i, buffer, phases + i, fraction_bits, size - i);
+      }
+
+      VITAL_KERNEL_TARGET("avx512f")
+      void halfbandAvx512(mono_float* dest, const mono_float* source, int stride,
+                          const mono_float* taps, int num_taps, int num_outputs) {
+        if (stride != kFrameSize || num_taps > kMaxHalfbandTaps) {
+          halfbandScalar(dest, source, stride, taps, num_taps, num_outputs);
+          return;
+        }
+
+        // Each register holds four neighbouring frames, so groups of four taps are applied together.
+        __m512 tap_groups[kMaxHalfbandTaps / 4];
+        int num_groups = num_taps / 4;
+        for (int t = 0; t < num_groups; ++t) {
+          const mono_float* group = taps + 4 * t;
+          tap_groups[t] = _mm512_setr_ps(group[0], group[0], group[0], group[0],
+                                         group[1], group[1], group[1], group[1],
+                                         group[2], group[2], group[2], group[2],
+                                         group[3], group[3], group[3], group[3]);
+        }
+
+        for (int i = 0; i < num_outputs; ++i) {
+          const mono_float* start = source + 2 * i * kFrameSize;
+          __m512 sum = _mm512_setzero_ps();
+          for (int t = 0; t < num_groups; ++t)
+            sum = _mm512_fmadd_ps(_mm512_loadu_ps(start + 4 * t * kFrameSize), tap_groups[t], sum);
+
+          __m128 total = _mm_add_ps(_mm_add_ps(_mm512_extractf32x4_ps(sum, 0), _mm512_extractf32x4_ps(sum, 1)),
+                                    _mm_add_ps(_mm512_extractf32x4_ps(sum, 2), _mm512_extractf32x4_ps(sum, 3)));
+          for (int t = 4 * num_groups; t < num_taps; ++t)
+            total = _mm_add_ps(total, _mm_mul_ps(_mm_loadu_ps(start + t * kFrameSize), _mm_set1_ps(taps[t])));
+          _mm_storeu_ps(dest + i * kFrameSize, _mm_movelh_ps(total, total));
+        }
+      }
+
+      VITAL_KERNEL_TARGET("avx512f")
+      void polyphaseAvx512(mono_float* dest, const mono_float* source, const mono_float* center_source,
+                           const mono_float* taps, int num_taps, mono_float center, int center_offset,
+                           int num_outputs) {
+        const __m512 center_value = _mm512_set1_ps(center);
+
+        int i = 0;
+        for (; i + 16 <= num_outputs; i += 16) {
+          const mono_float* start = source + 2 * i;
+          const mono_float* center_start = center_source + 2 * (i + center_offset);
+          __m512 sum1 = _mm512_mul_ps(_mm512_loadu_ps(center_start), center_value);
+          __m512 sum2 = _mm512_mul_ps(_mm512_loadu_ps(center_start + 16), center_value);
+          for (int t = 0; t < num_taps; ++t) {
+            __m512 tap = _mm512_set1_ps(taps[t]);
+            sum1 = _mm512_fmadd_ps(_mm512_loadu_ps(start + 2 * t), tap, sum1);
+            sum2 = _mm512_fmadd_ps(_mm512_loadu_ps(start + 2 * t + 16), tap, sum2);
+          }
+          _mm512_storeu_ps(dest + 2 * i, sum1);
+          _mm512_storeu_ps(dest + 2 * i + 16, sum2);
+        }
+
+        polyphaseAvx2(dest + 2 * i, source + 2 * i, center_source + 2 * i, taps, num_taps,
+                      center, center_offset, num_outputs - i);
+      }
+    #endif
+
+    #if VITAL_SSE2
+      const Table kBaselineTable = { kBaseline, zeroScalar, copySse2, interpolateScalar, halfbandSse2,
+                                     polyphaseSse2 };
+    #elif VITAL_NEON
+      const Table kBaselineTable = { kBaseline, zeroScalar, copyNeon, interpolateScalar, halfbandNeon,
+                                     polyphaseNeon };
+    #else
+      const Table kBaselineTable = { kBaseline, zeroScalar, copyScalar, interpolateScalar, halfbandScalar,
+                                     polyphaseScalar };
+    #endif
+
+    #if VITAL_KERNEL_DISPATCH
+      const Table kSse41Table = { kSse41, zeroScalar, copySse2, interpolateSse41, halfbandSse2, polyphaseSse2 };
+      const Table kAvx2Table = { kAvx2, zeroAvx2, copyAvx2, interpolateAvx2, halfbandAvx2, polyphaseAvx2 };
+      const Table kAvx512Table = { kAvx512, zeroAvx512, copyAvx512, interpolateAvx512, halfbandAvx512,
+                                   polyphaseAvx512 };
+    #endif
+
+      const char* kIsaNames[kNumIsas] = {
+      #if VITAL_NEON
+        "neon",
+      #else
+        "sse2",
+      #endif
+        "sse41",
+        "avx2",
+        "avx512"
+      };
+
+    #if VITAL_KERNEL_DISPATCH
+      bool cpuSupports(Isa isa) {
+      #if defined(_MSC_VER) && !defined(__clang__)
+        int info[4];
+        __cpuid(info, 1);
+        bool sse41 = info[2] & (1 << 19);
+        bool fma = info[2] & (1 << 12);
+        bool saves_ymm = false;
+        bool saves_zmm = false;
+        if (info[2] & (1 << 27)) {
+          unsigned long long enabled_state = _xgetbv(0);
+          saves_ymm = (enabled_state & 0x6) == 0x6;
+          saves_zmm = (enabled_state & 0xe6) == 0xe6;
+        }
+
+        __cpuidex(info, 7, 0);
+        if (isa == kSse41)
+          return sse41;
+        if (isa == kAvx2)
+          return saves_ymm && fma && (info[1] & (1 << 5));
+        if (isa == kAvx512)
+          return saves_zmm && (info[1] & (1 << 16));
+        return false;
+      #else
+        __builtin_cpu_init();
+        if (isa == kSse41)
+          return __builtin_cpu_supports("sse4.1");
+        if (isa == kAvx2)
+          return __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma");
+        if (isa == kAvx512)
+          return __builtin_cpu_supports("avx512f");
+        return false;
+      #endif
+      }
+    #endif
+
+      Isa selectIsa() {
+        int max_isa = kNumIsas - 1;
+        const char* requested = std::getenv("VITAL_KERNEL_ISA");
+        if (requested) {
+          for (int i = 0; i < kNumIsas; ++i) {
+            if (strcmp(requested, kIsaNames[i]) == 0)
+              max_isa = i;
+          }
+        }
+
+        for (int i = max_isa; i > kBaseline; --i) {
+          if (isSupported(static_cast<Isa>(i)))
+            return static_cast<Isa>(i);
+        }
+        return kBaseline;
+      }
+    } // namespace
+
+    const Table& get() {
+      static const Table& table = getTable(selectIsa());
+      return table;
+    }
+
+    const Table& getTable(Isa isa) {
+    #if VITAL_KERNEL_DISPATCH
+      if (isa == kSse41)
+        return kSse41Table;
+      if (isa == kAvx2)
+        return kAvx2Table;
+      if (isa == kAvx512)
+        return kAvx512Table;
+    #endif
+      return kBaselineTable;
+    }
+
+    bool isSupported(Isa isa) {
+    #if VITAL_KERNEL_DISPATCH
+      if (isa != kBaseline)
+        return cpuSupports(isa);
+    #endif
+      return isa == kBaseline;
+    }
+
+    const char* getName(Isa isa) {
+      return kIsaNames[isa];
+    }
+  } // namespace kernels
+} // namespace vital
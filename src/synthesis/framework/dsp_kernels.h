@@ -0,0 +1,73 @@
+/* Copyright 2013-2019 Matt Tytel
+ *
+ * vital is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * vital is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with vital.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "common.h"
+
+namespace vital {
+
+  // Block kernels compiled for several instruction sets. The best supported set is picked once at startup and
+  // can be forced lower with the VITAL_KERNEL_ISA environment variable (sse2, neon, sse41, avx2, avx512).
+  // Kernels work on plain float arrays so they don't depend on the width of poly_float.
+  namespace kernels {
+    enum Isa {
+      kBaseline,
+      kSse41,
+      kAvx2,
+      kAvx512,
+      kNumIsas
+    };
+
+    constexpr int kFrameSize = 4;
+    constexpr int kMaxHalfbandTaps = 64;
+
+    // Below these sizes in floats the lookup and indirect call cost more than the kernel saves over an inline
+    // loop. Measured with vital --kernel-bench.
+    constexpr int kMinZeroKernelSize = 256;
+    constexpr int kMinCopyKernelSize = 16;
+
+    struct Table {
+      Isa isa;
+
+      void (*zero)(mono_float* dest, int size);
+      void (*copy)(mono_float* dest, const mono_float* source, int size);
+
+      // Linearly interpolates buffer at fixed point phases. The top bits of each phase index the buffer and
+      // the low fraction_bits are the fraction between neighbouring values.
+      void (*interpolate)(mono_float* dest, const mono_float* buffer, const uint32_t* phases,
+                          int fraction_bits, int size);
+
+      // Filters and halves the sample rate of the stereo signal in lanes 0 and 1 of frames that are stride
+      // floats apart. Output frame i is the sum of taps[t] * source frame (2 * i + t) with the stereo result
+      // repeated across the output frame.
+      void (*halfband)(mono_float* dest, const mono_float* source, int stride,
+                       const mono_float* taps, int num_taps, int num_outputs);
+
+      // Polyphase halfband decimation on interleaved stereo pairs, applying only the nonzero taps. Output pair i
+      // is the sum of taps[t] * source pair (i + t) plus center * center_source pair (i + center_offset).
+      // Consecutive output pairs share each tap so they are computed several to a register.
+      void (*polyphase)(mono_float* dest, const mono_float* source, const mono_float* center_source,
+                        const mono_float* taps, int num_taps, mono_float center, int center_offset,
+                        int num_outputs);
+    };
+
+    const Table& get();
+    const Table& getTable(Isa isa);
+    bool isSupported(Isa isa);
+    const char* getName(Isa isa);
+  } // namespace kernels
+} // namespace vital
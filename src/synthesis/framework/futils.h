@@ -368,14 +368,25 @@ namespace vital {
       return numerator / denominator;
     }
 
-    force_inline poly_float powerScale(poly_float value, poly_float power) {
+    force_inline poly_mask powerScaleLinearMask(poly_float power) {
       static constexpr mono_float kMinPowerMag = 0.005f;
-      poly_mask zero_mask = poly_float::lessThan(power, kMinPowerMag) & poly_float::lessThan(-power, kMinPowerMag);
+      return poly_float::lessThan(power, kMinPowerMag) & poly_float::lessThan(-power, kMinPowerMag);
+    }
+
+    force_inline poly_float powerScale(poly_float value, poly_float power) {
+      poly_mask zero_mask = powerScaleLinearMask(power);
       poly_float numerator = exp(power * value) - 1.0f;
       poly_float denominator = exp(power) - 1.0f;
       poly_float result = numerator / denominator;
       return utils::maskLoad(result, value, zero_mask);
     }
+
+    // Same as powerScale with the per block terms precomputed for a constant power.
+    force_inline poly_float powerScale(poly_float value, poly_float power,
+                                       poly_float inverse_denominator, poly_mask linear_mask) {
+      poly_float result = (exp(power * value) - 1.0f) * inverse_denominator;
+      return utils::maskLoad(result, value, linear_mask);
+    }
   } // namespace futils
 } // namespace vital
 
@@ -16,6 +16,7 @@
 
 #pragma once
 
+#include "dsp_kernels.h"
 #include "matrix.h"
 #include "utils.h"
 
@@ -317,6 +318,28 @@ namespace vital {
     #endif
     }
 
+    // Unnormalized Walsh-Hadamard transform of all lanes of size values, where size is a power of two. Lane
+    // butterflies are done with shuffles in each register, then whole registers are butterflied together.
+    force_inline void hadamardTransform(poly_float* values, int size) {
+      poly_float stereo_signs(1.0f, -1.0f);
+      poly_float voice_signs(1.0f, 1.0f, -1.0f, -1.0f);
+      for (int i = 0; i < size; ++i) {
+        poly_float value = mulAdd(swapStereo(values[i]), values[i], stereo_signs);
+        values[i] = mulAdd(swapVoices(value), value, voice_signs);
+      }
+
+      for (int half = 1; half < size; half *= 2) {
+        for (int start = 0; start < size; start += 2 * half) {
+          for (int i = start; i < start + half; ++i) {
+            poly_float first = values[i];
+            poly_float second = values[i + half];
+            values[i] = first + second;
+            values[i + half] = first - second;
+          }
+        }
+      }
+    }
+
     force_inline poly_float consolidateAudio(poly_float one, poly_float two) {
     #if VITAL_AVX2
       return _mm256_unpacklo_ps(one.value, two.value);
@@ -373,21 +396,41 @@ namespace vital {
     }
 
     force_inline void zeroBuffer(mono_float* buffer, int size) {
+      if (size >= kernels::kMinZeroKernelSize) {
+        kernels::get().zero(buffer, size);
+        return;
+      }
+
       for (int i = 0; i < size; ++i)
         buffer[i] = 0.0f;
     }
 
     force_inline void zeroBuffer(poly_float* buffer, int size) {
+      if (size * poly_float::kSize >= kernels::kMinZeroKernelSize) {
+        kernels::get().zero((mono_float*)buffer, size * poly_float::kSize);
+        return;
+      }
+
       for (int i = 0; i < size; ++i)
         buffer[i] = 0.0f;
     }
 
     force_inline void copyBuffer(mono_float* dest, const mono_float* source, int size) {
+      if (size >= kernels::kMinCopyKernelSize) {
+        kernels::get().copy(dest, source, size);
+        return;
+      }
+
       for (int i = 0; i < size; ++i)
         dest[i] = source[i];
     }
     
     force_inline void copyBuffer(poly_float* dest, const poly_float* source, int size) {
+      if (size * poly_float::kSize >= kernels::kMinCopyKernelSize) {
+        kernels::get().copy((mono_float*)dest, (const mono_float*)source, size * poly_float::kSize);
+        return;
+      }
+
       for (int i = 0; i < size; ++i)
         dest[i] = source[i];
     }
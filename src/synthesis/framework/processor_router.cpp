@@ -31,6 +31,8 @@ namespace vital {
       local_order_(kMaxModulationConnections),
       global_feedback_order_(new std::vector<const Feedback*>()),
       global_changes_(new int(0)), local_changes_(0),
+      global_slots_(new std::map<const Processor*, int>()),
+      global_plan_(new std::shared_ptr<const ExecutionPlan>()),
       dependencies_(new CircularQueue<const Processor*>(kMaxModulationConnections)),
       dependencies_visited_(new CircularQueue<const Processor*>(kMaxModulationConnections)),
       dependency_inputs_(new CircularQueue<const Processor*>(kMaxModulationConnections)) { }
@@ -39,7 +41,8 @@ namespace vital {
       Processor(original), global_order_(original.global_order_), global_reorder_(original.global_reorder_),
       global_feedback_order_(original.global_feedback_order_),
       global_changes_(original.global_changes_),
-      local_changes_(original.local_changes_) {
+      local_changes_(original.local_changes_),
+      global_slots_(original.global_slots_), global_plan_(original.global_plan_) {
     local_order_.reserve(global_order_->capacity());
     local_order_.assign(global_order_->size(), 0);
     local_feedback_order_.assign(global_feedback_order_->size(), nullptr);
@@ -314,43 +317,142 @@ namespace vital {
     if (local_changes_ == *global_changes_)
       return;
 
+    std::shared_ptr<const ExecutionPlan> plan = getExecutionPlan();
+    bool first_plan = local_plan_ == nullptr;
+    local_plan_ = plan;
+
+    if (first_plan)
+      deleteRemovedProcessors();
+    else
+      deleteRemovedSlots();
     createAddedProcessors();
-    deleteRemovedProcessors();
 
     local_changes_ = *global_changes_;
   }
 
+  std::shared_ptr<const ProcessorRouter::ExecutionPlan> ProcessorRouter::getExecutionPlan() {
+    std::shared_ptr<const ExecutionPlan> plan = std::atomic_load(global_plan_.get());
+    if (plan && plan->changes == *global_changes_)
+      return plan;
+
+    plan = compileExecutionPlan(plan.get());
+    std::atomic_store(global_plan_.get(), plan);
+    return plan;
+  }
+
+  std::shared_ptr<const ProcessorRouter::ExecutionPlan> ProcessorRouter::compileExecutionPlan(
+      const ExecutionPlan* previous) {
+    std::shared_ptr<ExecutionPlan> plan = std::make_shared<ExecutionPlan>(*global_changes_);
+    int num_processors = global_order_->size();
+    if (previous)
+      plan->slot_processors.assign(previous->slot_processors.size(), nullptr);
+    plan->order.assign(num_processors, -1);
+
+    for (int i = 0; i < num_processors; ++i) {
+      Processor* processor = global_order_->at(i);
+      auto slot = global_slots_->find(processor);
+      if (slot != global_slots_->end()) {
+        plan->slot_processors[slot->second] = processor;
+        plan->order[i] = slot->second;
+      }
+    }
+
+    if (previous) {
+      int num_slots = static_cast<int>(previous->slot_processors.size());
+      for (int i = 0; i < num_slots; ++i) {
+        Processor* old_processor = previous->slot_processors[i];
+        if (old_processor && plan->slot_processors[i] != old_processor)
+          global_slots_->erase(old_processor);
+      }
+    }
+
+    int free_slot = 0;
+    for (int i = 0; i < num_processors; ++i) {
+      if (plan->order[i] >= 0)
+        continue;
+
+      int num_slots = static_cast<int>(plan->slot_processors.size());
+      while (free_slot < num_slots && plan->slot_processors[free_slot])
+        free_slot++;
+      if (free_slot == num_slots)
+        plan->slot_processors.push_back(nullptr);
+
+      Processor* processor = global_order_->at(i);
+      plan->slot_processors[free_slot] = processor;
+      plan->order[i] = free_slot;
+      (*global_slots_)[processor] = free_slot;
+    }
+
+    return plan;
+  }
+
   void ProcessorRouter::createAddedProcessors() {
     if (global_order_->size() > local_order_.capacity())
       local_order_.reserve(global_order_->capacity());
-   
-    local_order_.assign(global_order_->size(), nullptr);
-    local_feedback_order_.assign(global_feedback_order_->size(), nullptr);
 
-    int num_processors = global_order_->size();
+    const ExecutionPlan* plan = local_plan_.get();
+    int num_slots = static_cast<int>(plan->slot_processors.size());
+    if (static_cast<int>(local_slots_.size()) < num_slots) {
+      local_slots_.resize(num_slots, nullptr);
+      local_slot_sources_.resize(num_slots, nullptr);
+    }
+
+    int num_processors = static_cast<int>(plan->order.size());
+    local_order_.assign(num_processors, nullptr);
     for (int i = 0; i < num_processors; ++i) {
-      Processor* next = global_order_->at(i);
-      if (next->hasState()) {
-        if (processors_.count(next) == 0)
-          processors_[next] = { 0, std::unique_ptr<Processor>(next->clone()) };
-        local_order_[i] = processors_[next].second.get();
+      int slot = plan->order[i];
+      if (local_slots_[slot] == nullptr) {
+        Processor* next = plan->slot_processors[slot];
+        if (next->hasState()) {
+          std::unique_ptr<Processor>& local_processor = processors_[next].second;
+          if (local_processor == nullptr)
+            local_processor.reset(next->clone());
+          local_slots_[slot] = local_processor.get();
+        }
+        else
+          local_slots_[slot] = next;
+        local_slot_sources_[slot] = next;
       }
-      else
-        local_order_[i] = next;
+
+      local_order_[i] = local_slots_[slot];
     }
 
+    local_feedback_order_.assign(global_feedback_order_->size(), nullptr);
     int num_feedbacks = static_cast<int>(global_feedback_order_->size());
     for (int i = 0; i < num_feedbacks; ++i) {
       const Feedback* next = global_feedback_order_->at(i);
-      if (feedback_processors_.count(next) == 0)
-        feedback_processors_[next] = { 0, std::unique_ptr<Feedback>((Feedback*)(next->clone())) };
-      local_feedback_order_[i] = feedback_processors_[next].second.get();
+      std::unique_ptr<Feedback>& local_feedback = feedback_processors_[next].second;
+      if (local_feedback == nullptr)
+        local_feedback.reset((Feedback*)(next->clone()));
+      local_feedback_order_[i] = local_feedback.get();
     }
   }
 
+  void ProcessorRouter::deleteRemovedSlots() {
+    const ExecutionPlan* plan = local_plan_.get();
+    int num_plan_slots = static_cast<int>(plan->slot_processors.size());
+    int num_slots = static_cast<int>(local_slots_.size());
+    for (int i = 0; i < num_slots; ++i) {
+      const Processor* source = local_slot_sources_[i];
+      if (source == nullptr || (i < num_plan_slots && plan->slot_processors[i] == source))
+        continue;
+
+      // Only delete our copy if the processor left the router and didn't just move to another slot.
+      if (global_slots_->count(source) == 0)
+        processors_.erase(source);
+      local_slots_[i] = nullptr;
+      local_slot_sources_[i] = nullptr;
+    }
+
+    deleteRemovedFeedbacks();
+  }
+
   void ProcessorRouter::deleteRemovedProcessors() {
-    for (const Processor* global_processor : *global_order_)
-      processors_[global_processor].first = *global_changes_;
+    for (const Processor* global_processor : *global_order_) {
+      auto local_processor = processors_.find(global_processor);
+      if (local_processor != processors_.end())
+        local_processor->second.first = *global_changes_;
+    }
 
     for (auto iter = processors_.cbegin(); iter != processors_.cend();) {
       if (iter->second.first != *global_changes_)
@@ -359,8 +461,17 @@ namespace vital {
         iter++;
     }
 
-    for (const Feedback* global_feedback : *global_feedback_order_)
-      feedback_processors_[global_feedback].first = *global_changes_;
+    local_slots_.clear();
+    local_slot_sources_.clear();
+    deleteRemovedFeedbacks();
+  }
+
+  void ProcessorRouter::deleteRemovedFeedbacks() {
+    for (const Feedback* global_feedback : *global_feedback_order_) {
+      auto local_feedback = feedback_processors_.find(global_feedback);
+      if (local_feedback != feedback_processors_.end())
+        local_feedback->second.first = *global_changes_;
+    }
 
     for (auto iter = feedback_processors_.cbegin(); iter != feedback_processors_.cend();) {
       if (iter->second.first != *global_changes_)
@@ -368,13 +479,6 @@ namespace vital {
       else
         iter++;
     }
-
-    int num_feedbacks = static_cast<int>(global_feedback_order_->size());
-    local_feedback_order_.clear();
-    for (int i = 0; i < num_feedbacks; ++i) {
-      const Feedback* next = global_feedback_order_->at(i);
-      local_feedback_order_.push_back(feedback_processors_[next].second.get());
-    }
   }
 
   const Processor* ProcessorRouter::getContext(const Processor* processor) const {
@@ -20,6 +20,7 @@
 #include "circular_queue.h"
 
 #include <map>
+#include <memory>
 #include <set>
 #include <vector>
 
@@ -62,6 +63,16 @@ namespace vital {
       virtual void resetFeedbacks(poly_mask reset_mask);
 
     protected:
+      // Flattened processing order shared by every copy of a router. Each processor gets a stable slot so
+      // copies can rebuild their local order with array lookups instead of searching _processors_.
+      struct ExecutionPlan {
+        ExecutionPlan(int plan_changes) : changes(plan_changes) { }
+
+        int changes;
+        std::vector<Processor*> slot_processors;
+        std::vector<int> order;
+      };
+
       // When we create a cycle into the ProcessorRouter graph, we must insert
       // a Feedback node and add it here.
       virtual void addFeedback(Feedback* feedback);
@@ -76,11 +87,17 @@ namespace vital {
 
       force_inline bool shouldUpdate() { return local_changes_ != *global_changes_; }
 
+      // Compiles the current global order into an ExecutionPlan and publishes it if it's out of date.
+      std::shared_ptr<const ExecutionPlan> getExecutionPlan();
+      std::shared_ptr<const ExecutionPlan> compileExecutionPlan(const ExecutionPlan* previous);
+
       // Will create local copies of added processors. 
       virtual void createAddedProcessors();
 
       // Will delete local copies of removed processors. 
       virtual void deleteRemovedProcessors();
+      void deleteRemovedSlots();
+      void deleteRemovedFeedbacks();
 
       // Returns the ancestor of _processor_ which is a child of _this_.
       // Returns null if _processor_ is not a descendant of _this_.
@@ -103,6 +120,12 @@ namespace vital {
       std::shared_ptr<int> global_changes_;
       int local_changes_;
 
+      std::shared_ptr<std::map<const Processor*, int>> global_slots_;
+      std::shared_ptr<std::shared_ptr<const ExecutionPlan>> global_plan_;
+      std::shared_ptr<const ExecutionPlan> local_plan_;
+      std::vector<Processor*> local_slots_;
+      std::vector<const Processor*> local_slot_sources_;
+
       std::shared_ptr<CircularQueue<const Processor*>> dependencies_;
       std::shared_ptr<CircularQueue<const Processor*>> dependencies_visited_;
       std::shared_ptr<CircularQueue<const Processor*>> dependency_inputs_;
@@ -286,7 +286,53 @@ namespace vital {
   }
 
   void SynthModule::createStatusOutput(std::string name, Output* source) {
-    data_->status_outputs[name] = std::make_unique<StatusOutput>(source);
+    std::unique_ptr<StatusOutput> status_output = std::make_unique<StatusOutput>(source, &data_->status_sequence);
+    StatusOutput* lookup = status_output.get();
+
+    auto existing = data_->status_output_lookup.find(name);
+    if (existing != data_->status_output_lookup.end()) {
+      for (auto& output : data_->status_outputs) {
+        if (output.get() == existing->second)
+          output = std::move(status_output);
+      }
+    }
+    else
+      data_->status_outputs.push_back(std::move(status_output));
+
+    data_->status_output_lookup[name] = lookup;
+  }
+
+  void SynthModule::updateStatusOutputs() {
+    unsigned int sequence = data_->status_sequence.load(std::memory_order_relaxed);
+    data_->status_sequence.store(sequence + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    for (auto& status_output : data_->status_outputs)
+      status_output->update();
+
+    data_->status_sequence.store(sequence + 2, std::memory_order_release);
+  }
+
+  void SynthModule::updateStatusOutputs(poly_mask voice_mask) {
+    unsigned int sequence = data_->status_sequence.load(std::memory_order_relaxed);
+    data_->status_sequence.store(sequence + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    for (auto& status_output : data_->status_outputs)
+      status_output->update(voice_mask);
+
+    data_->status_sequence.store(sequence + 2, std::memory_order_release);
+  }
+
+  void SynthModule::clearStatusOutputs() {
+    unsigned int sequence = data_->status_sequence.load(std::memory_order_relaxed);
+    data_->status_sequence.store(sequence + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    for (auto& status_output : data_->status_outputs)
+      status_output->clear();
+
+    data_->status_sequence.store(sequence + 2, std::memory_order_release);
   }
 
   control_map SynthModule::getControls() {
@@ -313,8 +359,9 @@ namespace vital {
   }
 
   const StatusOutput* SynthModule::getStatusOutput(std::string name) const {
-    if (data_->status_outputs.count(name))
-      return data_->status_outputs.at(name).get();
+    auto status_output = data_->status_output_lookup.find(name);
+    if (status_output != data_->status_output_lookup.end())
+      return status_output->second;
 
     for (SynthModule* sub_module : data_->sub_modules) {
       const StatusOutput* source = sub_module->getStatusOutput(name);
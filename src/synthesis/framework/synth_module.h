@@ -19,6 +19,7 @@
 #include "synth_types.h"
 #include "processor_router.h"
 
+#include <atomic>
 #include <climits>
 #include <vector>
 
@@ -30,9 +31,23 @@ namespace vital {
     public:
       static constexpr float kClearValue = INT_MIN;
 
-      StatusOutput(Output* source) : source_(source), value_(0.0f) { }
-
-      force_inline poly_float value() const { return value_; }
+      StatusOutput(Output* source, const std::atomic<unsigned int>* sequence = nullptr) :
+          source_(source), sequence_(sequence), value_(0.0f) { }
+
+      // Values are written on the audio thread between odd and even sequence numbers, so readers on other
+      // threads retry until they see the same even sequence before and after the read.
+      force_inline poly_float value() const {
+        if (sequence_ == nullptr)
+          return value_;
+
+        while (true) {
+          unsigned int start = sequence_->load(std::memory_order_acquire);
+          poly_float result = value_;
+          std::atomic_thread_fence(std::memory_order_acquire);
+          if ((start & 1) == 0 && sequence_->load(std::memory_order_relaxed) == start)
+            return result;
+        }
+      }
 
       force_inline void update(poly_mask voice_mask) {
         poly_float masked_value = source_->buffer[0] & voice_mask;
@@ -49,6 +64,7 @@ namespace vital {
 
     private:
       Output* source_;
+      const std::atomic<unsigned int>* sequence_;
       poly_float value_;
 
       JUCE_LEAK_DETECTOR(StatusOutput)
@@ -60,7 +76,9 @@ namespace vital {
 
     control_map controls;
     output_map mod_sources;
-    std::map<std::string, std::unique_ptr<StatusOutput>> status_outputs;
+    std::vector<std::unique_ptr<StatusOutput>> status_outputs;
+    std::map<std::string, StatusOutput*> status_output_lookup;
+    std::atomic<unsigned int> status_sequence { 0 };
     input_map mono_mod_destinations;
     input_map poly_mod_destinations;
     output_map mono_modulation_readout;
@@ -99,6 +117,8 @@ namespace vital {
       virtual output_map& getMonoModulations();
       virtual output_map& getPolyModulations();
       virtual void correctToTime(double seconds) { }
+      // Samples of output still expected after the input goes silent.
+      virtual int getTailSamples() { return 0; }
       void enableOwnedProcessors(bool enable);
       virtual void enable(bool enable) override;
       void addMonoProcessor(Processor* processor, bool own = true);
@@ -128,6 +148,9 @@ namespace vital {
                                     const Output* beats_per_second, bool poly, Input* midi = nullptr);
 
       void createStatusOutput(std::string name, Output* source);
+      void updateStatusOutputs();
+      void updateStatusOutputs(poly_mask voice_mask);
+      void clearStatusOutputs();
 
       std::shared_ptr<ModuleData> data_;
 
@@ -59,10 +59,18 @@ namespace vital {
     force_inline int pressedCompareHighestFirst(int left, int right) {
       return getNote(left) - getNote(right);
     }
+
+    force_inline poly_mask getInaudibleMask(const poly_float* buffer, int length) {
+      poly_float peak = 0.0f;
+      for (int i = 0; i < length; ++i)
+        peak = utils::max(peak, poly_float::abs(buffer[i]));
+      return poly_float::lessThan(peak, VoiceHandler::kInaudibleLevel);
+    }
   } // namespace
 
   Voice::Voice(AggregateVoice* parent) : voice_index_(0), voice_mask_(0), event_sample_(-1),
-      aftertouch_sample_(-1), aftertouch_(0.0f), slide_sample_(-1), slide_(0.0f), parent_(parent) {
+      aftertouch_sample_(-1), aftertouch_(0.0f), slide_sample_(-1), slide_(0.0f), parent_(parent),
+      list_(nullptr), list_previous_(nullptr), list_next_(nullptr) {
     state_.event = kVoiceOff;
     state_.midi_note = 0;
     state_.tuned_note = 0;
@@ -82,8 +90,6 @@ namespace vital {
       voice_priority_(kRoundRobin), voice_override_(kKill), total_notes_(0) {
     pressed_notes_.reserve(kMidiSize);
     all_voices_.reserve(kMaxPolyphony + kParallelVoices);
-    free_voices_.reserve(kMaxPolyphony + kParallelVoices);
-    active_voices_.reserve(kMaxPolyphony + kParallelVoices);
     all_aggregate_voices_.reserve(kMaxPolyphony / kParallelVoices + kParallelVoices);
     active_aggregate_voices_.reserve(kMaxPolyphony / kParallelVoices + kParallelVoices);
 
@@ -295,20 +301,21 @@ namespace vital {
 
     clearAccumulatedOutputs();
 
+    // The aggregate voice holding the last voice is processed last so its values are left in the outputs.
     active_aggregate_voices_.clear();
-    AggregateVoice* last_aggregate_voice = nullptr;
-    int last_aggregate_index = 0;
+    AggregateVoice* last_aggregate_voice = active_voices_.back()->parent();
+    int last_aggregate_index = active_voices_.back()->voice_index();
     for (Voice* active_voice : active_voices_) {
-      if (active_aggregate_voices_.count(active_voice->parent()) == 0)
-        active_aggregate_voices_.push_back(active_voice->parent());
-      last_aggregate_voice = active_voice->parent();
-      last_aggregate_index = active_voice->voice_index();
-    }
-
-    if (last_aggregate_voice) {
-      active_aggregate_voices_.remove(last_aggregate_voice);
-      active_aggregate_voices_.push_back(last_aggregate_voice);
+      AggregateVoice* aggregate_voice = active_voice->parent();
+      uint64_t& bits = active_aggregate_bits_[aggregate_voice->index / 64];
+      uint64_t bit = 1ULL << (aggregate_voice->index % 64);
+      if (aggregate_voice != last_aggregate_voice && (bits & bit) == 0) {
+        bits |= bit;
+        active_aggregate_voices_.push_back(aggregate_voice);
+      }
     }
+    active_aggregate_voices_.push_back(last_aggregate_voice);
+    std::fill(active_aggregate_bits_.begin(), active_aggregate_bits_.end(), 0);
 
     for (AggregateVoice* aggregate_voice : active_aggregate_voices_) {
       prepareVoiceTriggers(aggregate_voice, num_samples);
@@ -316,19 +323,15 @@ namespace vital {
       processVoice(aggregate_voice, num_samples);
       accumulateOutputs(num_samples);
 
-      // Remove voice if the right processor has a full silent buffer.
+      // Remove released voices once the voice killer stays inaudible for a full buffer.
       poly_mask alive_mask = constants::kFullMask;
       if (voice_killer_)
-        alive_mask = ~utils::getSilentMask(voice_killer_->buffer, num_samples);
+        alive_mask = ~getInaudibleMask(voice_killer_->buffer, num_samples);
       for (Voice* single_voice : aggregate_voice->voices) {
         bool released = single_voice->state().event == kVoiceOff || single_voice->state().event == kVoiceKill;
         bool alive = (single_voice->voice_mask() & alive_mask).sum();
-        bool active = active_voices_.count(single_voice);
-        if (released && !alive && active) {
-          active_voices_.remove(single_voice);
-          free_voices_.push_back(single_voice);
-          single_voice->markDead();
-        }
+        if (released && !alive && active_voices_.contains(single_voice))
+          freeVoice(single_voice);
       }
     }
 
@@ -461,11 +464,8 @@ namespace vital {
 
     for (Voice* voice : active_voices_) {
       voice->kill(0);
-      voice->markDead();
-      free_voices_.push_back(voice);
+      freeVoice(voice);
     }
-
-    active_voices_.clear();
   }
   
   void VoiceHandler::allNotesOff(int sample) {
@@ -528,40 +528,62 @@ namespace vital {
   }
 
   Voice* VoiceHandler::grabFreeVoice() {
-    Voice* voice = nullptr;
-    if (free_voices_.size()) {
-      voice = free_voices_.front();
-      free_voices_.pop_front();
-    }
+    Voice* voice = free_voices_.front();
+    if (voice == nullptr)
+      voice = free_parallel_voices_.front();
+
+    if (voice)
+      takeFreeVoice(voice);
     return voice;
   }
 
   Voice* VoiceHandler::grabFreeParallelVoice() {
-    for (auto& aggregate_voice : all_aggregate_voices_) {
-      Voice* dead_voice = nullptr;
-      bool has_active_voice = false;
+    Voice* voice = free_parallel_voices_.front();
+    if (voice)
+      takeFreeVoice(voice);
+    return voice;
+  }
 
-      for (Voice* single_voice : aggregate_voice->voices) {
-        if (single_voice->key_state() == Voice::kDead)
-          dead_voice = single_voice;
-        else
-          has_active_voice = true;
+  void VoiceHandler::takeFreeVoice(Voice* voice) {
+    free_voices_.remove(voice);
+    free_parallel_voices_.remove(voice);
+
+    for (Voice* other_voice : voice->parent()->voices) {
+      if (free_voices_.contains(other_voice)) {
+        free_voices_.remove(other_voice);
+        free_parallel_voices_.push_back(other_voice);
       }
+    }
+  }
+
+  void VoiceHandler::freeVoice(Voice* voice) {
+    active_voices_.remove(voice);
+    voice->markDead();
+
+    bool aggregate_playing = false;
+    for (Voice* other_voice : voice->parent()->voices) {
+      if (other_voice != voice && !free_voices_.contains(other_voice) && !free_parallel_voices_.contains(other_voice))
+        aggregate_playing = true;
+    }
+
+    if (aggregate_playing) {
+      free_parallel_voices_.push_back(voice);
+      return;
+    }
 
-      if (has_active_voice && dead_voice) {
-        VITAL_ASSERT(free_voices_.count(dead_voice));
-        free_voices_.remove(dead_voice);
-        return dead_voice;
+    free_voices_.push_back(voice);
+    for (Voice* other_voice : voice->parent()->voices) {
+      if (free_parallel_voices_.contains(other_voice)) {
+        free_parallel_voices_.remove(other_voice);
+        free_voices_.push_back(other_voice);
       }
     }
-    return nullptr;
   }
 
   Voice* VoiceHandler::grabVoiceOfType(Voice::KeyState key_state) {
-    for (auto iter = active_voices_.begin(); iter != active_voices_.end(); ++iter) {
-      Voice* voice = *iter;
+    for (Voice* voice : active_voices_) {
       if (voice->key_state() == key_state) {
-        active_voices_.erase(iter);
+        active_voices_.remove(voice);
         return voice;
       }
     }
@@ -879,6 +901,8 @@ namespace vital {
     }
 
     std::unique_ptr<AggregateVoice> aggregate_voice = std::make_unique<AggregateVoice>();
+    aggregate_voice->index = all_aggregate_voices_.size();
+    active_aggregate_bits_.resize(aggregate_voice->index / 64 + 1, 0);
     aggregate_voice->processor = std::unique_ptr<Processor>(voice_router_.clone());
     aggregate_voice->processor->process(1);
     aggregate_voice->voices.reserve(kParallelVoices);
@@ -46,6 +46,7 @@ namespace vital {
   };
 
   struct AggregateVoice;
+  class VoiceList;
 
   class Voice {
     public:
@@ -65,6 +66,7 @@ namespace vital {
       virtual ~Voice() { }
 
       force_inline AggregateVoice* parent() { return parent_; }
+      force_inline const VoiceList* list() const { return list_; }
       force_inline const VoiceState& state() { return state_; }
       force_inline const KeyState last_key_state() { return last_key_state_; }
       force_inline const KeyState key_state() { return key_state_; }
@@ -237,16 +239,153 @@ namespace vital {
       mono_float slide_;
 
       AggregateVoice* parent_;
+
+      VoiceList* list_;
+      Voice* list_previous_;
+      Voice* list_next_;
+
+      friend class VoiceList;
+  };
+
+  // Intrusive list so voices can move between the free and active lists in constant time.
+  // A voice can only be in one list at a time.
+  class VoiceList {
+    public:
+      class iterator {
+        public:
+          iterator(Voice* voice) : voice_(voice), next_(voice ? voice->list_next_ : nullptr) { }
+
+          force_inline Voice* operator*() const { return voice_; }
+          force_inline bool operator!=(const iterator& other) const { return voice_ != other.voice_; }
+
+          // The next voice is read ahead so the current voice can be removed while iterating.
+          force_inline iterator& operator++() {
+            voice_ = next_;
+            next_ = voice_ ? voice_->list_next_ : nullptr;
+            return *this;
+          }
+
+        private:
+          Voice* voice_;
+          Voice* next_;
+      };
+
+      VoiceList() : front_(nullptr), back_(nullptr), size_(0) { }
+
+      force_inline int size() const { return size_; }
+      force_inline Voice* front() const { return front_; }
+      force_inline Voice* back() const { return back_; }
+      force_inline bool contains(const Voice* voice) const { return voice->list_ == this; }
+      force_inline iterator begin() const { return iterator(front_); }
+      force_inline iterator end() const { return iterator(nullptr); }
+
+      force_inline void push_back(Voice* voice) {
+        VITAL_ASSERT(voice->list_ == nullptr);
+        voice->list_ = this;
+        voice->list_previous_ = back_;
+        voice->list_next_ = nullptr;
+        if (back_)
+          back_->list_next_ = voice;
+        else
+          front_ = voice;
+        back_ = voice;
+        size_++;
+      }
+
+      force_inline void push_front(Voice* voice) {
+        VITAL_ASSERT(voice->list_ == nullptr);
+        voice->list_ = this;
+        voice->list_previous_ = nullptr;
+        voice->list_next_ = front_;
+        if (front_)
+          front_->list_previous_ = voice;
+        else
+          back_ = voice;
+        front_ = voice;
+        size_++;
+      }
+
+      force_inline void remove(Voice* voice) {
+        if (voice->list_ != this)
+          return;
+
+        if (voice->list_previous_)
+          voice->list_previous_->list_next_ = voice->list_next_;
+        else
+          front_ = voice->list_next_;
+
+        if (voice->list_next_)
+          voice->list_next_->list_previous_ = voice->list_previous_;
+        else
+          back_ = voice->list_previous_;
+
+        voice->list_ = nullptr;
+        voice->list_previous_ = nullptr;
+        voice->list_next_ = nullptr;
+        size_--;
+      }
+
+      force_inline Voice* pop_front() {
+        Voice* voice = front_;
+        if (voice)
+          remove(voice);
+        return voice;
+      }
+
+      // Stable insertion sort with the same ordering as CircularQueue::sort.
+      template<int(*compare)(Voice*, Voice*)>
+      void sort() {
+        Voice* voice = front_ ? front_->list_next_ : nullptr;
+        while (voice) {
+          Voice* next = voice->list_next_;
+          Voice* position = voice->list_previous_;
+          while (position && compare(position, voice) < 0)
+            position = position->list_previous_;
+
+          if (position != voice->list_previous_) {
+            remove(voice);
+            insertAfter(position, voice);
+          }
+          voice = next;
+        }
+      }
+
+    private:
+      force_inline void insertAfter(Voice* position, Voice* voice) {
+        if (position == nullptr) {
+          push_front(voice);
+          return;
+        }
+
+        voice->list_ = this;
+        voice->list_previous_ = position;
+        voice->list_next_ = position->list_next_;
+        if (position->list_next_)
+          position->list_next_->list_previous_ = voice;
+        else
+          back_ = voice;
+        position->list_next_ = voice;
+        size_++;
+      }
+
+      Voice* front_;
+      Voice* back_;
+      int size_;
+
+      JUCE_DECLARE_NON_COPYABLE(VoiceList)
   };
 
   struct AggregateVoice {
     CircularQueue<Voice*> voices;
     std::unique_ptr<Processor> processor;
+    int index = 0;
   };
 
   class VoiceHandler : public SynthModule, public NoteHandler {
     public:
       static constexpr mono_float kLocalPitchBendRange = 48.0f;
+      // Released voices whose amplitude stays below this for a whole block are freed.
+      static constexpr mono_float kInaudibleLevel = 0.00001f;
 
       enum {
         kPolyphony,
@@ -418,6 +557,8 @@ namespace vital {
       Voice* grabVoice();
       Voice* grabFreeVoice();
       Voice* grabFreeParallelVoice();
+      void takeFreeVoice(Voice* voice);
+      void freeVoice(Voice* voice);
       Voice* grabVoiceOfType(Voice::KeyState key_state);
       Voice* getVoiceToKill(int max_voices);
       int grabNextUnplayedPressedNote();
@@ -477,10 +618,14 @@ namespace vital {
       CircularQueue<int> pressed_notes_;
       CircularQueue<std::unique_ptr<Voice>> all_voices_;
 
-      CircularQueue<Voice*> free_voices_;
-      CircularQueue<Voice*> active_voices_;
+      // Free voices are split by whether another voice in their aggregate is playing so new voices fill
+      // partly used aggregates first and fewer aggregates get processed.
+      VoiceList free_voices_;
+      VoiceList free_parallel_voices_;
+      VoiceList active_voices_;
       CircularQueue<std::unique_ptr<AggregateVoice>> all_aggregate_voices_;
       CircularQueue<AggregateVoice*> active_aggregate_voices_;
+      std::vector<uint64_t> active_aggregate_bits_;
 
       ProcessorRouter voice_router_;
       ProcessorRouter global_router_;
@@ -94,6 +94,8 @@ namespace vital {
           output[i] = buffer[(i + start_index) & bitmask];
       }
 
+      mono_float getAtIndex(int channel, unsigned int index) const { return buffers_[channel][index & bitmask_]; }
+
       unsigned int getOffset() const { return offset_; }
 
       void setOffset(int offset) { offset_ = offset; }
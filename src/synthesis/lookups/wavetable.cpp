@@ -25,7 +25,7 @@ namespace vital {
 
   Wavetable::Wavetable(int max_frames) :
       max_frames_(max_frames), current_data_(nullptr), 
-      active_audio_data_(nullptr), shepard_table_(false), fft_data_() {
+      active_audio_data_(nullptr), shepard_table_(false), fft_data_(), mip_data_() {
     loadDefaultWavetable();
   }
 
@@ -54,15 +54,18 @@ namespace vital {
     data_->frequency_amplitudes = std::make_unique<poly_float[][kPolyFrequencySize]>(num_frames);
     data_->normalized_frequencies = std::make_unique<poly_float[][kPolyFrequencySize]>(num_frames);
     data_->phases = std::make_unique<poly_float[][kPolyFrequencySize]>(num_frames);
+    data_->mip_levels = std::make_unique<poly_float[][kNumMipLevels][kMipPolySize]>(num_frames);
 
     int frame_size = kWaveformSize * sizeof(mono_float);
     int frequency_size = kPolyFrequencySize * sizeof(poly_float);
+    int mip_size = kNumMipLevels * kMipPolySize * sizeof(poly_float);
     int copy_frames = std::min(num_frames, old_num_frames);
     for (int i = 0; i < copy_frames; ++i) {
       memcpy(data_->wave_data[i], old_data->wave_data[i], frame_size);
       memcpy(data_->frequency_amplitudes[i], old_data->frequency_amplitudes[i], frequency_size);
       memcpy(data_->normalized_frequencies[i], old_data->normalized_frequencies[i], frequency_size);
       memcpy(data_->phases[i], old_data->phases[i], frequency_size);
+      memcpy(data_->mip_levels[i], old_data->mip_levels[i], mip_size);
     }
 
     if (old_data) {
@@ -74,11 +77,13 @@ namespace vital {
       void* last_old_amplitudes = old_data->frequency_amplitudes[old_num_frames - 1];
       void* last_old_normalized = old_data->normalized_frequencies[old_num_frames - 1];
       void* last_old_phases = old_data->phases[old_num_frames - 1];
+      void* last_old_mips = old_data->mip_levels[old_num_frames - 1];
       for (int i = 0; i < remaining_frames; ++i) {
         memcpy(data_->wave_data[i + old_num_frames], last_old_frame, frame_size);
         memcpy(data_->frequency_amplitudes[i + old_num_frames], last_old_amplitudes, frequency_size);
         memcpy(data_->normalized_frequencies[i + old_num_frames], last_old_normalized, frequency_size);
         memcpy(data_->phases[i + old_num_frames], last_old_phases, frequency_size);
+        memcpy(data_->mip_levels[i + old_num_frames], last_old_mips, mip_size);
       }
     }
 
@@ -87,6 +92,22 @@ namespace vital {
       std::this_thread::yield(); // Wait for audio thread to finish using old_data.
   }
 
+  void Wavetable::swapData(Wavetable* other) {
+    VITAL_ASSERT(max_frames_ == other->max_frames_);
+
+    int version = std::max(data_->version, other->data_->version) + 1;
+    data_.swap(other->data_);
+    name_.swap(other->name_);
+    author_.swap(other->author_);
+    std::swap(shepard_table_, other->shepard_table_);
+
+    data_->version = version;
+    other->current_data_ = other->data_.get();
+    current_data_ = data_.get();
+    while (active_audio_data_.load())
+      std::this_thread::yield(); // Wait for audio thread to finish using the old data.
+  }
+
   void Wavetable::setFrequencyRatio(float frequency_ratio) {
     current_data_->frequency_ratio = frequency_ratio;
   }
@@ -106,6 +127,8 @@ namespace vital {
     loadFrequencyAmplitudes(wave_frame->frequency_domain, to_index);
     loadNormalizedFrequencies(wave_frame->frequency_domain, to_index);
     memcpy(current_data_->wave_data[to_index], wave_frame->time_domain, kWaveformSize * sizeof(mono_float));
+    loadMipLevels(to_index);
+    current_data_->revision++;
   }
 
   void Wavetable::postProcess(float max_span) {
@@ -155,6 +178,10 @@ namespace vital {
       for (int frame = last_min_amp_frame + 1; frame < current_data_->num_frames; ++frame)
         ((std::complex<float>*)current_data_->normalized_frequencies[frame])[i] = last_normalized_frequency;
     }
+
+    for (int w = 0; w < current_data_->num_frames; ++w)
+      loadMipLevels(w);
+    current_data_->revision++;
   }
 
   void Wavetable::loadFrequencyAmplitudes(const std::complex<float>* frequencies, int to_index) {
@@ -176,4 +203,31 @@ namespace vital {
       phases[2 * i + 1] = arg;
     }
   }
+
+  void Wavetable::loadMipLevels(int to_index) {
+    static constexpr int kMaxPolyIndex = kWaveformSize / poly_float::kSize;
+
+    const poly_float* frequency_amplitudes = current_data_->frequency_amplitudes[to_index];
+    const poly_float* normalized_frequencies = current_data_->normalized_frequencies[to_index];
+    FourierTransform* transform = FFT<kFrequencyBins>::transform();
+    mono_float* buffer = (mono_float*)mip_data_;
+    poly_float* wave_start = mip_data_ + 1;
+
+    for (int level = 0; level < kNumMipLevels; ++level) {
+      int last_index = 2 * getMipHarmonics(level) / poly_float::kSize;
+
+      for (int i = 0; i <= last_index; ++i)
+        wave_start[i] = frequency_amplitudes[i] * normalized_frequencies[i];
+      for (int i = last_index + 1; i <= kMaxPolyIndex; ++i)
+        wave_start[i] = 0.0f;
+
+      transform->transformRealInverse(buffer + poly_float::kSize);
+      for (int i = 0; i < poly_float::kSize; ++i) {
+        buffer[i] = buffer[i + kWaveformSize];
+        buffer[i + kWaveformSize + poly_float::kSize] = buffer[i + poly_float::kSize];
+      }
+
+      memcpy(current_data_->mip_levels[to_index][level], mip_data_, kMipPolySize * sizeof(poly_float));
+    }
+  }
 } // namespace vital
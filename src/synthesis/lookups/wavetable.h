@@ -32,19 +32,26 @@ namespace vital {
       static constexpr int kExtraValues = 3;
       static constexpr int kNumHarmonics = kWaveformSize / 2 + 1;
       static constexpr int kPolyFrequencySize = 2 * kNumHarmonics / poly_float::kSize + 2;
+      static constexpr int kMinMipBits = 5;
+      static constexpr int kMinMipHarmonics = 1 << kMinMipBits;
+      static constexpr int kNumMipLevels = 2 * (kFrequencyBins - 1 - kMinMipBits) + 1;
+      static constexpr int kMipPolySize = kWaveformSize / poly_float::kSize + 2;
 
       struct WavetableData {
         WavetableData(int frames, int table_version) :
-            num_frames(frames), frequency_ratio(1.0f), sample_rate(kDefaultSampleRate), version(table_version) { }
+            num_frames(frames), frequency_ratio(1.0f), sample_rate(kDefaultSampleRate),
+            version(table_version), revision(0) { }
 
         int num_frames;
         mono_float frequency_ratio;
         mono_float sample_rate;
         int version;
+        int revision;
         std::unique_ptr<mono_float[][kWaveformSize]> wave_data;
         std::unique_ptr<poly_float[][kPolyFrequencySize]> frequency_amplitudes;
         std::unique_ptr<poly_float[][kPolyFrequencySize]> normalized_frequencies;
         std::unique_ptr<poly_float[][kPolyFrequencySize]> phases;
+        std::unique_ptr<poly_float[][kNumMipLevels][kMipPolySize]> mip_levels;
       };
 
       static constexpr const mono_float* null_waveform() { return kZeroWaveform; }
@@ -53,6 +60,7 @@ namespace vital {
 
       void loadDefaultWavetable();
       void setNumFrames(int num_frames);
+      void swapData(Wavetable* other);
       void setFrequencyRatio(float frequency_ratio);
       void setSampleRate(float rate);
       std::string getName() { return name_; }
@@ -69,6 +77,32 @@ namespace vital {
         return utils::iclamp(utils::ilog2(num_waves), 0, kFrequencyBins - 1);
       }
 
+      // Levels are half an octave apart and hold what a passthrough morph keeps at getMipHarmonics(level).
+      // Pitches too high for the lowest level return -1 and use the transform instead.
+      static force_inline int getMipLevel(int last_harmonic) {
+        if (last_harmonic < kMinMipHarmonics)
+          return -1;
+
+        int level = std::min(kNumMipLevels - 1, 2 * (utils::ilog2(last_harmonic) - kMinMipBits) + 1);
+        if (getMipHarmonics(level) > last_harmonic)
+          level--;
+        return level;
+      }
+
+      static force_inline int getMipHarmonics(int level) {
+        static constexpr int kHalfOctaveNumerator = 181;
+        static constexpr int kHalfOctaveDenominator = 128;
+
+        int harmonics = kMinMipHarmonics << (level / 2);
+        if (level % 2)
+          harmonics = harmonics * kHalfOctaveNumerator / kHalfOctaveDenominator;
+        return harmonics;
+      }
+
+      static force_inline const mono_float* getMipBuffer(const WavetableData* data, int frame_index, int level) {
+        return ((const mono_float*)data->mip_levels[frame_index][level]) + poly_float::kSize - 1;
+      }
+
       force_inline int clampFrame(int frame) {
         return std::min(frame, current_data_->num_frames - 1);
       }
@@ -139,6 +173,7 @@ namespace vital {
     
       void loadFrequencyAmplitudes(const std::complex<float>* frequencies, int to_index);
       void loadNormalizedFrequencies(const std::complex<float>* frequencies, int to_index);
+      void loadMipLevels(int to_index);
 
       static const mono_float kZeroWaveform[kWaveformSize + kExtraValues];
 
@@ -151,6 +186,7 @@ namespace vital {
       bool shepard_table_;
 
       mono_float fft_data_[2 * kWaveformSize];
+      poly_float mip_data_[2 * kWaveformSize / poly_float::kSize + poly_float::kSize];
 
       JUCE_LEAK_DETECTOR(Wavetable)
   };
@@ -19,6 +19,16 @@
 
 namespace vital {
 
+  namespace {
+    force_inline poly_float sectionValue(int sample, poly_float power, poly_float delta_power,
+                                         poly_float position, poly_float delta_position,
+                                         poly_float start, poly_float end, poly_float delta_end) {
+      poly_float sample_position = utils::clamp(position + delta_position * sample, 0.0f, 1.0f);
+      poly_float t = futils::powerScale(sample_position, power + delta_power * sample);
+      return utils::interpolate(start, end + delta_end * sample, t);
+    }
+  } // namespace
+
   Envelope::Envelope() :
       Processor(kNumInputs, kNumOutputs), current_value_(0.0f),
       position_(0.0f), value_(0.0f), poly_state_(0.0f), start_value_(0.0f),
@@ -139,6 +149,59 @@ namespace vital {
     return utils::clamp(position + delta_position * num_samples, 0.0f, 1.0f);
   }
 
+  poly_float Envelope::processSectionSubRate(poly_float* audio_out, int from, int to, int sub_rate, bool cubic,
+                                             poly_float power, poly_float delta_power,
+                                             poly_float position, poly_float delta_position,
+                                             poly_float start, poly_float end, poly_float delta_end) {
+    int num_samples = to - from;
+    poly_float last_value = sectionValue(0, power, delta_power, position, delta_position, start, end, delta_end);
+    audio_out[from] = last_value;
+
+    int previous_sample = 0;
+    poly_float previous_value = last_value;
+    int ahead_sample = 0;
+    poly_float ahead_value = last_value;
+
+    for (int i = 0; i < num_samples - 1;) {
+      int next = std::min(i + sub_rate, num_samples - 1);
+      int steps = next - i;
+      poly_float next_value = ahead_value;
+      if (ahead_sample != next)
+        next_value = sectionValue(next, power, delta_power, position, delta_position, start, end, delta_end);
+
+      if (cubic) {
+        if (previous_sample != i - steps) {
+          previous_value = sectionValue(i - steps, power, delta_power, position, delta_position,
+                                        start, end, delta_end);
+        }
+        ahead_sample = next + steps;
+        ahead_value = sectionValue(ahead_sample, power, delta_power, position, delta_position,
+                                   start, end, delta_end);
+
+        matrix values(previous_value, last_value, next_value, ahead_value);
+        mono_float step_inc = 1.0f / steps;
+        for (int s = 1; s < steps; ++s)
+          audio_out[from + i + s] = values.multiplyAndSumRows(utils::getCatmullInterpolationMatrix(s * step_inc));
+      }
+      else {
+        poly_float delta_value = (next_value - last_value) * (1.0f / steps);
+        poly_float value = last_value;
+        for (int s = 1; s < steps; ++s) {
+          value += delta_value;
+          audio_out[from + i + s] = value;
+        }
+      }
+
+      audio_out[from + next] = next_value;
+      previous_sample = i;
+      previous_value = last_value;
+      last_value = next_value;
+      i = next;
+    }
+
+    return utils::clamp(position + delta_position * num_samples, 0.0f, 1.0f);
+  }
+
   void Envelope::processAudioRate(int num_samples) {
     poly_float delta_time = 1.0f / getSampleRate();
     mono_float delta_sample = 1.0f / num_samples;
@@ -222,8 +285,18 @@ namespace vital {
       poly_float end = (poly_float(1.0f) & (attack_mask | hold_mask)) + (current_sustain & decay_mask);
       poly_float delta_end = ((sustain_end - sustain_) * delta_sample) & decay_mask;
 
-      current_position = processSection(audio_out, i, last_cycle, power, delta_power,
-                                        current_position, delta_position, start, end, delta_end);
+      // Attacks and fast segments are computed every sample to keep transients sharp.
+      int sub_rate = getSubRateSamples();
+      bool fast = utils::maxFloat(delta_position) * sub_rate >= kMaxSubRatePositionDelta;
+      if (sub_rate > 1 && last_cycle - i > sub_rate && !attack_mask.anyMask() && !fast) {
+        bool cubic = input(kSubRateInterpolation)->at(0)[0] == constants::kCubicSubRate;
+        current_position = processSectionSubRate(audio_out, i, last_cycle, sub_rate, cubic, power, delta_power,
+                                                 current_position, delta_position, start, end, delta_end);
+      }
+      else {
+        current_position = processSection(audio_out, i, last_cycle, power, delta_power,
+                                          current_position, delta_position, start, end, delta_end);
+      }
       i = last_cycle;
 
       value_ = audio_out[i - 1];
@@ -17,6 +17,7 @@
 #pragma once
 
 #include "processor.h"
+#include "synth_constants.h"
 #include "utils.h"
 
 namespace vital {
@@ -34,6 +35,8 @@ namespace vital {
         kRelease,
         kReleasePower,
         kTrigger,
+        kSubRate,
+        kSubRateInterpolation,
         kNumInputs
       };
 
@@ -43,12 +46,23 @@ namespace vital {
         kNumOutputs
       };
 
+      static constexpr int kMaxSubRateSamples = 16;
+      static constexpr mono_float kMaxSubRatePositionDelta = 1.0f / 64.0f;
+
       Envelope();
       virtual ~Envelope() { }
 
       virtual Processor* clone() const override { return new Envelope(*this); }
       virtual void process(int num_samples) override;
 
+      // Audio rate output is computed every few samples and interpolated in between, 1 is full rate.
+      int getSubRateSamples() const {
+        int sub_rate = utils::iclamp(input(kSubRate)->at(0)[0], 0, constants::kNumModulatorSubRates - 1);
+        if (sub_rate == constants::kFullRateModulators)
+          return 1;
+        return utils::iclamp((1 << sub_rate) * getOversampleAmount(), 1, kMaxSubRateSamples);
+      }
+
     private:
       void processControlRate(int num_samples);
       void processAudioRate(int num_samples);
@@ -57,6 +71,10 @@ namespace vital {
                                 poly_float power, poly_float delta_power,
                                 poly_float position, poly_float delta_position,
                                 poly_float start, poly_float end, poly_float delta_end);
+      poly_float processSectionSubRate(poly_float* audio_out, int from, int to, int sub_rate, bool cubic,
+                                       poly_float power, poly_float delta_power,
+                                       poly_float position, poly_float delta_position,
+                                       poly_float start, poly_float end, poly_float delta_end);
 
       poly_float current_value_;
 
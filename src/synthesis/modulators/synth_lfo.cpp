@@ -26,8 +26,11 @@
 namespace vital {
   SynthLfo::SynthLfo(LineGenerator* source) : Processor(kNumInputs, kNumOutputs), source_(source) {
     was_control_rate_ = true;
+    was_shared_ = false;
+    sub_rate_history_ = 0.0f;
     sync_seconds_ = std::make_shared<double>();
     *sync_seconds_ = 0;
+    shared_ = std::make_shared<SharedState>();
 
     trigger_sample_ = 0;
   }
@@ -295,6 +298,96 @@ namespace vital {
     return phased_offset;
   }
 
+  poly_float SynthLfo::processAudioRateLfoSubRate(int num_samples, int sub_rate, bool cubic, poly_float current_phase,
+                                                  poly_float current_offset, poly_float delta_offset) {
+    int lfo_resolution = source_->resolution();
+    poly_float resolution = lfo_resolution;
+    poly_int max_index = lfo_resolution - 1;
+    mono_float* lfo_buffer = source_->getCubicInterpolationBuffer();
+    poly_float delta_phase = (audio_rate_state_.phase - current_phase) * (1.0f / num_samples);
+
+    poly_float fade_time = input(kFade)->at(0);
+    poly_float delay_time = input(kDelay)->at(0) + trigger_delay_;
+    poly_float delay_time_passed = audio_rate_state_.delay_time_passed;
+    poly_float current_amplitude = audio_rate_state_.fade_amplitude;
+    poly_float tick_time = 1.0f / getSampleRate();
+    poly_float fade_increase = tick_time / utils::max(tick_time, fade_time);
+
+    bool smooth = input(kSmoothMode)->at(0)[0];
+    poly_mask smooth_mask = 0;
+    poly_float smooth_exponent = 0.0f;
+    if (smooth) {
+      poly_float half_life = input(kSmoothTime)->at(0) * kHalfLifeRatio;
+      smooth_mask = poly_float::greaterThan(half_life, kMinHalfLife);
+      smooth_exponent = poly_float(-tick_time) / utils::max(half_life, kMinHalfLife);
+      current_amplitude = 1.0f;
+    }
+    poly_float smooth_mult = futils::exp2(smooth_exponent * sub_rate) & smooth_mask;
+
+    poly_mask delaying_mask = poly_float::greaterThan(delay_time, delay_time_passed);
+    poly_float* dest = output(kValue)->buffer;
+    poly_float phased_offset = 0.0f;
+    poly_float current_value = audio_rate_state_.smooth_value;
+    poly_float last_output = current_amplitude * current_value;
+    poly_float start_output = last_output;
+
+    for (int i = 0; i < num_samples; i += sub_rate) {
+      int steps = std::min(sub_rate, num_samples - i);
+      if (steps != sub_rate)
+        smooth_mult = futils::exp2(smooth_exponent * steps) & smooth_mask;
+
+      delay_time_passed += tick_time * steps;
+      poly_mask past_delay_mask = poly_float::greaterThanOrEqual(delay_time_passed, delay_time);
+      current_amplitude = utils::clamp(current_amplitude + ((fade_increase * steps) & past_delay_mask), 0.0f, 1.0f);
+
+      poly_float step_offset = (delta_offset * (steps - 1.0f)) & past_delay_mask;
+      phased_offset = utils::mod(current_offset + step_offset + current_phase + delta_phase * (steps - 1.0f));
+      poly_float value = getValueAtPhase(lfo_buffer, resolution, max_index, phased_offset);
+      current_value = utils::interpolate(value, current_value, smooth_mult);
+
+      poly_float next_output = current_amplitude * current_value;
+      if (!cubic) {
+        poly_float delta_output = (next_output - last_output) * (1.0f / steps);
+        for (int s = 1; s < steps; ++s)
+          dest[i + s - 1] = last_output + delta_output * s;
+      }
+      dest[i + steps - 1] = next_output;
+      last_output = next_output;
+
+      current_offset = utils::mod(current_offset + ((delta_offset * steps) & past_delay_mask));
+      current_phase += delta_phase * steps;
+    }
+
+    // Fill in between the computed values, extrapolating the value after the end of the block.
+    if (cubic) {
+      poly_float previous = sub_rate_history_;
+      poly_float from = start_output;
+      for (int i = 0; i < num_samples; i += sub_rate) {
+        int steps = std::min(sub_rate, num_samples - i);
+        poly_float to = dest[i + steps - 1];
+        int ahead_index = std::min(i + steps + sub_rate, num_samples) - 1;
+        poly_float ahead = to * 2.0f - from;
+        if (ahead_index >= i + steps)
+          ahead = dest[ahead_index];
+
+        matrix values(previous, from, to, ahead);
+        mono_float step_inc = 1.0f / steps;
+        for (int s = 1; s < steps; ++s)
+          dest[i + s - 1] = values.multiplyAndSumRows(utils::getCatmullInterpolationMatrix(s * step_inc));
+
+        previous = from;
+        from = to;
+      }
+    }
+
+    audio_rate_state_.smooth_value = current_value;
+    audio_rate_state_.fade_amplitude = current_amplitude;
+    audio_rate_state_.delay_time_passed = delay_time_passed;
+    poly_float undelayed_offset = utils::mod(audio_rate_state_.offset + delta_offset * num_samples);
+    audio_rate_state_.offset = utils::maskLoad(undelayed_offset, current_offset, delaying_mask);
+    return phased_offset;
+  }
+
   poly_float SynthLfo::processAudioRateLoopPoint(int num_samples, poly_float current_phase,
                                                  poly_float current_offset, poly_float delta_offset) {
     int lfo_resolution = source_->resolution();
@@ -418,8 +511,21 @@ namespace vital {
       output_phase = processAudioRateEnvelope(num_samples, current_phase, offset, delta_offset);
     else if (sync_type == kSustainEnvelope)
       output_phase = processAudioRateSustainEnvelope(num_samples, current_phase, offset, delta_offset);
-    else if (sync_type == kTrigger || sync_type == kSync)
-      output_phase = processAudioRateLfo(num_samples, current_phase, offset, delta_offset);
+    else if (sync_type == kTrigger || sync_type == kSync) {
+      // Fast moving and retriggered LFOs fall back to computing every sample.
+      int sub_rate = getSubRateSamples();
+      poly_float phase_delta = poly_float::abs(delta_offset) +
+                               poly_float::abs(audio_rate_state_.phase - current_phase) * (1.0f / num_samples);
+      bool slow = utils::maxFloat(phase_delta) * sub_rate < kMaxSubRatePhaseDelta;
+      if (sub_rate > 1 && slow && !getResetMask(kNoteTrigger).anyMask()) {
+        bool cubic = input(kSubRateInterpolation)->at(0)[0] == constants::kCubicSubRate;
+        output_phase = processAudioRateLfoSubRate(num_samples, sub_rate, cubic, current_phase, offset, delta_offset);
+      }
+      else
+        output_phase = processAudioRateLfo(num_samples, current_phase, offset, delta_offset);
+
+      sub_rate_history_ = output(kValue)->buffer[std::max(num_samples - 1 - sub_rate, 0)];
+    }
     else if (sync_type == kLoopPoint)
       output_phase = processAudioRateLoopPoint(num_samples, current_phase, offset, delta_offset);
     else if (sync_type == kLoopHold)
@@ -429,7 +535,54 @@ namespace vital {
     output(kOscFrequency)->buffer[0] = frequency;
   }
 
+  void SynthLfo::processShared(int num_samples) {
+    poly_mask reset_mask = getResetMask(kNoteTrigger);
+    held_mask_ = (held_mask_ | reset_mask) & ~getReleaseMask();
+    was_shared_ = true;
+    if (shared_->processed_block == shared_->block)
+      return;
+
+    bool stale = shared_->processed_block + 1 != shared_->block;
+    shared_->processed_block = shared_->block;
+    control_rate_state_ = shared_->control_rate_state;
+    audio_rate_state_ = shared_->audio_rate_state;
+    trigger_delay_ = 0.0f;
+
+    bool control_rate = isControlRate();
+    if (shared_->was_control_rate && !control_rate)
+      audio_rate_state_ = control_rate_state_;
+    shared_->was_control_rate = control_rate;
+
+    // Restart every lane on the host synced phase, the same place a newly triggered voice would start.
+    if (stale || reset_mask.anyMask()) {
+      poly_float sync_phase = utils::getCycleOffsetFromSeconds(*sync_seconds_, input(kFrequency)->at(0));
+      control_rate_state_ = LfoState();
+      control_rate_state_.offset = sync_phase;
+      audio_rate_state_ = control_rate_state_;
+      audio_rate_state_.phase = input(kPhase)->at(0) + input(kStereoPhase)->at(0) * poly_float(0.5f, -0.5f);
+    }
+
+    if (!control_rate)
+      processAudioRate(num_samples);
+    processControlRate(num_samples);
+
+    shared_->control_rate_state = control_rate_state_;
+    shared_->audio_rate_state = audio_rate_state_;
+  }
+
   void SynthLfo::process(int num_samples) {
+    if (shared_->enabled) {
+      processShared(num_samples);
+      return;
+    }
+
+    if (was_shared_) {
+      control_rate_state_ = shared_->control_rate_state;
+      audio_rate_state_ = shared_->audio_rate_state;
+      was_control_rate_ = shared_->was_control_rate;
+      was_shared_ = false;
+    }
+
     bool control_rate = isControlRate();
     if (was_control_rate_ && !control_rate)
       audio_rate_state_ = control_rate_state_;
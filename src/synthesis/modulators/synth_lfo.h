@@ -18,6 +18,7 @@
 
 #include "processor.h"
 #include "line_generator.h"
+#include "synth_constants.h"
 
 namespace vital {
 
@@ -35,6 +36,8 @@ namespace vital {
         kStereoPhase,
         kDelay,
         kNoteCount,
+        kSubRate,
+        kSubRateInterpolation,
         kNumInputs
       };
 
@@ -73,9 +76,20 @@ namespace vital {
         poly_float phase = 0.0f;
       };
 
+      struct SharedState {
+        LfoState control_rate_state;
+        LfoState audio_rate_state;
+        bool enabled = false;
+        bool was_control_rate = true;
+        unsigned int block = 0;
+        unsigned int processed_block = 0;
+      };
+
       static constexpr mono_float kMaxPower = 20.0f;
       static constexpr float kHalfLifeRatio = 0.2f;
       static constexpr float kMinHalfLife = 0.0002f;
+      static constexpr int kMaxSubRateSamples = 16;
+      static constexpr mono_float kMaxSubRatePhaseDelta = 1.0f / 64.0f;
 
       force_inline poly_float getValueAtPhase(mono_float* buffer, poly_float resolution,
                                               poly_int max_index, poly_float phase) {
@@ -108,8 +122,23 @@ namespace vital {
       void process(int num_samples) override;
       void correctToTime(double seconds);
 
+      // Voice invariant LFOs are computed by the first voice processed each block. Output buffers are shared
+      // between voice clones so the remaining voices reuse the result.
+      void setShared(bool shared) { shared_->enabled = shared; }
+      bool isShared() const { return shared_->enabled; }
+      void advanceSharedBlock() { shared_->block++; }
+
+      // Audio rate output is computed every few samples and interpolated in between, 1 is full rate.
+      int getSubRateSamples() const {
+        int sub_rate = utils::iclamp(input(kSubRate)->at(0)[0], 0, constants::kNumModulatorSubRates - 1);
+        if (sub_rate == constants::kFullRateModulators)
+          return 1;
+        return utils::iclamp((1 << sub_rate) * getOversampleAmount(), 1, kMaxSubRateSamples);
+      }
+
     protected:
       void processTrigger();
+      void processShared(int num_samples);
       void processControlRate(int num_samples);
 
       poly_float processAudioRateEnvelope(int num_samples, poly_float current_phase,
@@ -118,6 +147,8 @@ namespace vital {
                                                  poly_float current_offset, poly_float delta_offset);
       poly_float processAudioRateLfo(int num_samples, poly_float current_phase,
                                      poly_float current_offset, poly_float delta_offset);
+      poly_float processAudioRateLfoSubRate(int num_samples, int sub_rate, bool cubic, poly_float current_phase,
+                                            poly_float current_offset, poly_float delta_offset);
       poly_float processAudioRateLoopPoint(int num_samples, poly_float current_phase,
                                            poly_float current_offset, poly_float delta_offset);
       poly_float processAudioRateLoopHold(int num_samples, poly_float current_phase,
@@ -125,6 +156,8 @@ namespace vital {
       void processAudioRate(int num_samples);
 
       bool was_control_rate_;
+      bool was_shared_;
+      poly_float sub_rate_history_;
       LfoState control_rate_state_;
       LfoState audio_rate_state_;
 
@@ -134,6 +167,7 @@ namespace vital {
       LineGenerator* source_;
 
       std::shared_ptr<double> sync_seconds_;
+      std::shared_ptr<SharedState> shared_;
 
       JUCE_LEAK_DETECTOR(SynthLfo)
   };
@@ -158,4 +158,11 @@ namespace vital {
   void ChorusModule::correctToTime(double seconds) {
     phase_ = utils::getCycleOffsetFromSeconds(seconds, frequency_->buffer[0]);
   }
+
+  int ChorusModule::getTailSamples() {
+    int tail_samples = 0;
+    for (int i = 0; i < last_num_voices_; ++i)
+      tail_samples = std::max(tail_samples, delays_[i]->getTailSamples());
+    return tail_samples;
+  }
 } // namespace vital
@@ -0,0 +1,66 @@
+/* Copyright 2013-2019 Matt Tytel
+ *
+ * vital is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * vital is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with vital.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "convolution_module.h"
+
+#include "convolution.h"
+
+namespace vital {
+
+  ConvolutionModule::ConvolutionModule() : SynthModule(0, 1), convolution_(nullptr) { }
+
+  ConvolutionModule::~ConvolutionModule() {
+  }
+
+  void ConvolutionModule::init() {
+    convolution_ = new Convolution();
+    convolution_->useOutput(output());
+    addIdleProcessor(convolution_);
+
+    Output* convolution_wet = createMonoModControl("convolution_dry_wet");
+    Output* convolution_gain = createMonoModControl("convolution_gain");
+
+    convolution_->plug(convolution_wet, Convolution::kWet);
+    convolution_->plug(convolution_gain, Convolution::kGain);
+
+    SynthModule::init();
+  }
+
+  void ConvolutionModule::hardReset() {
+    convolution_->hardReset();
+  }
+
+  void ConvolutionModule::enable(bool enable) {
+    SynthModule::enable(enable);
+    process(1);
+    if (!enable)
+      convolution_->hardReset();
+  }
+
+  void ConvolutionModule::setSampleRate(int sample_rate) {
+    SynthModule::setSampleRate(sample_rate);
+    convolution_->setSampleRate(sample_rate);
+  }
+
+  int ConvolutionModule::getTailSamples() {
+    return convolution_->getTailSamples();
+  }
+
+  void ConvolutionModule::processWithInput(const poly_float* audio_in, int num_samples) {
+    SynthModule::process(num_samples);
+    convolution_->processWithInput(audio_in, num_samples);
+  }
+} // namespace vital
@@ -39,6 +39,7 @@ namespace vital {
           delay_->hardReset();
       }
       virtual void setSampleRate(int sample_rate) override;
+      virtual int getTailSamples() override { return delay_->getTailSamples(); }
       virtual void setOversampleAmount(int oversample) override;
       virtual void processWithInput(const poly_float* audio_in, int num_samples) override;
       virtual Processor* clone() const override { return new DelayModule(*this); }
@@ -24,6 +24,8 @@ namespace vital {
       SynthModule(kNumInputs, kNumOutputs), prefix_(prefix), force_audio_rate_(force_audio_rate) {
     envelope_ = new Envelope();
     envelope_->useInput(input(kTrigger), Envelope::kTrigger);
+    envelope_->useInput(input(kSubRate), Envelope::kSubRate);
+    envelope_->useInput(input(kSubRateInterpolation), Envelope::kSubRateInterpolation);
     
     envelope_->useOutput(output(kValue), Envelope::kValue);
     envelope_->useOutput(output(kPhase), Envelope::kPhase);
@@ -25,6 +25,8 @@ namespace vital {
     public:
       enum {
         kTrigger,
+        kSubRate,
+        kSubRateInterpolation,
         kNumInputs
       };
     
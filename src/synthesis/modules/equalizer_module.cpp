@@ -26,7 +26,7 @@ namespace vital {
       low_mode_(nullptr), band_mode_(nullptr), high_mode_(nullptr),
       high_pass_(nullptr), low_shelf_(nullptr),
       notch_(nullptr), band_shelf_(nullptr),
-      low_pass_(nullptr), high_shelf_(nullptr) {
+      low_pass_(nullptr), high_shelf_(nullptr), audio_memory_enabled_(true) {
     audio_memory_ = std::make_shared<vital::StereoMemory>(vital::kAudioMemorySamples);
   }
 
@@ -152,6 +152,9 @@ namespace vital {
     band_processor->processWithInput(low_processor->output()->buffer, num_samples);
     high_processor->processWithInput(band_processor->output()->buffer, num_samples);
 
+    if (!audio_memory_enabled_)
+      return;
+
     const poly_float* output_buffer = high_processor->output()->buffer;
     for (int i = 0; i < num_samples; ++i)
       audio_memory_->push(output_buffer[i]);
@@ -48,6 +48,7 @@ namespace vital {
 
       void processWithInput(const poly_float* audio_in, int num_samples) override;
       void correctToTime(double seconds) override;
+      int getTailSamples() override { return delay_->getTailSamples(); }
 
       Processor* clone() const override { VITAL_ASSERT(false); return nullptr; }
 
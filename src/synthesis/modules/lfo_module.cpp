@@ -17,12 +17,14 @@
 #include "lfo_module.h"
 
 #include "line_generator.h"
+#include "operators.h"
 #include "synth_lfo.h"
 
 namespace vital {
 
   LfoModule::LfoModule(const std::string& prefix, LineGenerator* line_generator, const Output* beats_per_second) :
-      SynthModule(kNumInputs, kNumOutputs), prefix_(prefix), beats_per_second_(beats_per_second) {
+      SynthModule(kNumInputs, kNumOutputs), prefix_(prefix), sync_type_(nullptr), smooth_mode_(nullptr),
+      tempo_sync_(nullptr), beats_per_second_(beats_per_second) {
     lfo_ = new SynthLfo(line_generator);
     addProcessor(lfo_);
 
@@ -42,6 +44,8 @@ namespace vital {
     Output* frequency = createTempoSyncSwitch(prefix_, free_frequency->owner, beats_per_second_, true, input(kMidi));
     lfo_->useInput(input(kNoteTrigger), SynthLfo::kNoteTrigger);
     lfo_->useInput(input(kNoteCount), SynthLfo::kNoteCount);
+    lfo_->useInput(input(kSubRate), SynthLfo::kSubRate);
+    lfo_->useInput(input(kSubRateInterpolation), SynthLfo::kSubRateInterpolation);
 
     lfo_->useOutput(output(kValue), SynthLfo::kValue);
     lfo_->useOutput(output(kOscPhase), SynthLfo::kOscPhase);
@@ -54,6 +58,38 @@ namespace vital {
     lfo_->plug(fade, SynthLfo::kFade);
     lfo_->plug(smooth_time, SynthLfo::kSmoothTime);
     lfo_->plug(delay, SynthLfo::kDelay);
+
+    sync_type_ = sync_type;
+    smooth_mode_ = smooth_mode;
+    tempo_sync_ = data_->controls[prefix_ + "_sync"];
+    for (auto& destination : data_->poly_mod_destinations)
+      poly_modulation_destinations_.push_back(destination.second);
+  }
+
+  bool LfoModule::isVoiceInvariant() const {
+    if (static_cast<int>(sync_type_->value()) != SynthLfo::kSync ||
+        static_cast<int>(tempo_sync_->value()) == TempoChooser::kKeytrack) {
+      return false;
+    }
+
+    for (Processor* destination : poly_modulation_destinations_) {
+      if (destination->connectedInputs())
+        return false;
+    }
+
+    // Fades, delays and smoothing all restart when a voice triggers.
+    if (utils::maxFloat(lfo_->input(SynthLfo::kFade)->at(0)) > 0.0f ||
+        utils::maxFloat(lfo_->input(SynthLfo::kDelay)->at(0)) > 0.0f) {
+      return false;
+    }
+
+    poly_float half_life = lfo_->input(SynthLfo::kSmoothTime)->at(0) * SynthLfo::kHalfLifeRatio;
+    return smooth_mode_->value() == 0.0f || utils::maxFloat(half_life) <= SynthLfo::kMinHalfLife;
+  }
+
+  void LfoModule::updateSharedEvaluation() {
+    lfo_->setShared(isVoiceInvariant());
+    lfo_->advanceSharedBlock();
   }
 
   void LfoModule::correctToTime(double seconds) {
@@ -29,6 +29,8 @@ namespace vital {
         kNoteTrigger,
         kNoteCount,
         kMidi,
+        kSubRate,
+        kSubRateInterpolation,
         kNumInputs
       };
 
@@ -47,9 +49,17 @@ namespace vital {
       void correctToTime(double seconds) override;
       void setControlRate(bool control_rate) override;
 
+      // True when every voice would compute the same LFO output under the current settings.
+      bool isVoiceInvariant() const;
+      void updateSharedEvaluation();
+
     protected:
       std::string prefix_;
       SynthLfo* lfo_;
+      Value* sync_type_;
+      Value* smooth_mode_;
+      Value* tempo_sync_;
+      std::vector<Processor*> poly_modulation_destinations_;
       const Output* beats_per_second_;
 
       JUCE_LEAK_DETECTOR(LfoModule)
@@ -76,97 +76,31 @@ namespace vital {
     bool using_map = !map_generator_->linear();
 
     if (using_power && using_map)
-      processAudioRateRemappedAndMorphed(num_samples, source, power);
+      processAudioRateMapped<true, true>(num_samples, source, power);
     else if (using_power)
-      processAudioRateMorphed(num_samples, source, power);
+      processAudioRateMapped<false, true>(num_samples, source, power);
     else if (using_map)
-      processAudioRateRemapped(num_samples, source);
+      processAudioRateMapped<true, false>(num_samples, source, power);
     else
-      processAudioRateLinear(num_samples, source);
+      processAudioRateMapped<false, false>(num_samples, source, power);
 
     power_ = power;
   }
 
-  void ModulationConnectionProcessor::processAudioRateLinear(int num_samples, const Output* source) {
+  template<bool kRemap, bool kMorph>
+  void ModulationConnectionProcessor::processAudioRateMapped(int num_samples, const Output* source,
+                                                             poly_float power) {
     poly_float* dest = output(kModulationOutput)->buffer;
     const poly_float* modulation_source = source->buffer;
 
-    poly_float bipolar_offset = -bipolar_->value() * 0.5f;
-    poly_float current_amount = modulation_amount_;
-    poly_float stereo_scale = poly_float(1.0f) - (constants::kRightOne * 2.0f * stereo_->value());
-    poly_float modulation_amount = utils::clamp(input(kModulationAmount)->at(0), -1.0f, 1.0f) * stereo_scale;
-    modulation_amount_ = modulation_amount * (*destination_scale_);
-    current_amount = utils::maskLoad(current_amount, modulation_amount_, getResetMask(kReset));
-    poly_float delta_amount = (modulation_amount_ - current_amount) * (1.0f / num_samples);
-
-    for (int i = 0; i < num_samples; ++i) {
-      current_amount += delta_amount;
-      poly_float modulation_value = modulation_source[i];
-      dest[i] = (modulation_value + bipolar_offset) * current_amount;
-    }
-
-    output(kModulationPreScale)->buffer[0] = (modulation_source[0] + bipolar_offset) * modulation_amount;
-    output(kModulationOutput)->trigger_value = dest[0];
-  }
-
-  void ModulationConnectionProcessor::processAudioRateMorphed(int num_samples, const Output* source,
-                                                              poly_float power) {
-    poly_float* dest = output(kModulationOutput)->buffer;
-    const poly_float* modulation_source = source->buffer;
-    poly_float bipolar_offset = -bipolar_->value() * 0.5f;
-
     poly_float bipolar = bipolar_->value();
-    poly_float polarity_pre_scale = bipolar + 1.0f;
-    poly_float polarity_post_scale = -bipolar * 0.5f + 1.0f;
-    polarity_post_scale *= poly_float(1.0f) - (constants::kRightOne * 2.0f * stereo_->value());
-
-    poly_float current_amount = modulation_amount_;
-    poly_float current_power = power_;
-
+    poly_float stereo_scale = poly_float(1.0f) - (constants::kRightOne * 2.0f * stereo_->value());
     poly_float modulation_amount = utils::clamp(input(kModulationAmount)->at(0), -1.0f, 1.0f);
-    modulation_amount_ = modulation_amount * (*destination_scale_);
-
-    poly_mask reset_mask = getResetMask(kReset);
-    current_amount = utils::maskLoad(current_amount, modulation_amount_, reset_mask);
-    current_power = utils::maskLoad(current_power, power, reset_mask);
-
-    float sample_inc = 1.0f / num_samples;
-    poly_float delta_amount = (modulation_amount_ - current_amount) * sample_inc;
-    poly_float delta_power = (power - current_power) * sample_inc;
-
-    for (int i = 0; i < num_samples; ++i) {
-      current_amount += delta_amount;
-      current_power += delta_power;
-
-      poly_float modulation_value = modulation_source[i];
-      poly_float modulation_shift = modulation_value * polarity_pre_scale - bipolar;
-      poly_float modulation_abs = poly_float::abs(modulation_shift);
-      poly_mask sign_mask = poly_float::sign_mask(modulation_shift);
-
-      poly_float shifted_modulation = futils::powerScale(modulation_abs, current_power);
-      poly_float pre_modulation = current_amount * shifted_modulation;
-      dest[i] = (pre_modulation ^ sign_mask) * polarity_post_scale;
-    }
-
-    output(kModulationPreScale)->buffer[0] = dest[0] * (1.0f / (*destination_scale_));
-    output(kModulationOutput)->trigger_value = dest[0];
-  }
-
-  void ModulationConnectionProcessor::processAudioRateRemappedAndMorphed(int num_samples, const Output* source,
-                                                                         poly_float power) {
-    poly_float* dest = output(kModulationOutput)->buffer;
-    const poly_float* modulation_source = source->buffer;
-    poly_float bipolar_offset = -bipolar_->value() * 0.5f;
-
-    poly_float bipolar = bipolar_->value();
-    poly_float polarity_pre_scale = bipolar + 1.0f;
-    poly_float polarity_post_scale = -bipolar * 0.5f + 1.0f;
-    polarity_post_scale *= poly_float(1.0f) - (constants::kRightOne * 2.0f * stereo_->value());
+    if (!kMorph)
+      modulation_amount *= stereo_scale;
 
     poly_float current_amount = modulation_amount_;
     poly_float current_power = power_;
-
-    poly_float modulation_amount = utils::clamp(input(kModulationAmount)->at(0), -1.0f, 1.0f);
     modulation_amount_ = modulation_amount * (*destination_scale_);
 
     poly_mask reset_mask = getResetMask(kReset);
@@ -176,69 +110,56 @@ namespace vital {
     float sample_inc = 1.0f / num_samples;
     poly_float delta_amount = (modulation_amount_ - current_amount) * sample_inc;
     poly_float delta_power = (power - current_power) * sample_inc;
+    bool constant_power = poly_float::notEqual(delta_power, 0.0f).anyMask() == 0;
 
-    mono_float* buffer = map_generator_->getCubicInterpolationBuffer();
-    for (int i = 0; i < num_samples; ++i) {
-      current_amount += delta_amount;
-      current_power += delta_power;
-      poly_float modulation_value = modulation_source[i];
-
-      mono_float resolution = map_generator_->resolution();
-      poly_float boost = utils::clamp(modulation_value * resolution, 0.0f, resolution);
-      poly_int indices = utils::clamp(utils::toInt(boost), 0, resolution - 1);
-      poly_float t = boost - utils::toFloat(indices);
-
-      matrix interpolation_matrix = utils::getCatmullInterpolationMatrix(t);
-      matrix value_matrix = utils::getValueMatrix(buffer, indices);
-
-      value_matrix.transpose();
-      modulation_value = utils::clamp(interpolation_matrix.multiplyAndSumRows(value_matrix), -1.0f, 1.0f);
-
-      poly_float modulation_shift = modulation_value * polarity_pre_scale - bipolar;
-      poly_float modulation_abs = poly_float::abs(modulation_shift);
-      poly_mask sign_mask = poly_float::sign_mask(modulation_shift);
-
-      poly_float shifted_modulation = futils::powerScale(modulation_abs, current_power);
-      poly_float pre_modulation = current_amount * shifted_modulation;
-      dest[i] = (pre_modulation ^ sign_mask) * polarity_post_scale;
-    }
-
-    output(kModulationPreScale)->buffer[0] = dest[0] * (1.0f / (*destination_scale_));
-    output(kModulationOutput)->trigger_value = dest[0];
-  }
-
-  void ModulationConnectionProcessor::processAudioRateRemapped(int num_samples, const Output* source) {
-    poly_float* dest = output(kModulationOutput)->buffer;
-    const poly_float* modulation_source = source->buffer;
+    poly_float bipolar_offset = -bipolar * 0.5f;
+    poly_float polarity_pre_scale = bipolar + 1.0f;
+    poly_float polarity_post_scale = (-bipolar * 0.5f + 1.0f) * stereo_scale;
+    poly_mask linear_mask = futils::powerScaleLinearMask(power);
+    poly_float inverse_denominator = poly_float(1.0f) / (futils::exp(power) - 1.0f);
 
-    poly_float bipolar_offset = -bipolar_->value() * 0.5f;
-    poly_float current_amount = modulation_amount_;
-    poly_float stereo_scale = poly_float(1.0f) - (constants::kRightOne * 2.0f * stereo_->value());
-    poly_float modulation_amount = utils::clamp(input(kModulationAmount)->at(0), -1.0f, 1.0f) * stereo_scale;
-    modulation_amount_ = modulation_amount * (*destination_scale_);
-    current_amount = utils::maskLoad(current_amount, modulation_amount_, getResetMask(kReset));
-    poly_float delta_amount = (modulation_amount_ - current_amount) * (1.0f / num_samples);
+    const mono_float* map_buffer = map_generator_->getCubicInterpolationBuffer();
+    mono_float resolution = map_generator_->resolution();
 
-    mono_float* buffer = map_generator_->getCubicInterpolationBuffer();
     for (int i = 0; i < num_samples; ++i) {
       current_amount += delta_amount;
       poly_float modulation_value = modulation_source[i];
 
-      mono_float resolution = map_generator_->resolution();
-      poly_float boost = utils::clamp(modulation_value * resolution, 0.0f, resolution);
-      poly_int indices = utils::clamp(utils::toInt(boost), 0, resolution - 1);
-      poly_float t = boost - utils::toFloat(indices);
-
-      matrix interpolation_matrix = utils::getCatmullInterpolationMatrix(t);
-      matrix value_matrix = utils::getValueMatrix(buffer, indices);
-
-      value_matrix.transpose();
-
-      modulation_value = utils::clamp(interpolation_matrix.multiplyAndSumRows(value_matrix), -1.0f, 1.0f);
-      dest[i] = (modulation_value + bipolar_offset) * current_amount;
+      if (kRemap) {
+        poly_float boost = utils::clamp(modulation_value * resolution, 0.0f, resolution);
+        poly_int indices = utils::clamp(utils::toInt(boost), 0, resolution - 1);
+        poly_float t = boost - utils::toFloat(indices);
+
+        matrix interpolation_matrix = utils::getCatmullInterpolationMatrix(t);
+        matrix value_matrix = utils::getValueMatrix(map_buffer, indices);
+
+        value_matrix.transpose();
+        modulation_value = utils::clamp(interpolation_matrix.multiplyAndSumRows(value_matrix), -1.0f, 1.0f);
+      }
+
+      if (kMorph) {
+        poly_float modulation_shift = modulation_value * polarity_pre_scale - bipolar;
+        poly_float modulation_abs = poly_float::abs(modulation_shift);
+        poly_mask sign_mask = poly_float::sign_mask(modulation_shift);
+
+        poly_float shifted_modulation;
+        if (constant_power)
+          shifted_modulation = futils::powerScale(modulation_abs, power, inverse_denominator, linear_mask);
+        else {
+          current_power += delta_power;
+          shifted_modulation = futils::powerScale(modulation_abs, current_power);
+        }
+        poly_float pre_modulation = current_amount * shifted_modulation;
+        dest[i] = (pre_modulation ^ sign_mask) * polarity_post_scale;
+      }
+      else
+        dest[i] = (modulation_value + bipolar_offset) * current_amount;
     }
 
-    output(kModulationPreScale)->buffer[0] = (modulation_source[0] + bipolar_offset) * modulation_amount;
+    if (kMorph)
+      output(kModulationPreScale)->buffer[0] = dest[0] * (1.0f / (*destination_scale_));
+    else
+      output(kModulationPreScale)->buffer[0] = (modulation_source[0] + bipolar_offset) * modulation_amount;
     output(kModulationOutput)->trigger_value = dest[0];
   }
 
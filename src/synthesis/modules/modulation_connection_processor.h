@@ -44,10 +44,8 @@ namespace vital {
       void init() override;
       void process(int num_samples) override;
       void processAudioRate(int num_samples, const Output* source);
-      void processAudioRateLinear(int num_samples, const Output* source);
-      void processAudioRateRemapped(int num_samples, const Output* source);
-      void processAudioRateMorphed(int num_samples, const Output* source, poly_float power);
-      void processAudioRateRemappedAndMorphed(int num_samples, const Output* source, poly_float power);
+      template<bool kRemap, bool kMorph>
+      void processAudioRateMapped(int num_samples, const Output* source, poly_float power);
       void processControlRate(const Output* source);
 
       virtual Processor* clone() const override { return new ModulationConnectionProcessor(*this); }
@@ -29,6 +29,7 @@ namespace vital {
         kRetrigger,
         kMidi,
         kActiveVoices,
+        kUnisonCulling,
         kNumInputs
       };
 
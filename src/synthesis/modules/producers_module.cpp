@@ -36,9 +36,12 @@ namespace vital {
   }
 
   void ProducersModule::init() {
+    Value* unison_culling = createBaseControl("unison_culling");
+
     for (int i = 0; i < kNumOscillators; ++i) {
       std::string number = std::to_string(i + 1);
       oscillator_destinations_[i] = createBaseControl("osc_" + number + "_destination");
+      oscillators_[i]->plug(unison_culling, OscillatorModule::kUnisonCulling);
 
       oscillators_[i]->useInput(input(kReset), OscillatorModule::kReset);
       oscillators_[i]->useInput(input(kRetrigger), OscillatorModule::kRetrigger);
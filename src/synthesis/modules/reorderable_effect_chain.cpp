@@ -18,6 +18,7 @@
 
 #include "chorus_module.h"
 #include "compressor_module.h"
+#include "convolution_module.h"
 #include "delay_module.h"
 #include "distortion_module.h"
 #include "equalizer_module.h"
@@ -64,7 +65,7 @@ namespace vital {
   };
 
   ReorderableEffectChain::ReorderableEffectChain(const Output* beats_per_second, const Output* keytrack) :
-      vital::SynthModule(kNumInputs, 1), equalizer_memory_(nullptr),
+      vital::SynthModule(kNumInputs, 1), equalizer_(nullptr), equalizer_memory_(nullptr), convolution_(nullptr),
       beats_per_second_(beats_per_second), keytrack_(keytrack), last_order_(0.0f) {
     for (int i = 0; i < constants::kNumEffects; ++i) {
       SynthModule* effect_module = createEffectModule(i);
@@ -75,6 +76,7 @@ namespace vital {
       effects_on_[i] = createBaseControl(strings::kEffectOrder[i] + "_on");
       effects_[i] = effect_module;
       effect_order_[i] = i;
+      silent_input_samples_[i] = 0;
     }
 
     last_order_ = utils::encodeOrderToFloat(effect_order_, constants::kNumEffects);
@@ -92,6 +94,7 @@ namespace vital {
         return new DistortionModule();
       case constants::kEq: {
         EqualizerModule* eq = new EqualizerModule();
+        equalizer_ = eq;
         equalizer_memory_ = eq->getAudioMemory();
         return eq;
       }
@@ -103,6 +106,11 @@ namespace vital {
         return new PhaserModule(beats_per_second_);
       case constants::kReverb:
         return new ReverbModule();
+      case constants::kConvolution: {
+        ConvolutionModule* convolution = new ConvolutionModule();
+        convolution_ = convolution;
+        return convolution;
+      }
       default:
         return nullptr;
     }
@@ -119,32 +127,66 @@ namespace vital {
       utils::decodeFloatToOrder(effect_order_, float_order, constants::kNumEffects);
     last_order_ = float_order;
 
+    bool silent = utils::isSilent(audio_in, num_samples);
+    int min_tail_samples = kMinTailTime * getSampleRate();
+
     for (int i = 0; i < constants::kNumEffects; ++i) {
       VITAL_ASSERT(utils::isFinite(audio_in, num_samples));
 
       int index = effect_order_[i];
       bool on = effects_on_[index]->value();
       bool enabled = effects_[index]->enabled();
-      if (on != enabled)
+      if (on != enabled) {
         effects_[index]->enable(on);
+        silent_input_samples_[index] = 0;
+      }
 
-      if (on) {
-        effects_[index]->processWithInput(audio_in, num_samples);
-        audio_in = effects_[index]->output(0)->buffer;
+      if (!on)
+        continue;
+
+      // Skip effects that have been fed silence for longer than their tail.
+      bool tail_finished = false;
+      if (silent) {
+        int tail_samples = std::max(min_tail_samples, effects_[index]->getTailSamples());
+        if (silent_input_samples_[index] > tail_samples)
+          continue;
+        silent_input_samples_[index] += num_samples;
+        tail_finished = silent_input_samples_[index] > tail_samples;
       }
+      else
+        silent_input_samples_[index] = 0;
+
+      effects_[index]->processWithInput(audio_in, num_samples);
+      audio_in = effects_[index]->output(0)->buffer;
+      if (tail_finished)
+        clearStatusOutputs(effects_[index]);
+      if (silent)
+        silent = utils::isSilent(audio_in, num_samples);
     }
 
     VITAL_ASSERT(utils::isFinite(audio_in, num_samples));
     utils::copyBuffer(output()->buffer, audio_in, num_samples);
   }
 
+  void ReorderableEffectChain::clearStatusOutputs(SynthModule* effect) {
+    for (int i = 1; i < effect->numOutputs(); ++i)
+      effect->output(i)->clearBuffer();
+  }
+
   void ReorderableEffectChain::hardReset() {
-    for (int i = 0; i < constants::kNumEffects; ++i)
+    for (int i = 0; i < constants::kNumEffects; ++i) {
       effects_[i]->hardReset();
+      silent_input_samples_[i] = 0;
+    }
   }
 
   void ReorderableEffectChain::correctToTime(double seconds) {
     for (int i = 0; i < constants::kNumEffects; ++i)
       effects_[i]->correctToTime(seconds);
   }
+
+  void ReorderableEffectChain::setTelemetryEnabled(bool enabled) {
+    if (equalizer_)
+      equalizer_->setAudioMemoryEnabled(enabled);
+  }
 } // namespace vital
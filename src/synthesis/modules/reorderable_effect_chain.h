@@ -22,10 +22,14 @@
 
 namespace vital {
 
+  class ConvolutionModule;
+  class EqualizerModule;
   class StereoMemory;
 
   class ReorderableEffectChain : public SynthModule {
     public:
+      static constexpr mono_float kMinTailTime = 0.5f;
+
       enum {
         kAudio,
         kOrder,
@@ -43,16 +47,22 @@ namespace vital {
 
       SynthModule* getEffect(constants::Effect effect) { return effects_[effect]; }
       const StereoMemory* getEqualizerMemory() { return equalizer_memory_; }
+      ConvolutionModule* getConvolution() { return convolution_; }
+      void setTelemetryEnabled(bool enabled);
 
     protected:
       SynthModule* createEffectModule(int index);
+      void clearStatusOutputs(SynthModule* effect);
 
+      EqualizerModule* equalizer_;
       const StereoMemory* equalizer_memory_;
+      ConvolutionModule* convolution_;
       const Output* beats_per_second_;
       const Output* keytrack_;
       SynthModule* effects_[constants::kNumEffects];
       Value* effects_on_[constants::kNumEffects];
       int effect_order_[constants::kNumEffects];
+      int silent_input_samples_[constants::kNumEffects];
       float last_order_;
 
       JUCE_LEAK_DETECTOR(ReorderableEffectChain)
@@ -42,6 +42,7 @@ namespace vital {
     Output* reverb_size = createMonoModControl("reverb_size");
     Output* reverb_delay = createMonoModControl("reverb_delay");
     Output* reverb_wet = createMonoModControl("reverb_dry_wet");
+    Value* reverb_quality = createBaseControl("reverb_quality");
 
     reverb_->plug(reverb_decay_time, Reverb::kDecayTime);
     reverb_->plug(reverb_pre_low_cutoff, Reverb::kPreLowCutoff);
@@ -55,6 +56,7 @@ namespace vital {
     reverb_->plug(reverb_delay, Reverb::kDelay);
     reverb_->plug(reverb_size, Reverb::kSize);
     reverb_->plug(reverb_wet, Reverb::kWet);
+    reverb_->plug(reverb_quality, Reverb::kQuality);
 
     SynthModule::init();
   }
@@ -75,6 +77,10 @@ namespace vital {
     reverb_->setSampleRate(sample_rate);
   }
 
+  int ReverbModule::getTailSamples() {
+    return reverb_->getTailSamples();
+  }
+
   void ReverbModule::processWithInput(const poly_float* audio_in, int num_samples) {
     SynthModule::process(num_samples);
     reverb_->processWithInput(audio_in, num_samples);
@@ -33,6 +33,7 @@ namespace vital {
       void enable(bool enable) override;
 
       void setSampleRate(int sample_rate) override;
+      int getTailSamples() override;
       void processWithInput(const poly_float* audio_in, int num_samples) override;
       Processor* clone() const override { return new ReverbModule(*this); }
 
@@ -38,7 +38,8 @@ namespace vital {
       pitch_wheel_(nullptr), filters_module_(nullptr), lfos_(), envelopes_(), lfo_sources_(), random_(nullptr),
       random_lfos_(), note_mapping_(nullptr), velocity_mapping_(nullptr), aftertouch_mapping_(nullptr),
       slide_mapping_(nullptr), lift_mapping_(nullptr), mod_wheel_mapping_(nullptr),
-      pitch_wheel_mapping_(nullptr), stereo_(nullptr), note_percentage_(nullptr), last_active_voice_mask_(0) {
+      pitch_wheel_mapping_(nullptr), stereo_(nullptr), note_percentage_(nullptr), last_active_voice_mask_(0),
+      telemetry_enabled_(true) {
     output_ = new Multiply();
     registerOutput(output_->output());
 
@@ -151,6 +152,9 @@ namespace vital {
   }
 
   void SynthVoiceHandler::createModulators() {
+    Value* sub_rate = createBaseControl("modulator_sub_rate");
+    Value* sub_rate_interpolation = createBaseControl("modulator_sub_rate_interpolation");
+
     for (int i = 0; i < kNumLfos; ++i) {
       lfo_sources_[i].setLoop(false);
       lfo_sources_[i].initTriangle();
@@ -162,6 +166,8 @@ namespace vital {
       lfo->plug(retrigger(), LfoModule::kNoteTrigger);
       lfo->plug(note_count(), LfoModule::kNoteCount);
       lfo->plug(bent_midi_, LfoModule::kMidi);
+      lfo->plug(sub_rate, LfoModule::kSubRate);
+      lfo->plug(sub_rate_interpolation, LfoModule::kSubRateInterpolation);
 
       data_->mod_sources[prefix] = lfo->output(LfoModule::kValue);
       createStatusOutput(prefix, lfo->output(LfoModule::kValue));
@@ -173,6 +179,8 @@ namespace vital {
       std::string prefix = std::string("env_") + std::to_string(i + 1);
       EnvelopeModule* envelope = new EnvelopeModule(prefix, i == 0);
       envelope->plug(retrigger(), EnvelopeModule::kTrigger);
+      envelope->plug(sub_rate, EnvelopeModule::kSubRate);
+      envelope->plug(sub_rate_interpolation, EnvelopeModule::kSubRateInterpolation);
       addSubmodule(envelope);
       addProcessor(envelope);
       envelopes_[i] = envelope;
@@ -309,19 +317,24 @@ namespace vital {
     if (reset_mask.anyMask())
       resetFeedbacks(reset_mask);
 
+    for (int i = 0; i < kNumLfos; ++i) {
+      if (lfos_[i]->enabled())
+        lfos_[i]->updateSharedEvaluation();
+    }
+
     VoiceHandler::process(num_samples);
     int num_voices = getNumActiveVoices();
     num_voices_.buffer[0] = num_voices;
     note_retriggered_.clearTrigger();
 
     if (num_voices == 0) {
-      for (auto& status_source : data_->status_outputs)
-        status_source.second->clear();
+      if (telemetry_enabled_)
+        clearStatusOutputs();
     }
     else {
       last_active_voice_mask_ = getCurrentVoiceMask();
-      for (auto& status_source : data_->status_outputs)
-        status_source.second->update(last_active_voice_mask_);
+      if (telemetry_enabled_)
+        updateStatusOutputs(last_active_voice_mask_);
 
       for (ModulationConnectionProcessor* processor : enabled_modulation_processors_) {
         poly_float* buffer = processor->output()->buffer;
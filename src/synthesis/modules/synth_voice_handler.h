@@ -63,6 +63,7 @@ namespace vital {
       Output* note_retrigger() { return &note_retriggered_; }
 
       Output* midi_offset_output() { return midi_offset_output_; }
+      void setTelemetryEnabled(bool enabled) { telemetry_enabled_ = enabled; }
 
       void enableModulationConnection(ModulationConnectionProcessor* processor);
       void disableModulationConnection(ModulationConnectionProcessor* processor);
@@ -121,6 +122,7 @@ namespace vital {
 
       output_map poly_readouts_;
       poly_mask last_active_voice_mask_;
+      bool telemetry_enabled_;
 
       JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(SynthVoiceHandler)
   };
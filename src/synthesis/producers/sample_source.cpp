@@ -267,30 +267,47 @@ namespace vital {
     init();
   }
 
-  void Sample::loadSample(const mono_float* buffer, int size, int sample_rate) {
+  std::shared_ptr<Sample::SampleData> Sample::createData(const mono_float* left_buffer,
+                                                        const mono_float* right_buffer, int size, int sample_rate) {
     static constexpr int kMaxSize = 1764000;
 
+    if (right_buffer == nullptr)
+      size = std::min(size, kMaxSize);
+
+    std::shared_ptr<SampleData> data = std::make_shared<SampleData>(size, sample_rate, right_buffer != nullptr);
+    createBandLimitedBuffers(data->left_buffers, data->left_loop_buffers, left_buffer, size);
+    if (right_buffer)
+      createBandLimitedBuffers(data->right_buffers, data->right_loop_buffers, right_buffer, size);
+    return data;
+  }
+
+  void Sample::loadSample(const mono_float* buffer, int size, int sample_rate) {
+    setData(createData(buffer, nullptr, size, sample_rate));
+  }
+
+  void Sample::loadSample(const mono_float* left_buffer, const mono_float* right_buffer, int size, int sample_rate) {
+    setData(createData(left_buffer, right_buffer, size, sample_rate));
+  }
+
+  void Sample::setData(std::shared_ptr<SampleData> data) {
     VITAL_ASSERT(active_audio_data_.is_lock_free());
 
-    size = std::min(size, kMaxSize);
-    std::unique_ptr<SampleData> old_data = std::move(data_);
-    data_ = std::make_unique<SampleData>(size, sample_rate, false);
-    createBandLimitedBuffers(data_->left_buffers, data_->left_loop_buffers, buffer, size);
+    std::shared_ptr<SampleData> old_data = std::move(data_);
+    data_ = std::move(data);
 
     current_data_ = data_.get();
     while (active_audio_data_.load())
       std::this_thread::yield(); // Wait for audio thread to finish using old_data.
   }
 
-  void Sample::loadSample(const mono_float* left_buffer, const mono_float* right_buffer, int size, int sample_rate) {
-    std::unique_ptr<SampleData> old_data = std::move(data_);
-    data_ = std::make_unique<SampleData>(size, sample_rate, true);
-    createBandLimitedBuffers(data_->left_buffers, data_->left_loop_buffers, left_buffer, size);
-    createBandLimitedBuffers(data_->right_buffers, data_->right_loop_buffers, right_buffer, size);
+  void Sample::swapData(Sample* other) {
+    name_.swap(other->name_);
+    data_.swap(other->data_);
 
+    other->current_data_ = other->data_.get();
     current_data_ = data_.get();
     while (active_audio_data_.load())
-      std::this_thread::yield(); // Wait for audio thread to finish using old_data.
+      std::this_thread::yield(); // Wait for audio thread to finish using the old data.
   }
 
   void Sample::init() {
@@ -329,23 +346,18 @@ namespace vital {
     int length = data["length"];
     int sample_rate = data["sample_rate"];
 
+    // Decodes straight into preallocated pcm blocks without copying the encoded strings.
     MemoryOutputStream decoded(length * sizeof(int16_t));
-    std::string wave_data = data["samples"];
-    Base64::convertFromBase64(decoded, wave_data);
-    std::unique_ptr<int16_t[]> pcm_data = std::make_unique<int16_t[]>(length);
-    memcpy(pcm_data.get(), decoded.getData(), length * sizeof(int16_t));
+    Base64::convertFromBase64(decoded, data["samples"].get_ref<const std::string&>());
     std::unique_ptr<mono_float[]> buffer = std::make_unique<mono_float[]>(length);
-    utils::pcmToFloatData(buffer.get(), pcm_data.get(), length);
+    utils::pcmToFloatData(buffer.get(), (const int16_t*)decoded.getData(), length);
 
     if (data.count("samples_stereo")) {
       MemoryOutputStream decoded_stereo(length * sizeof(int16_t));
-      std::string wave_data_stereo = data["samples_stereo"];
-      Base64::convertFromBase64(decoded_stereo, wave_data_stereo);
-      std::unique_ptr<int16_t[]> pcm_data_stereo = std::make_unique<int16_t[]>(length);
-      memcpy(pcm_data_stereo.get(), decoded_stereo.getData(), length * sizeof(int16_t));
+      Base64::convertFromBase64(decoded_stereo, data["samples_stereo"].get_ref<const std::string&>());
 
       std::unique_ptr<mono_float[]> buffer_stereo = std::make_unique<mono_float[]>(length);
-      utils::pcmToFloatData(buffer_stereo.get(), pcm_data_stereo.get(), length);
+      utils::pcmToFloatData(buffer_stereo.get(), (const int16_t*)decoded_stereo.getData(), length);
       loadSample(buffer.get(), buffer_stereo.get(), length, sample_rate);
     }
     else
@@ -47,8 +47,15 @@ namespace vital {
     
       Sample();
 
+      // Builds the band limited buffers without touching any sample, so it can run off the message thread.
+      // Pass nullptr for right_buffer to build mono data.
+      static std::shared_ptr<SampleData> createData(const mono_float* left_buffer, const mono_float* right_buffer,
+                                                    int size, int sample_rate);
+
       void loadSample(const mono_float* buffer, int size, int sample_rate);
       void loadSample(const mono_float* left_buffer, const mono_float* right_buffer, int size, int sample_rate);
+      void setData(std::shared_ptr<SampleData> data);
+      void swapData(Sample* other);
       void setName(const std::string& name) { name_ = name; }
       std::string getName() const { return name_; }
       void setLastBrowsedFile(const std::string& path) { last_browsed_file_ = path; }
@@ -108,7 +115,7 @@ namespace vital {
       std::string last_browsed_file_;
       SampleData* current_data_;
       std::atomic<SampleData*> active_audio_data_;
-      std::unique_ptr<SampleData> data_;
+      std::shared_ptr<SampleData> data_;
 
       JUCE_LEAK_DETECTOR(Sample)
   };
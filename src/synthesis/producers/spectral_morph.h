@@ -304,6 +304,52 @@ namespace vital {
     transformAndWrapBuffer(transform, dest);
   }
 
+  // Crossfades the two mip levels around the cutoff. Returns false if the cutoff is below the lowest level.
+  static force_inline bool loadMipLowPass(const Wavetable::WavetableData* wavetable_data, int wavetable_index,
+                                          poly_float* dest, float cutoff, int max_level) {
+    if (max_level < 0 || cutoff < Wavetable::kMinMipHarmonics)
+      return false;
+
+    const poly_float (*levels)[Wavetable::kMipPolySize] = wavetable_data->mip_levels[wavetable_index];
+    int level = 0;
+    while (level < max_level && Wavetable::getMipHarmonics(level + 1) <= cutoff)
+      level++;
+
+    if (level == max_level) {
+      memcpy(dest, levels[max_level], Wavetable::kMipPolySize * sizeof(poly_float));
+      return true;
+    }
+
+    float low_harmonics = Wavetable::getMipHarmonics(level);
+    float high_harmonics = Wavetable::getMipHarmonics(level + 1);
+    mono_float t = utils::clamp((cutoff - low_harmonics) / (high_harmonics - low_harmonics), 0.0f, 1.0f);
+    for (int i = 0; i < Wavetable::kMipPolySize; ++i)
+      dest[i] = utils::interpolate(levels[level][i], levels[level + 1][i], t);
+    return true;
+  }
+
+  static void lowPassMipMorph(const Wavetable::WavetableData* wavetable_data, int wavetable_index,
+                              poly_float* dest, FourierTransform* transform, float cutoff_t, int last_harmonic) {
+    float cutoff = futils::pow(2.0f, (Wavetable::kFrequencyBins - 1) * cutoff_t) + 1.0f;
+    if (!loadMipLowPass(wavetable_data, wavetable_index, dest, cutoff, Wavetable::getMipLevel(last_harmonic)))
+      lowPassMorph(wavetable_data, wavetable_index, dest, transform, cutoff_t, last_harmonic, nullptr);
+  }
+
+  static void highPassMipMorph(const Wavetable::WavetableData* wavetable_data, int wavetable_index,
+                               poly_float* dest, FourierTransform* transform, float cutoff_t, int last_harmonic) {
+    float cutoff = futils::pow(2.0f, (Wavetable::kFrequencyBins - 1) * cutoff_t);
+    cutoff *= (kNumHarmonics + 1.0f) / kNumHarmonics;
+    int max_level = Wavetable::getMipLevel(last_harmonic);
+    if (!loadMipLowPass(wavetable_data, wavetable_index, dest, cutoff, max_level)) {
+      highPassMorph(wavetable_data, wavetable_index, dest, transform, cutoff_t, last_harmonic, nullptr);
+      return;
+    }
+
+    const poly_float* top = wavetable_data->mip_levels[wavetable_index][max_level];
+    for (int i = 0; i < Wavetable::kMipPolySize; ++i)
+      dest[i] = top[i] - dest[i];
+  }
+
   static void evenOddVocodeMorph(const Wavetable::WavetableData* wavetable_data,
                                  int wavetable_index, poly_float* dest, FourierTransform* transform,
                                  float shift, int last_harmonic, const poly_float* data_buffer) {
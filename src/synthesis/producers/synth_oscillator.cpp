@@ -45,6 +45,9 @@ namespace vital {
     constexpr mono_float kCenterLowAmplitude = 0.4f;
     constexpr mono_float kDetunedHighAmplitude = 0.6f;
     constexpr mono_float kWavetableFadeTime = 0.007f;
+    constexpr int kMaxFusedVoiceBlocks = 4;
+    constexpr mono_float kMaxCulledDetunedAmplitude = 0.00001f;
+    constexpr mono_float kMaxCoherentDetuneRatio = 0.000001f;
 
     constexpr int kMaxSyncPower = 4;
     constexpr int kMaxSync = 1 << kMaxSyncPower;
@@ -57,6 +60,11 @@ namespace vital {
     const poly_float kFmPhaseMult = kPhaseMult / 8.0f;
     const poly_int kMaxFmModulation = 48;
 
+    force_inline poly_mask closeRatios(poly_float one, poly_float two) {
+      poly_float tolerance = poly_float::abs(one) * kMaxCoherentDetuneRatio;
+      return ~poly_float::greaterThan(poly_float::abs(one - two), tolerance);
+    }
+
     force_inline poly_int passThroughPhase(poly_int phase, poly_float, poly_int, const poly_float*, int) {
       return phase;
     }
@@ -206,15 +214,6 @@ namespace vital {
       return utils::toFloat(indices & kIntermediateMask) * (1.0f / kIntermediateMult);
     }
 
-    force_inline poly_float linearlyInterpolateBuffer(const mono_float* buffer, const poly_int indices) {
-      poly_int start_indices = utils::shiftRight<kIntermediateBits>(indices);
-      poly_float t = getInterpolationValues(indices);
-      matrix interpolation_matrix = utils::getLinearInterpolationMatrix(t);
-      matrix value_matrix = utils::getValueMatrix(buffer, start_indices);
-      value_matrix.transpose();
-      return interpolation_matrix.multiplyAndSumRows(value_matrix);
-    }
-
     force_inline poly_float interpolateBuffers(const mono_float* const* buffers, const poly_int indices) {
       poly_int start_indices = utils::shiftRight<kIntermediateBits>(indices);
       poly_float t = getInterpolationValues(indices);
@@ -285,6 +284,26 @@ namespace vital {
       return phase;
     }
 
+    poly_int advanceDetunedPhase(const SynthOscillator::VoiceBlock& voice_block) {
+      int start = voice_block.start_sample;
+      mono_float sample_inc = (1.0f / voice_block.total_samples);
+
+      poly_int phase = voice_block.phase;
+      poly_float current_phase_inc_mult = voice_block.from_phase_inc_mult;
+      poly_float end_phase_inc_mult = voice_block.phase_inc_mult;
+      poly_float delta_phase_inc_mult = (end_phase_inc_mult - current_phase_inc_mult) * sample_inc;
+      current_phase_inc_mult += delta_phase_inc_mult * start;
+
+      const poly_float* phase_inc_buffer = voice_block.phase_inc_buffer + start;
+      int num_samples = voice_block.end_sample - start;
+      for (int i = 0; i < num_samples; ++i) {
+        current_phase_inc_mult += delta_phase_inc_mult;
+        phase += utils::toInt(phase_inc_buffer[i] * current_phase_inc_mult);
+      }
+
+      return phase;
+    }
+
     template<poly_int(*phaseDistort)(poly_int, poly_float, poly_int, const poly_float*, int),
              poly_float(*window)(poly_int, poly_int, poly_float, const poly_float*, int),
              poly_float(*interpolate)(const mono_float* const*, const mono_float* const*,
@@ -463,6 +482,79 @@ namespace vital {
           current_detuned_amplitude, delta_detuned_amplitude);
     }
 
+    template<int kNumBlocks,
+             poly_int(*phaseDistort)(poly_int, poly_float, poly_int, const poly_float*, int),
+             poly_float(*window)(poly_int, poly_int, poly_float, const poly_float*, int),
+             poly_float(*interpolate)(const mono_float* const*, const mono_float* const*,
+                                      const poly_int, poly_float)>
+    void processVoiceBlocks(const SynthOscillator::VoiceBlock* voice_blocks, poly_float* audio_out, poly_int* phases,
+                            poly_float current_center_amplitude, poly_float delta_center_amplitude,
+                            poly_float current_detuned_amplitude, poly_float delta_detuned_amplitude) {
+      const SynthOscillator::VoiceBlock& center_block = voice_blocks[0];
+      int start = center_block.start_sample;
+
+      poly_float t_inc = 1.0f / center_block.num_buffer_samples;
+      poly_float t = utils::toFloat(center_block.current_buffer_sample + 1) * t_inc;
+      mono_float sample_inc = (1.0f / center_block.total_samples);
+
+      poly_int current_dist_phase = center_block.last_distortion_phase;
+      poly_int end_dist_phase = center_block.distortion_phase;
+      poly_int delta_dist_phase = utils::toInt(utils::toFloat(end_dist_phase - current_dist_phase) * sample_inc);
+      current_dist_phase += delta_dist_phase * start;
+
+      poly_int phase[kNumBlocks];
+      poly_float current_phase_inc_mult[kNumBlocks];
+      poly_float delta_phase_inc_mult[kNumBlocks];
+      poly_float current_distortion[kNumBlocks];
+      poly_float distortion_inc[kNumBlocks];
+      for (int b = 0; b < kNumBlocks; ++b) {
+        const SynthOscillator::VoiceBlock& voice_block = voice_blocks[b];
+        phase[b] = voice_block.phase;
+        current_phase_inc_mult[b] = voice_block.from_phase_inc_mult;
+        delta_phase_inc_mult[b] = (voice_block.phase_inc_mult - current_phase_inc_mult[b]) * sample_inc;
+        current_phase_inc_mult[b] += delta_phase_inc_mult[b] * start;
+
+        current_distortion[b] = voice_block.last_distortion;
+        distortion_inc[b] = (voice_block.distortion - current_distortion[b]) * sample_inc;
+        current_distortion[b] += distortion_inc[b] * start;
+      }
+
+      const poly_float* modulation_buffer = center_block.modulation_buffer + start;
+      const poly_float* phase_inc_buffer = center_block.phase_inc_buffer + start;
+      const poly_int* phase_buffer = center_block.phase_buffer + start;
+      int num_samples = center_block.end_sample - start;
+      for (int i = 0; i < num_samples; ++i) {
+        current_dist_phase += delta_dist_phase;
+
+        poly_float reads[kNumBlocks];
+        for (int b = 0; b < kNumBlocks; ++b) {
+          current_phase_inc_mult[b] += delta_phase_inc_mult[b];
+          phase[b] += utils::toInt(phase_inc_buffer[i] * current_phase_inc_mult[b]);
+          poly_int adjusted_phase = phase[b] + phase_buffer[i];
+          current_distortion[b] += distortion_inc[b];
+          poly_int distorted_phase = phaseDistort(adjusted_phase, current_distortion[b],
+                                                  current_dist_phase, modulation_buffer, i);
+          poly_float mult = window(adjusted_phase, distorted_phase, current_distortion[b], modulation_buffer, i);
+          reads[b] = mult * interpolate(voice_blocks[b].from_buffers, voice_blocks[b].to_buffers,
+                                        distorted_phase + current_dist_phase, t);
+        }
+
+        poly_float detuned_value = 0.0f;
+        for (int b = 1; b < kNumBlocks; ++b)
+          detuned_value += reads[b];
+
+        current_center_amplitude += delta_center_amplitude;
+        current_detuned_amplitude += delta_detuned_amplitude;
+        audio_out[i] = current_center_amplitude * reads[0] + current_detuned_amplitude * detuned_value;
+        VITAL_ASSERT(utils::isFinite(audio_out[i]));
+
+        t += t_inc;
+      }
+
+      for (int b = 0; b < kNumBlocks; ++b)
+        phases[b] = phase[b];
+    }
+
     template<class T>
     force_inline T compactAndLoadVoice(T* values, poly_mask active_mask) {
       T one = values[0];
@@ -515,6 +607,70 @@ namespace vital {
     { 1.0f, 3.0f, 5.0f, 7.0f, 9.0f, 11.0f, 13.0f, 15.0f }
   };
 
+  class SpectralFrameCache {
+    public:
+      static constexpr int kNumFrames = 32;
+
+      struct Key {
+        bool operator==(const Key& other) const {
+          return wavetable_data == other.wavetable_data && version == other.version && revision == other.revision &&
+                 spectral_morph == other.spectral_morph && table_index == other.table_index &&
+                 shift == other.shift && last_harmonic == other.last_harmonic;
+        }
+
+        const Wavetable::WavetableData* wavetable_data;
+        int version;
+        int revision;
+        SynthOscillator::SpectralMorph spectral_morph;
+        int table_index;
+        float shift;
+        int last_harmonic;
+      };
+
+      SpectralFrameCache() : next_frame_(0), hits_(0), misses_(0) {
+        for (Key& key : keys_)
+          key.wavetable_data = nullptr;
+      }
+
+      const poly_float* find(const Key& key) {
+        for (int i = 0; i < kNumFrames; ++i) {
+          if (keys_[i] == key) {
+            hits_++;
+            return frames_.get() + i * SynthOscillator::kSpectralBufferSize;
+          }
+        }
+        misses_++;
+        return nullptr;
+      }
+
+      void store(const Key& key, const poly_float* frame) {
+        // Frames are allocated on the first store so oscillators without spectral morphs never hold them.
+        if (frames_ == nullptr)
+          frames_ = std::make_unique<poly_float[]>(kNumFrames * SynthOscillator::kSpectralBufferSize);
+
+        keys_[next_frame_] = key;
+        poly_float* destination = frames_.get() + next_frame_ * SynthOscillator::kSpectralBufferSize;
+        memcpy(destination, frame, SynthOscillator::kSpectralBufferSize * sizeof(poly_float));
+        next_frame_ = (next_frame_ + 1) % kNumFrames;
+      }
+
+      bool allocated() const { return frames_ != nullptr; }
+
+      float hitRate() const {
+        uint64_t lookups = hits_ + misses_;
+        return lookups ? hits_ / (1.0 * lookups) : 0.0f;
+      }
+
+    private:
+      Key keys_[kNumFrames];
+      std::unique_ptr<poly_float[]> frames_;
+      int next_frame_;
+      uint64_t hits_;
+      uint64_t misses_;
+
+      JUCE_LEAK_DETECTOR(SpectralFrameCache)
+  };
+
   SynthOscillator::VoiceBlock::VoiceBlock() : start_sample(0), end_sample(0), total_samples(0),
                                               phase(0), phase_inc_mult(0.0f), from_phase_inc_mult(0.0f),
                                               shepard_double_mask(0), shepard_half_mask(0),
@@ -533,7 +689,9 @@ namespace vital {
   SynthOscillator::SynthOscillator(Wavetable* wavetable) :
       Processor(kNumInputs, kNumOutputs), random_generator_(-1.0f, 1.0f),
       transpose_quantize_(0), last_quantized_transpose_(0.0f), last_quantize_ratio_(1.0f),
-      unison_(1), active_oscillators_(2), wavetable_(wavetable), wavetable_version_(wavetable->getVersion()),
+      unison_(1), active_oscillators_(2), rendered_oscillators_(2), fused_processing_(true),
+      spectral_frame_caching_(true),
+      wavetable_(wavetable), wavetable_version_(wavetable->getVersion()),
       first_mod_oscillator_(nullptr), second_mod_oscillator_(nullptr), sample_(nullptr),
       fourier_frames1_(), fourier_frames2_() {
     pan_amplitude_ = 0.0f;
@@ -561,6 +719,7 @@ namespace vital {
     resetWavetableBuffers();
 
     fourier_transform_ = std::make_shared<FourierTransform>(kWaveformBits);
+    spectral_frame_cache_ = std::make_shared<SpectralFrameCache>();
     phase_inc_buffer_ = std::make_shared<Output>();
     phase_buffer_ = std::make_shared<PhaseBuffer>();
     voice_block_.phase_inc_buffer = phase_inc_buffer_->buffer;
@@ -568,6 +727,14 @@ namespace vital {
     RandomValues::instance();
   }
 
+  bool SynthOscillator::hasSpectralFrameCache() const {
+    return spectral_frame_cache_->allocated();
+  }
+
+  float SynthOscillator::getSpectralFrameCacheHitRate() const {
+    return spectral_frame_cache_->hitRate();
+  }
+
   void SynthOscillator::reset(poly_mask reset_mask, poly_int sample) {
     reset(reset_mask);
     voice_block_.current_buffer_sample = utils::maskLoad(voice_block_.current_buffer_sample, -sample, reset_mask);
@@ -790,9 +957,34 @@ namespace vital {
       int last_harmonic = std::max<int>(0, WaveFrame::kWaveformSize * futils::exp2(-bin_shift));
       last_harmonic = std::min(last_harmonic, WaveFrame::kWaveformSize / 2);
 
-      spectralMorph(wavetable_data, table_index, fourier_buffer,
-                    fourier_transform_.get(), shift, last_harmonic, RandomValues::instance()->buffer());
-      wave_buffers_[buffer_index] = ((mono_float*)fourier_buffer) + poly_float::kSize - 1;
+      // Morphs that only truncate harmonics read the precomputed mip levels instead of running a transform.
+      int mip_level = Wavetable::getMipLevel(last_harmonic);
+      if (spectralMorph == passthroughMorph && mip_level >= 0)
+        wave_buffers_[buffer_index] = Wavetable::getMipBuffer(wavetable_data, table_index, mip_level);
+      else {
+        SpectralFrameCache::Key key = { wavetable_data, wavetable_data->version, wavetable_data->revision,
+                                        voice_block_.spectral_morph, table_index, shift, last_harmonic };
+        const poly_float* cached_frame = spectral_frame_caching_ ? spectral_frame_cache_->find(key) : nullptr;
+        if (cached_frame)
+          memcpy(fourier_buffer, cached_frame, kSpectralBufferSize * sizeof(poly_float));
+        else {
+          if (spectralMorph == lowPassMorph) {
+            lowPassMipMorph(wavetable_data, table_index, fourier_buffer,
+                            fourier_transform_.get(), shift, last_harmonic);
+          }
+          else if (spectralMorph == highPassMorph) {
+            highPassMipMorph(wavetable_data, table_index, fourier_buffer,
+                             fourier_transform_.get(), shift, last_harmonic);
+          }
+          else {
+            spectralMorph(wavetable_data, table_index, fourier_buffer,
+                          fourier_transform_.get(), shift, last_harmonic, RandomValues::instance()->buffer());
+          }
+          if (spectral_frame_caching_)
+            spectral_frame_cache_->store(key, fourier_buffer);
+        }
+        wave_buffers_[buffer_index] = ((mono_float*)fourier_buffer) + poly_float::kSize - 1;
+      }
 
       if (i == index && morph_amount[i] == morph_amount[i + 1] && wave_index[i] == wave_index[i + 1]) {
         last_buffers_[buffer_index + 1] = wave_buffers_[buffer_index + 1];
@@ -863,52 +1055,6 @@ namespace vital {
     }
   }
 
-  void SynthOscillator::stereoBlend(poly_float* audio_out, int num_samples, poly_mask reset_mask) {
-    poly_float stereo_spread = utils::clamp(input(kStereoSpread)->at(0), 0.0f, 1.0f);
-
-    poly_float current_stereo_mult = blend_stereo_multiply_;
-    poly_float current_center_mult = blend_center_multiply_;
-    blend_stereo_multiply_ = futils::equalPowerFade(stereo_spread * 0.5f + 0.5f);
-    blend_center_multiply_ = futils::equalPowerFadeInverse(stereo_spread * 0.5f + 0.5f);
-
-    current_stereo_mult = utils::maskLoad(current_stereo_mult, blend_stereo_multiply_, reset_mask);
-    current_center_mult = utils::maskLoad(current_center_mult, blend_center_multiply_, reset_mask);
-    poly_float delta_stereo_mult = (blend_stereo_multiply_ - current_stereo_mult) * (1.0f / num_samples);
-    poly_float delta_center_mult = (blend_center_multiply_ - current_center_mult) * (1.0f / num_samples);
-
-    if (delta_stereo_mult.sum() + delta_center_mult.sum() == 0.0f && utils::equal(stereo_spread, 1.0f))
-      return;
-
-    for (int i = 0; i < num_samples; ++i) {
-      current_stereo_mult += delta_stereo_mult;
-      current_center_mult += delta_center_mult;
-      poly_float val = audio_out[i];
-      poly_float swap = utils::swapStereo(val);
-      audio_out[i] = val * current_stereo_mult + swap * current_center_mult;
-    }
-  }
-
-  void SynthOscillator::levelOutput(poly_float* audio_out, const poly_float* raw_out,
-                                    int num_samples, poly_mask reset_mask) {
-    VITAL_ASSERT(inputMatchesBufferSize(kAmplitude));
-
-    poly_float current_pan_amplitude = pan_amplitude_;
-    pan_amplitude_ = futils::panAmplitude(utils::clamp(input(kPan)->at(0), -1.0f, 1.0f));
-
-    current_pan_amplitude = utils::maskLoad(current_pan_amplitude, pan_amplitude_, reset_mask);
-    poly_float delta_pan_amplitude = (pan_amplitude_ - current_pan_amplitude) * (1.0f / num_samples);
-
-    const poly_float* amplitude = input(kAmplitude)->source->buffer;
-    poly_float zero = 0.0f;
-    for (int i = 0; i < num_samples; ++i) {
-      poly_float amp = utils::max(amplitude[i], zero);
-      current_pan_amplitude += delta_pan_amplitude;
-      audio_out[i] = current_pan_amplitude * raw_out[i] * amp * amp;
-
-      VITAL_ASSERT(utils::isFinite(audio_out[i]));
-    }
-  }
-
   void SynthOscillator::convertVoiceChannels(int num_samples, poly_float* audio_out, poly_mask active_mask) {
     for (int i = 0; i < num_samples; ++i)
       audio_out[i] += utils::swapVoices(audio_out[i]);
@@ -942,7 +1088,7 @@ namespace vital {
       compactAndLoadVoice(voice_block.from_buffers, last_buffers_ + buffer_index, active_mask);
       compactAndLoadVoice(voice_block.to_buffers, wave_buffers_ + buffer_index, active_mask);
 
-      if ((index + 1) * poly_float::kSize > active_oscillators_) {
+      if ((index + 1) * poly_float::kSize > rendered_oscillators_) {
         int zero_index = active_mask[0] ? 2 : 0;
         voice_block.from_buffers[zero_index] = Wavetable::null_waveform();
         voice_block.from_buffers[zero_index + 1] = Wavetable::null_waveform();
@@ -1191,8 +1337,10 @@ namespace vital {
     }
   }
 
-  poly_float SynthOscillator::interpolate(const mono_float* buffer, const poly_int indices) {
-    return linearlyInterpolateBuffer(buffer, indices);
+  void SynthOscillator::interpolate(mono_float* dest, const mono_float* buffer,
+                                    const poly_int* phases, int num_phases) {
+    kernels::get().interpolate(dest, buffer + 1, (const uint32_t*)phases, kIntermediateBits,
+                               num_phases * poly_float::kSize);
   }
 
   bool SynthOscillator::usesDistortionPhase(DistortionType distortion_type) {
@@ -1292,6 +1440,34 @@ namespace vital {
     active_oscillators_ = new_active_oscillators;
   }
 
+  bool SynthOscillator::isUnisonCoherent(poly_mask active_mask) {
+    if (voice_block_.spectral_morph == kShepardTone)
+      return false;
+
+    DistortionType distortion_type = static_cast<DistortionType>((int)input(kDistortionType)->at(0)[0]);
+    int num_phase_updates = active_oscillators_ / 2;
+    for (int p = 1; p < num_phase_updates; ++p) {
+      poly_mask equal = poly_int::equal(phases_[p], phases_[0]);
+      equal &= closeRatios(phase_inc_mults_[p], phase_inc_mults_[0]);
+      equal &= closeRatios(from_phase_inc_mults_[p], from_phase_inc_mults_[0]);
+      if (distortion_type != kNone) {
+        equal &= poly_float::equal(distortion_values_[p], distortion_values_[0]);
+        equal &= poly_float::equal(last_distortion_values_[p], last_distortion_values_[0]);
+      }
+      if ((active_mask & ~equal).anyMask())
+        return false;
+
+      for (int i = 0; i < poly_float::kSize; ++i) {
+        int buffer_index = p * poly_float::kSize + i;
+        if (active_mask[i] && (wave_buffers_[buffer_index] != wave_buffers_[i] ||
+                               last_buffers_[buffer_index] != last_buffers_[i])) {
+          return false;
+        }
+      }
+    }
+    return true;
+  }
+
   template<poly_float(*snapTranspose)(poly_float, poly_float, float*)>
   void SynthOscillator::setPhaseIncBufferSnap(int num_samples, poly_mask reset_mask,
                                               poly_int trigger_sample, poly_mask active_mask, float* snap_buffer) {
@@ -1450,11 +1626,26 @@ namespace vital {
     int num_samples = voice_block_.end_sample - voice_block_.start_sample;
 
     poly_float* audio_out = output(kRaw)->buffer + voice_block_.start_sample;
-    utils::zeroBuffer(audio_out, num_samples);
-
     poly_float center_amplitude = center_amplitude_;
     poly_float detuned_amplitude = detuned_amplitude_;
 
+    // Detuned pairs that can't be heard only advance their phase and pairs identical to the center pair are folded
+    // into it.
+    int collapsed_pairs = 0;
+    rendered_oscillators_ = active_oscillators_;
+    if (active_oscillators_ > 2 && input(kUnisonCulling)->at(0)[0]) {
+      poly_float max_detuned = utils::max(poly_float::abs(current_detuned_amplitude),
+                                          poly_float::abs(detuned_amplitude));
+      if (!poly_float::greaterThanOrEqual(max_detuned, kMaxCulledDetunedAmplitude).anyMask())
+        rendered_oscillators_ = 2;
+      else if (isUnisonCoherent(active_voice_mask)) {
+        collapsed_pairs = active_oscillators_ / 2 - 1;
+        rendered_oscillators_ = 2;
+        current_center_amplitude += current_detuned_amplitude * collapsed_pairs;
+        center_amplitude += detuned_amplitude * collapsed_pairs;
+      }
+    }
+
     if (num_active_voices < 2) {
       poly_float current_detuned_swap = utils::swapVoices(current_detuned_amplitude);
       current_detuned_amplitude = utils::maskLoad(current_detuned_swap, current_detuned_amplitude, active_voice_mask);
@@ -1476,39 +1667,156 @@ namespace vital {
                                                            active_voice_mask);
     }
 
-    int num_phase_updates = (poly_float::kSize - 1 + num_active_voices * active_oscillators_) / poly_float::kSize;
-    for (int p = 1; p < num_phase_updates; ++p) {
-      loadVoiceBlock(voice_block_, p, active_voice_mask);
+    mono_float sample_inc = 1.0f / voice_block_.total_samples;
+    poly_float delta_center_amplitude = (center_amplitude - current_center_amplitude) * sample_inc;
+    poly_float delta_detuned_amplitude = (detuned_amplitude - current_detuned_amplitude) * sample_inc;
+    current_center_amplitude += delta_center_amplitude * voice_block_.start_sample;
+    current_detuned_amplitude += delta_detuned_amplitude * voice_block_.start_sample;
+
+    int num_phase_updates = (poly_float::kSize - 1 + num_active_voices * rendered_oscillators_) / poly_float::kSize;
+    if (collapsed_pairs == 0) {
+      int num_voice_blocks = (poly_float::kSize - 1 + num_active_voices * active_oscillators_) / poly_float::kSize;
+      for (int p = num_phase_updates; p < num_voice_blocks; ++p) {
+        loadVoiceBlock(voice_block_, p, active_voice_mask);
 
-      poly_int phase = processDetuned<phaseDistort, window>(voice_block_, audio_out);
-      if (num_active_voices < 2)
-        expandAndWriteVoice(phases_ + 2 * p, phase, active_voice_mask);
+        poly_int phase = advanceDetunedPhase(voice_block_);
+        if (num_active_voices < 2)
+          expandAndWriteVoice(phases_ + 2 * p, phase, active_voice_mask);
+        else
+          phases_[p] = phase;
+      }
+    }
+
+    if (fused_processing_ && num_phase_updates <= kMaxFusedVoiceBlocks && voice_block_.spectral_morph != kShepardTone) {
+      processFusedChunk<phaseDistort, window>(num_phase_updates, active_voice_mask,
+                                              current_center_amplitude, delta_center_amplitude,
+                                              current_detuned_amplitude, delta_detuned_amplitude);
+    }
+    else {
+      utils::zeroBuffer(audio_out, num_samples);
+      for (int p = 1; p < num_phase_updates; ++p) {
+        loadVoiceBlock(voice_block_, p, active_voice_mask);
+
+        poly_int phase = processDetuned<phaseDistort, window>(voice_block_, audio_out);
+        if (num_active_voices < 2)
+          expandAndWriteVoice(phases_ + 2 * p, phase, active_voice_mask);
+        else
+          phases_[p] = phase;
+      }
+
+      loadVoiceBlock(voice_block_, 0, active_voice_mask);
+      poly_int center_phase = processCenter<phaseDistort, window>(voice_block_, audio_out,
+                                                                  current_center_amplitude, delta_center_amplitude,
+                                                                  current_detuned_amplitude, delta_detuned_amplitude);
+
+      if (num_active_voices < 2) {
+        expandAndWriteVoice(phases_, center_phase, active_voice_mask);
+        convertVoiceChannels(num_samples, audio_out, active_voice_mask);
+      }
       else
-        phases_[p] = phase;
+        phases_[0] = center_phase;
     }
 
+    for (int p = 1; p <= collapsed_pairs; ++p)
+      phases_[p] = utils::maskLoad(phases_[p], phases_[0], active_voice_mask);
+  }
+
+  template<poly_int(*phaseDistort)(poly_int, poly_float, poly_int, const poly_float*, int),
+           poly_float(*window)(poly_int, poly_int, poly_float, const poly_float*, int)>
+  void SynthOscillator::processFusedChunk(int num_blocks, poly_mask active_voice_mask,
+                                          poly_float current_center_amplitude, poly_float delta_center_amplitude,
+                                          poly_float current_detuned_amplitude, poly_float delta_detuned_amplitude) {
+    typedef void(*VoiceBlockKernel)(const VoiceBlock*, poly_float*, poly_int*,
+                                    poly_float, poly_float, poly_float, poly_float);
+    static const VoiceBlockKernel kStaticKernels[kMaxFusedVoiceBlocks] = {
+      processVoiceBlocks<1, phaseDistort, window, interpolateBuffers>,
+      processVoiceBlocks<2, phaseDistort, window, interpolateBuffers>,
+      processVoiceBlocks<3, phaseDistort, window, interpolateBuffers>,
+      processVoiceBlocks<4, phaseDistort, window, interpolateBuffers>
+    };
+    static const VoiceBlockKernel kFadingKernels[kMaxFusedVoiceBlocks] = {
+      processVoiceBlocks<1, phaseDistort, window, interpolateMultipleBuffers>,
+      processVoiceBlocks<2, phaseDistort, window, interpolateMultipleBuffers>,
+      processVoiceBlocks<3, phaseDistort, window, interpolateMultipleBuffers>,
+      processVoiceBlocks<4, phaseDistort, window, interpolateMultipleBuffers>
+    };
+
+    VoiceBlock voice_blocks[kMaxFusedVoiceBlocks];
+    for (int p = 1; p < num_blocks; ++p) {
+      voice_blocks[p] = voice_block_;
+      loadVoiceBlock(voice_blocks[p], p, active_voice_mask);
+    }
     loadVoiceBlock(voice_block_, 0, active_voice_mask);
+    voice_blocks[0] = voice_block_;
 
-    mono_float sample_inc = 1.0f / voice_block_.total_samples;
-    poly_float delta_center_amplitude = (center_amplitude - current_center_amplitude) * sample_inc;
-    poly_float delta_detuned_amplitude = (detuned_amplitude - current_detuned_amplitude) * sample_inc;
-    current_center_amplitude += delta_center_amplitude * voice_block_.start_sample;
-    current_detuned_amplitude += delta_detuned_amplitude * voice_block_.start_sample;
-    poly_int center_phase = processCenter<phaseDistort, window>(voice_block_, audio_out,
-                                                                current_center_amplitude, delta_center_amplitude,
-                                                                current_detuned_amplitude, delta_detuned_amplitude);
+    bool is_static = true;
+    for (int p = 0; p < num_blocks; ++p)
+      is_static = is_static && voice_blocks[p].isStatic();
 
-    if (num_active_voices < 2) {
-      expandAndWriteVoice(phases_, center_phase, active_voice_mask);
-      convertVoiceChannels(num_samples, audio_out, active_voice_mask);
+    poly_float* audio_out = output(kRaw)->buffer + voice_block_.start_sample;
+    poly_int phases[kMaxFusedVoiceBlocks];
+    const VoiceBlockKernel* kernels = is_static ? kStaticKernels : kFadingKernels;
+    kernels[num_blocks - 1](voice_blocks, audio_out, phases,
+                            current_center_amplitude, delta_center_amplitude,
+                            current_detuned_amplitude, delta_detuned_amplitude);
+
+    if ((~active_voice_mask).anyMask()) {
+      for (int p = 0; p < num_blocks; ++p)
+        expandAndWriteVoice(phases_ + 2 * p, phases[p], active_voice_mask);
+      convertVoiceChannels(voice_block_.end_sample - voice_block_.start_sample, audio_out, active_voice_mask);
+    }
+    else {
+      for (int p = 0; p < num_blocks; ++p)
+        phases_[p] = phases[p];
     }
-    else
-      phases_[0] = center_phase;
   }
 
   void SynthOscillator::processBlend(int num_samples, poly_mask reset_mask) {
-    poly_float* audio_out = output(kRaw)->buffer;
-    stereoBlend(audio_out, num_samples, reset_mask);
-    levelOutput(output(kLevelled)->buffer, audio_out, num_samples, reset_mask);
+    VITAL_ASSERT(inputMatchesBufferSize(kAmplitude));
+
+    poly_float stereo_spread = utils::clamp(input(kStereoSpread)->at(0), 0.0f, 1.0f);
+    poly_float current_stereo_mult = blend_stereo_multiply_;
+    poly_float current_center_mult = blend_center_multiply_;
+    blend_stereo_multiply_ = futils::equalPowerFade(stereo_spread * 0.5f + 0.5f);
+    blend_center_multiply_ = futils::equalPowerFadeInverse(stereo_spread * 0.5f + 0.5f);
+
+    current_stereo_mult = utils::maskLoad(current_stereo_mult, blend_stereo_multiply_, reset_mask);
+    current_center_mult = utils::maskLoad(current_center_mult, blend_center_multiply_, reset_mask);
+    poly_float delta_stereo_mult = (blend_stereo_multiply_ - current_stereo_mult) * (1.0f / num_samples);
+    poly_float delta_center_mult = (blend_center_multiply_ - current_center_mult) * (1.0f / num_samples);
+
+    poly_float current_pan_amplitude = pan_amplitude_;
+    pan_amplitude_ = futils::panAmplitude(utils::clamp(input(kPan)->at(0), -1.0f, 1.0f));
+    current_pan_amplitude = utils::maskLoad(current_pan_amplitude, pan_amplitude_, reset_mask);
+    poly_float delta_pan_amplitude = (pan_amplitude_ - current_pan_amplitude) * (1.0f / num_samples);
+
+    poly_float* raw_out = output(kRaw)->buffer;
+    poly_float* audio_out = output(kLevelled)->buffer;
+    const poly_float* amplitude = input(kAmplitude)->source->buffer;
+    poly_float zero = 0.0f;
+
+    if (delta_stereo_mult.sum() + delta_center_mult.sum() == 0.0f && utils::equal(stereo_spread, 1.0f)) {
+      for (int i = 0; i < num_samples; ++i) {
+        poly_float amp = utils::max(amplitude[i], zero);
+        current_pan_amplitude += delta_pan_amplitude;
+        audio_out[i] = current_pan_amplitude * raw_out[i] * amp * amp;
+        VITAL_ASSERT(utils::isFinite(audio_out[i]));
+      }
+      return;
+    }
+
+    for (int i = 0; i < num_samples; ++i) {
+      current_stereo_mult += delta_stereo_mult;
+      current_center_mult += delta_center_mult;
+      poly_float val = raw_out[i];
+      poly_float swap = utils::swapStereo(val);
+      poly_float blended = val * current_stereo_mult + swap * current_center_mult;
+      raw_out[i] = blended;
+
+      poly_float amp = utils::max(amplitude[i], zero);
+      current_pan_amplitude += delta_pan_amplitude;
+      audio_out[i] = current_pan_amplitude * blended * amp * amp;
+      VITAL_ASSERT(utils::isFinite(audio_out[i]));
+    }
   }
 } // namespace vital
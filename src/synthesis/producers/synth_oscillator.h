@@ -25,6 +25,7 @@
 namespace vital {
 
   class FourierTransform;
+  class SpectralFrameCache;
   class Wavetable;
 
   struct PhaseBuffer {
@@ -85,6 +86,7 @@ namespace vital {
         kSpectralUnison,
         kDistortionType,
         kDistortionAmount,
+        kUnisonCulling,
         kActiveVoices,
         kReset,
         kRetrigger,
@@ -204,7 +206,7 @@ namespace vital {
                                          poly_float distortion_amount, poly_int distortion_phase);
       static vital::poly_float getPhaseWindow(DistortionType distortion_type, poly_int phase,
                                               poly_int distorted_phase);
-      static poly_float interpolate(const mono_float* buffers, const poly_int indices);
+      static void interpolate(mono_float* dest, const mono_float* buffer, const poly_int* phases, int num_phases);
       static bool usesDistortionPhase(DistortionType distortion_type);
 
       SynthOscillator(Wavetable* wavetable);
@@ -219,6 +221,12 @@ namespace vital {
       void setFirstOscillatorOutput(Output* oscillator) { first_mod_oscillator_ = oscillator; }
       void setSecondOscillatorOutput(Output* oscillator) { second_mod_oscillator_ = oscillator; }
       void setSampleOutput(Output* sample) { sample_ = sample; }
+      // Renders every chunk on the generic per-block path when off. Used to test the fused kernels.
+      void setFusedProcessing(bool fused) { fused_processing_ = fused; }
+      // Runs every spectral morph transform when off. Used to test and benchmark the shared frame cache.
+      void setSpectralFrameCaching(bool caching) { spectral_frame_caching_ = caching; }
+      bool hasSpectralFrameCache() const;
+      float getSpectralFrameCacheHitRate() const;
 
       virtual void setOversampleAmount(int oversample) override {
         Processor::setOversampleAmount(oversample);
@@ -234,12 +242,19 @@ namespace vital {
                poly_float(*window)(poly_int, poly_int, poly_float, const poly_float*, int)>
       void processChunk(poly_float current_center_amplitude, poly_float current_detuned_amplitude);
 
+      template<poly_int(*phaseDistort)(poly_int, poly_float, poly_int, const poly_float*, int),
+               poly_float(*window)(poly_int, poly_int, poly_float, const poly_float*, int)>
+      void processFusedChunk(int num_blocks, poly_mask active_voice_mask,
+                             poly_float current_center_amplitude, poly_float delta_center_amplitude,
+                             poly_float current_detuned_amplitude, poly_float delta_detuned_amplitude);
+
       void processBlend(int num_samples, poly_mask reset_mask);
 
       void loadVoiceBlock(VoiceBlock& voice_block, int index, poly_mask active_mask);
 
       void resetWavetableBuffers();
       void setActiveOscillators(int new_active_oscillators);
+      bool isUnisonCoherent(poly_mask active_mask);
       template<poly_float(*snapTranspose)(poly_float, poly_float, float*)>
       void setPhaseIncBufferSnap(int num_samples, poly_mask reset_mask,
                                  poly_int trigger_sample, poly_mask active_mask, float* snap_buffer);
@@ -258,8 +273,6 @@ namespace vital {
       template<void(*spectralMorph)(const Wavetable::WavetableData*, int, poly_float*,
                                     FourierTransform*, float, int, const poly_float*)>
       void setFourierWaveBuffers(poly_float phase_inc, int index, bool formant_shift);
-      void stereoBlend(poly_float* audio_out, int num_samples, poly_mask reset_mask);
-      void levelOutput(poly_float* audio_out, const poly_float* raw_out, int buffer_size, poly_mask reset_mask);
       void convertVoiceChannels(int buffer_size, poly_float* audio_out, poly_mask active_mask);
       force_inline float getPhaseIncAdjustment() {
         static constexpr int kBaseSampleRate = 44100;
@@ -303,6 +316,9 @@ namespace vital {
       poly_float last_quantize_ratio_;
       int unison_;
       int active_oscillators_;
+      int rendered_oscillators_;
+      bool fused_processing_;
+      bool spectral_frame_caching_;
       Wavetable* wavetable_;
       int wavetable_version_;
       Output* first_mod_oscillator_;
@@ -312,6 +328,7 @@ namespace vital {
       poly_float fourier_frames1_[kNumBuffers + 1][kSpectralBufferSize];
       poly_float fourier_frames2_[kNumBuffers + 1][kSpectralBufferSize];
       std::shared_ptr<FourierTransform> fourier_transform_;
+      std::shared_ptr<SpectralFrameCache> spectral_frame_cache_;
       std::shared_ptr<Output> phase_inc_buffer_;
       std::shared_ptr<PhaseBuffer> phase_buffer_;
 
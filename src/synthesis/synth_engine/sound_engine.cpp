@@ -17,6 +17,7 @@
 #include "sound_engine.h"
 
 #include "compressor_module.h"
+#include "convolution_module.h"
 #include "flanger_module.h"
 #include "phaser_module.h"
 #include "decimator.h"
@@ -32,7 +33,9 @@ namespace vital {
 
   SoundEngine::SoundEngine() : SynthModule(0, 1), voice_handler_(nullptr), effect_chain_(nullptr),
                                output_total_(nullptr), last_oversampling_amount_(-1), last_sample_rate_(-1),
-                               oversampling_(nullptr), legato_(nullptr), decimator_(nullptr), peak_meter_(nullptr) {
+                               last_oversampling_quality_(constants::kStandardOversampling), latency_samples_(0),
+                               oversampling_(nullptr), oversampling_quality_(nullptr), legato_(nullptr),
+                               decimator_(nullptr), peak_meter_(nullptr), telemetry_enabled_(true) {
     SoundEngine::init();
     bps_ = data_->controls["beats_per_minute"];
     modulation_processors_.reserve(kMaxModulationConnections);
@@ -47,6 +50,7 @@ namespace vital {
     createBaseControl("mpe_enabled");
     createBaseControl("view_spectrogram");
     oversampling_ = createBaseControl("oversampling");
+    oversampling_quality_ = createBaseControl("oversampling_quality");
     legato_ = createBaseControl("legato");
 
     Output* stereo_routing = createMonoModControl("stereo_routing");
@@ -133,7 +137,7 @@ namespace vital {
 
     SynthModule::init();
     disableUnnecessaryModSources();
-    setOversamplingAmount(kDefaultOversamplingAmount, kDefaultSampleRate);
+    setOversamplingAmount(kDefaultOversamplingAmount, kDefaultSampleRate, constants::kStandardOversampling);
   }
 
   void SoundEngine::connectModulation(const modulation_change& change) {
@@ -219,11 +223,16 @@ namespace vital {
     int oversampling = oversampling_->value();
     int oversampling_amount = 1 << oversampling;
     int sample_rate = getSampleRate();
-    if (last_oversampling_amount_ != oversampling_amount || last_sample_rate_ != sample_rate)
-      setOversamplingAmount(oversampling_amount, sample_rate);
+    int quality_index = utils::iclamp(oversampling_quality_->value(), 0, constants::kNumOversamplingQualities - 1);
+    constants::OversamplingQuality quality = static_cast<constants::OversamplingQuality>(quality_index);
+    if (last_oversampling_amount_ != oversampling_amount || last_sample_rate_ != sample_rate ||
+        last_oversampling_quality_ != quality) {
+      setOversamplingAmount(oversampling_amount, sample_rate, quality);
+    }
   }
 
-  void SoundEngine::setOversamplingAmount(int oversampling_amount, int sample_rate) {
+  void SoundEngine::setOversamplingAmount(int oversampling_amount, int sample_rate,
+                                          constants::OversamplingQuality quality) {
     static constexpr int kBaseSampleRate = 44100;
     
     int oversample = oversampling_amount;
@@ -235,8 +244,16 @@ namespace vital {
     voice_handler_->setOversampleAmount(oversample);
     effect_chain_->setOversampleAmount(oversample);
     output_total_->setOversampleAmount(oversample);
+    decimator_->setQuality(quality);
+
+    int num_stages = 0;
+    while ((1 << num_stages) < oversample)
+      num_stages++;
+    latency_samples_ = decimator_->getLatency(num_stages);
+
     last_oversampling_amount_ = oversampling_amount;
     last_sample_rate_ = sample_rate;
+    last_oversampling_quality_ = quality;
   }
 
   void SoundEngine::process(int num_samples) {
@@ -254,8 +271,8 @@ namespace vital {
       }
     }
 
-    for (auto& status_source : data_->status_outputs)
-      status_source.second->update();
+    if (telemetry_enabled_)
+      updateStatusOutputs();
   }
 
   void SoundEngine::correctToTime(double seconds) {
@@ -321,10 +338,23 @@ namespace vital {
     return getModulationSource(source)->owner->enabled();
   }
 
+  void SoundEngine::setTelemetryEnabled(bool enabled) {
+    if (telemetry_enabled_ == enabled)
+      return;
+
+    telemetry_enabled_ = enabled;
+    voice_handler_->setTelemetryEnabled(enabled);
+    effect_chain_->setTelemetryEnabled(enabled);
+  }
+
   const StereoMemory* SoundEngine::getEqualizerMemory() {
     return effect_chain_->getEqualizerMemory();
   }
 
+  Convolution* SoundEngine::getConvolution() {
+    return effect_chain_->getConvolution()->getConvolution();
+  }
+
   void SoundEngine::setAftertouch(mono_float note, mono_float value, int sample, int channel) {
     voice_handler_->setAftertouch(note, value, sample, channel);
   }
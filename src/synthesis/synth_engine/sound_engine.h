@@ -19,11 +19,13 @@
 #include "circular_queue.h"
 #include "synth_module.h"
 #include "note_handler.h"
+#include "synth_constants.h"
 
 class LineGenerator;
 class Tuning;
 
 namespace vital {
+  class Convolution;
   class Decimator;
   class PeakMeter;
   class Sample;
@@ -73,6 +75,11 @@ namespace vital {
       void disableModSource(const std::string& source);
       bool isModSourceEnabled(const std::string& source);
       const StereoMemory* getEqualizerMemory();
+      Convolution* getConvolution();
+
+      // Status outputs and visualization memories are only written while something is reading them.
+      void setTelemetryEnabled(bool enabled);
+      bool isTelemetryEnabled() const { return telemetry_enabled_; }
 
       void setBpm(mono_float bpm);
       void setAftertouch(mono_float note, mono_float value, int sample, int channel);
@@ -94,11 +101,15 @@ namespace vital {
       void sostenutoOnRange(int from_channel, int to_channel);
       void sostenutoOffRange(int sample, int from_channel, int to_channel);
       force_inline int getOversamplingAmount() const { return last_oversampling_amount_; }
+      force_inline constants::OversamplingQuality getOversamplingQuality() const {
+        return last_oversampling_quality_;
+      }
+      force_inline int getLatencySamples() const { return latency_samples_; }
 
       void checkOversampling();
 
     private:
-      void setOversamplingAmount(int oversampling_amount, int sample_rate);
+      void setOversamplingAmount(int oversampling_amount, int sample_rate, constants::OversamplingQuality quality);
     
       SynthVoiceHandler* voice_handler_;
       ReorderableEffectChain* effect_chain_;
@@ -106,11 +117,15 @@ namespace vital {
 
       int last_oversampling_amount_;
       int last_sample_rate_;
+      constants::OversamplingQuality last_oversampling_quality_;
+      int latency_samples_;
       Value* oversampling_;
+      Value* oversampling_quality_;
       Value* bps_;
       Value* legato_;
       Decimator* decimator_;
       PeakMeter* peak_meter_;
+      bool telemetry_enabled_;
 
       CircularQueue<Processor*> modulation_processors_;
 
@@ -18,12 +18,16 @@
 #include "border_bounds_constrainer.cpp"
 #endif
 
+#include "audio_file_cache.cpp"
+#include "bank_writer.cpp"
 #include "line_generator.cpp"
 #include "midi_manager.cpp"
 #include "tuning.cpp"
 #include "startup.cpp"
 #include "synth_gui_interface.cpp"
 #include "synth_parameters.cpp"
+#include "telemetry_tap.cpp"
+#include "file_index.cpp"
 #include "load_save.cpp"
 #include "synth_types.cpp"
 #include "synth_base.cpp"
@@ -31,4 +31,5 @@
 #include "oscillator_section.cpp"
 #include "phaser_section.cpp"
 #include "compressor_section.cpp"
+#include "convolution_section.cpp"
 #include "reverb_section.cpp"
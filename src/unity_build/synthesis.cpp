@@ -36,6 +36,7 @@
 #include "wave_frame.cpp"
 #include "wavetable.cpp"
 #include "utils.cpp"
+#include "dsp_kernels.cpp"
 #include "feedback.cpp"
 #include "voice_handler.cpp"
 #include "processor.cpp"
@@ -68,6 +69,7 @@
 #include "delay_module.cpp"
 #include "comb_module.cpp"
 #include "compressor_module.cpp"
+#include "convolution_module.cpp"
 #include "formant_module.cpp"
 #include "sample_module.cpp"
 #include "oscillator_module.cpp"
@@ -76,6 +78,7 @@
 #include "phaser.cpp"
 #include "distortion.cpp"
 #include "compressor.cpp"
+#include "convolution.cpp"
 #include "delay.cpp"
 #include "reverb.cpp"
 #include "sound_engine.cpp"
@@ -0,0 +1,64 @@
+/* Copyright 2013-2019 Matt Tytel
+ *
+ * vital is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * vital is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with vital.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "engine_host_test.h"
+#include "../../src/headless/engine_host.h"
+
+namespace {
+  constexpr int kNumBlocks = 20;
+  constexpr int kNote = 60;
+} // namespace
+
+void EngineHostTest::runTest() {
+#if VITAL_ENGINE_HOST
+  testScheduling(1, 1);
+  testScheduling(7, 3);
+  testScheduling(2, 4);
+  testScheduling(16, 4);
+#endif
+}
+
+void EngineHostTest::testScheduling(int num_instances, int num_threads) {
+#if VITAL_ENGINE_HOST
+  beginTest(String(num_instances) + " Instances on " + String(num_threads) + " Threads");
+
+  EngineHost host(num_instances, num_threads);
+  expect(host.getNumInstances() == num_instances);
+  expect(host.getStats().num_threads == num_threads);
+
+  for (int i = 0; i < num_instances; ++i)
+    host.getMidi(i).addEvent(MidiMessage::noteOn(1, kNote, 0.8f), 0);
+
+  for (int b = 0; b < kNumBlocks; ++b) {
+    host.processBlock();
+
+    for (int i = 0; i < num_instances; ++i) {
+      expect(host.getNumBlocksProcessed(i) == b + 1);
+      expect(host.getMidi(i).isEmpty());
+    }
+  }
+
+  bool all_sounding = true;
+  for (int i = 0; i < num_instances; ++i) {
+    const AudioSampleBuffer& output = host.getOutput(i);
+    all_sounding = all_sounding && output.getMagnitude(0, host.getBlockSize()) > 0.0f;
+  }
+  expect(all_sounding);
+  expect(host.getStats().num_blocks == kNumBlocks);
+#endif
+}
+
+static EngineHostTest engine_host_test;
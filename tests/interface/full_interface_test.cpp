@@ -26,7 +26,7 @@ void FullInterfaceTest::runTest() {
   FullInterface* full_interface = new FullInterface(&data);
   lock.reset();
 
-  full_interface->setOscilloscopeMemory(getSynthBase()->getOscilloscopeMemory());
+  full_interface->setTelemetryTap(getSynthBase()->getTelemetryTap());
   full_interface->setAudioMemory(getSynthBase()->getAudioMemory());
 
   runStressRandomTest(full_interface, full_interface);
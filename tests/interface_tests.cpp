@@ -17,6 +17,7 @@
 #include "interface/bend_section_test.cpp"
 #include "interface/chorus_section_test.cpp"
 #include "interface/compressor_section_test.cpp"
+#include "interface/convolution_section_test.cpp"
 #include "interface/delay_section_test.cpp"
 #include "interface/distortion_section_test.cpp"
 #include "interface/envelope_section_test.cpp"
@@ -0,0 +1,123 @@
+/* Copyright 2013-2019 Matt Tytel
+ *
+ * vital is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * vital is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with vital.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "convolution_test.h"
+#include "convolution.h"
+#include "value.h"
+
+void ConvolutionTest::runTest() {
+  vital::Convolution convolution;
+  runInputBoundsTest(&convolution);
+
+  for (bool background : { false, true }) {
+    runAccuracyTest(vital::Convolution::kHeadBlockSize / 2, background);
+    runAccuracyTest(vital::Convolution::kHeadLength - 7, background);
+    runAccuracyTest(3 * vital::Convolution::kTailBlockSize + vital::Convolution::kHeadLength + 5, background);
+  }
+}
+
+void ConvolutionTest::runAccuracyTest(int impulse_length, bool background) {
+  static constexpr int kNumBlocks = 80;
+  static constexpr float kMaxError = 0.0005f;
+  static constexpr double kMaxKernelWaitMs = 5000.0;
+
+  beginTest(String(background ? "Background " : "") + "Accuracy " + String(impulse_length));
+
+  int buffer_size = vital::kMaxBufferSize;
+  int sample_rate = vital::kDefaultSampleRate;
+  vital::Convolution convolution;
+  vital::Output audio;
+  audio.ensureBufferSize(buffer_size);
+  vital::Value wet(1.0f);
+  vital::Value gain(0.0f);
+
+  convolution.plug(&audio, vital::Convolution::kAudio);
+  convolution.plug(&wet, vital::Convolution::kWet);
+  convolution.plug(&gain, vital::Convolution::kGain);
+  convolution.setBackgroundProcessing(background);
+  convolution.setSampleRate(sample_rate);
+
+  std::vector<vital::mono_float> left(impulse_length);
+  std::vector<vital::mono_float> right(impulse_length);
+  Random random(impulse_length);
+  float left_energy = 0.0f;
+  float right_energy = 0.0f;
+  for (int i = 0; i < impulse_length; ++i) {
+    left[i] = random.nextFloat() - 0.5f;
+    right[i] = random.nextFloat() - 0.5f;
+    left_energy += left[i] * left[i];
+    right_energy += right[i] * right[i];
+  }
+  float scale = 1.0f / sqrtf(std::max(left_energy, right_energy));
+  convolution.setImpulseResponse(left.data(), right.data(), impulse_length, sample_rate, "Test");
+
+  // The worker builds the kernel and the audio thread picks it up at the next tail block, fed silence meanwhile.
+  double block_ms = 1000.0 * buffer_size / sample_rate;
+  double start_ms = Time::getMillisecondCounterHiRes();
+  convolution.process(buffer_size);
+  while (background && convolution.getTailSamples() != impulse_length &&
+         Time::getMillisecondCounterHiRes() - start_ms < kMaxKernelWaitMs) {
+    Thread::sleep(1);
+    convolution.process(buffer_size);
+  }
+  expect(convolution.hasKernel());
+  expect(convolution.getTailSamples() == impulse_length);
+  int start_underruns = convolution.getTailUnderruns();
+
+  std::vector<vital::mono_float> input_left(kNumBlocks * buffer_size);
+  std::vector<vital::mono_float> input_right(kNumBlocks * buffer_size);
+  for (int i = 0; i < kNumBlocks * buffer_size; ++i) {
+    input_left[i] = random.nextFloat() - 0.5f;
+    input_right[i] = random.nextFloat() - 0.5f;
+  }
+
+  float max_error = 0.0f;
+  double next_block_ms = Time::getMillisecondCounterHiRes();
+  for (int block = 0; block < kNumBlocks; ++block) {
+    for (int i = 0; i < buffer_size; ++i) {
+      int index = block * buffer_size + i;
+      audio.buffer[i] = vital::poly_float(input_left[index], input_right[index], 0.0f, 0.0f);
+    }
+
+    // Runs at the pace of a real audio device so the worker gets the time it would have live.
+    if (background) {
+      next_block_ms += block_ms;
+      double wait_ms = next_block_ms - Time::getMillisecondCounterHiRes();
+      if (wait_ms >= 1.0)
+        Thread::sleep(static_cast<int>(wait_ms));
+    }
+    convolution.process(buffer_size);
+
+    for (int i = 0; i < buffer_size; ++i) {
+      int index = block * buffer_size + i;
+      float expected_left = 0.0f;
+      float expected_right = 0.0f;
+      for (int t = 0; t < impulse_length && t <= index; ++t) {
+        expected_left += left[t] * input_left[index - t];
+        expected_right += right[t] * input_right[index - t];
+      }
+
+      vital::poly_float result = convolution.output()->buffer[i];
+      max_error = std::max(max_error, fabsf(result[0] - scale * expected_left));
+      max_error = std::max(max_error, fabsf(result[1] - scale * expected_right));
+    }
+  }
+
+  expect(max_error < kMaxError, "Error " + String(max_error));
+  expect(convolution.getTailUnderruns() == start_underruns, "Tail underruns");
+}
+
+static ConvolutionTest convolution_test;
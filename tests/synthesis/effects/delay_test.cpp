@@ -17,12 +17,56 @@
 #include "delay_test.h"
 #include "delay.h"
 #include "memory.h"
+#include "value.h"
 
 void DelayTest::runTest() {
   vital::MultiDelay multi_delay(10000);
   vital::StereoDelay stereo_delay(10000);
   runInputBoundsTest(&multi_delay);
   runInputBoundsTest(&stereo_delay);
+  runTailTest();
+}
+
+void DelayTest::runTailTest() {
+  beginTest("Tail Length");
+
+  vital::StereoDelay delay(10000);
+  vital::Output audio;
+  audio.ensureBufferSize(vital::kMaxBufferSize);
+  vital::Value frequency(100.0f);
+  vital::Value feedback(0.7f);
+  vital::Value wet(1.0f);
+  vital::Value style(vital::StereoDelay::kPingPong);
+  vital::Value zero(0.0f);
+
+  delay.plug(&audio, vital::StereoDelay::kAudio);
+  delay.plug(&wet, vital::StereoDelay::kWet);
+  delay.plug(&frequency, vital::StereoDelay::kFrequency);
+  delay.plug(&frequency, vital::StereoDelay::kFrequencyAux);
+  delay.plug(&feedback, vital::StereoDelay::kFeedback);
+  delay.plug(&zero, vital::StereoDelay::kDamping);
+  delay.plug(&style, vital::StereoDelay::kStyle);
+  delay.plug(&zero, vital::StereoDelay::kFilterCutoff);
+  delay.plug(&zero, vital::StereoDelay::kFilterSpread);
+
+  audio.buffer[0] = 1.0f;
+  delay.process(vital::kMaxBufferSize);
+  audio.clearBuffer();
+
+  int tail_samples = delay.getTailSamples();
+  expect(tail_samples > 0 && tail_samples < vital::kMaxTailSamples);
+  for (int i = 0; i < tail_samples; i += vital::kMaxBufferSize)
+    delay.process(vital::kMaxBufferSize);
+
+  for (int i = 0; i < 100; ++i) {
+    delay.process(vital::kMaxBufferSize);
+    float peak = vital::utils::maxFloat(vital::utils::peak(delay.output()->buffer, vital::kMaxBufferSize));
+    expect(peak < vital::kTailSilenceAmplitude);
+  }
+
+  feedback.set(1.0f);
+  delay.process(vital::kMaxBufferSize);
+  expect(delay.getTailSamples() == vital::kMaxTailSamples);
 }
 
 static DelayTest delay_test;
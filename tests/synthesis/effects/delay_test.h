@@ -22,5 +22,6 @@ class DelayTest : public ProcessorTest {
   public:
     DelayTest() : ProcessorTest("Delay") { }
     void runTest() override;
+    void runTailTest();
 };
 
@@ -16,10 +16,126 @@
 
 #include "reverb_test.h"
 #include "reverb.h"
+#include "value.h"
 
 void ReverbTest::runTest() {
   vital::Reverb reverb;
   runInputBoundsTest(&reverb);
+
+  for (int quality = 0; quality < vital::Reverb::kNumQualities; ++quality) {
+    runQualityTest(quality, 1);
+    runQualityTest(quality, 2);
+  }
+
+  runQualityChangeTest(vital::Reverb::kStandard, vital::Reverb::kUltra, 1);
+  runQualityChangeTest(vital::Reverb::kUltra, vital::Reverb::kEco, 1);
+  runQualityChangeTest(vital::Reverb::kDense, vital::Reverb::kStandard, 2);
+  runQualityChangeTest(vital::Reverb::kStandard, vital::Reverb::kLight, 2);
+}
+
+namespace {
+  struct ReverbInputs {
+    ReverbInputs(int quality) : quality_value(quality), decay_time(1.0f), wet(1.0f), high_cutoff(128.0f),
+                                size(0.5f), zero(0.0f) { }
+
+    void plug(vital::Reverb* reverb, vital::Output* audio) {
+      reverb->plug(audio, vital::Reverb::kAudio);
+      reverb->plug(&quality_value, vital::Reverb::kQuality);
+      reverb->plug(&decay_time, vital::Reverb::kDecayTime);
+      reverb->plug(&zero, vital::Reverb::kPreLowCutoff);
+      reverb->plug(&high_cutoff, vital::Reverb::kPreHighCutoff);
+      reverb->plug(&zero, vital::Reverb::kLowCutoff);
+      reverb->plug(&zero, vital::Reverb::kLowGain);
+      reverb->plug(&high_cutoff, vital::Reverb::kHighCutoff);
+      reverb->plug(&zero, vital::Reverb::kHighGain);
+      reverb->plug(&zero, vital::Reverb::kChorusAmount);
+      reverb->plug(&zero, vital::Reverb::kChorusFrequency);
+      reverb->plug(&zero, vital::Reverb::kStereoWidth);
+      reverb->plug(&size, vital::Reverb::kSize);
+      reverb->plug(&zero, vital::Reverb::kDelay);
+      reverb->plug(&wet, vital::Reverb::kWet);
+    }
+
+    vital::Value quality_value;
+    vital::Value decay_time;
+    vital::Value wet;
+    vital::Value high_cutoff;
+    vital::Value size;
+    vital::Value zero;
+  };
+} // namespace
+
+void ReverbTest::runQualityTest(int quality, int oversample) {
+  beginTest("Quality " + String(quality) + " Oversample " + String(oversample));
+
+  int buffer_size = vital::kMaxBufferSize * oversample;
+  vital::Reverb reverb;
+  vital::Output audio;
+  audio.ensureBufferSize(buffer_size);
+  ReverbInputs inputs(quality);
+  inputs.plug(&reverb, &audio);
+  reverb.setSampleRate(vital::kDefaultSampleRate);
+  reverb.setOversampleAmount(oversample);
+
+  reverb.process(buffer_size);
+  expect(reverb.getNetworkSize() == vital::Reverb::getNetworkSize(quality));
+  int network_rate = vital::kDefaultSampleRate * oversample;
+  if (vital::Reverb::runsAtBaseRate(quality))
+    network_rate = vital::kDefaultSampleRate;
+  expect(reverb.getNetworkSampleRate() == network_rate);
+
+  audio.buffer[0] = 1.0f;
+  reverb.process(buffer_size);
+  audio.clearBuffer();
+
+  float tail_peak = 0.0f;
+  for (int i = 0; i < vital::kDefaultSampleRate / vital::kMaxBufferSize; ++i) {
+    reverb.process(buffer_size);
+    expect(vital::utils::isFinite(reverb.output()->buffer, buffer_size));
+    tail_peak = std::max(tail_peak, vital::utils::maxFloat(vital::utils::peak(reverb.output()->buffer, buffer_size)));
+  }
+  expect(tail_peak > 0.0001f);
+  expect(tail_peak < 1.0f);
+}
+
+void ReverbTest::runQualityChangeTest(int from_quality, int to_quality, int oversample) {
+  static constexpr int kTailBlocks = 200;
+  static constexpr float kMinTailRatio = 0.1f;
+
+  beginTest("Quality Change " + String(from_quality) + " To " + String(to_quality) +
+            " Oversample " + String(oversample));
+
+  int buffer_size = vital::kMaxBufferSize * oversample;
+  vital::Reverb reverb;
+  vital::Output audio;
+  audio.ensureBufferSize(buffer_size);
+  ReverbInputs inputs(from_quality);
+  inputs.plug(&reverb, &audio);
+  reverb.setSampleRate(vital::kDefaultSampleRate);
+  reverb.setOversampleAmount(oversample);
+
+  for (int i = 0; i < buffer_size; ++i)
+    audio.buffer[i] = (i % 32) < 16 ? 1.0f : -1.0f;
+  reverb.process(buffer_size);
+  audio.clearBuffer();
+
+  for (int i = 0; i < kTailBlocks; ++i)
+    reverb.process(buffer_size);
+  float tail_before = vital::utils::maxFloat(vital::utils::peak(reverb.output()->buffer, buffer_size));
+
+  inputs.quality_value.set(to_quality);
+  reverb.process(buffer_size);
+  expect(reverb.getNetworkSize() == vital::Reverb::getNetworkSize(to_quality));
+  expect(vital::utils::isFinite(reverb.output()->buffer, buffer_size));
+  float tail_after = vital::utils::maxFloat(vital::utils::peak(reverb.output()->buffer, buffer_size));
+  expect(tail_before > 0.0f);
+  expect(tail_after > kMinTailRatio * tail_before, "Changing quality cleared the reverb tail.");
+
+  for (int i = 0; i < kTailBlocks; ++i) {
+    reverb.process(buffer_size);
+    expect(vital::utils::isFinite(reverb.output()->buffer, buffer_size));
+  }
+  expect(vital::utils::maxFloat(vital::utils::peak(reverb.output()->buffer, buffer_size)) < 1.0f);
 }
 
 static ReverbTest reverb_test;
@@ -22,5 +22,7 @@ class ReverbTest : public ProcessorTest {
   public:
     ReverbTest() : ProcessorTest("Reverb") { }
     void runTest() override;
+    void runQualityTest(int quality, int oversample);
+    void runQualityChangeTest(int from_quality, int to_quality, int oversample);
 };
 
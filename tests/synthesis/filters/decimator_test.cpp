@@ -14,12 +14,117 @@
  * along with vital.  If not, see <http://www.gnu.org/licenses/>.
  */
 
+
 #include "decimator_test.h"
 #include "decimator.h"
+#include "value.h"
+
+#include <cmath>
+
+namespace {
+  constexpr int kMaxStages = 3;
+  constexpr int kNumBlocks = 40;
+  constexpr int kSettleBlocks = 10;
+  constexpr float kPassbandFrequency = 1000.0f;
+  constexpr float kAliasedFrequency = 15000.0f;
+
+  // Runs a sine through the decimator and returns the peak amplitude of the output once it has settled.
+  float getOutputAmplitude(vital::constants::OversamplingQuality quality, int num_stages, double frequency) {
+    int oversample = 1 << num_stages;
+    vital::Decimator decimator(kMaxStages);
+    decimator.setQuality(quality);
+    decimator.init();
+
+    vital::Value source;
+    source.setOversampleAmount(oversample);
+    decimator.plug(&source, vital::Decimator::kAudio);
+
+    double phase_delta = 2.0 * vital::kPi * frequency / source.getSampleRate();
+    double phase = 0.0;
+    double total = 0.0;
+    int num_measured = 0;
+    for (int b = 0; b < kNumBlocks; ++b) {
+      for (int i = 0; i < vital::kMaxBufferSize * oversample; ++i) {
+        source.output()->buffer[i] = std::sin(phase);
+        phase += phase_delta;
+      }
+
+      decimator.process(vital::kMaxBufferSize);
+      if (b < kSettleBlocks)
+        continue;
+
+      for (int i = 0; i < vital::kMaxBufferSize; ++i) {
+        vital::poly_float value = decimator.output()->buffer[i];
+        total += value[0] * value[0] + value[1] * value[1];
+        num_measured += 2;
+      }
+    }
+
+    return std::sqrt(2.0 * total / num_measured);
+  }
+} // namespace
 
 void DecimatorTest::runTest() {
   vital::Decimator decimator;
   runInputBoundsTest(&decimator);
+
+  testPassband();
+  testAliasing();
+  testLatency();
+}
+
+void DecimatorTest::testPassband() {
+  beginTest("Passband");
+  for (int q = 0; q < vital::constants::kNumOversamplingQualities; ++q) {
+    vital::constants::OversamplingQuality quality = static_cast<vital::constants::OversamplingQuality>(q);
+    for (int num_stages = 1; num_stages <= kMaxStages; ++num_stages)
+      expectWithinAbsoluteError(getOutputAmplitude(quality, num_stages, kPassbandFrequency), 1.0f, 0.01f);
+  }
+}
+
+void DecimatorTest::testAliasing() {
+  beginTest("Aliasing");
+  static constexpr float kMaxAlias[vital::constants::kNumOversamplingQualities] = { 0.01f, 0.00001f, 0.0001f };
+
+  for (int q = 0; q < vital::constants::kNumOversamplingQualities; ++q) {
+    vital::constants::OversamplingQuality quality = static_cast<vital::constants::OversamplingQuality>(q);
+    for (int num_stages = 1; num_stages <= kMaxStages; ++num_stages) {
+      double frequency = vital::kDefaultSampleRate - kAliasedFrequency;
+      expectLessThan(getOutputAmplitude(quality, num_stages, frequency), kMaxAlias[q]);
+    }
+  }
+}
+
+void DecimatorTest::testLatency() {
+  beginTest("Latency");
+  for (int num_stages = 1; num_stages <= kMaxStages; ++num_stages) {
+    int oversample = 1 << num_stages;
+    vital::Decimator decimator(kMaxStages);
+    decimator.setQuality(vital::constants::kLinearPhaseOversampling);
+    decimator.init();
+
+    vital::Value source;
+    source.setOversampleAmount(oversample);
+    decimator.plug(&source, vital::Decimator::kAudio);
+
+    int latency = decimator.getLatency(num_stages);
+    expect(latency > 0 && latency < vital::kMaxBufferSize);
+
+    vital::utils::zeroBuffer(source.output()->buffer, vital::kMaxBufferSize * oversample);
+    source.output()->buffer[0] = 1.0f;
+    decimator.process(vital::kMaxBufferSize);
+
+    int peak_index = 0;
+    for (int i = 0; i < vital::kMaxBufferSize; ++i) {
+      if (decimator.output()->buffer[i][0] > decimator.output()->buffer[peak_index][0])
+        peak_index = i;
+    }
+    expectEquals(peak_index, latency);
+  }
+
+  vital::Decimator decimator(kMaxStages);
+  decimator.setQuality(vital::constants::kStandardOversampling);
+  expectEquals(decimator.getLatency(kMaxStages), 0);
 }
 
 static DecimatorTest decimator_test;
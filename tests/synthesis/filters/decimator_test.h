@@ -22,5 +22,9 @@ class DecimatorTest : public ProcessorTest {
   public:
     DecimatorTest() : ProcessorTest("Decimator") { }
     void runTest() override;
+
+    void testPassband();
+    void testAliasing();
+    void testLatency();
 };
 
@@ -0,0 +1,173 @@
+/* Copyright 2013-2019 Matt Tytel
+ *
+ * vital is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * vital is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with vital.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "dsp_kernels_test.h"
+#include "dsp_kernels.h"
+
+namespace {
+  constexpr int kSize = 203;
+  constexpr int kFractionBits = 21;
+  constexpr int kBufferSize = 2048;
+  constexpr int kNumTaps = 32;
+  constexpr int kNumOutputs = 61;
+  constexpr float kEpsilon = 0.00001f;
+} // namespace
+
+void DspKernelsTest::runTest() {
+  testBufferOps();
+  testInterpolate();
+  testHalfband();
+  testPolyphase();
+}
+
+void DspKernelsTest::testBufferOps() {
+  beginTest("Buffer Ops");
+  Random random(1);
+  vital::mono_float source[kSize];
+  vital::mono_float dest[kSize + 1];
+  for (int i = 0; i < kSize; ++i)
+    source[i] = random.nextFloat() * 2.0f - 1.0f;
+
+  for (int i = 0; i < vital::kernels::kNumIsas; ++i) {
+    vital::kernels::Isa isa = static_cast<vital::kernels::Isa>(i);
+    if (!vital::kernels::isSupported(isa))
+      continue;
+
+    const vital::kernels::Table& table = vital::kernels::getTable(isa);
+    expect(table.isa == isa);
+
+    dest[kSize] = 1.0f;
+    table.copy(dest, source, kSize);
+    for (int s = 0; s < kSize; ++s)
+      expect(dest[s] == source[s]);
+
+    table.zero(dest, kSize);
+    for (int s = 0; s < kSize; ++s)
+      expect(dest[s] == 0.0f);
+    expect(dest[kSize] == 1.0f);
+  }
+}
+
+void DspKernelsTest::testInterpolate() {
+  beginTest("Interpolate");
+  Random random(2);
+  vital::mono_float buffer[kBufferSize + 1];
+  for (int i = 0; i <= kBufferSize; ++i)
+    buffer[i] = random.nextFloat() * 2.0f - 1.0f;
+
+  uint32_t phases[kSize];
+  for (int i = 0; i < kSize; ++i)
+    phases[i] = random.nextInt64();
+
+  vital::mono_float expected[kSize];
+  vital::kernels::getTable(vital::kernels::kBaseline).interpolate(expected, buffer, phases, kFractionBits, kSize);
+  for (int i = 0; i < kSize; ++i) {
+    uint32_t index = phases[i] >> kFractionBits;
+    float t = (phases[i] & ((1 << kFractionBits) - 1)) / (1.0f * (1 << kFractionBits));
+    expectWithinAbsoluteError(expected[i], buffer[index] + t * (buffer[index + 1] - buffer[index]), kEpsilon);
+  }
+
+  vital::mono_float result[kSize];
+  for (int i = 0; i < vital::kernels::kNumIsas; ++i) {
+    vital::kernels::Isa isa = static_cast<vital::kernels::Isa>(i);
+    if (!vital::kernels::isSupported(isa))
+      continue;
+
+    vital::kernels::getTable(isa).interpolate(result, buffer, phases, kFractionBits, kSize);
+    for (int s = 0; s < kSize; ++s)
+      expectWithinAbsoluteError(result[s], expected[s], kEpsilon);
+  }
+}
+
+void DspKernelsTest::testHalfband() {
+  beginTest("Halfband");
+  static constexpr int kStride = vital::kernels::kFrameSize;
+  static constexpr int kNumFrames = 2 * kNumOutputs + kNumTaps;
+
+  Random random(3);
+  vital::mono_float taps[kNumTaps];
+  for (int i = 0; i < kNumTaps; ++i)
+    taps[i] = random.nextFloat() - 0.5f;
+
+  vital::mono_float source[kNumFrames * kStride];
+  for (int i = 0; i < kNumFrames * kStride; ++i)
+    source[i] = random.nextFloat() * 2.0f - 1.0f;
+
+  vital::mono_float result[kNumOutputs * kStride];
+  for (int i = 0; i < vital::kernels::kNumIsas; ++i) {
+    vital::kernels::Isa isa = static_cast<vital::kernels::Isa>(i);
+    if (!vital::kernels::isSupported(isa))
+      continue;
+
+    for (int num_taps : { kNumTaps, kNumTaps - 1 }) {
+      vital::kernels::getTable(isa).halfband(result, source, kStride, taps, num_taps, kNumOutputs);
+      for (int o = 0; o < kNumOutputs; ++o) {
+        for (int c = 0; c < 2; ++c) {
+          float expected = 0.0f;
+          for (int t = 0; t < num_taps; ++t)
+            expected += taps[t] * source[(2 * o + t) * kStride + c];
+
+          expectWithinAbsoluteError(result[o * kStride + c], expected, kEpsilon);
+          expectWithinAbsoluteError(result[o * kStride + c + 2], expected, kEpsilon);
+        }
+      }
+    }
+  }
+}
+
+void DspKernelsTest::testPolyphase() {
+  beginTest("Polyphase");
+  static constexpr int kCenterOffset = kNumTaps / 2;
+  static constexpr int kNumPairs = kNumOutputs + kNumTaps;
+  static constexpr float kCenter = 0.5f;
+
+  Random random(4);
+  vital::mono_float taps[kNumTaps];
+  for (int i = 0; i < kNumTaps; ++i)
+    taps[i] = random.nextFloat() - 0.5f;
+
+  vital::mono_float source[2 * kNumPairs];
+  vital::mono_float center_source[2 * kNumPairs];
+  for (int i = 0; i < 2 * kNumPairs; ++i) {
+    source[i] = random.nextFloat() * 2.0f - 1.0f;
+    center_source[i] = random.nextFloat() * 2.0f - 1.0f;
+  }
+
+  vital::mono_float result[2 * kNumOutputs + 1];
+  for (int i = 0; i < vital::kernels::kNumIsas; ++i) {
+    vital::kernels::Isa isa = static_cast<vital::kernels::Isa>(i);
+    if (!vital::kernels::isSupported(isa))
+      continue;
+
+    for (int num_outputs : { kNumOutputs, 16, 3 }) {
+      result[2 * num_outputs] = 1.0f;
+      vital::kernels::getTable(isa).polyphase(result, source, center_source, taps, kNumTaps,
+                                              kCenter, kCenterOffset, num_outputs);
+      for (int o = 0; o < num_outputs; ++o) {
+        for (int c = 0; c < 2; ++c) {
+          float expected = kCenter * center_source[2 * (o + kCenterOffset) + c];
+          for (int t = 0; t < kNumTaps; ++t)
+            expected += taps[t] * source[2 * (o + t) + c];
+
+          expectWithinAbsoluteError(result[2 * o + c], expected, kEpsilon);
+        }
+      }
+      expect(result[2 * num_outputs] == 1.0f);
+    }
+  }
+}
+
+static DspKernelsTest dsp_kernels_test;
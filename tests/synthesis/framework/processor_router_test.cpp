@@ -0,0 +1,122 @@
+/* Copyright 2013-2019 Matt Tytel
+ *
+ * vital is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * vital is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with vital.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "processor_router_test.h"
+#include "processor_router.h"
+
+namespace {
+  class OrderRecorder : public vital::Processor {
+    public:
+      OrderRecorder(int id, std::vector<int>* log, int* num_alive) :
+          vital::Processor(1, 1), id_(id), log_(log), num_alive_(num_alive) {
+        (*num_alive_)++;
+      }
+
+      OrderRecorder(const OrderRecorder& original) : vital::Processor(original), id_(original.id_),
+                                                     log_(original.log_), num_alive_(original.num_alive_) {
+        (*num_alive_)++;
+      }
+
+      ~OrderRecorder() { (*num_alive_)--; }
+
+      vital::Processor* clone() const override { return new OrderRecorder(*this); }
+      void process(int num_samples) override { log_->push_back(id_); }
+
+    private:
+      int id_;
+      std::vector<int>* log_;
+      int* num_alive_;
+  };
+} // namespace
+
+void ProcessorRouterTest::runTest() {
+  testCopiesFollowOrder();
+  testCopiesFollowRemoval();
+}
+
+void ProcessorRouterTest::testCopiesFollowOrder() {
+  beginTest("Copies Follow Order");
+
+  std::vector<int> log;
+  int num_alive = 0;
+  vital::ProcessorRouter router;
+  OrderRecorder* first = new OrderRecorder(0, &log, &num_alive);
+  OrderRecorder* second = new OrderRecorder(1, &log, &num_alive);
+  router.addProcessor(first);
+  router.addProcessor(second);
+
+  std::unique_ptr<vital::Processor> copy(router.clone());
+  copy->process(kNumSamples);
+  expect(log == std::vector<int>({ 0, 1 }));
+
+  OrderRecorder* third = new OrderRecorder(2, &log, &num_alive);
+  router.addProcessor(third);
+  first->plug(third);
+
+  log.clear();
+  copy->process(kNumSamples);
+  expect(log == std::vector<int>({ 2, 0, 1 }));
+  expect(num_alive == 6);
+}
+
+void ProcessorRouterTest::testCopiesFollowRemoval() {
+  beginTest("Copies Follow Removal");
+
+  std::vector<int> log;
+  int num_alive = 0;
+  vital::ProcessorRouter router;
+  OrderRecorder* first = new OrderRecorder(0, &log, &num_alive);
+  OrderRecorder* second = new OrderRecorder(1, &log, &num_alive);
+  OrderRecorder* third = new OrderRecorder(2, &log, &num_alive);
+  router.addProcessor(first);
+  router.addProcessor(second);
+  router.addProcessor(third);
+
+  std::unique_ptr<vital::Processor> copy(router.clone());
+  copy->process(kNumSamples);
+  expect(num_alive == 6);
+
+  router.removeProcessor(second);
+  delete second;
+  log.clear();
+  copy->process(kNumSamples);
+  expect(log == std::vector<int>({ 0, 2 }));
+  expect(num_alive == 4);
+
+  OrderRecorder* fourth = new OrderRecorder(3, &log, &num_alive);
+  router.addProcessor(fourth);
+  third->plug(fourth);
+  log.clear();
+  copy->process(kNumSamples);
+  expect(log == std::vector<int>({ 3, 2, 0 }));
+  expect(num_alive == 6);
+
+  for (int i = 0; i < 4; ++i) {
+    OrderRecorder* temporary = new OrderRecorder(4, &log, &num_alive);
+    router.addProcessor(temporary);
+    copy->process(kNumSamples);
+    router.removeProcessor(temporary);
+    delete temporary;
+    copy->process(kNumSamples);
+  }
+  expect(num_alive == 6);
+
+  log.clear();
+  copy->process(kNumSamples);
+  expect(log == std::vector<int>({ 3, 2, 0 }));
+}
+
+static ProcessorRouterTest processor_router_test;
@@ -0,0 +1,135 @@
+/* Copyright 2013-2019 Matt Tytel
+ *
+ * vital is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * vital is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with vital.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "voice_list_test.h"
+#include "voice_handler.h"
+
+namespace {
+  constexpr int kNumVoices = 40;
+
+  int compareLowestFirst(vital::Voice* left, vital::Voice* right) {
+    return right->state().note_count - left->state().note_count;
+  }
+
+  int compareValuesLowestFirst(int left, int right) {
+    return right - left;
+  }
+} // namespace
+
+void VoiceListTest::runTest() {
+  testAddingRemoving();
+  testRemovingWhileIterating();
+  testSorting();
+}
+
+void VoiceListTest::testAddingRemoving() {
+  beginTest("Adding and Removing");
+
+  vital::AggregateVoice aggregate_voice;
+  std::vector<std::unique_ptr<vital::Voice>> voices;
+  vital::VoiceList list;
+  vital::VoiceList other_list;
+  for (int i = 0; i < kNumVoices; ++i) {
+    voices.push_back(std::make_unique<vital::Voice>(&aggregate_voice));
+    list.push_back(voices[i].get());
+    expect(list.size() == i + 1);
+    expect(list.back() == voices[i].get());
+  }
+
+  expect(list.front() == voices[0].get());
+  for (auto& voice : voices)
+    expect(list.contains(voice.get()));
+
+  vital::Voice* middle = voices[kNumVoices / 2].get();
+  list.remove(middle);
+  expect(!list.contains(middle));
+  expect(list.size() == kNumVoices - 1);
+
+  other_list.push_front(middle);
+  expect(other_list.contains(middle));
+  list.remove(middle);
+  expect(other_list.contains(middle));
+  expect(list.size() == kNumVoices - 1);
+
+  int index = 0;
+  for (vital::Voice* voice : list) {
+    if (index == kNumVoices / 2)
+      index++;
+    expect(voice == voices[index].get());
+    index++;
+  }
+  expect(index == kNumVoices);
+
+  while (list.size())
+    list.pop_front();
+  expect(list.front() == nullptr);
+  expect(list.back() == nullptr);
+}
+
+void VoiceListTest::testRemovingWhileIterating() {
+  beginTest("Removing While Iterating");
+
+  vital::AggregateVoice aggregate_voice;
+  std::vector<std::unique_ptr<vital::Voice>> voices;
+  vital::VoiceList list;
+  for (int i = 0; i < kNumVoices; ++i) {
+    voices.push_back(std::make_unique<vital::Voice>(&aggregate_voice));
+    list.push_back(voices[i].get());
+  }
+
+  int visited = 0;
+  for (vital::Voice* voice : list) {
+    if (visited % 2)
+      list.remove(voice);
+    visited++;
+  }
+
+  expect(visited == kNumVoices);
+  expect(list.size() == kNumVoices / 2);
+  for (int i = 0; i < kNumVoices; ++i)
+    expect(list.contains(voices[i].get()) == (i % 2 == 0));
+}
+
+void VoiceListTest::testSorting() {
+  beginTest("Sorting Matches Circular Queue");
+
+  vital::AggregateVoice aggregate_voice;
+  std::vector<std::unique_ptr<vital::Voice>> voices;
+  vital::VoiceList list;
+  vital::CircularQueue<int> queue;
+  queue.reserve(kNumVoices);
+  Random random(1);
+  for (int i = 0; i < kNumVoices; ++i) {
+    int note_count = random.nextInt(kNumVoices / 4);
+    voices.push_back(std::make_unique<vital::Voice>(&aggregate_voice));
+    voices[i]->activate(0, 0.0f, 1.0f, 0.0f, 0, note_count, 0, 0);
+    list.push_back(voices[i].get());
+    queue.push_back(note_count);
+  }
+
+  list.sort<compareLowestFirst>();
+  queue.sort<compareValuesLowestFirst>();
+
+  int index = 0;
+  for (vital::Voice* voice : list) {
+    expect(voice->state().note_count == queue[index]);
+    index++;
+  }
+  expect(index == kNumVoices);
+  expect(list.size() == kNumVoices);
+}
+
+static VoiceListTest voice_list_test;
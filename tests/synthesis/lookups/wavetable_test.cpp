@@ -0,0 +1,77 @@
+/* Copyright 2013-2019 Matt Tytel
+ *
+ * vital is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * vital is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with vital.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "wavetable_test.h"
+#include "synth_oscillator.h"
+#include "wavetable.h"
+
+void WavetableTest::runTest() {
+  testMipLevelSelection();
+  testMipLevelsMatchPassthrough();
+}
+
+void WavetableTest::testMipLevelSelection() {
+  static constexpr float kHalfOctave = 1.41422f;
+
+  beginTest("Mip Level Selection");
+
+  for (int last_harmonic = 0; last_harmonic < vital::Wavetable::kMinMipHarmonics; ++last_harmonic)
+    expect(vital::Wavetable::getMipLevel(last_harmonic) == -1);
+
+  expect(vital::Wavetable::getMipHarmonics(vital::Wavetable::kNumMipLevels - 1) == vital::kNumHarmonics - 1);
+  for (int last_harmonic = vital::Wavetable::kMinMipHarmonics; last_harmonic < vital::kNumHarmonics; ++last_harmonic) {
+    int level = vital::Wavetable::getMipLevel(last_harmonic);
+    expect(level >= 0 && level < vital::Wavetable::kNumMipLevels);
+
+    int harmonics = vital::Wavetable::getMipHarmonics(level);
+    expect(harmonics <= last_harmonic, "Mip level holds harmonics that would alias.");
+    expect(harmonics * kHalfOctave > last_harmonic, "Mip level dropped more than half an octave.");
+  }
+}
+
+void WavetableTest::testMipLevelsMatchPassthrough() {
+  static constexpr float kMaxError = 0.0001f;
+  static constexpr int kBufferSize = 2 * vital::Wavetable::kWaveformSize / vital::poly_float::kSize +
+                                     vital::poly_float::kSize;
+
+  beginTest("Mip Levels Match Passthrough");
+
+  vital::WaveFrame wave_frame;
+  for (int i = 0; i < vital::WaveFrame::kWaveformSize; ++i)
+    wave_frame.time_domain[i] = (2.0f * rand()) / RAND_MAX - 1.0f;
+  wave_frame.toFrequencyDomain();
+
+  vital::Wavetable wavetable(1);
+  wavetable.loadWaveFrame(&wave_frame);
+  const vital::Wavetable::WavetableData* data = wavetable.getAllData();
+  vital::FourierTransform* transform = vital::FFT<vital::Wavetable::kFrequencyBins>::transform();
+
+  for (int level = 0; level < vital::Wavetable::kNumMipLevels; ++level) {
+    vital::poly_float passthrough[kBufferSize] = {};
+    vital::passthroughMorph(data, 0, passthrough, transform, 0.0f,
+                            vital::Wavetable::getMipHarmonics(level), nullptr);
+
+    const vital::mono_float* expected = ((vital::mono_float*)passthrough) + vital::poly_float::kSize - 1;
+    const vital::mono_float* mip = vital::Wavetable::getMipBuffer(data, 0, level);
+    float max_error = 0.0f;
+    for (int i = 0; i < vital::Wavetable::kWaveformSize + vital::Wavetable::kExtraValues; ++i)
+      max_error = std::max(max_error, std::abs(mip[i] - expected[i]));
+
+    expect(max_error < kMaxError, "Mip level " + String(level) + " differs from passthrough by " + String(max_error));
+  }
+}
+
+static WavetableTest wavetable_test;
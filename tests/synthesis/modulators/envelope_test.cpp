@@ -16,10 +16,70 @@
 
 #include "envelope_test.h"
 #include "envelope.h"
+#include "value.h"
 
 void EnvelopeTest::runTest() {
   vital::Envelope envelope;
   runInputBoundsTest(&envelope);
+  runSubRateTest(vital::constants::kLinearSubRate);
+  runSubRateTest(vital::constants::kCubicSubRate);
+}
+
+void EnvelopeTest::runSubRateTest(int interpolation) {
+  beginTest(interpolation == vital::constants::kCubicSubRate ? "Sub Rate Error Cubic" : "Sub Rate Error Linear");
+
+  vital::Envelope full_rate;
+  vital::Envelope sub_rate;
+
+  vital::Output trigger;
+  vital::Value zero(0.0f);
+  vital::Value sub_rate_amount(vital::constants::kHalfRateModulators);
+  vital::Value sub_rate_interpolation(interpolation);
+  vital::Value attack(0.01f);
+  vital::Value decay(0.5f);
+  vital::Value sustain(0.3f);
+  vital::Value release(0.2f);
+  vital::Value power(-4.0f);
+
+  vital::Envelope* envelopes[] = { &full_rate, &sub_rate };
+  for (vital::Envelope* envelope : envelopes) {
+    for (int i = 0; i < vital::Envelope::kNumInputs; ++i)
+      envelope->plug(&zero, i);
+    envelope->plug(&attack, vital::Envelope::kAttack);
+    envelope->plug(&decay, vital::Envelope::kDecay);
+    envelope->plug(&power, vital::Envelope::kDecayPower);
+    envelope->plug(&sustain, vital::Envelope::kSustain);
+    envelope->plug(&release, vital::Envelope::kRelease);
+    envelope->plug(&power, vital::Envelope::kReleasePower);
+    envelope->plug(&trigger, vital::Envelope::kTrigger);
+    envelope->setControlRate(false);
+    envelope->setSampleRate(vital::kDefaultSampleRate);
+    envelope->setOversampleAmount(kOversampleAmount);
+  }
+  sub_rate.plug(&sub_rate_amount, vital::Envelope::kSubRate);
+  sub_rate.plug(&sub_rate_interpolation, vital::Envelope::kSubRateInterpolation);
+  expect(full_rate.getSubRateSamples() == 1);
+  expect(sub_rate.getSubRateSamples() > 1);
+
+  int num_samples = vital::kMaxBufferSize * kOversampleAmount;
+  float max_error = 0.0f;
+  for (int b = 0; b < kNumBlocks; ++b) {
+    if (b == 0)
+      trigger.trigger(vital::constants::kFullMask, vital::kVoiceOn, 0);
+    else if (b == kNumBlocks / 2)
+      trigger.trigger(vital::constants::kFullMask, vital::kVoiceOff, 0);
+
+    full_rate.process(num_samples);
+    sub_rate.process(num_samples);
+    trigger.clearTrigger();
+
+    const vital::poly_float* full_buffer = full_rate.output()->buffer;
+    const vital::poly_float* sub_buffer = sub_rate.output()->buffer;
+    for (int i = 0; i < num_samples; ++i)
+      max_error = std::max(max_error, vital::utils::maxFloat(vital::poly_float::abs(full_buffer[i] - sub_buffer[i])));
+  }
+
+  expect(max_error < kMaxSubRateError);
 }
 
 static EnvelopeTest envelope_test;
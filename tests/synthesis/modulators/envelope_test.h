@@ -20,7 +20,12 @@
 
 class EnvelopeTest : public ProcessorTest {
   public:
+    static constexpr float kMaxSubRateError = 0.001f;
+    static constexpr int kOversampleAmount = 8;
+    static constexpr int kNumBlocks = 200;
+
     EnvelopeTest() : ProcessorTest("Envelope") { }
     void runTest() override;
+    void runSubRateTest(int interpolation);
 };
 
@@ -17,6 +17,7 @@
 #include "synth_lfo_test.h"
 #include "synth_lfo.h"
 #include "line_generator.h"
+#include "value.h"
 
 void SynthLfoTest::runTest() {
   LineGenerator line_source;
@@ -25,6 +26,111 @@ void SynthLfoTest::runTest() {
   std::set<int> ignored_outputs;
   ignored_outputs.insert(vital::SynthLfo::kOscPhase);
   runInputBoundsTest(&synth_lfo, ignored_inputs, ignored_outputs);
+  runSubRateTest(vital::constants::kLinearSubRate);
+  runSubRateTest(vital::constants::kCubicSubRate);
+  runSharedEvaluationTest();
+}
+
+void SynthLfoTest::runSubRateTest(int interpolation) {
+  beginTest(interpolation == vital::constants::kCubicSubRate ? "Sub Rate Error Cubic" : "Sub Rate Error Linear");
+
+  LineGenerator line_source;
+  line_source.initSin();
+  vital::SynthLfo full_rate(&line_source);
+  vital::SynthLfo sub_rate(&line_source);
+
+  vital::Output trigger;
+  vital::Value frequency(3.0f);
+  vital::Value zero(0.0f);
+  vital::Value sub_rate_amount(vital::constants::kHalfRateModulators);
+  vital::Value sub_rate_interpolation(interpolation);
+  vital::Value one(1.0f);
+
+  vital::SynthLfo* lfos[] = { &full_rate, &sub_rate };
+  for (vital::SynthLfo* lfo : lfos) {
+    for (int i = 0; i < vital::SynthLfo::kNumInputs; ++i)
+      lfo->plug(&zero, i);
+    lfo->plug(&frequency, vital::SynthLfo::kFrequency);
+    lfo->plug(&one, vital::SynthLfo::kAmplitude);
+    lfo->plug(&trigger, vital::SynthLfo::kNoteTrigger);
+    lfo->setControlRate(false);
+    lfo->setSampleRate(vital::kDefaultSampleRate);
+    lfo->setOversampleAmount(kOversampleAmount);
+  }
+  sub_rate.plug(&sub_rate_amount, vital::SynthLfo::kSubRate);
+  sub_rate.plug(&sub_rate_interpolation, vital::SynthLfo::kSubRateInterpolation);
+  expect(full_rate.getSubRateSamples() == 1);
+  expect(sub_rate.getSubRateSamples() > 1);
+
+  int num_samples = vital::kMaxBufferSize * kOversampleAmount;
+  float max_error = 0.0f;
+  for (int b = 0; b < kNumBlocks; ++b) {
+    full_rate.process(num_samples);
+    sub_rate.process(num_samples);
+
+    const vital::poly_float* full_buffer = full_rate.output()->buffer;
+    const vital::poly_float* sub_buffer = sub_rate.output()->buffer;
+    for (int i = 0; i < num_samples; ++i)
+      max_error = std::max(max_error, vital::utils::maxFloat(vital::poly_float::abs(full_buffer[i] - sub_buffer[i])));
+  }
+
+  expect(max_error < kMaxSubRateError);
+}
+
+void SynthLfoTest::runSharedEvaluationTest() {
+  beginTest("Shared Evaluation Matches Per Voice");
+
+  LineGenerator line_source;
+  line_source.initSin();
+  vital::SynthLfo per_voice(&line_source);
+  vital::SynthLfo shared(&line_source);
+
+  vital::Output trigger;
+  vital::Value frequency(2.5f);
+  vital::Value sync_type(vital::SynthLfo::kSync);
+  vital::Value zero(0.0f);
+  vital::Value one(1.0f);
+
+  vital::SynthLfo* lfos[] = { &per_voice, &shared };
+  for (vital::SynthLfo* lfo : lfos) {
+    for (int i = 0; i < vital::SynthLfo::kNumInputs; ++i)
+      lfo->plug(&zero, i);
+    lfo->plug(&frequency, vital::SynthLfo::kFrequency);
+    lfo->plug(&one, vital::SynthLfo::kAmplitude);
+    lfo->plug(&sync_type, vital::SynthLfo::kSyncType);
+    lfo->plug(&trigger, vital::SynthLfo::kNoteTrigger);
+    lfo->setControlRate(false);
+    lfo->setSampleRate(vital::kDefaultSampleRate);
+    lfo->correctToTime(1.3);
+  }
+
+  // Voice clones share their output buffers so the second clone should leave the first clone's result alone.
+  std::unique_ptr<vital::Processor> first_voice(shared.clone());
+  std::unique_ptr<vital::Processor> second_voice(shared.clone());
+  shared.setShared(true);
+
+  int num_samples = vital::kMaxBufferSize;
+  float max_error = 0.0f;
+  trigger.trigger(vital::constants::kFullMask, vital::kVoiceOn, 0);
+  for (int b = 0; b < kNumBlocks; ++b) {
+    if (b == kNumBlocks / 2)
+      shared.setShared(false);
+
+    shared.advanceSharedBlock();
+    per_voice.process(num_samples);
+    first_voice->process(num_samples);
+    second_voice->process(num_samples);
+    trigger.clearTrigger();
+
+    const vital::poly_float* per_voice_buffer = per_voice.output()->buffer;
+    const vital::poly_float* shared_buffer = second_voice->output()->buffer;
+    for (int i = 0; i < num_samples; ++i) {
+      vital::poly_float error = vital::poly_float::abs(per_voice_buffer[i] - shared_buffer[i]);
+      max_error = std::max(max_error, vital::utils::maxFloat(error));
+    }
+  }
+
+  expect(max_error < kMaxSharedError);
 }
 
 static SynthLfoTest synth_lfo_test;
@@ -20,7 +20,14 @@
 
 class SynthLfoTest : public ProcessorTest {
   public:
+    static constexpr float kMaxSubRateError = 0.001f;
+    static constexpr int kOversampleAmount = 8;
+    static constexpr int kNumBlocks = 400;
+    static constexpr float kMaxSharedError = 0.00001f;
+
     SynthLfoTest() : ProcessorTest("Synth Lfo") { }
     void runTest() override;
+    void runSubRateTest(int interpolation);
+    void runSharedEvaluationTest();
 };
 
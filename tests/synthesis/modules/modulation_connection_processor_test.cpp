@@ -0,0 +1,188 @@
+/* Copyright 2013-2019 Matt Tytel
+ *
+ * vital is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * vital is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with vital.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "modulation_connection_processor_test.h"
+#include "modulation_connection_processor.h"
+#include "futils.h"
+#include "line_generator.h"
+#include "value.h"
+
+namespace {
+  constexpr int kNumSamples = vital::kMaxBufferSize;
+  constexpr float kDestinationScale = 2.0f;
+  constexpr float kAllowedError = 0.00001f;
+
+  const float kBlockPowers[] = { 0.0f, 0.0f, 2.5f, 2.5f, -3.0f, 1.0f, 1.0f, 0.0f, 0.0f };
+  const float kBlockAmounts[] = { 0.5f, -0.25f, 0.8f, 0.8f, -1.0f, 0.3f, 0.3f, 1.0f, 0.6f };
+
+  // The separate audio rate paths as they were before they were folded into processAudioRateMapped.
+  class LegacyConnection {
+    public:
+      LegacyConnection(const LineGenerator* map_generator, float bipolar, float stereo) :
+          map_generator_(map_generator), bipolar_(bipolar), stereo_(stereo), power_(0.0f), modulation_amount_(0.0f),
+          pre_scale_(0.0f) { }
+
+      void process(const vital::poly_float* source, vital::poly_float* dest, float amount, float power_value) {
+        vital::poly_float power = -power_value;
+        bool using_power = (vital::poly_float::notEqual(0.0f, power) |
+                            vital::poly_float::notEqual(0.0f, power_)).anyMask();
+        if (using_power)
+          processMorphed(source, dest, amount, power);
+        else
+          processLinear(source, dest, amount);
+        power_ = power;
+      }
+
+      vital::poly_float preScale() const { return pre_scale_; }
+
+    private:
+      vital::poly_float remap(vital::poly_float modulation_value) {
+        if (map_generator_->linear())
+          return modulation_value;
+
+        vital::mono_float* buffer = map_generator_->getCubicInterpolationBuffer();
+        vital::mono_float resolution = map_generator_->resolution();
+        vital::poly_float boost = vital::utils::clamp(modulation_value * resolution, 0.0f, resolution);
+        vital::poly_int indices = vital::utils::clamp(vital::utils::toInt(boost), 0, resolution - 1);
+        vital::poly_float t = boost - vital::utils::toFloat(indices);
+
+        vital::matrix interpolation_matrix = vital::utils::getCatmullInterpolationMatrix(t);
+        vital::matrix value_matrix = vital::utils::getValueMatrix(buffer, indices);
+
+        value_matrix.transpose();
+        return vital::utils::clamp(interpolation_matrix.multiplyAndSumRows(value_matrix), -1.0f, 1.0f);
+      }
+
+      void processLinear(const vital::poly_float* source, vital::poly_float* dest, float amount) {
+        vital::poly_float bipolar_offset = -bipolar_ * 0.5f;
+        vital::poly_float current_amount = modulation_amount_;
+        vital::poly_float stereo_scale = vital::poly_float(1.0f) - (vital::constants::kRightOne * 2.0f * stereo_);
+        vital::poly_float modulation_amount = vital::utils::clamp(vital::poly_float(amount), -1.0f, 1.0f) * stereo_scale;
+        modulation_amount_ = modulation_amount * kDestinationScale;
+        vital::poly_float delta_amount = (modulation_amount_ - current_amount) * (1.0f / kNumSamples);
+
+        for (int i = 0; i < kNumSamples; ++i) {
+          current_amount += delta_amount;
+          dest[i] = (remap(source[i]) + bipolar_offset) * current_amount;
+        }
+
+        pre_scale_ = (source[0] + bipolar_offset) * modulation_amount;
+      }
+
+      void processMorphed(const vital::poly_float* source, vital::poly_float* dest, float amount,
+                          vital::poly_float power) {
+        vital::poly_float bipolar = bipolar_;
+        vital::poly_float polarity_pre_scale = bipolar + 1.0f;
+        vital::poly_float polarity_post_scale = -bipolar * 0.5f + 1.0f;
+        polarity_post_scale *= vital::poly_float(1.0f) - (vital::constants::kRightOne * 2.0f * stereo_);
+
+        vital::poly_float current_amount = modulation_amount_;
+        vital::poly_float current_power = power_;
+        modulation_amount_ = vital::utils::clamp(vital::poly_float(amount), -1.0f, 1.0f) * kDestinationScale;
+
+        float sample_inc = 1.0f / kNumSamples;
+        vital::poly_float delta_amount = (modulation_amount_ - current_amount) * sample_inc;
+        vital::poly_float delta_power = (power - current_power) * sample_inc;
+
+        for (int i = 0; i < kNumSamples; ++i) {
+          current_amount += delta_amount;
+          current_power += delta_power;
+
+          vital::poly_float modulation_shift = remap(source[i]) * polarity_pre_scale - bipolar;
+          vital::poly_float modulation_abs = vital::poly_float::abs(modulation_shift);
+          vital::poly_mask sign_mask = vital::poly_float::sign_mask(modulation_shift);
+
+          vital::poly_float shifted_modulation = vital::futils::powerScale(modulation_abs, current_power);
+          vital::poly_float pre_modulation = current_amount * shifted_modulation;
+          dest[i] = (pre_modulation ^ sign_mask) * polarity_post_scale;
+        }
+
+        pre_scale_ = dest[0] * (1.0f / kDestinationScale);
+      }
+
+      const LineGenerator* map_generator_;
+      float bipolar_;
+      float stereo_;
+      vital::poly_float power_;
+      vital::poly_float modulation_amount_;
+      vital::poly_float pre_scale_;
+  };
+
+  bool closeTo(vital::poly_float expected, vital::poly_float value) {
+    vital::poly_float allowed = vital::utils::max(vital::poly_float::abs(expected), 1.0f) * kAllowedError;
+    return vital::poly_float::greaterThan(vital::poly_float::abs(expected - value), allowed).anyMask() == 0;
+  }
+} // namespace
+
+void ModulationConnectionProcessorTest::runTest() {
+  for (int remap = 0; remap < 2; ++remap) {
+    testAudioRatePaths(remap, false, false);
+    testAudioRatePaths(remap, true, false);
+    testAudioRatePaths(remap, true, true);
+  }
+}
+
+void ModulationConnectionProcessorTest::testAudioRatePaths(bool remap, bool bipolar, bool stereo) {
+  beginTest(String("Audio Rate Matches Legacy Paths") + (remap ? " Remapped" : "") +
+            (bipolar ? " Bipolar" : "") + (stereo ? " Stereo" : ""));
+
+  vital::ModulationConnectionProcessor connection(0);
+  connection.init();
+  connection.setControlRate(false);
+  connection.setBipolar(bipolar);
+  connection.setStereo(stereo);
+  connection.setDestinationScale(kDestinationScale);
+  if (remap)
+    connection.lineMapGenerator()->initSin();
+
+  vital::Output source;
+  vital::Output reset(1);
+  vital::Value amount;
+  vital::Value power;
+  connection.plug(&source, vital::ModulationConnectionProcessor::kModulationInput);
+  connection.plug(&amount, vital::ModulationConnectionProcessor::kModulationAmount);
+  connection.plug(&power, vital::ModulationConnectionProcessor::kModulationPower);
+  connection.plug(&reset, vital::ModulationConnectionProcessor::kReset);
+
+  LegacyConnection legacy(connection.lineMapGenerator(), bipolar ? 1.0f : 0.0f, stereo ? 1.0f : 0.0f);
+  vital::poly_float expected[kNumSamples];
+  const vital::Output* modulation_output = connection.output(vital::ModulationConnectionProcessor::kModulationOutput);
+  const vital::Output* pre_scale_output = connection.output(vital::ModulationConnectionProcessor::kModulationPreScale);
+
+  int num_blocks = sizeof(kBlockPowers) / sizeof(kBlockPowers[0]);
+  bool matches = true;
+  for (int b = 0; b < num_blocks; ++b) {
+    for (int i = 0; i < kNumSamples; ++i) {
+      float phase = (b * kNumSamples + i) * 0.013f;
+      source.buffer[i] = vital::poly_float(0.5f + 0.5f * sinf(phase), 0.5f + 0.5f * cosf(phase),
+                                           fmodf(phase, 1.0f), 0.25f);
+    }
+    source.trigger_value = source.buffer[0];
+
+    amount.set(kBlockAmounts[b]);
+    power.set(kBlockPowers[b]);
+    connection.process(kNumSamples);
+    legacy.process(source.buffer, expected, kBlockAmounts[b], kBlockPowers[b]);
+
+    for (int i = 0; i < kNumSamples; ++i)
+      matches = matches && closeTo(expected[i], modulation_output->buffer[i]);
+    matches = matches && closeTo(legacy.preScale(), pre_scale_output->buffer[0]);
+  }
+
+  expect(matches);
+}
+
+static ModulationConnectionProcessorTest modulation_connection_processor_test;
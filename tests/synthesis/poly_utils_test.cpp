@@ -45,6 +45,34 @@ void PolyUtilsTest::runTest() {
   for (int i = 0; i < vital::poly_float::kSize; ++i)
     expect(reverse[i] == vital::poly_float::kSize - 1 - i);
 
+  beginTest("Hadamard Transform");
+  static constexpr int kMaxHadamardSize = 16;
+  for (int size = 1; size <= kMaxHadamardSize; size *= 2) {
+    int num_values = size * vital::poly_float::kSize;
+    vital::poly_float values[kMaxHadamardSize];
+    for (int i = 0; i < size; ++i) {
+      for (int v = 0; v < vital::poly_float::kSize; ++v)
+        values[i].set(v, (i * vital::poly_float::kSize + v) % 7 - 3.0f);
+    }
+
+    vital::poly_float transformed[kMaxHadamardSize];
+    for (int i = 0; i < size; ++i)
+      transformed[i] = values[i];
+    vital::utils::hadamardTransform(transformed, size);
+
+    for (int row = 0; row < num_values; ++row) {
+      vital::mono_float expected = 0.0f;
+      for (int column = 0; column < num_values; ++column) {
+        vital::mono_float sign = 1.0f;
+        for (int bits = row & column; bits; bits &= bits - 1)
+          sign = -sign;
+        expected += sign * values[column / vital::poly_float::kSize][column % vital::poly_float::kSize];
+      }
+      vital::mono_float result = transformed[row / vital::poly_float::kSize][row % vital::poly_float::kSize];
+      expectWithinAbsoluteError<vital::mono_float>(result, expected, EPSILON);
+    }
+  }
+
   beginTest("Mid Side Encoding");
   vital::poly_float encode_mid_side = vital::utils::encodeMidSide(test_value);
   vital::poly_float decode_mid_side = vital::utils::decodeMidSide(encode_mid_side);
@@ -67,6 +95,28 @@ void PolyUtilsTest::runTest() {
   expect(int_combine[1] == 2);
   expect(int_combine[2] == (unsigned int)-20);
   expect(int_combine[3] == 50);
+
+  beginTest("Zero And Copy Buffers");
+  static constexpr int kMaxBufferFloats = 2 * vital::kernels::kMinZeroKernelSize;
+  vital::mono_float source[kMaxBufferFloats + 1];
+  vital::mono_float dest[kMaxBufferFloats + 1];
+  for (int i = 0; i <= kMaxBufferFloats; ++i)
+    source[i] = i + 1.0f;
+
+  for (int size = 1; size <= kMaxBufferFloats; size += size / 2 + 1) {
+    for (int i = 0; i <= kMaxBufferFloats; ++i)
+      dest[i] = -1.0f;
+
+    vital::utils::copyBuffer(dest, source, size);
+    for (int i = 0; i < size; ++i)
+      expect(dest[i] == source[i]);
+    expect(dest[size] == -1.0f);
+
+    vital::utils::zeroBuffer(dest, size);
+    for (int i = 0; i < size; ++i)
+      expect(dest[i] == 0.0f);
+    expect(dest[size] == -1.0f);
+  }
 }
 
 static PolyUtilsTest poly_utils_test;
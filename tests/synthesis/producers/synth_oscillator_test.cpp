@@ -16,13 +16,214 @@
 
 #include "synth_oscillator_test.h"
 #include "synth_oscillator.h"
+#include "value.h"
 #include "wavetable.h"
 
+namespace {
+  class OscillatorRig {
+    public:
+      static constexpr int kNumHarmonics = 8;
+      static constexpr int kNumFrames = 4;
+
+      OscillatorRig(int unison, float detune, float blend, bool two_voices, bool culling) :
+          wavetable_(vital::kNumOscillatorWaveFrames), inputs_(vital::SynthOscillator::kNumInputs) {
+        wavetable_.setNumFrames(kNumFrames);
+        for (int f = 0; f < kNumFrames; ++f) {
+          vital::WaveFrame wave_frame;
+          wave_frame.index = f;
+          for (int i = 0; i < vital::WaveFrame::kWaveformSize; ++i) {
+            float t = (1.0f * i) / vital::WaveFrame::kWaveformSize;
+            for (int h = 1; h <= kNumHarmonics; ++h)
+              wave_frame.time_domain[i] += sinf(2.0f * vital::kPi * h * t + f * h) / (h + f * (h - 1));
+          }
+          wave_frame.toFrequencyDomain();
+          wavetable_.loadWaveFrame(&wave_frame);
+        }
+
+        oscillator_ = std::make_unique<vital::SynthOscillator>(&wavetable_);
+        for (int i = 0; i < vital::SynthOscillator::kNumInputs; ++i)
+          oscillator_->plug(&inputs_[i], i);
+        oscillator_->plug(&reset_, vital::SynthOscillator::kReset);
+        oscillator_->plug(&retrigger_, vital::SynthOscillator::kRetrigger);
+
+        inputs_[vital::SynthOscillator::kMidiNote].set(vital::poly_float(48.0f, 55.0f));
+        inputs_[vital::SynthOscillator::kMidiTrack].set(1.0f);
+        inputs_[vital::SynthOscillator::kAmplitude].set(1.0f);
+        inputs_[vital::SynthOscillator::kUnisonVoices].set(unison);
+        inputs_[vital::SynthOscillator::kUnisonDetune].set(detune);
+        inputs_[vital::SynthOscillator::kBlend].set(blend);
+        inputs_[vital::SynthOscillator::kStereoSpread].set(1.0f);
+        inputs_[vital::SynthOscillator::kDetunePower].set(1.5f);
+        inputs_[vital::SynthOscillator::kDetuneRange].set(2.0f);
+        inputs_[vital::SynthOscillator::kPhase].set(0.5f);
+        inputs_[vital::SynthOscillator::kSpectralUnison].set(1.0f);
+        inputs_[vital::SynthOscillator::kUnisonCulling].set(culling ? 1.0f : 0.0f);
+        if (two_voices)
+          inputs_[vital::SynthOscillator::kActiveVoices].set(1.0f);
+        else
+          inputs_[vital::SynthOscillator::kActiveVoices].set(vital::poly_float(1.0f, 1.0f, 0.0f, 0.0f));
+      }
+
+      vital::Value& input(int index) { return inputs_[index]; }
+      void setFusedProcessing(bool fused) { oscillator_->setFusedProcessing(fused); }
+      void setSpectralFrameCaching(bool caching) { oscillator_->setSpectralFrameCaching(caching); }
+      bool hasSpectralFrameCache() const { return oscillator_->hasSpectralFrameCache(); }
+
+      const vital::poly_float* process() {
+        if (first_block_)
+          reset_.trigger(vital::constants::kFullMask, vital::kVoiceOn, 0);
+        oscillator_->process(vital::kMaxBufferSize);
+        reset_.clearTrigger();
+        first_block_ = false;
+        return oscillator_->output(vital::SynthOscillator::kLevelled)->buffer;
+      }
+
+    private:
+      vital::Wavetable wavetable_;
+      std::vector<vital::Value> inputs_;
+      vital::Output reset_;
+      vital::Output retrigger_;
+      std::unique_ptr<vital::SynthOscillator> oscillator_;
+      bool first_block_ = true;
+  };
+} // namespace
+
 void SynthOscillatorTest::runTest() {
   vital::Wavetable wavetable(vital::kNumOscillatorWaveFrames);
 
   std::unique_ptr<vital::SynthOscillator> osc = std::make_unique<vital::SynthOscillator>(&wavetable);
   // runInputBoundsTest(osc.get());
+
+  for (bool two_voices : { false, true }) {
+    runUnisonCullingTest(8, 0.0f, 0.8f, two_voices);
+    runUnisonCullingTest(7, 0.0f, 0.5f, two_voices);
+    runUnisonCullingTest(16, 4.47f, 0.0f, two_voices);
+    runUnisonCullingTest(4, 4.47f, 0.8f, two_voices);
+  }
+
+  for (bool fading : { false, true }) {
+    for (bool two_voices : { false, true }) {
+      for (int unison : { 1, 2, 4, 8, 16 })
+        runFusedKernelTest(unison, two_voices, fading);
+    }
+  }
+
+  for (bool two_voices : { false, true }) {
+    runSpectralFrameCacheTest(vital::SynthOscillator::kNoSpectralMorph, two_voices);
+    runSpectralFrameCacheTest(vital::SynthOscillator::kVocode, two_voices);
+    runSpectralFrameCacheTest(vital::SynthOscillator::kSmear, two_voices);
+    runSpectralFrameCacheTest(vital::SynthOscillator::kLowPass, two_voices);
+    runSpectralFrameCacheTest(vital::SynthOscillator::kHighPass, two_voices);
+    runSpectralFrameCacheTest(vital::SynthOscillator::kRandomAmplitudes, two_voices);
+  }
+}
+
+void SynthOscillatorTest::runUnisonCullingTest(int unison, float detune, float blend, bool two_voices) {
+  static constexpr int kNumBlocks = 64;
+  static constexpr int kChangeBlock = kNumBlocks / 2;
+  static constexpr float kMaxError = 0.0001f;
+
+  beginTest("Unison Culling Matches Full Render " + String(unison) + " voices, detune " + String(detune) +
+            ", blend " + String(blend) + (two_voices ? ", two notes" : ", one note"));
+
+  OscillatorRig full(unison, detune, blend, two_voices, false);
+  OscillatorRig culled(unison, detune, blend, two_voices, true);
+
+  float max_error = 0.0f;
+  float max_peak = 0.0f;
+  for (int b = 0; b < kNumBlocks; ++b) {
+    if (b == kChangeBlock) {
+      full.input(vital::SynthOscillator::kUnisonDetune).set(detune + 1.0f);
+      culled.input(vital::SynthOscillator::kUnisonDetune).set(detune + 1.0f);
+      full.input(vital::SynthOscillator::kBlend).set(0.8f);
+      culled.input(vital::SynthOscillator::kBlend).set(0.8f);
+    }
+
+    const vital::poly_float* full_out = full.process();
+    const vital::poly_float* culled_out = culled.process();
+    for (int i = 0; i < vital::kMaxBufferSize; ++i) {
+      max_error = std::max(max_error, vital::utils::maxFloat(vital::poly_float::abs(full_out[i] - culled_out[i])));
+      max_peak = std::max(max_peak, vital::utils::maxFloat(vital::poly_float::abs(full_out[i])));
+    }
+  }
+
+  expect(max_peak > 0.0f);
+  expect(max_error < kMaxError * max_peak, "Culled unison differs from the full render by " + String(max_error));
+}
+
+void SynthOscillatorTest::runFusedKernelTest(int unison, bool two_voices, bool fading) {
+  static constexpr int kNumBlocks = 32;
+  static constexpr float kMaxError = 0.00001f;
+
+  beginTest("Fused Kernels Match Generic Path " + String(unison) + " voices" +
+            (two_voices ? ", two notes" : ", one note") + (fading ? ", fading" : ", static"));
+
+  OscillatorRig fused(unison, 2.0f, 0.8f, two_voices, false);
+  OscillatorRig generic(unison, 2.0f, 0.8f, two_voices, false);
+  generic.setFusedProcessing(false);
+
+  float max_error = 0.0f;
+  float max_peak = 0.0f;
+  for (int b = 0; b < kNumBlocks; ++b) {
+    if (fading) {
+      float frame = b % OscillatorRig::kNumFrames;
+      fused.input(vital::SynthOscillator::kWaveFrame).set(frame);
+      generic.input(vital::SynthOscillator::kWaveFrame).set(frame);
+    }
+
+    const vital::poly_float* fused_out = fused.process();
+    const vital::poly_float* generic_out = generic.process();
+    for (int i = 0; i < vital::kMaxBufferSize; ++i) {
+      max_error = std::max(max_error, vital::utils::maxFloat(vital::poly_float::abs(fused_out[i] - generic_out[i])));
+      max_peak = std::max(max_peak, vital::utils::maxFloat(vital::poly_float::abs(generic_out[i])));
+    }
+  }
+
+  expect(max_peak > 0.0f);
+  expect(max_error < kMaxError * max_peak, "Fused kernels differ from the generic path by " + String(max_error));
+}
+
+void SynthOscillatorTest::runSpectralFrameCacheTest(vital::SynthOscillator::SpectralMorph morph, bool two_voices) {
+  static constexpr int kNumBlocks = 48;
+  static constexpr int kModulateBlock = kNumBlocks / 2;
+
+  beginTest("Spectral Frame Cache Matches Uncached Render, morph " + String(morph) +
+            (two_voices ? ", two notes" : ", one note"));
+
+  OscillatorRig cached(8, 2.0f, 0.8f, two_voices, false);
+  OscillatorRig uncached(8, 2.0f, 0.8f, two_voices, false);
+  uncached.setSpectralFrameCaching(false);
+  for (OscillatorRig* rig : { &cached, &uncached }) {
+    rig->input(vital::SynthOscillator::kSpectralMorphType).set(morph);
+    rig->input(vital::SynthOscillator::kSpectralMorphAmount).set(0.5f);
+    rig->input(vital::SynthOscillator::kUnisonFrameSpread).set(1.0f);
+  }
+
+  float max_error = 0.0f;
+  float max_peak = 0.0f;
+  for (int b = 0; b < kNumBlocks; ++b) {
+    float frame = (b / 4) % OscillatorRig::kNumFrames;
+    float morph_amount = b < kModulateBlock ? 0.5f : 0.5f + 0.4f * sinf(0.3f * b);
+    for (OscillatorRig* rig : { &cached, &uncached }) {
+      rig->input(vital::SynthOscillator::kWaveFrame).set(frame);
+      rig->input(vital::SynthOscillator::kSpectralMorphAmount).set(morph_amount);
+    }
+
+    const vital::poly_float* cached_out = cached.process();
+    const vital::poly_float* uncached_out = uncached.process();
+    for (int i = 0; i < vital::kMaxBufferSize; ++i) {
+      max_error = std::max(max_error, vital::utils::maxFloat(vital::poly_float::abs(cached_out[i] - uncached_out[i])));
+      max_peak = std::max(max_peak, vital::utils::maxFloat(vital::poly_float::abs(uncached_out[i])));
+    }
+  }
+
+  expect(max_peak > 0.0f);
+  expect(max_error == 0.0f, "Cached spectral frames differ from the uncached render by " + String(max_error));
+  expect(!uncached.hasSpectralFrameCache(), "Uncached oscillator allocated its frame cache");
+  if (morph == vital::SynthOscillator::kNoSpectralMorph)
+    expect(!cached.hasSpectralFrameCache(), "Frame cache allocated without a spectral morph");
+  else
+    expect(cached.hasSpectralFrameCache(), "Spectral morph didn't use the frame cache");
 }
 
 static SynthOscillatorTest synth_oscillator_test;
@@ -17,10 +17,14 @@
 #pragma once
 
 #include "processor_test.h"
+#include "synth_oscillator.h"
 
 class SynthOscillatorTest : public ProcessorTest {
   public:
     SynthOscillatorTest() : ProcessorTest("Synth Oscillator") { }
     void runTest() override;
+    void runUnisonCullingTest(int unison, float detune, float blend, bool two_voices);
+    void runFusedKernelTest(int unison, bool two_voices, bool fading);
+    void runSpectralFrameCacheTest(vital::SynthOscillator::SpectralMorph morph, bool two_voices);
 };
 
@@ -18,9 +18,13 @@
 #include "synthesis/processor_test.cpp"
 #include "synthesis/poly_utils_test.cpp"
 #include "synthesis/framework/circular_queue_test.cpp"
+#include "synthesis/framework/voice_list_test.cpp"
+#include "synthesis/framework/dsp_kernels_test.cpp"
 #include "synthesis/framework/matrix_test.cpp"
 #include "synthesis/framework/poly_values_test.cpp"
+#include "synthesis/framework/processor_router_test.cpp"
 #include "synthesis/lookups/wave_frame_test.cpp"
+#include "synthesis/lookups/wavetable_test.cpp"
 #include "synthesis/producers/synth_oscillator_test.cpp"
 #include "synthesis/producers/sample_source_test.cpp"
 #include "synthesis/effects/distortion_test.cpp"
@@ -28,6 +32,7 @@
 #include "synthesis/effects/phaser_test.cpp"
 #include "synthesis/effects/delay_test.cpp"
 #include "synthesis/effects/reverb_test.cpp"
+#include "synthesis/effects/convolution_test.cpp"
 #include "synthesis/filters/comb_filter_test.cpp"
 #include "synthesis/filters/decimator_test.cpp"
 #include "synthesis/filters/fir_halfband_decimator_test.cpp"
@@ -41,6 +46,7 @@
 #include "synthesis/filters/iir_halfband_decimator_test.cpp"
 #include "synthesis/filters/ladder_filter_test.cpp"
 #include "synthesis/filters/formant_filter_test.cpp"
+#include "synthesis/modules/modulation_connection_processor_test.cpp"
 #include "synthesis/modulators/random_lfo_test.cpp"
 #include "synthesis/modulators/synth_lfo_test.cpp"
 #include "synthesis/modulators/envelope_test.cpp"